@@ -0,0 +1,371 @@
+#include <Geometry/Collision.hpp>
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <string>
+
+namespace
+{
+
+    uint32_t FailureCount = 0;
+
+    void Expect(bool condition, const char* description)
+    {
+        if (!condition)
+        {
+            std::printf("FAILED: %s\n", description);
+            ++FailureCount;
+        }
+    }
+
+    // Runs the workload several times and prints the fastest and the average run
+    template <class Workload>
+    void Measure(const std::string& name, uint32_t runCount, const Workload& workload)
+    {
+        double minMilliseconds = std::numeric_limits<double>::max();
+        double totalMilliseconds = 0.0;
+
+        for (auto run = 0u; run < runCount; ++run)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            workload();
+            auto end = std::chrono::high_resolution_clock::now();
+
+            double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+            minMilliseconds = std::min(minMilliseconds, milliseconds);
+            totalMilliseconds += milliseconds;
+        }
+
+        std::printf("%-36s min %9.3f ms   avg %9.3f ms\n", name.c_str(), minMilliseconds, totalMilliseconds / runCount);
+    }
+
+    bool NearlyEqual(float a, float b)
+    {
+        return std::abs(a - b) <= 1e-4f * std::max(1.0f, std::max(std::abs(a), std::abs(b)));
+    }
+
+    bool IsMaskBitSet(const std::vector<uint32_t>& masks, uint64_t index)
+    {
+        return masks[index / 32] & (1u << (index % 32));
+    }
+
+    // Same boxes in both layouts, so that scalar and batch routines see identical input
+    struct BoxSet
+    {
+        std::vector<Geometry::AxisAlignedBox3D> Boxes;
+        std::vector<float> MinX, MinY, MinZ, MaxX, MaxY, MaxZ;
+
+        Geometry::AxisAlignedBox3DSoA View() const
+        {
+            Geometry::AxisAlignedBox3DSoA view;
+            view.MinX = MinX.data(); view.MinY = MinY.data(); view.MinZ = MinZ.data();
+            view.MaxX = MaxX.data(); view.MaxY = MaxY.data(); view.MaxZ = MaxZ.data();
+            view.Count = Boxes.size();
+            return view;
+        }
+    };
+
+    // Count deliberately isn't a multiple of 8 to exercise the scalar tail of batch routines
+    BoxSet GenerateBoxes(std::mt19937& random, uint64_t count)
+    {
+        std::uniform_real_distribution<float> position{ -100.0f, 100.0f };
+        std::uniform_real_distribution<float> extent{ 0.5f, 5.0f };
+        BoxSet set;
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            Geometry::AxisAlignedBox3D box;
+            box.Min = { position(random), position(random), position(random) };
+            box.Max = box.Min + glm::vec3{ extent(random), extent(random), extent(random) };
+
+            set.Boxes.push_back(box);
+            set.MinX.push_back(box.Min.x); set.MinY.push_back(box.Min.y); set.MinZ.push_back(box.Min.z);
+            set.MaxX.push_back(box.Max.x); set.MaxY.push_back(box.Max.y); set.MaxZ.push_back(box.Max.z);
+        }
+
+        return set;
+    }
+
+    void BenchmarkRayAABBs(std::mt19937& random, uint32_t runCount)
+    {
+        const uint64_t boxCount = (1 << 16) + 5;
+        const uint32_t rayCount = 64;
+        const float maxDistance = 150.0f;
+
+        BoxSet boxes = GenerateBoxes(random, boxCount);
+        Geometry::AxisAlignedBox3DSoA view = boxes.View();
+        std::uniform_real_distribution<float> position{ -120.0f, 120.0f };
+        std::vector<Geometry::Ray3D> rays;
+
+        for (auto i = 0u; i < rayCount; ++i)
+        {
+            glm::vec3 origin{ position(random), position(random), position(random) };
+            glm::vec3 target{ position(random), position(random), position(random) };
+            rays.emplace_back(origin, glm::normalize(target - origin));
+        }
+
+        uint64_t maskCount = (boxCount + 31) / 32;
+        std::vector<uint32_t> scalarMasks(maskCount * rayCount);
+        std::vector<float> scalarDistances(boxCount * rayCount);
+        std::vector<uint32_t> batchMasks(maskCount * rayCount);
+        std::vector<float> batchDistances(boxCount * rayCount);
+
+        Measure("RayAABB scalar", runCount, [&]
+        {
+            std::fill(scalarMasks.begin(), scalarMasks.end(), 0);
+
+            for (auto r = 0u; r < rayCount; ++r)
+            {
+                for (auto i = 0u; i < boxCount; ++i)
+                {
+                    float distance = 0.0f;
+                    bool hit = Geometry::Collision::RayAABB(rays[r], boxes.Boxes[i], distance);
+
+                    // Batch variant clamps entry distance of boxes containing ray origin
+                    distance = std::max(distance, 0.0f);
+                    scalarDistances[r * boxCount + i] = distance;
+
+                    if (hit && distance <= maxDistance)
+                    {
+                        scalarMasks[r * maskCount + i / 32] |= 1u << (i % 32);
+                    }
+                }
+            }
+        });
+
+        Measure("RayAABBs batch", runCount, [&]
+        {
+            for (auto r = 0u; r < rayCount; ++r)
+            {
+                Geometry::Collision::RayAABBs(rays[r], view, maxDistance, &batchDistances[r * boxCount], &batchMasks[r * maskCount]);
+            }
+        });
+
+        uint64_t hitCount = 0;
+        bool distancesMatch = true;
+
+        for (auto r = 0u; r < rayCount; ++r)
+        {
+            for (auto i = 0u; i < boxCount; ++i)
+            {
+                if (!IsMaskBitSet(scalarMasks, r * maskCount * 32 + i)) continue;
+
+                ++hitCount;
+                distancesMatch = distancesMatch && NearlyEqual(scalarDistances[r * boxCount + i], batchDistances[r * boxCount + i]);
+            }
+        }
+
+        std::printf("%-36s %llu hits\n", "", (unsigned long long)hitCount);
+
+        Expect(hitCount > 0, "Rays hit some boxes");
+        Expect(scalarMasks == batchMasks, "RayAABBs hits match RayAABB");
+        Expect(distancesMatch, "RayAABBs distances match RayAABB");
+    }
+
+    // Aims every ray at a point with known barycentric coordinates. Points too close to triangle edges are avoided,
+    // because scalar and packet routines use different formulations and may legitimately disagree there.
+    template <uint32_t Width>
+    void GeneratePacket(std::mt19937& random, const Geometry::Triangle3D& triangle, Geometry::RayPacket3D<Width>& packet, std::vector<Geometry::Ray3D>& rays)
+    {
+        std::uniform_real_distribution<float> barycentric{ -0.5f, 1.5f };
+        std::uniform_real_distribution<float> height{ 1.0f, 50.0f };
+        std::uniform_real_distribution<float> offset{ -10.0f, 10.0f };
+        std::bernoulli_distribution coinFlip{ 0.5 };
+
+        glm::vec3 normal = glm::normalize(glm::cross(triangle.b - triangle.a, triangle.c - triangle.a));
+
+        for (auto lane = 0u; lane < Width; ++lane)
+        {
+            float u = 0.0f, v = 0.0f, w = 0.0f;
+
+            do
+            {
+                u = barycentric(random);
+                v = barycentric(random);
+                w = 1.0f - u - v;
+            } while (std::min({ std::abs(u), std::abs(v), std::abs(w) }) < 0.02f);
+
+            glm::vec3 target = triangle.a * w + triangle.b * u + triangle.c * v;
+            // Rays come from both sides of the triangle to cover back face rejection
+            glm::vec3 origin = target + normal * (coinFlip(random) ? height(random) : -height(random)) + glm::vec3{ offset(random), offset(random), offset(random) };
+            // Some rays point away from the triangle
+            glm::vec3 direction = glm::normalize(coinFlip(random) ? target - origin : origin - target);
+
+            Geometry::Ray3D ray{ origin, direction };
+            packet.setRay(lane, ray);
+            rays.push_back(ray);
+        }
+    }
+
+    void BenchmarkRayPacketTriangle(std::mt19937& random, uint32_t runCount)
+    {
+        const uint32_t triangleCount = 1 << 14;
+
+        std::uniform_real_distribution<float> position{ -10.0f, 10.0f };
+        std::vector<Geometry::Triangle3D> triangles;
+        std::vector<Geometry::RayPacket3D8> packets(triangleCount);
+        std::vector<Geometry::Ray3D> rays;
+
+        for (auto t = 0u; t < triangleCount; ++t)
+        {
+            Geometry::Triangle3D triangle;
+            triangle.a = { position(random), position(random), position(random) };
+            triangle.b = { position(random), position(random), position(random) };
+            triangle.c = { position(random), position(random), position(random) };
+            triangles.push_back(triangle);
+
+            GeneratePacket(random, triangle, packets[t], rays);
+        }
+
+        // Narrow packets hold the same rays as wide ones, four lanes each
+        std::vector<Geometry::RayPacket3D4> narrowPackets(triangleCount * 2);
+
+        for (auto i = 0u; i < rays.size(); ++i)
+        {
+            narrowPackets[i / 4].setRay(i % 4, rays[i]);
+        }
+
+        std::vector<uint32_t> scalarMasks(triangleCount);
+        std::vector<float> scalarDistances(rays.size());
+        std::vector<uint32_t> masks4(triangleCount);
+        std::vector<float> distances4(rays.size());
+        std::vector<uint32_t> masks8(triangleCount);
+        std::vector<float> distances8(rays.size());
+
+        Measure("RayTriangle scalar", runCount, [&]
+        {
+            for (auto t = 0u; t < triangleCount; ++t)
+            {
+                uint32_t mask = 0;
+
+                for (auto lane = 0u; lane < 8; ++lane)
+                {
+                    if (Geometry::Collision::RayTriangle(rays[t * 8 + lane], triangles[t], scalarDistances[t * 8 + lane]))
+                    {
+                        mask |= 1u << lane;
+                    }
+                }
+
+                scalarMasks[t] = mask;
+            }
+        });
+
+        Measure("RayPacketTriangle 4 wide", runCount, [&]
+        {
+            for (auto t = 0u; t < triangleCount; ++t)
+            {
+                masks4[t] = Geometry::Collision::RayPacketTriangle(narrowPackets[t * 2], triangles[t], &distances4[t * 8]) |
+                    (Geometry::Collision::RayPacketTriangle(narrowPackets[t * 2 + 1], triangles[t], &distances4[t * 8 + 4]) << 4);
+            }
+        });
+
+        Measure("RayPacketTriangle 8 wide", runCount, [&]
+        {
+            for (auto t = 0u; t < triangleCount; ++t)
+            {
+                masks8[t] = Geometry::Collision::RayPacketTriangle(packets[t], triangles[t], &distances8[t * 8]);
+            }
+        });
+
+        uint64_t hitCount = 0;
+        bool distancesMatch = true;
+
+        for (auto t = 0u; t < triangleCount; ++t)
+        {
+            for (auto lane = 0u; lane < 8; ++lane)
+            {
+                if (!(scalarMasks[t] & (1u << lane))) continue;
+
+                uint32_t ray = t * 8 + lane;
+                ++hitCount;
+                distancesMatch = distancesMatch && NearlyEqual(scalarDistances[ray], distances4[ray]) && NearlyEqual(scalarDistances[ray], distances8[ray]);
+            }
+        }
+
+        std::printf("%-36s %llu hits out of %llu rays\n", "", (unsigned long long)hitCount, (unsigned long long)rays.size());
+
+        Expect(hitCount > 0, "Rays hit some triangles");
+        Expect(scalarMasks == masks4, "4 wide RayPacketTriangle hits match RayTriangle");
+        Expect(scalarMasks == masks8, "8 wide RayPacketTriangle hits match RayTriangle");
+        Expect(distancesMatch, "RayPacketTriangle distances match RayTriangle");
+    }
+
+    void BenchmarkFrustumAABBs(std::mt19937& random, uint32_t runCount)
+    {
+        const uint64_t boxCount = (1 << 18) + 3;
+
+        BoxSet boxes = GenerateBoxes(random, boxCount);
+        Geometry::AxisAlignedBox3DSoA view = boxes.View();
+
+        glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 120.0f);
+        glm::mat4 viewMatrix = glm::lookAt(glm::vec3{ -20.0f, 10.0f, -30.0f }, glm::vec3{ 30.0f, -5.0f, 40.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f });
+        Geometry::Frustum frustum{ projection * viewMatrix };
+
+        std::vector<uint32_t> scalarMasks((boxCount + 31) / 32);
+        std::vector<uint32_t> batchMasks((boxCount + 31) / 32);
+
+        Measure("Frustum::Intersects scalar", runCount, [&]
+        {
+            std::fill(scalarMasks.begin(), scalarMasks.end(), 0);
+
+            for (auto i = 0u; i < boxCount; ++i)
+            {
+                if (frustum.Intersects(boxes.Boxes[i])) scalarMasks[i / 32] |= 1u << (i % 32);
+            }
+        });
+
+        Measure("FrustumAABBs batch", runCount, [&]
+        {
+            Geometry::Collision::FrustumAABBs(frustum, view, batchMasks.data());
+        });
+
+        uint64_t visibleCount = 0;
+
+        for (uint32_t mask : scalarMasks)
+        {
+            for (; mask; mask &= mask - 1) ++visibleCount;
+        }
+
+        std::printf("%-36s %llu of %llu boxes visible\n", "", (unsigned long long)visibleCount, (unsigned long long)boxCount);
+
+        Expect(visibleCount > 0 && visibleCount < boxCount, "Frustum culls some boxes but not all");
+        Expect(scalarMasks == batchMasks, "FrustumAABBs visibility matches Frustum::Intersects");
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    // Usage: CollisionBenchmark [run count]
+    uint32_t runCount = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 10;
+
+#if defined(__AVX__)
+    const char* instructionSet = "AVX";
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    const char* instructionSet = "SSE";
+#else
+    const char* instructionSet = "scalar";
+#endif
+
+    std::printf("Batch routines: %s, runs: %u\n", instructionSet, runCount);
+
+    // Fixed seed keeps runs comparable
+    std::mt19937 random{ 1234 };
+
+    BenchmarkRayAABBs(random, runCount);
+    BenchmarkRayPacketTriangle(random, runCount);
+    BenchmarkFrustumAABBs(random, runCount);
+
+    if (FailureCount) std::printf("%u checks failed\n", FailureCount);
+
+    return FailureCount ? 1 : 0;
+}
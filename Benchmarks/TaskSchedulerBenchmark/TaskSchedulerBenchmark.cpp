@@ -0,0 +1,205 @@
+#include <Foundation/TaskScheduler.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <cmath>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <string>
+
+namespace
+{
+
+    uint32_t FailureCount = 0;
+
+    void Expect(bool condition, const char* description)
+    {
+        if (!condition)
+        {
+            std::printf("FAILED: %s\n", description);
+            ++FailureCount;
+        }
+    }
+
+    // Runs the workload several times and prints the fastest and the average run
+    template <class Workload>
+    void Measure(const std::string& name, uint32_t runCount, const Workload& workload)
+    {
+        double minMilliseconds = std::numeric_limits<double>::max();
+        double totalMilliseconds = 0.0;
+
+        for (auto run = 0u; run < runCount; ++run)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            workload();
+            auto end = std::chrono::high_resolution_clock::now();
+
+            double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+            minMilliseconds = std::min(minMilliseconds, milliseconds);
+            totalMilliseconds += milliseconds;
+        }
+
+        std::printf("%-36s min %9.3f ms   avg %9.3f ms\n", name.c_str(), minMilliseconds, totalMilliseconds / runCount);
+    }
+
+    // Enough arithmetic per index for scheduling overhead not to dominate completely
+    float Work(uint64_t index)
+    {
+        float value = float(index);
+
+        for (auto i = 0; i < 64; ++i)
+        {
+            value = std::sqrt(value * 1.0001f + 1.0f);
+        }
+
+        return value;
+    }
+
+    void BenchmarkFlatParallelFor(Foundation::TaskScheduler& scheduler, uint32_t runCount)
+    {
+        const uint64_t itemCount = 1 << 18;
+        std::vector<float> serialResults(itemCount);
+        std::vector<float> parallelResults(itemCount);
+
+        Measure("Serial loop", runCount, [&]
+        {
+            for (auto i = 0u; i < itemCount; ++i) serialResults[i] = Work(i);
+        });
+
+        Measure("ParallelFor", runCount, [&]
+        {
+            scheduler.ParallelFor(0, itemCount, 4096, [&](uint64_t i) { parallelResults[i] = Work(i); });
+        });
+
+        Expect(serialResults == parallelResults, "ParallelFor produces same results as serial loop");
+    }
+
+    void BenchmarkNestedParallelFor(Foundation::TaskScheduler& scheduler, uint32_t runCount)
+    {
+        const uint64_t outerCount = 64;
+        const uint64_t innerCount = 4096;
+        std::vector<float> results(outerCount * innerCount);
+        std::atomic<uint64_t> innerInvocationCount = 0;
+
+        // Inner loops are waited on from inside worker tasks, which must not deadlock
+        Measure("Nested ParallelFor", runCount, [&]
+        {
+            scheduler.ParallelFor(0, outerCount, 4, [&](uint64_t outer)
+            {
+                scheduler.ParallelFor(0, innerCount, 512, [&](uint64_t inner)
+                {
+                    results[outer * innerCount + inner] = Work(outer * innerCount + inner);
+                    innerInvocationCount.fetch_add(1, std::memory_order_relaxed);
+                });
+            });
+        });
+
+        Expect(innerInvocationCount == outerCount * innerCount * runCount, "Every nested index is executed exactly once per run");
+        Expect(results.back() == Work(outerCount * innerCount - 1), "Nested ParallelFor produces correct results");
+    }
+
+    void BenchmarkDependencyChains(Foundation::TaskScheduler& scheduler, uint32_t runCount)
+    {
+        const uint32_t chainCount = 64;
+        const uint32_t chainLength = 256;
+        std::vector<uint32_t> progress(chainCount);
+        std::atomic<uint32_t> orderViolationCount = 0;
+
+        Measure("ScheduleAfter chains", runCount, [&]
+        {
+            std::fill(progress.begin(), progress.end(), 0);
+
+            // Counters have to outlive every task that depends on them
+            std::vector<std::vector<Foundation::TaskCounter>> counters(chainCount);
+            Foundation::TaskCounter allChainsCounter;
+
+            for (auto chain = 0u; chain < chainCount; ++chain)
+            {
+                counters[chain] = std::vector<Foundation::TaskCounter>(chainLength);
+
+                for (auto link = 0u; link < chainLength; ++link)
+                {
+                    auto task = [&, chain, link]
+                    {
+                        // Each link must observe every previous link of its chain
+                        if (progress[chain] != link) orderViolationCount.fetch_add(1);
+                        progress[chain] = link + 1;
+                        Work(link);
+                    };
+
+                    Foundation::TaskCounter* counter = &counters[chain][link];
+
+                    if (link == 0) scheduler.Schedule(task, counter);
+                    else scheduler.ScheduleAfter(counters[chain][link - 1], task, counter);
+                }
+
+                scheduler.ScheduleAfter(counters[chain].back(), [] {}, &allChainsCounter);
+            }
+
+            scheduler.Wait(allChainsCounter);
+
+            // Waiting is what makes counters safe to destroy, completion of dependent tasks doesn't
+            for (auto& chainCounters : counters) scheduler.Wait(chainCounters.back());
+        });
+
+        Expect(orderViolationCount == 0, "ScheduleAfter tasks run after their dependencies");
+        Expect(std::all_of(progress.begin(), progress.end(), [&](uint32_t p) { return p == chainLength; }), "Every chain runs to completion");
+    }
+
+    void BenchmarkMainThreadTasks(Foundation::TaskScheduler& scheduler, uint32_t runCount)
+    {
+        const uint32_t taskCount = 4096;
+        std::atomic<uint32_t> offMainThreadCount = 0;
+        std::atomic<uint32_t> executedCount = 0;
+
+        // Workers hand results over to the main thread, which pumps its queue like a frame loop would
+        Measure("Main thread tasks from workers", runCount, [&]
+        {
+            Foundation::TaskCounter mainThreadCounter;
+
+            scheduler.ParallelFor(0, taskCount, 64, [&](uint64_t)
+            {
+                scheduler.ScheduleOnMainThread([&]
+                {
+                    if (!scheduler.IsMainThread()) offMainThreadCount.fetch_add(1);
+                    executedCount.fetch_add(1, std::memory_order_relaxed);
+                }, &mainThreadCounter);
+            });
+
+            while (!mainThreadCounter.IsDone())
+            {
+                scheduler.ExecuteMainThreadTasks();
+            }
+
+            // Makes counter safe to destroy
+            scheduler.Wait(mainThreadCounter);
+        });
+
+        Expect(offMainThreadCount == 0, "Main thread tasks execute only on main thread");
+        Expect(executedCount == taskCount * runCount, "Every main thread task is executed");
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    // Usage: TaskSchedulerBenchmark [run count] [worker count, zero for one per hardware thread]
+    uint32_t runCount = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 10;
+    uint32_t workerCount = argc > 2 ? std::max(std::atoi(argv[2]), 0) : 0;
+
+    Foundation::TaskScheduler scheduler{ workerCount };
+
+    std::printf("Workers: %u, runs: %u\n", scheduler.WorkerCount(), runCount);
+
+    BenchmarkFlatParallelFor(scheduler, runCount);
+    BenchmarkNestedParallelFor(scheduler, runCount);
+    BenchmarkDependencyChains(scheduler, runCount);
+    BenchmarkMainThreadTasks(scheduler, runCount);
+
+    if (FailureCount) std::printf("%u checks failed\n", FailureCount);
+
+    return FailureCount ? 1 : 0;
+}
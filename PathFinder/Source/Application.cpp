@@ -15,13 +15,13 @@ namespace PathFinder
 
         mCmdLineParser = std::make_unique<CommandLineParser>(argc, argv);
         mRenderEngine = std::make_unique<RenderEngine<RenderPassContentMediator>>(mWindowHandle, *mCmdLineParser);
-        mScene = std::make_unique<Scene>(mCmdLineParser->ExecutableFolderPath(), mRenderEngine->Device(), mRenderEngine->ResourceProducer());
+        mScene = std::make_unique<Scene>(mCmdLineParser->ExecutableFolderPath(), mRenderEngine->Device(), mRenderEngine->ResourceProducer(), mRenderEngine->TaskScheduler());
         mInput = std::make_unique<Input>();
         mSettingsController = std::make_unique<RenderSettingsController>(mInput.get());
         mWindowsInputHandler = std::make_unique<InputHandlerWindows>(mInput.get(), mWindowHandle);
         mCameraInteractor = std::make_unique<CameraInteractor>(&mScene->MainCamera(), mInput.get());
         mDisplaySettingsController = std::make_unique<DisplaySettingsController>(mRenderEngine->SelectedAdapter(), mRenderEngine->SwapChain(), mWindowHandle);
-        mUIDependencies = std::make_unique<UIDependencies>(mRenderEngine->ResourceStorage(), &mRenderEngine->PreRenderEvent(), &mRenderEngine->PostRenderEvent(), mScene.get());
+        mUIDependencies = std::make_unique<UIDependencies>(mRenderEngine->ResourceStorage(), &mRenderEngine->PreRenderEvent(), &mRenderEngine->PostRenderEvent(), mRenderEngine->Profiler(), mRenderEngine->ResourceAllocator(), mCmdLineParser.get(), mScene.get());
         mUIManager = std::make_unique<UIManager>(mInput.get(), mUIDependencies.get(), mRenderEngine->ResourceProducer());
         mUIEntryPoint = std::make_unique<UIEntryPoint>(mUIManager.get());
         mContentMediator = std::make_unique<RenderPassContentMediator>(&mUIManager->GPUStorage(), &mScene->GPUStorage(), mScene.get(), mInput.get(), mDisplaySettingsController.get(), mSettingsController.get());
@@ -39,7 +39,7 @@ namespace PathFinder
 
         // Temporary to load demo Scene until proper UI is implemented
         mMeshLoader = std::make_unique<MeshLoader>(mCmdLineParser->ExecutableFolderPath() / "MediaResources/Models/");
-        mMaterialLoader = std::make_unique<MaterialLoader>(mCmdLineParser->ExecutableFolderPath(), mRenderEngine->AssetStorage(), mRenderEngine->ResourceProducer());
+        mMaterialLoader = std::make_unique<MaterialLoader>(mCmdLineParser->ExecutableFolderPath(), mRenderEngine->AssetStorage(), mRenderEngine->ResourceProducer(), mRenderEngine->TaskScheduler());
         LoadDemoScene();
     }
 
@@ -127,7 +127,6 @@ namespace PathFinder
         mRenderEngine->AddRenderPass(&mToneMappingPass);
         mRenderEngine->AddRenderPass(&mBackBufferOutputPass);
         mRenderEngine->AddRenderPass(&mUIPass);
-        mRenderEngine->AddRenderPass(&mGeometryPickingPass);
     }
 
     void Application::PerformPreRenderActions()
@@ -148,8 +147,11 @@ namespace PathFinder
         mSettingsController->SetEnabled(!interactingWithUI);
         mSettingsController->ApplyVolatileSettings();
 
+        // Instance table refers to index ranges of selected levels of detail
+        mScene->LODSelector().Select(mScene->MainCamera(), viewportSize.Height);
         mScene->GPUStorage().UploadInstances();
-        mScene->RemapEntityIDs();
+
+        mScene->BVH().Update();
 
         // Top RT needs to be rebuilt every frame
         mRenderEngine->AddTopRayTracingAccelerationStructure(&mScene->GPUStorage().TopAccelerationStructure());
@@ -177,6 +179,23 @@ namespace PathFinder
         mPerFrameConstants.IsMotionDebugEnabled = settings.IsDenoiserMotionDebugRenderingEnabled;
         mPerFrameConstants.IsDenoiserAntilagEnabled = settings.IsDenoiserAntilagEnabled;
 
+        mScene->Culler().Cull(mScene->MainCamera(), settings.IsOcclusionCullingEnabled);
+
+        // Residency follows instances visible this frame.
+        // Material table refers to descriptors of textures replaced by streaming.
+        if (mMaterialLoader->UpdateTextureResidency(*mScene, viewportSize.Height))
+        {
+            mScene->GPUStorage().UploadMaterials();
+        }
+
+        mRenderEngine->SetPassOrderingPolicy(settings.IsMemoryAwarePassOrderingEnabled ?
+            PathFinder::RenderPassGraph::OrderingPolicy::TransientMemory :
+            PathFinder::RenderPassGraph::OrderingPolicy::DependencyDepth);
+
+        mRenderEngine->SetQueueAssignmentPolicy(settings.IsAutomaticAsyncComputeEnabled ?
+            PathFinder::RenderPassGraph::QueueAssignmentPolicy::CriticalPath :
+            PathFinder::RenderPassGraph::QueueAssignmentPolicy::Manual);
+
         mRenderEngine->SetGlobalRootConstants(mGlobalConstants);
         mRenderEngine->SetFrameRootConstants(mPerFrameConstants);
     }
@@ -240,77 +259,84 @@ namespace PathFinder
             "/MediaResources/Textures/ScuffedTitanium/Titanium-Scuffed_roughness.dds",
             "/MediaResources/Textures/ScuffedTitanium/Titanium-Scuffed_metallic.dds"));
 
-        PathFinder::Mesh& plane = mScene->AddMesh(std::move(mMeshLoader->Load("plane.obj").back()));
+        // Demo models consist of a single mesh, further instances share it
+        auto addModel = [this](const std::string& fileName, const PathFinder::Material& material)
+        {
+            return mScene->AddModel(mMeshLoader->LoadModel(fileName), { &material }).front();
+        };
+
+        auto addInstance = [this](PathFinder::Scene::MeshInstanceHandle modelInstance, const PathFinder::Material& material)
+        {
+            return mScene->AddMeshInstance(mScene->MeshInstances()[modelInstance].AssociatedMesh(), &material);
+        };
+
+        auto planeModelInstance = addModel("plane.obj", concrete19Material);
+        bool isPlaneModelInstanceUsed = false;
 
         for (float x = -100; x < 100; x += 20)
         {
             for (float z = -100; z < 100; z += 20)
             {
-                PathFinder::MeshInstance& planeInstance = mScene->AddMeshInstance({ &plane, &concrete19Material });
+                auto planeInstance = isPlaneModelInstanceUsed ? addInstance(planeModelInstance, concrete19Material) : planeModelInstance;
+                isPlaneModelInstanceUsed = true;
                 Geometry::Transformation t;
                 t.Translation = glm::vec3{ x, -3.50207, z };
-                planeInstance.SetTransformation(t);
+                mScene->SetMeshInstanceTransformation(planeInstance, t);
             }
         }
 
-        PathFinder::Mesh& cube = mScene->AddMesh(std::move(mMeshLoader->Load("cube.obj").back()));
-        PathFinder::MeshInstance& cubeInstance = mScene->AddMeshInstance({ &cube, &metalMaterial });
-
-        PathFinder::Mesh& sphereType1 = mScene->AddMesh(std::move(mMeshLoader->Load("sphere1.obj").back()));
-        PathFinder::MeshInstance& sphereType1Instance0 = mScene->AddMeshInstance({ &sphereType1, &marbleTilesMaterial });
-
-        PathFinder::Mesh& sphereType2 = mScene->AddMesh(std::move(mMeshLoader->Load("sphere2.obj").back()));
-        PathFinder::MeshInstance& sphereType2Instance0 = mScene->AddMeshInstance({ &sphereType2, &marbleTilesMaterial });
+        auto cubeInstance = addModel("cube.obj", metalMaterial);
+        auto sphereType1Instance0 = addModel("sphere1.obj", marbleTilesMaterial);
+        auto sphereType2Instance0 = addModel("sphere2.obj", marbleTilesMaterial);
 
-        PathFinder::Mesh& sphereType3 = mScene->AddMesh(std::move(mMeshLoader->Load("sphere3.obj").back()));
-        PathFinder::MeshInstance& sphereType3Instance0 = mScene->AddMeshInstance({ &sphereType3, &grimyMetalMaterial });
-        PathFinder::MeshInstance& sphereType3Instance1 = mScene->AddMeshInstance({ &sphereType3, &redPlasticMaterial });
-        PathFinder::MeshInstance& sphereType3Instance2 = mScene->AddMeshInstance({ &sphereType3, &marble006Material });
-        PathFinder::MeshInstance& sphereType3Instance3 = mScene->AddMeshInstance({ &sphereType3, &charcoalMaterial });
-        PathFinder::MeshInstance& sphereType3Instance4 = mScene->AddMeshInstance({ &sphereType3, &concrete19Material });
-        PathFinder::MeshInstance& sphereType3Instance5 = mScene->AddMeshInstance({ &sphereType3, &metalMaterial });
+        auto sphereType3Instance0 = addModel("sphere3.obj", grimyMetalMaterial);
+        auto sphereType3Instance1 = addInstance(sphereType3Instance0, redPlasticMaterial);
+        auto sphereType3Instance2 = addInstance(sphereType3Instance0, marble006Material);
+        auto sphereType3Instance3 = addInstance(sphereType3Instance0, charcoalMaterial);
+        auto sphereType3Instance4 = addInstance(sphereType3Instance0, concrete19Material);
+        auto sphereType3Instance5 = addInstance(sphereType3Instance0, metalMaterial);
 
-        Geometry::Transformation t = cubeInstance.Transformation();
+        Geometry::Transformation t = mScene->MeshInstanceTransformation(cubeInstance);
         t.Rotation = glm::angleAxis(glm::radians(45.0f), glm::normalize(glm::vec3(1.0, 0.0, 1.0)));
         t.Translation = glm::vec3{ -4.88, 3.25, -3.42 };
         t.Scale = glm::vec3{ 0/*2.0f*/ };
-        cubeInstance.SetTransformation(t);
+        mScene->SetMeshInstanceTransformation(cubeInstance, t);
 
         //t.Scale = glm::vec3{ 0.1f }; // Large version
         //t.Translation = glm::vec3{ 0.0, -2, -4.0 }; // Large version
         t.Scale = glm::vec3{ 0.11f };
         t.Translation = glm::vec3{ -6.0, 8.0, -4.0 };
-        sphereType1Instance0.SetTransformation(t);
+        mScene->SetMeshInstanceTransformation(sphereType1Instance0, t);
 
         // Small sphere
         t.Scale = glm::vec3{ 0/*0.21f*/ };
         t.Translation = glm::vec3{ 6.0, -14.0, -9.0 };
-        sphereType2Instance0.SetTransformation(t);
+        mScene->SetMeshInstanceTransformation(sphereType2Instance0, t);
 
         // Normal spheres
         t.Scale = glm::vec3{ 0.12 };
         t.Translation = glm::vec3{ 9.0, 2.0, -17.5 };
-        sphereType3Instance0.SetTransformation(t);
+        mScene->SetMeshInstanceTransformation(sphereType3Instance0, t);
 
         t.Scale = glm::vec3{ 0.085 };
         t.Translation = glm::vec3{ 8.88, 1.2, 0.1 };
-        sphereType3Instance1.SetTransformation(t);
+        mScene->SetMeshInstanceTransformation(sphereType3Instance1, t);
 
         t.Scale = glm::vec3{ 0.15 };
         t.Translation = glm::vec3{ 3.88, 3, -23.77 };
-        sphereType3Instance2.SetTransformation(t);
+        mScene->SetMeshInstanceTransformation(sphereType3Instance2, t);
 
         t.Scale = glm::vec3{ 0.1 };
         t.Translation = glm::vec3{ -13.2, 1.5, -18.6 };
-        sphereType3Instance3.SetTransformation(t);
+        mScene->SetMeshInstanceTransformation(sphereType3Instance3, t);
 
         t.Scale = glm::vec3{ 0.09 };
         t.Translation = glm::vec3{ -4.07, 1.25, -19.25 };
-        sphereType3Instance4.SetTransformation(t);
+        mScene->SetMeshInstanceTransformation(sphereType3Instance4, t);
 
         t.Scale = glm::vec3{ 0.1 };
         t.Translation = glm::vec3{ 12.47, 1.7, -9.26 };
-        sphereType3Instance5.SetTransformation(t);
+        mScene->SetMeshInstanceTransformation(sphereType3Instance5, t);
 
         Foundation::Color light0Color{ 255.0 / 255, 241.0 / 255, 224.1 / 255 };
         Foundation::Color light1Color{ 64.0 / 255, 156.0 / 255, 255.0 / 255 };
@@ -318,28 +344,28 @@ namespace PathFinder
         Foundation::Color light3Color{ 250.0 / 255, 110.0 / 255, 100.0 / 255 };
 
         auto sphereLight0 = mScene->EmplaceSphericalLight();
-        sphereLight0->SetRadius(7);
-        sphereLight0->SetPosition({ 10.65, 12.0, -4.6 });
-        sphereLight0->SetColor(light0Color);
-        sphereLight0->SetLuminousPower(100000);
+        mScene->SphericalLights()[sphereLight0].SetRadius(7);
+        mScene->SphericalLights()[sphereLight0].SetPosition({ 10.65, 12.0, -4.6 });
+        mScene->SphericalLights()[sphereLight0].SetColor(light0Color);
+        mScene->SphericalLights()[sphereLight0].SetLuminousPower(100000);
 
         auto sphereLight1 = mScene->EmplaceSphericalLight();
-        sphereLight1->SetRadius(7.5);
-        sphereLight1->SetPosition({ -10.65, 12.0, -4.6 });
-        sphereLight1->SetColor(light1Color);
-        sphereLight1->SetLuminousPower(100000);
+        mScene->SphericalLights()[sphereLight1].SetRadius(7.5);
+        mScene->SphericalLights()[sphereLight1].SetPosition({ -10.65, 12.0, -4.6 });
+        mScene->SphericalLights()[sphereLight1].SetColor(light1Color);
+        mScene->SphericalLights()[sphereLight1].SetLuminousPower(100000);
 
         //auto sphereLight2 = mScene->EmplaceSphericalLight();
-        //sphereLight2->SetRadius(6);
-        //sphereLight2->SetPosition({ -5.3, 4.43, -4.76 });
-        //sphereLight2->SetColor(light2Color);
-        //sphereLight2->SetLuminousPower(300000);
+        //mScene->SphericalLights()[sphereLight2].SetRadius(6);
+        //mScene->SphericalLights()[sphereLight2].SetPosition({ -5.3, 4.43, -4.76 });
+        //mScene->SphericalLights()[sphereLight2].SetColor(light2Color);
+        //mScene->SphericalLights()[sphereLight2].SetLuminousPower(300000);
 
         //auto sphereLight3 = mScene->EmplaceSphericalLight();
-        //sphereLight3->SetRadius(8);
-        //sphereLight3->SetPosition({ -5.3, 4.43, -4.76 });
-        //sphereLight3->SetColor(light3Color);
-        //sphereLight3->SetLuminousPower(300000);
+        //mScene->SphericalLights()[sphereLight3].SetRadius(8);
+        //mScene->SphericalLights()[sphereLight3].SetPosition({ -5.3, 4.43, -4.76 });
+        //mScene->SphericalLights()[sphereLight3].SetColor(light3Color);
+        //mScene->SphericalLights()[sphereLight3].SetLuminousPower(300000);
 
         PathFinder::Camera& camera = mScene->MainCamera();
         camera.SetFarPlane(500);
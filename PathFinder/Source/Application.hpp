@@ -35,7 +35,6 @@
 #include "RenderPipeline/RenderPasses/CommonSetupRenderPass.hpp"
 #include "RenderPipeline/RenderPasses/BloomBlurRenderPass.hpp"
 #include "RenderPipeline/RenderPasses/BloomCompositionRenderPass.hpp"
-#include "RenderPipeline/RenderPasses/GeometryPickingRenderPass.hpp"
 #include "RenderPipeline/GlobalRootConstants.hpp"
 #include "RenderPipeline/PerFrameRootConstants.hpp"
 #include "RenderPipeline/RenderPassContentMediator.hpp"
@@ -99,7 +98,6 @@ namespace PathFinder
         SMAANeighborhoodBlendingRenderPass mSMAANeighborhoodBlendingPass;
         BackBufferOutputPass mBackBufferOutputPass;
         UIRenderPass mUIPass;
-        GeometryPickingRenderPass mGeometryPickingPass;
 
         GlobalRootConstants mGlobalConstants;
         PerFrameRootConstants mPerFrameConstants;
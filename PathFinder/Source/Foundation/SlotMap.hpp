@@ -0,0 +1,80 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+
+namespace Foundation
+{
+
+    // Stores objects densely in one contiguous array for linear iteration,
+    // while handing out generational handles that survive insertions and removals of other objects.
+    // Insertion and removal are O(1): removed object is replaced by the last one in dense array.
+    // Pointers and references to stored objects are invalidated by insertions and removals, handles are not.
+    template <class T>
+    class SlotMap
+    {
+    public:
+        struct Handle
+        {
+            uint32_t SlotIndex = std::numeric_limits<uint32_t>::max();
+            uint32_t Generation = 0;
+
+            inline bool IsValid() const { return SlotIndex != std::numeric_limits<uint32_t>::max(); }
+            inline bool operator==(const Handle& other) const { return SlotIndex == other.SlotIndex && Generation == other.Generation; }
+            inline bool operator!=(const Handle& other) const { return !(*this == other); }
+        };
+
+        template <class... Args>
+        Handle Emplace(Args&&... args);
+
+        void Remove(Handle handle);
+        void Clear();
+        bool Contains(Handle handle) const;
+
+        T* Get(Handle handle);
+        const T* Get(Handle handle) const;
+
+        // Access by slot index only, ignoring generation, for ids that can't accommodate it
+        T* GetBySlotIndex(uint32_t slotIndex);
+        const T* GetBySlotIndex(uint32_t slotIndex) const;
+
+        Handle HandleAt(uint64_t denseIndex) const;
+
+        // Position in dense array, for data kept in arrays parallel to it
+        uint64_t DenseIndex(Handle handle) const;
+        uint64_t DenseIndexOf(const T& object) const;
+
+        // Handle of an object currently occupying the slot, or invalid handle for a free slot
+        Handle HandleForSlotIndex(uint32_t slotIndex) const;
+
+        T& operator[](Handle handle);
+        const T& operator[](Handle handle) const;
+
+    private:
+        struct Slot
+        {
+            uint32_t DenseIndex = 0;
+            uint32_t Generation = 0;
+            bool IsOccupied = false;
+        };
+
+        std::vector<T> mObjects;
+        std::vector<uint32_t> mDenseToSlot;
+        std::vector<Slot> mSlots;
+        std::vector<uint32_t> mFreeSlots;
+
+    public:
+        inline auto begin() { return mObjects.begin(); }
+        inline auto end() { return mObjects.end(); }
+        inline auto begin() const { return mObjects.begin(); }
+        inline auto end() const { return mObjects.end(); }
+        inline auto size() const { return mObjects.size(); }
+        inline bool empty() const { return mObjects.empty(); }
+        inline T* data() { return mObjects.data(); }
+        inline const T* data() const { return mObjects.data(); }
+    };
+
+}
+
+#include "SlotMap.inl"
@@ -0,0 +1,149 @@
+#include <utility>
+
+#include "Assert.hpp"
+
+namespace Foundation
+{
+
+    template <class T>
+    template <class... Args>
+    typename SlotMap<T>::Handle SlotMap<T>::Emplace(Args&&... args)
+    {
+        uint32_t slotIndex = 0;
+
+        if (!mFreeSlots.empty())
+        {
+            slotIndex = mFreeSlots.back();
+            mFreeSlots.pop_back();
+        }
+        else
+        {
+            slotIndex = mSlots.size();
+            mSlots.emplace_back();
+        }
+
+        Slot& slot = mSlots[slotIndex];
+        slot.DenseIndex = mObjects.size();
+        slot.IsOccupied = true;
+
+        mObjects.emplace_back(std::forward<Args>(args)...);
+        mDenseToSlot.push_back(slotIndex);
+
+        return { slotIndex, slot.Generation };
+    }
+
+    template <class T>
+    void SlotMap<T>::Remove(Handle handle)
+    {
+        assert_format(Contains(handle), "Removing an object by stale or invalid handle");
+
+        Slot& slot = mSlots[handle.SlotIndex];
+        uint32_t lastDenseIndex = mObjects.size() - 1;
+
+        // Fill the hole with the last object to keep the array dense
+        if (slot.DenseIndex != lastDenseIndex)
+        {
+            mObjects[slot.DenseIndex] = std::move(mObjects[lastDenseIndex]);
+            mDenseToSlot[slot.DenseIndex] = mDenseToSlot[lastDenseIndex];
+            mSlots[mDenseToSlot[slot.DenseIndex]].DenseIndex = slot.DenseIndex;
+        }
+
+        mObjects.pop_back();
+        mDenseToSlot.pop_back();
+
+        // Generation bump makes outstanding handles to this slot stale
+        slot.IsOccupied = false;
+        ++slot.Generation;
+        mFreeSlots.push_back(handle.SlotIndex);
+    }
+
+    template <class T>
+    void SlotMap<T>::Clear()
+    {
+        for (uint32_t slotIndex : mDenseToSlot)
+        {
+            mSlots[slotIndex].IsOccupied = false;
+            ++mSlots[slotIndex].Generation;
+            mFreeSlots.push_back(slotIndex);
+        }
+
+        mObjects.clear();
+        mDenseToSlot.clear();
+    }
+
+    template <class T>
+    bool SlotMap<T>::Contains(Handle handle) const
+    {
+        return handle.SlotIndex < mSlots.size() && 
+            mSlots[handle.SlotIndex].IsOccupied && 
+            mSlots[handle.SlotIndex].Generation == handle.Generation;
+    }
+
+    template <class T>
+    T* SlotMap<T>::Get(Handle handle)
+    {
+        return Contains(handle) ? &mObjects[mSlots[handle.SlotIndex].DenseIndex] : nullptr;
+    }
+
+    template <class T>
+    const T* SlotMap<T>::Get(Handle handle) const
+    {
+        return Contains(handle) ? &mObjects[mSlots[handle.SlotIndex].DenseIndex] : nullptr;
+    }
+
+    template <class T>
+    T* SlotMap<T>::GetBySlotIndex(uint32_t slotIndex)
+    {
+        return slotIndex < mSlots.size() && mSlots[slotIndex].IsOccupied ? &mObjects[mSlots[slotIndex].DenseIndex] : nullptr;
+    }
+
+    template <class T>
+    const T* SlotMap<T>::GetBySlotIndex(uint32_t slotIndex) const
+    {
+        return slotIndex < mSlots.size() && mSlots[slotIndex].IsOccupied ? &mObjects[mSlots[slotIndex].DenseIndex] : nullptr;
+    }
+
+    template <class T>
+    typename SlotMap<T>::Handle SlotMap<T>::HandleAt(uint64_t denseIndex) const
+    {
+        uint32_t slotIndex = mDenseToSlot[denseIndex];
+        return { slotIndex, mSlots[slotIndex].Generation };
+    }
+
+    template <class T>
+    uint64_t SlotMap<T>::DenseIndex(Handle handle) const
+    {
+        assert_format(Contains(handle), "Accessing an object by stale or invalid handle");
+        return mSlots[handle.SlotIndex].DenseIndex;
+    }
+
+    template <class T>
+    uint64_t SlotMap<T>::DenseIndexOf(const T& object) const
+    {
+        assert_format(&object >= mObjects.data() && &object < mObjects.data() + mObjects.size(), "Object is not stored in this map");
+        return &object - mObjects.data();
+    }
+
+    template <class T>
+    typename SlotMap<T>::Handle SlotMap<T>::HandleForSlotIndex(uint32_t slotIndex) const
+    {
+        return slotIndex < mSlots.size() && mSlots[slotIndex].IsOccupied ? Handle{ slotIndex, mSlots[slotIndex].Generation } : Handle{};
+    }
+
+    template <class T>
+    T& SlotMap<T>::operator[](Handle handle)
+    {
+        T* object = Get(handle);
+        assert_format(object, "Accessing an object by stale or invalid handle");
+        return *object;
+    }
+
+    template <class T>
+    const T& SlotMap<T>::operator[](Handle handle) const
+    {
+        const T* object = Get(handle);
+        assert_format(object, "Accessing an object by stale or invalid handle");
+        return *object;
+    }
+
+}
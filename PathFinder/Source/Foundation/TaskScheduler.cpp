@@ -0,0 +1,274 @@
+#include "TaskScheduler.hpp"
+#include "Assert.hpp"
+
+namespace Foundation
+{
+
+    namespace
+    {
+        // Identifies queue owned by the current thread. Workers of different schedulers never overlap.
+        thread_local const TaskScheduler* tOwningScheduler = nullptr;
+        thread_local uint32_t tQueueIndex = 0;
+    }
+
+    bool TaskCounter::IsDone() const
+    {
+        return mPendingTaskCount.load(std::memory_order_acquire) == 0;
+    }
+
+    void TaskCounter::Increment()
+    {
+        mPendingTaskCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void TaskCounter::Decrement(TaskScheduler* scheduler)
+    {
+        std::vector<Continuation> continuations;
+
+        {
+            // Decrement is done under the lock, so that waiters, which acquire it after observing zero,
+            // can't destroy the counter while it's still being accessed here
+            std::lock_guard lock{ mContinuationsMutex };
+
+            if (mPendingTaskCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+
+            continuations = std::move(mContinuations);
+            mContinuations.clear();
+        }
+
+        // Counters of continuations were already incremented when they were scheduled
+        for (Continuation& continuation : continuations)
+        {
+            scheduler->Push({ std::move(continuation.Function), continuation.Counter });
+        }
+    }
+
+    TaskScheduler::TaskScheduler(uint32_t workerCount)
+        : mMainThreadID{ std::this_thread::get_id() }
+    {
+        if (workerCount == 0)
+        {
+            workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+        }
+
+        for (auto i = 0u; i < workerCount + 1; ++i)
+        {
+            mQueues.emplace_back(std::make_unique<WorkerQueue>());
+        }
+
+        tOwningScheduler = this;
+        tQueueIndex = 0;
+
+        for (auto i = 0u; i < workerCount; ++i)
+        {
+            mWorkers.emplace_back([this, queueIndex = i + 1] { WorkerLoop(queueIndex); });
+        }
+    }
+
+    TaskScheduler::~TaskScheduler()
+    {
+        {
+            std::lock_guard lock{ mSleepMutex };
+            mIsStopping = true;
+        }
+
+        mWakeCondition.notify_all();
+
+        for (std::thread& worker : mWorkers)
+        {
+            worker.join();
+        }
+    }
+
+    void TaskScheduler::Schedule(Task task, TaskCounter* counter)
+    {
+        if (counter) counter->Increment();
+        Push({ std::move(task), counter });
+    }
+
+    void TaskScheduler::ScheduleAfter(TaskCounter& dependency, Task task, TaskCounter* counter)
+    {
+        // Counter is incremented right away so that waiting on it covers deferred task as well
+        if (counter) counter->Increment();
+
+        {
+            std::lock_guard lock{ dependency.mContinuationsMutex };
+
+            if (!dependency.IsDone())
+            {
+                dependency.mContinuations.push_back({ std::move(task), counter });
+                return;
+            }
+        }
+
+        Push({ std::move(task), counter });
+    }
+
+    void TaskScheduler::ScheduleOnMainThread(Task task, TaskCounter* counter)
+    {
+        if (counter) counter->Increment();
+        PushMainThreadTask({ std::move(task), counter });
+    }
+
+    void TaskScheduler::Wait(const TaskCounter& counter)
+    {
+        bool isMainThread = IsMainThread();
+
+        while (!counter.IsDone())
+        {
+            // Main thread tasks are served first because workers can be blocked waiting on them
+            if (isMainThread && TryExecuteMainThreadTask())
+                continue;
+
+            if (!TryExecuteTask())
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        std::lock_guard lock{ counter.mContinuationsMutex };
+    }
+
+    void TaskScheduler::ExecuteMainThreadTasks()
+    {
+        assert_format(IsMainThread(), "Main thread tasks can only be executed by the main thread");
+
+        while (TryExecuteMainThreadTask()) {}
+    }
+
+    bool TaskScheduler::IsMainThread() const
+    {
+        return std::this_thread::get_id() == mMainThreadID;
+    }
+
+    void TaskScheduler::Push(ScheduledTask&& task)
+    {
+        WorkerQueue& queue = *mQueues[CurrentQueueIndex()];
+
+        {
+            std::lock_guard lock{ queue.Mutex };
+            queue.Tasks.push_back(std::move(task));
+        }
+
+        mQueuedTaskCount.fetch_add(1, std::memory_order_release);
+
+        // Taking the lock orders the increment with sleeping workers' predicate check, so no wake up is lost
+        {
+            std::lock_guard lock{ mSleepMutex };
+        }
+
+        mWakeCondition.notify_one();
+    }
+
+    void TaskScheduler::PushMainThreadTask(ScheduledTask&& task)
+    {
+        std::lock_guard lock{ mMainThreadQueueMutex };
+        mMainThreadQueue.push_back(std::move(task));
+    }
+
+    bool TaskScheduler::TryPop(uint32_t queueIndex, ScheduledTask& task)
+    {
+        WorkerQueue& queue = *mQueues[queueIndex];
+        std::lock_guard lock{ queue.Mutex };
+
+        if (queue.Tasks.empty())
+            return false;
+
+        // Most recently pushed task is the most likely to have its data in cache
+        task = std::move(queue.Tasks.back());
+        queue.Tasks.pop_back();
+        mQueuedTaskCount.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool TaskScheduler::TrySteal(uint32_t thiefQueueIndex, ScheduledTask& task)
+    {
+        uint32_t queueCount = mQueues.size();
+
+        for (auto offset = 1u; offset < queueCount; ++offset)
+        {
+            WorkerQueue& queue = *mQueues[(thiefQueueIndex + offset) % queueCount];
+            std::unique_lock lock{ queue.Mutex, std::try_to_lock };
+
+            if (!lock.owns_lock() || queue.Tasks.empty())
+                continue;
+
+            // Oldest tasks tend to be the largest ones, so stealing them keeps the number of steals low
+            task = std::move(queue.Tasks.front());
+            queue.Tasks.pop_front();
+            mQueuedTaskCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        return false;
+    }
+
+    bool TaskScheduler::TryExecuteTask()
+    {
+        uint32_t queueIndex = CurrentQueueIndex();
+        ScheduledTask task;
+
+        if (!TryPop(queueIndex, task) && !TrySteal(queueIndex, task))
+            return false;
+
+        Execute(task);
+        return true;
+    }
+
+    bool TaskScheduler::TryExecuteMainThreadTask()
+    {
+        ScheduledTask task;
+
+        {
+            std::lock_guard lock{ mMainThreadQueueMutex };
+
+            if (mMainThreadQueue.empty())
+                return false;
+
+            task = std::move(mMainThreadQueue.front());
+            mMainThreadQueue.pop_front();
+        }
+
+        Execute(task);
+        return true;
+    }
+
+    void TaskScheduler::Execute(ScheduledTask& task)
+    {
+        task.Function();
+
+        if (task.Counter)
+        {
+            task.Counter->Decrement(this);
+        }
+    }
+
+    void TaskScheduler::WorkerLoop(uint32_t queueIndex)
+    {
+        tOwningScheduler = this;
+        tQueueIndex = queueIndex;
+
+        while (true)
+        {
+            if (TryExecuteTask())
+                continue;
+
+            std::unique_lock lock{ mSleepMutex };
+
+            mWakeCondition.wait(lock, [this]
+            {
+                return mIsStopping || mQueuedTaskCount.load(std::memory_order_acquire) > 0;
+            });
+
+            if (mIsStopping)
+                return;
+        }
+    }
+
+    uint32_t TaskScheduler::CurrentQueueIndex() const
+    {
+        return tOwningScheduler == this ? tQueueIndex : 0;
+    }
+
+}
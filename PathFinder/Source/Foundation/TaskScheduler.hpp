@@ -0,0 +1,124 @@
+#pragma once
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+namespace Foundation
+{
+
+    class TaskScheduler;
+
+    // Tracks completion of a group of tasks.
+    // Tasks can be scheduled to start only after a counter reaches zero, which is how dependencies are expressed.
+    class TaskCounter
+    {
+    public:
+        friend TaskScheduler;
+
+        TaskCounter() = default;
+        TaskCounter(const TaskCounter& that) = delete;
+        TaskCounter& operator=(const TaskCounter& that) = delete;
+
+        bool IsDone() const;
+
+    private:
+        struct Continuation
+        {
+            std::function<void()> Function;
+            TaskCounter* Counter = nullptr;
+        };
+
+        void Increment();
+        void Decrement(TaskScheduler* scheduler);
+
+        std::atomic<uint64_t> mPendingTaskCount = 0;
+        mutable std::mutex mContinuationsMutex;
+        std::vector<Continuation> mContinuations;
+    };
+
+    // Work-stealing task scheduler.
+    // Every worker owns a deque: it pushes and pops its own tasks from the back,
+    // while idle workers steal from the front of other workers' deques.
+    // Tasks with main thread affinity are only executed by the thread that created the scheduler.
+    class TaskScheduler
+    {
+    public:
+        friend TaskCounter;
+
+        using Task = std::function<void()>;
+
+        // Zero worker count means one worker per hardware thread except the main one
+        TaskScheduler(uint32_t workerCount = 0);
+        ~TaskScheduler();
+
+        TaskScheduler(const TaskScheduler& that) = delete;
+        TaskScheduler& operator=(const TaskScheduler& that) = delete;
+
+        void Schedule(Task task, TaskCounter* counter = nullptr);
+        void ScheduleAfter(TaskCounter& dependency, Task task, TaskCounter* counter = nullptr);
+        void ScheduleOnMainThread(Task task, TaskCounter* counter = nullptr);
+
+        // Calling thread executes pending tasks while waiting instead of blocking,
+        // so waiting from inside a task can't deadlock the scheduler
+        void Wait(const TaskCounter& counter);
+
+        // Must be called periodically by the main thread to process tasks with main thread affinity
+        void ExecuteMainThreadTasks();
+
+        // Splits [begin, end) into chunks of grainSize indices, executes them in parallel and waits for completion.
+        // Function is invoked once per index.
+        template <class Function>
+        void ParallelFor(uint64_t begin, uint64_t end, uint64_t grainSize, const Function& function);
+
+        bool IsMainThread() const;
+
+    private:
+        struct ScheduledTask
+        {
+            Task Function;
+            TaskCounter* Counter = nullptr;
+        };
+
+        struct WorkerQueue
+        {
+            std::mutex Mutex;
+            std::deque<ScheduledTask> Tasks;
+        };
+
+        void Push(ScheduledTask&& task);
+        void PushMainThreadTask(ScheduledTask&& task);
+        bool TryPop(uint32_t queueIndex, ScheduledTask& task);
+        bool TrySteal(uint32_t thiefQueueIndex, ScheduledTask& task);
+        bool TryExecuteTask();
+        bool TryExecuteMainThreadTask();
+        void Execute(ScheduledTask& task);
+        void WorkerLoop(uint32_t queueIndex);
+        uint32_t CurrentQueueIndex() const;
+
+        // Queue 0 belongs to the main thread and to any other thread that isn't a worker
+        std::vector<std::unique_ptr<WorkerQueue>> mQueues;
+        std::vector<std::thread> mWorkers;
+        std::thread::id mMainThreadID;
+
+        std::mutex mMainThreadQueueMutex;
+        std::deque<ScheduledTask> mMainThreadQueue;
+
+        std::mutex mSleepMutex;
+        std::condition_variable mWakeCondition;
+        std::atomic<uint64_t> mQueuedTaskCount = 0;
+        std::atomic<bool> mIsStopping = false;
+
+    public:
+        inline uint32_t WorkerCount() const { return mWorkers.size(); }
+    };
+
+}
+
+#include "TaskScheduler.inl"
@@ -0,0 +1,43 @@
+#include <algorithm>
+
+namespace Foundation
+{
+
+    template <class Function>
+    void TaskScheduler::ParallelFor(uint64_t begin, uint64_t end, uint64_t grainSize, const Function& function)
+    {
+        if (begin >= end)
+            return;
+
+        grainSize = std::max<uint64_t>(grainSize, 1);
+
+        // Single chunk is not worth the scheduling round trip
+        if (end - begin <= grainSize || mWorkers.empty())
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                function(i);
+            }
+
+            return;
+        }
+
+        TaskCounter counter;
+
+        for (auto chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+        {
+            uint64_t chunkEnd = std::min(chunkBegin + grainSize, end);
+
+            Schedule([&function, chunkBegin, chunkEnd]
+            {
+                for (auto i = chunkBegin; i < chunkEnd; ++i)
+                {
+                    function(i);
+                }
+            }, &counter);
+        }
+
+        Wait(counter);
+    }
+
+}
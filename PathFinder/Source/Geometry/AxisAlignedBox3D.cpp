@@ -127,18 +127,29 @@ namespace Geometry
 
     AxisAlignedBox3D AxisAlignedBox3D::TransformedBy(const glm::mat4 &m) const
     {
-        glm::vec4 newMin = { Min.x, Min.y, Min.z, 1.0 };
-        glm::vec4 newMax = { Max.x, Max.y, Max.z, 1.0 };
-        newMin = m * newMin;
-        newMax = m * newMax;
-        newMin /= newMin.w;
-        newMax /= newMax.w;
-        return { glm::vec3(newMin), glm::vec3(newMax) };
+        // Transform every corner, otherwise rotations produce inside-out boxes
+        AxisAlignedBox3D result = MaximumReversed();
+
+        for (const glm::vec4& corner : CornerPoints())
+        {
+            glm::vec4 transformed = m * corner;
+            transformed /= transformed.w;
+            result.Min = glm::min(result.Min, glm::vec3(transformed));
+            result.Max = glm::max(result.Max, glm::vec3(transformed));
+        }
+
+        return result;
     }
 
-    AxisAlignedBox3D AxisAlignedBox3D::Union(const AxisAlignedBox3D& otherBox)
+    AxisAlignedBox3D AxisAlignedBox3D::Union(const AxisAlignedBox3D& otherBox) const
     {
         return { glm::min(Min, otherBox.Min), glm::max(Max, otherBox.Max) };
     }
 
+    float AxisAlignedBox3D::SurfaceArea() const
+    {
+        glm::vec3 extent = Max - Min;
+        return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+    }
+
 }
@@ -60,7 +60,23 @@ namespace Geometry
         std::array<AxisAlignedBox3D, 8> Octet() const;
         AxisAlignedBox3D TransformedBy(const Transformation &t) const;
         AxisAlignedBox3D TransformedBy(const glm::mat4 &m) const;
-        AxisAlignedBox3D Union(const AxisAlignedBox3D& otherBox);
+        AxisAlignedBox3D Union(const AxisAlignedBox3D& otherBox) const;
+        float SurfaceArea() const;
+    };
+
+    /**
+     Non-owning view of several boxes stored in structure of arrays layout.
+     Used by batch intersection routines to test many boxes at once.
+     */
+    struct AxisAlignedBox3DSoA
+    {
+        const float* MinX = nullptr;
+        const float* MinY = nullptr;
+        const float* MinZ = nullptr;
+        const float* MaxX = nullptr;
+        const float* MaxY = nullptr;
+        const float* MaxZ = nullptr;
+        uint64_t Count = 0;
     };
 
 }
@@ -0,0 +1,302 @@
+#include "BVH.hpp"
+#include "Collision.hpp"
+
+#include <numeric>
+
+namespace Geometry
+{
+
+    void BVH::Node::SetChildBounds(uint32_t slot, const AxisAlignedBox3D& bounds)
+    {
+        MinX[slot] = bounds.Min.x; MinY[slot] = bounds.Min.y; MinZ[slot] = bounds.Min.z;
+        MaxX[slot] = bounds.Max.x; MaxY[slot] = bounds.Max.y; MaxZ[slot] = bounds.Max.z;
+    }
+
+    AxisAlignedBox3D BVH::Node::Bounds() const
+    {
+        AxisAlignedBox3D bounds = AxisAlignedBox3D::MaximumReversed();
+
+        for (auto slot = 0u; slot < NodeWidth; ++slot)
+        {
+            if (Child[slot] == InvalidIndex)
+                continue;
+
+            bounds = bounds.Union({ { MinX[slot], MinY[slot], MinZ[slot] }, { MaxX[slot], MaxY[slot], MaxZ[slot] } });
+        }
+
+        return bounds;
+    }
+
+    void BVH::Build(const std::vector<AxisAlignedBox3D>& primitiveBounds, uint32_t maxLeafSize)
+    {
+        mNodes.clear();
+        mPrimitiveIndices.resize(primitiveBounds.size());
+        std::iota(mPrimitiveIndices.begin(), mPrimitiveIndices.end(), 0);
+
+        if (primitiveBounds.empty())
+            return;
+
+        std::vector<glm::vec3> centroids;
+        centroids.reserve(primitiveBounds.size());
+
+        for (const AxisAlignedBox3D& bounds : primitiveBounds)
+        {
+            centroids.push_back(bounds.Сenter());
+        }
+
+        std::vector<BuildNode> buildNodes;
+        buildNodes.reserve(primitiveBounds.size() * 2);
+
+        uint32_t root = BuildBinaryNode(buildNodes, primitiveBounds, centroids, 0, primitiveBounds.size(), std::max(maxLeafSize, 1u));
+
+        if (buildNodes[root].PrimitiveCount > 0)
+        {
+            // Whole hierarchy fits into a single leaf
+            Node& node = mNodes.emplace_back();
+            std::fill(std::begin(node.Child), std::end(node.Child), InvalidIndex);
+            std::fill(std::begin(node.PrimitiveCount), std::end(node.PrimitiveCount), 0);
+            node.Child[0] = buildNodes[root].FirstPrimitive;
+            node.PrimitiveCount[0] = buildNodes[root].PrimitiveCount;
+            node.SetChildBounds(0, buildNodes[root].Bounds);
+        }
+        else
+        {
+            CollapseToWideNode(buildNodes, root);
+        }
+    }
+
+    void BVH::Refit(const std::vector<AxisAlignedBox3D>& primitiveBounds)
+    {
+        assert_format(primitiveBounds.size() == mPrimitiveIndices.size(), "Primitive count changed since BVH was built. Rebuild is required.");
+
+        // Nodes are stored in depth-first order, so children always follow their parents
+        for (auto nodeIdx = (int64_t)mNodes.size() - 1; nodeIdx >= 0; --nodeIdx)
+        {
+            Node& node = mNodes[nodeIdx];
+
+            for (auto slot = 0u; slot < NodeWidth; ++slot)
+            {
+                if (node.Child[slot] == InvalidIndex)
+                    continue;
+
+                if (node.PrimitiveCount[slot] == 0)
+                {
+                    node.SetChildBounds(slot, mNodes[node.Child[slot]].Bounds());
+                    continue;
+                }
+
+                AxisAlignedBox3D bounds = AxisAlignedBox3D::MaximumReversed();
+
+                for (auto i = 0u; i < node.PrimitiveCount[slot]; ++i)
+                {
+                    bounds = bounds.Union(primitiveBounds[mPrimitiveIndices[node.Child[slot] + i]]);
+                }
+
+                node.SetChildBounds(slot, bounds);
+            }
+        }
+    }
+
+    uint32_t BVH::BuildBinaryNode(
+        std::vector<BuildNode>& buildNodes,
+        const std::vector<AxisAlignedBox3D>& primitiveBounds,
+        const std::vector<glm::vec3>& centroids,
+        uint32_t first, uint32_t count, uint32_t maxLeafSize)
+    {
+        static const uint32_t BinCount = 16;
+
+        uint32_t nodeIndex = buildNodes.size();
+        buildNodes.emplace_back();
+
+        AxisAlignedBox3D bounds = AxisAlignedBox3D::MaximumReversed();
+        AxisAlignedBox3D centroidBounds = AxisAlignedBox3D::MaximumReversed();
+
+        for (auto i = first; i < first + count; ++i)
+        {
+            uint32_t primitive = mPrimitiveIndices[i];
+            bounds = bounds.Union(primitiveBounds[primitive]);
+            centroidBounds = centroidBounds.Union({ centroids[primitive], centroids[primitive] });
+        }
+
+        buildNodes[nodeIndex].Bounds = bounds;
+
+        auto makeLeaf = [&]
+        {
+            buildNodes[nodeIndex].FirstPrimitive = first;
+            buildNodes[nodeIndex].PrimitiveCount = count;
+            return nodeIndex;
+        };
+
+        if (count <= maxLeafSize)
+            return makeLeaf();
+
+        glm::vec3 centroidExtent = centroidBounds.Max - centroidBounds.Min;
+        uint32_t axis = centroidExtent.x > centroidExtent.y ? (centroidExtent.x > centroidExtent.z ? 0 : 2) : (centroidExtent.y > centroidExtent.z ? 1 : 2);
+
+        auto* indicesBegin = mPrimitiveIndices.data() + first;
+        auto* indicesEnd = indicesBegin + count;
+        uint32_t splitCount = 0;
+
+        if (centroidExtent[axis] > 0.0f)
+        {
+            struct Bin
+            {
+                AxisAlignedBox3D Bounds = AxisAlignedBox3D::MaximumReversed();
+                uint32_t Count = 0;
+            };
+
+            std::array<Bin, BinCount> bins;
+            float binScale = BinCount / centroidExtent[axis];
+
+            auto binIndex = [&](uint32_t primitive)
+            {
+                uint32_t index = (centroids[primitive][axis] - centroidBounds.Min[axis]) * binScale;
+                return std::min(index, BinCount - 1);
+            };
+
+            for (auto* it = indicesBegin; it != indicesEnd; ++it)
+            {
+                Bin& bin = bins[binIndex(*it)];
+                bin.Bounds = bin.Bounds.Union(primitiveBounds[*it]);
+                bin.Count++;
+            }
+
+            // Sweep from the right to get costs of right sides for every split plane
+            std::array<float, BinCount - 1> rightCosts;
+            AxisAlignedBox3D rightBounds = AxisAlignedBox3D::MaximumReversed();
+            uint32_t rightCount = 0;
+
+            for (auto i = BinCount - 1; i > 0; --i)
+            {
+                rightBounds = rightBounds.Union(bins[i].Bounds);
+                rightCount += bins[i].Count;
+                rightCosts[i - 1] = rightCount ? rightBounds.SurfaceArea() * rightCount : 0.0f;
+            }
+
+            AxisAlignedBox3D leftBounds = AxisAlignedBox3D::MaximumReversed();
+            uint32_t leftCount = 0;
+            float bestCost = std::numeric_limits<float>::max();
+            uint32_t bestSplit = 0;
+
+            for (auto i = 0u; i < BinCount - 1; ++i)
+            {
+                leftBounds = leftBounds.Union(bins[i].Bounds);
+                leftCount += bins[i].Count;
+
+                float cost = (leftCount ? leftBounds.SurfaceArea() * leftCount : 0.0f) + rightCosts[i];
+
+                if (leftCount > 0 && leftCount < count && cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestSplit = i;
+                }
+            }
+
+            // Traversal step is assumed to be as expensive as one primitive test
+            float leafCost = count;
+            float splitCost = 1.0f + bestCost / std::max(bounds.SurfaceArea(), std::numeric_limits<float>::min());
+
+            if (bestCost != std::numeric_limits<float>::max() && splitCost < leafCost)
+            {
+                auto* middle = std::partition(indicesBegin, indicesEnd, [&](uint32_t primitive) { return binIndex(primitive) <= bestSplit; });
+                splitCount = middle - indicesBegin;
+            }
+        }
+
+        // SAH found no good split or centroids are coincident: fall back to median split to bound leaf sizes
+        if (splitCount == 0 || splitCount == count)
+        {
+            splitCount = count / 2;
+            std::nth_element(indicesBegin, indicesBegin + splitCount, indicesEnd, [&](uint32_t a, uint32_t b)
+            {
+                return centroids[a][axis] < centroids[b][axis];
+            });
+        }
+
+        uint32_t left = BuildBinaryNode(buildNodes, primitiveBounds, centroids, first, splitCount, maxLeafSize);
+        uint32_t right = BuildBinaryNode(buildNodes, primitiveBounds, centroids, first + splitCount, count - splitCount, maxLeafSize);
+
+        buildNodes[nodeIndex].Left = left;
+        buildNodes[nodeIndex].Right = right;
+
+        return nodeIndex;
+    }
+
+    uint32_t BVH::CollapseToWideNode(const std::vector<BuildNode>& buildNodes, uint32_t buildNodeIndex)
+    {
+        const BuildNode& buildNode = buildNodes[buildNodeIndex];
+
+        std::array<uint32_t, NodeWidth> children{ buildNode.Left, buildNode.Right };
+        uint32_t childCount = 2;
+
+        // Pull grandchildren up, opening largest inner children first
+        while (childCount < NodeWidth)
+        {
+            int32_t largestInnerChild = -1;
+            float largestArea = -1.0f;
+
+            for (auto i = 0u; i < childCount; ++i)
+            {
+                const BuildNode& child = buildNodes[children[i]];
+
+                if (child.PrimitiveCount == 0 && child.Bounds.SurfaceArea() > largestArea)
+                {
+                    largestArea = child.Bounds.SurfaceArea();
+                    largestInnerChild = i;
+                }
+            }
+
+            if (largestInnerChild < 0)
+                break;
+
+            const BuildNode& opened = buildNodes[children[largestInnerChild]];
+            children[largestInnerChild] = opened.Left;
+            children[childCount++] = opened.Right;
+        }
+
+        uint32_t nodeIndex = mNodes.size();
+        mNodes.emplace_back();
+
+        std::fill(std::begin(mNodes[nodeIndex].Child), std::end(mNodes[nodeIndex].Child), InvalidIndex);
+        std::fill(std::begin(mNodes[nodeIndex].PrimitiveCount), std::end(mNodes[nodeIndex].PrimitiveCount), 0);
+
+        for (auto slot = 0u; slot < childCount; ++slot)
+        {
+            const BuildNode& child = buildNodes[children[slot]];
+
+            // Recursion may reallocate node storage, so node is accessed by index
+            uint32_t childIndex = child.PrimitiveCount > 0 ? child.FirstPrimitive : CollapseToWideNode(buildNodes, children[slot]);
+
+            Node& node = mNodes[nodeIndex];
+            node.Child[slot] = childIndex;
+            node.PrimitiveCount[slot] = child.PrimitiveCount;
+            node.SetChildBounds(slot, child.Bounds);
+        }
+
+        for (auto slot = childCount; slot < NodeWidth; ++slot)
+        {
+            // Empty boxes are never hit
+            mNodes[nodeIndex].SetChildBounds(slot, AxisAlignedBox3D::MaximumReversed());
+        }
+
+        return nodeIndex;
+    }
+
+    uint32_t BVH::IntersectNodeChildren(const Node& node, const Ray3D& ray, float maxDistance, float* childDistances) const
+    {
+        AxisAlignedBox3DSoA childBounds{ node.MinX, node.MinY, node.MinZ, node.MaxX, node.MaxY, node.MaxZ, NodeWidth };
+        uint32_t hitMask = 0;
+
+        Collision::RayAABBs(ray, childBounds, maxDistance, childDistances, &hitMask);
+
+        // Mask out empty slots explicitly, slab test on inside-out boxes is not reliable
+        for (auto slot = 0u; slot < NodeWidth; ++slot)
+        {
+            if (node.Child[slot] == InvalidIndex)
+                hitMask &= ~(1 << slot);
+        }
+
+        return hitMask;
+    }
+
+}
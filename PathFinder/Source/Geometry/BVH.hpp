@@ -0,0 +1,84 @@
+#pragma once
+
+#include "AxisAlignedBox3D.hpp"
+#include "Ray3D.hpp"
+
+#include <vector>
+#include <limits>
+#include <cstdint>
+
+namespace Geometry
+{
+
+    // Bounding volume hierarchy over arbitrary primitives represented by their bounding boxes.
+    // Built with binned SAH and collapsed into 4-wide nodes which store child bounds
+    // in SoA layout, so that all children of a node are tested against a ray at once.
+    class BVH
+    {
+    public:
+        static const uint32_t NodeWidth = 4;
+        static const uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        struct alignas(16) Node
+        {
+            float MinX[NodeWidth];
+            float MinY[NodeWidth];
+            float MinZ[NodeWidth];
+            float MaxX[NodeWidth];
+            float MaxY[NodeWidth];
+            float MaxZ[NodeWidth];
+
+            // Index of a child node for inner children or offset into primitive indices for leaves
+            uint32_t Child[NodeWidth];
+
+            // Zero for inner children
+            uint32_t PrimitiveCount[NodeWidth];
+
+            void SetChildBounds(uint32_t slot, const AxisAlignedBox3D& bounds);
+            AxisAlignedBox3D Bounds() const;
+        };
+
+        void Build(const std::vector<AxisAlignedBox3D>& primitiveBounds, uint32_t maxLeafSize = 4);
+
+        // Recomputes node bounds for moved primitives keeping the topology.
+        // Primitive count and order must match the ones used to build the hierarchy.
+        void Refit(const std::vector<AxisAlignedBox3D>& primitiveBounds);
+
+        // Finds closest primitive hit by the ray. Intersector is invoked for primitives
+        // in leaves that ray reaches and must have a bool(uint32_t primitiveIndex, float& distance) signature.
+        template <class Intersector>
+        bool RayIntersection(const Ray3D& ray, const Intersector& intersector, float& distance, uint32_t& primitiveIndex) const;
+
+    private:
+        struct BuildNode
+        {
+            AxisAlignedBox3D Bounds;
+            uint32_t Left = InvalidIndex;
+            uint32_t Right = InvalidIndex;
+            uint32_t FirstPrimitive = 0;
+            uint32_t PrimitiveCount = 0;
+        };
+
+        uint32_t BuildBinaryNode(
+            std::vector<BuildNode>& buildNodes,
+            const std::vector<AxisAlignedBox3D>& primitiveBounds,
+            const std::vector<glm::vec3>& centroids,
+            uint32_t first, uint32_t count, uint32_t maxLeafSize);
+
+        uint32_t CollapseToWideNode(const std::vector<BuildNode>& buildNodes, uint32_t buildNodeIndex);
+
+        // All children are tested in one batched call. Returns mask of children hit closer than maxDistance.
+        uint32_t IntersectNodeChildren(const Node& node, const Ray3D& ray, float maxDistance, float* childDistances) const;
+
+        std::vector<Node> mNodes;
+        std::vector<uint32_t> mPrimitiveIndices;
+
+    public:
+        inline const auto& Nodes() const { return mNodes; }
+        inline const auto& PrimitiveIndices() const { return mPrimitiveIndices; }
+        inline bool IsEmpty() const { return mNodes.empty(); }
+    };
+
+}
+
+#include "BVH.inl"
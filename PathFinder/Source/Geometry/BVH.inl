@@ -0,0 +1,75 @@
+#include <array>
+#include <algorithm>
+
+namespace Geometry
+{
+
+    template <class Intersector>
+    bool BVH::RayIntersection(const Ray3D& ray, const Intersector& intersector, float& distance, uint32_t& primitiveIndex) const
+    {
+        if (mNodes.empty())
+            return false;
+
+        float closestDistance = std::numeric_limits<float>::max();
+        uint32_t closestPrimitive = InvalidIndex;
+
+        // Every visited node pushes at most NodeWidth - 1 additional entries
+        std::array<uint32_t, 64 * (NodeWidth - 1) + 1> stack;
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const Node& node = mNodes[stack[--stackSize]];
+
+            float childDistances[NodeWidth];
+            uint32_t hitMask = IntersectNodeChildren(node, ray, closestDistance, childDistances);
+
+            // Collect inner children to visit them front to back
+            std::array<std::pair<float, uint32_t>, NodeWidth> innerHits;
+            uint32_t innerHitCount = 0;
+
+            for (auto slot = 0u; slot < NodeWidth; ++slot)
+            {
+                if ((hitMask & (1 << slot)) == 0)
+                    continue;
+
+                if (node.PrimitiveCount[slot] == 0)
+                {
+                    innerHits[innerHitCount++] = { childDistances[slot], node.Child[slot] };
+                    continue;
+                }
+
+                for (auto i = 0u; i < node.PrimitiveCount[slot]; ++i)
+                {
+                    uint32_t primitive = mPrimitiveIndices[node.Child[slot] + i];
+                    float primitiveDistance = 0.0f;
+
+                    if (intersector(primitive, primitiveDistance) && primitiveDistance < closestDistance)
+                    {
+                        closestDistance = primitiveDistance;
+                        closestPrimitive = primitive;
+                    }
+                }
+            }
+
+            // Push farthest first so that closest is popped first
+            std::sort(innerHits.begin(), innerHits.begin() + innerHitCount, [](auto& a, auto& b) { return a.first > b.first; });
+
+            assert_format(stackSize + innerHitCount <= stack.size(), "BVH is too deep for traversal stack");
+
+            for (auto i = 0u; i < innerHitCount; ++i)
+            {
+                stack[stackSize++] = innerHits[i].second;
+            }
+        }
+
+        if (closestPrimitive == InvalidIndex)
+            return false;
+
+        distance = closestDistance;
+        primitiveIndex = closestPrimitive;
+        return true;
+    }
+
+}
@@ -11,8 +11,157 @@
 #include <glm/geometric.hpp>
 #include <glm/vec3.hpp>
 
+#include <algorithm>
+#include <array>
+
+// Only AVX instructions are used, so AVX2 targets take this path as well
+#if defined(__AVX__)
+#define GEOMETRY_COLLISION_AVX
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define GEOMETRY_COLLISION_SSE
+#include <xmmintrin.h>
+#endif
+
 namespace Geometry {
 
+    namespace {
+
+        // Moller-Trumbore test. Determinant is negative for triangles
+        // facing the ray, which matches culling done by RayPlane.
+        template <uint32_t Width>
+        bool RayTriangleLane(const RayPacket3D<Width> &packet, uint32_t lane, const Triangle3D &triangle, float &distance) {
+            glm::vec3 origin(packet.originX[lane], packet.originY[lane], packet.originZ[lane]);
+            glm::vec3 direction(packet.directionX[lane], packet.directionY[lane], packet.directionZ[lane]);
+
+            glm::vec3 e1 = triangle.b - triangle.a;
+            glm::vec3 e2 = triangle.c - triangle.a;
+            glm::vec3 p = glm::cross(direction, e2);
+            float det = glm::dot(e1, p);
+
+            if (det >= 0.0f) {
+                return false;
+            }
+
+            float inverseDet = 1.0f / det;
+            glm::vec3 s = origin - triangle.a;
+            float u = glm::dot(s, p) * inverseDet;
+            glm::vec3 q = glm::cross(s, e1);
+            float v = glm::dot(direction, q) * inverseDet;
+            float t = glm::dot(e2, q) * inverseDet;
+
+            if (u < 0.0f || v < 0.0f || u + v > 1.0f || t < 0.0f) {
+                return false;
+            }
+
+            distance = t;
+            return true;
+        }
+
+#if defined(GEOMETRY_COLLISION_SSE)
+        template <uint32_t Width>
+        uint32_t RayTriangleLanes4(const RayPacket3D<Width> &packet, uint32_t firstLane, const Triangle3D &triangle, float *distances) {
+            glm::vec3 e1 = triangle.b - triangle.a;
+            glm::vec3 e2 = triangle.c - triangle.a;
+
+            __m128 dx = _mm_loadu_ps(packet.directionX + firstLane);
+            __m128 dy = _mm_loadu_ps(packet.directionY + firstLane);
+            __m128 dz = _mm_loadu_ps(packet.directionZ + firstLane);
+            __m128 e1x = _mm_set1_ps(e1.x), e1y = _mm_set1_ps(e1.y), e1z = _mm_set1_ps(e1.z);
+            __m128 e2x = _mm_set1_ps(e2.x), e2y = _mm_set1_ps(e2.y), e2z = _mm_set1_ps(e2.z);
+
+            // p = cross(direction, e2)
+            __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+            __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+            __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+            __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+            __m128 inverseDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+            __m128 sx = _mm_sub_ps(_mm_loadu_ps(packet.originX + firstLane), _mm_set1_ps(triangle.a.x));
+            __m128 sy = _mm_sub_ps(_mm_loadu_ps(packet.originY + firstLane), _mm_set1_ps(triangle.a.y));
+            __m128 sz = _mm_sub_ps(_mm_loadu_ps(packet.originZ + firstLane), _mm_set1_ps(triangle.a.z));
+            __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), inverseDet);
+
+            // q = cross(s, e1)
+            __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+            __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+            __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+            __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), inverseDet);
+            __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inverseDet);
+
+            __m128 zero = _mm_setzero_ps();
+            __m128 hit = _mm_cmplt_ps(det, zero);
+            hit = _mm_and_ps(hit, _mm_cmpge_ps(u, zero));
+            hit = _mm_and_ps(hit, _mm_cmpge_ps(v, zero));
+            hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(1.0f)));
+            hit = _mm_and_ps(hit, _mm_cmpge_ps(t, zero));
+
+            _mm_storeu_ps(distances + firstLane, t);
+
+            return _mm_movemask_ps(hit);
+        }
+#endif
+
+#if defined(GEOMETRY_COLLISION_AVX)
+        uint32_t RayTriangleLanes8(const RayPacket3D8 &packet, const Triangle3D &triangle, float *distances) {
+            glm::vec3 e1 = triangle.b - triangle.a;
+            glm::vec3 e2 = triangle.c - triangle.a;
+
+            __m256 dx = _mm256_load_ps(packet.directionX);
+            __m256 dy = _mm256_load_ps(packet.directionY);
+            __m256 dz = _mm256_load_ps(packet.directionZ);
+            __m256 e1x = _mm256_set1_ps(e1.x), e1y = _mm256_set1_ps(e1.y), e1z = _mm256_set1_ps(e1.z);
+            __m256 e2x = _mm256_set1_ps(e2.x), e2y = _mm256_set1_ps(e2.y), e2z = _mm256_set1_ps(e2.z);
+
+            // p = cross(direction, e2)
+            __m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+            __m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+            __m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+            __m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+            __m256 inverseDet = _mm256_div_ps(_mm256_set1_ps(1.0f), det);
+
+            __m256 sx = _mm256_sub_ps(_mm256_load_ps(packet.originX), _mm256_set1_ps(triangle.a.x));
+            __m256 sy = _mm256_sub_ps(_mm256_load_ps(packet.originY), _mm256_set1_ps(triangle.a.y));
+            __m256 sz = _mm256_sub_ps(_mm256_load_ps(packet.originZ), _mm256_set1_ps(triangle.a.z));
+            __m256 u = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, px), _mm256_mul_ps(sy, py)), _mm256_mul_ps(sz, pz)), inverseDet);
+
+            // q = cross(s, e1)
+            __m256 qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+            __m256 qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+            __m256 qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+            __m256 v = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz)), inverseDet);
+            __m256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz)), inverseDet);
+
+            __m256 zero = _mm256_setzero_ps();
+            __m256 hit = _mm256_cmp_ps(det, zero, _CMP_LT_OQ);
+            hit = _mm256_and_ps(hit, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+            hit = _mm256_and_ps(hit, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+            hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(u, v), _mm256_set1_ps(1.0f), _CMP_LE_OQ));
+            hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, zero, _CMP_GE_OQ));
+
+            _mm256_storeu_ps(distances, t);
+
+            return _mm256_movemask_ps(hit);
+        }
+#endif
+
+        template <uint32_t Width>
+        uint32_t RayTriangleLanesScalar(const RayPacket3D<Width> &packet, uint32_t firstLane, uint32_t laneCount, const Triangle3D &triangle, float *distances) {
+            uint32_t mask = 0;
+
+            for (uint32_t lane = firstLane; lane < firstLane + laneCount; ++lane) {
+                if (RayTriangleLane(packet, lane, triangle, distances[lane])) {
+                    mask |= 1 << (lane - firstLane);
+                }
+            }
+
+            return mask;
+        }
+
+    }
+
     Interval Collision::GetInterval(const Triangle3D &triangle, const glm::vec3 &axis) {
         Interval result;
 
@@ -216,4 +365,178 @@ namespace Geometry {
         return false;
     }
 
+    void Collision::RayAABBs(const Ray3D &ray, const AxisAlignedBox3DSoA &boxes, float maxDistance, float *distances, uint32_t *hitMasks) {
+        glm::vec3 inverseDirection = glm::vec3(1.0) / ray.direction;
+
+        std::fill(hitMasks, hitMasks + (boxes.Count + 31) / 32, 0);
+
+        uint64_t i = 0;
+
+        // Every SIMD step covers 8 or 4 boxes, so that masks never straddle 32 bit words
+#if defined(GEOMETRY_COLLISION_AVX)
+        {
+            __m256 ox = _mm256_set1_ps(ray.origin.x), oy = _mm256_set1_ps(ray.origin.y), oz = _mm256_set1_ps(ray.origin.z);
+            __m256 ix = _mm256_set1_ps(inverseDirection.x), iy = _mm256_set1_ps(inverseDirection.y), iz = _mm256_set1_ps(inverseDirection.z);
+            __m256 zero = _mm256_setzero_ps();
+            __m256 limit = _mm256_set1_ps(maxDistance);
+
+            for (; i + 8 <= boxes.Count; i += 8) {
+                __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.MinX + i), ox), ix);
+                __m256 t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.MaxX + i), ox), ix);
+                __m256 t3 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.MinY + i), oy), iy);
+                __m256 t4 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.MaxY + i), oy), iy);
+                __m256 t5 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.MinZ + i), oz), iz);
+                __m256 t6 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.MaxZ + i), oz), iz);
+
+                __m256 tmin = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(t1, t2), _mm256_min_ps(t3, t4)), _mm256_min_ps(t5, t6));
+                __m256 tmax = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(t1, t2), _mm256_max_ps(t3, t4)), _mm256_max_ps(t5, t6));
+
+                tmin = _mm256_max_ps(tmin, zero);
+                tmax = _mm256_min_ps(tmax, limit);
+
+                _mm256_storeu_ps(distances + i, tmin);
+
+                uint32_t mask = _mm256_movemask_ps(_mm256_cmp_ps(tmin, tmax, _CMP_LE_OQ));
+                hitMasks[i / 32] |= mask << (i % 32);
+            }
+        }
+#endif
+
+#if defined(GEOMETRY_COLLISION_SSE)
+        {
+            __m128 ox = _mm_set1_ps(ray.origin.x), oy = _mm_set1_ps(ray.origin.y), oz = _mm_set1_ps(ray.origin.z);
+            __m128 ix = _mm_set1_ps(inverseDirection.x), iy = _mm_set1_ps(inverseDirection.y), iz = _mm_set1_ps(inverseDirection.z);
+            __m128 zero = _mm_setzero_ps();
+            __m128 limit = _mm_set1_ps(maxDistance);
+
+            for (; i + 4 <= boxes.Count; i += 4) {
+                __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.MinX + i), ox), ix);
+                __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.MaxX + i), ox), ix);
+                __m128 t3 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.MinY + i), oy), iy);
+                __m128 t4 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.MaxY + i), oy), iy);
+                __m128 t5 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.MinZ + i), oz), iz);
+                __m128 t6 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.MaxZ + i), oz), iz);
+
+                __m128 tmin = _mm_max_ps(_mm_max_ps(_mm_min_ps(t1, t2), _mm_min_ps(t3, t4)), _mm_min_ps(t5, t6));
+                __m128 tmax = _mm_min_ps(_mm_min_ps(_mm_max_ps(t1, t2), _mm_max_ps(t3, t4)), _mm_max_ps(t5, t6));
+
+                tmin = _mm_max_ps(tmin, zero);
+                tmax = _mm_min_ps(tmax, limit);
+
+                _mm_storeu_ps(distances + i, tmin);
+
+                uint32_t mask = _mm_movemask_ps(_mm_cmple_ps(tmin, tmax));
+                hitMasks[i / 32] |= mask << (i % 32);
+            }
+        }
+#endif
+
+        for (; i < boxes.Count; ++i) {
+            float t1 = (boxes.MinX[i] - ray.origin.x) * inverseDirection.x;
+            float t2 = (boxes.MaxX[i] - ray.origin.x) * inverseDirection.x;
+            float t3 = (boxes.MinY[i] - ray.origin.y) * inverseDirection.y;
+            float t4 = (boxes.MaxY[i] - ray.origin.y) * inverseDirection.y;
+            float t5 = (boxes.MinZ[i] - ray.origin.z) * inverseDirection.z;
+            float t6 = (boxes.MaxZ[i] - ray.origin.z) * inverseDirection.z;
+
+            float tmin = std::max(std::max(std::min(t1, t2), std::min(t3, t4)), std::min(t5, t6));
+            float tmax = std::min(std::min(std::max(t1, t2), std::max(t3, t4)), std::max(t5, t6));
+
+            tmin = std::max(tmin, 0.0f);
+            tmax = std::min(tmax, maxDistance);
+
+            distances[i] = tmin;
+
+            if (tmin <= tmax) {
+                hitMasks[i / 32] |= 1u << (i % 32);
+            }
+        }
+    }
+
+    uint32_t Collision::RayPacketTriangle(const RayPacket3D4 &packet, const Triangle3D &triangle, float *distances) {
+#if defined(GEOMETRY_COLLISION_SSE)
+        return RayTriangleLanes4(packet, 0, triangle, distances);
+#else
+        return RayTriangleLanesScalar(packet, 0, 4, triangle, distances);
+#endif
+    }
+
+    uint32_t Collision::RayPacketTriangle(const RayPacket3D8 &packet, const Triangle3D &triangle, float *distances) {
+#if defined(GEOMETRY_COLLISION_AVX)
+        return RayTriangleLanes8(packet, triangle, distances);
+#elif defined(GEOMETRY_COLLISION_SSE)
+        return RayTriangleLanes4(packet, 0, triangle, distances) | (RayTriangleLanes4(packet, 4, triangle, distances) << 4);
+#else
+        return RayTriangleLanesScalar(packet, 0, 8, triangle, distances);
+#endif
+    }
+
+    void Collision::FrustumAABBs(const Frustum &frustum, const AxisAlignedBox3DSoA &boxes, uint32_t *visibilityMasks) {
+        std::fill(visibilityMasks, visibilityMasks + (boxes.Count + 31) / 32, 0);
+
+        // Box corner furthest along each plane normal is known upfront, so choose source arrays once per plane
+        std::array<std::array<const float *, 3>, 6> positiveVertices;
+
+        for (uint32_t p = 0; p < 6; ++p) {
+            const glm::vec4 &plane = frustum.Planes[p];
+            positiveVertices[p] = {
+                plane.x > 0.0f ? boxes.MaxX : boxes.MinX,
+                plane.y > 0.0f ? boxes.MaxY : boxes.MinY,
+                plane.z > 0.0f ? boxes.MaxZ : boxes.MinZ
+            };
+        }
+
+        uint64_t i = 0;
+
+#if defined(GEOMETRY_COLLISION_AVX)
+        for (; i + 8 <= boxes.Count; i += 8) {
+            __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+            for (uint32_t p = 0; p < 6; ++p) {
+                const glm::vec4 &plane = frustum.Planes[p];
+                __m256 distance = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(positiveVertices[p][0] + i), _mm256_set1_ps(plane.x)),
+                        _mm256_mul_ps(_mm256_loadu_ps(positiveVertices[p][1] + i), _mm256_set1_ps(plane.y))),
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(positiveVertices[p][2] + i), _mm256_set1_ps(plane.z)), _mm256_set1_ps(plane.w)));
+
+                visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+            }
+
+            visibilityMasks[i / 32] |= uint32_t(_mm256_movemask_ps(visible)) << (i % 32);
+        }
+#endif
+
+#if defined(GEOMETRY_COLLISION_SSE)
+        for (; i + 4 <= boxes.Count; i += 4) {
+            __m128 visible = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+
+            for (uint32_t p = 0; p < 6; ++p) {
+                const glm::vec4 &plane = frustum.Planes[p];
+                __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(positiveVertices[p][0] + i), _mm_set1_ps(plane.x)),
+                        _mm_mul_ps(_mm_loadu_ps(positiveVertices[p][1] + i), _mm_set1_ps(plane.y))),
+                    _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(positiveVertices[p][2] + i), _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w)));
+
+                visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+            }
+
+            visibilityMasks[i / 32] |= uint32_t(_mm_movemask_ps(visible)) << (i % 32);
+        }
+#endif
+
+        for (; i < boxes.Count; ++i) {
+            bool visible = true;
+
+            for (uint32_t p = 0; p < 6 && visible; ++p) {
+                const glm::vec4 &plane = frustum.Planes[p];
+                float distance = positiveVertices[p][0][i] * plane.x + positiveVertices[p][1][i] * plane.y + positiveVertices[p][2][i] * plane.z + plane.w;
+                visible = distance >= 0.0f;
+            }
+
+            if (visible) {
+                visibilityMasks[i / 32] |= 1u << (i % 32);
+            }
+        }
+    }
+
 }
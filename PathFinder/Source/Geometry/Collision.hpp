@@ -3,10 +3,12 @@
 #include "Interval.hpp"
 #include "AxisAlignedBox3D.hpp"
 #include "Ray3D.hpp"
+#include "RayPacket3D.hpp"
 #include "Triangle2D.hpp"
 #include "Triangle3D.hpp"
 #include "Sphere.hpp"
 #include "Plane.hpp"
+#include "Frustum.hpp"
 
 #include <glm/vec3.hpp>
 
@@ -35,6 +37,23 @@ namespace Geometry
         static bool RayPlane(const Ray3D &ray, const Plane &plane, float &distance);
 
         static bool RayTriangle(const Ray3D &ray, const Triangle3D &triangle, float &distance);
+
+        // Batch variants. Vectorized with AVX or SSE depending on target architecture, scalar otherwise.
+
+        // Tests one ray against a stream of boxes. Entry distance of every box, clamped to zero
+        // for boxes containing ray origin, is written to distances. Bit (i % 32) of hitMasks[i / 32]
+        // is set for each box i intersected closer than maxDistance.
+        static void RayAABBs(const Ray3D &ray, const AxisAlignedBox3DSoA &boxes, float maxDistance, float *distances, uint32_t *hitMasks);
+
+        // Same front face only semantics as RayTriangle.
+        // Returns mask of lanes that hit the triangle, distances are meaningful for those lanes only.
+        static uint32_t RayPacketTriangle(const RayPacket3D4 &packet, const Triangle3D &triangle, float *distances);
+
+        static uint32_t RayPacketTriangle(const RayPacket3D8 &packet, const Triangle3D &triangle, float *distances);
+
+        // Same conservative test as Frustum::Intersects for a stream of boxes.
+        // Bit (i % 32) of visibilityMasks[i / 32] is set for each box i that is not rejected.
+        static void FrustumAABBs(const Frustum &frustum, const AxisAlignedBox3DSoA &boxes, uint32_t *visibilityMasks);
     };
 
 }
@@ -0,0 +1,58 @@
+#include "Frustum.hpp"
+
+#include <glm/gtc/matrix_access.hpp>
+#include <glm/geometric.hpp>
+
+namespace Geometry
+{
+
+    Frustum::Frustum(const glm::mat4 &viewProjection)
+    {
+        glm::vec4 row0 = glm::row(viewProjection, 0);
+        glm::vec4 row1 = glm::row(viewProjection, 1);
+        glm::vec4 row2 = glm::row(viewProjection, 2);
+        glm::vec4 row3 = glm::row(viewProjection, 3);
+
+        Planes[Left] = row3 + row0;
+        Planes[Right] = row3 - row0;
+        Planes[Bottom] = row3 + row1;
+        Planes[Top] = row3 - row1;
+        Planes[Near] = row2;
+        Planes[Far] = row3 - row2;
+
+        for (glm::vec4 &plane : Planes)
+        {
+            plane /= glm::length(glm::vec3(plane));
+        }
+    }
+
+    bool Frustum::Contains(const glm::vec3 &point) const
+    {
+        for (const glm::vec4 &plane : Planes)
+        {
+            if (glm::dot(glm::vec3(plane), point) + plane.w < 0.0f)
+                return false;
+        }
+
+        return true;
+    }
+
+    bool Frustum::Intersects(const AxisAlignedBox3D &box) const
+    {
+        for (const glm::vec4 &plane : Planes)
+        {
+            // Corner furthest along plane normal
+            glm::vec3 positiveVertex{
+                plane.x > 0.0f ? box.Max.x : box.Min.x,
+                plane.y > 0.0f ? box.Max.y : box.Min.y,
+                plane.z > 0.0f ? box.Max.z : box.Min.z
+            };
+
+            if (glm::dot(glm::vec3(plane), positiveVertex) + plane.w < 0.0f)
+                return false;
+        }
+
+        return true;
+    }
+
+}
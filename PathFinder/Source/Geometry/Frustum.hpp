@@ -0,0 +1,47 @@
+#pragma once
+
+#include "AxisAlignedBox3D.hpp"
+
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <array>
+
+namespace Geometry
+{
+
+    struct Frustum
+    {
+        enum PlaneIndex
+        {
+            Left = 0, Right, Bottom, Top, Near, Far
+        };
+
+        /**
+         Planes are stored as (normal, distance) with normals pointing inside,
+         so that dot(plane.xyz, point) + plane.w >= 0 for points within the frustum
+         */
+        std::array<glm::vec4, 6> Planes;
+
+        Frustum() = default;
+
+        /**
+         Extracts planes from combined view-projection matrix
+         assuming [0, 1] clip space depth range
+
+         @param viewProjection view-projection matrix
+         */
+        Frustum(const glm::mat4 &viewProjection);
+
+        bool Contains(const glm::vec3 &point) const;
+
+        /**
+         Conservative test: boxes intersecting the frustum
+         as well as some boxes near its corners are reported as visible
+
+         @return false if box is guaranteed to be outside
+         */
+        bool Intersects(const AxisAlignedBox3D &box) const;
+    };
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Ray3D.hpp"
+
+#include <cstdint>
+
+namespace Geometry {
+
+    // Several rays stored in structure of arrays layout,
+    // so that each component of all rays can be loaded into one SIMD register
+    template <uint32_t Width>
+    struct alignas(32) RayPacket3D {
+        static const uint32_t width = Width;
+
+        float originX[Width];
+        float originY[Width];
+        float originZ[Width];
+        float directionX[Width];
+        float directionY[Width];
+        float directionZ[Width];
+
+        void setRay(uint32_t lane, const Ray3D &ray) {
+            originX[lane] = ray.origin.x;
+            originY[lane] = ray.origin.y;
+            originZ[lane] = ray.origin.z;
+            directionX[lane] = ray.direction.x;
+            directionY[lane] = ray.direction.y;
+            directionZ[lane] = ray.direction.z;
+        }
+    };
+
+    using RayPacket3D4 = RayPacket3D<4>;
+    using RayPacket3D8 = RayPacket3D<8>;
+
+}
@@ -4,8 +4,157 @@
 #include <glm/gtx/transform.hpp>
 #include <glm/gtx/matrix_decompose.hpp>
 
+#if defined(__AVX__)
+#define GEOMETRY_TRANSFORMATION_AVX
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define GEOMETRY_TRANSFORMATION_SSE
+#include <xmmintrin.h>
+#endif
+
 namespace Geometry {
 
+    namespace {
+
+        float* StreamColumn(const Matrix4x4Stream& stream, uint64_t index, uint32_t column)
+        {
+            return reinterpret_cast<float*>(stream.Data + index * stream.Stride) + column * 4;
+        }
+
+        struct ScalarLanes
+        {
+            using Vector = float;
+            static const uint32_t Width = 1;
+
+            static Vector Load(const float* data) { return *data; }
+            static Vector Set(float value) { return value; }
+            static Vector Add(Vector a, Vector b) { return a + b; }
+            static Vector Sub(Vector a, Vector b) { return a - b; }
+            static Vector Mul(Vector a, Vector b) { return a * b; }
+            static Vector Div(Vector a, Vector b) { return a / b; }
+
+            static void StoreColumn(const Matrix4x4Stream& stream, uint64_t first, uint32_t column, Vector x, Vector y, Vector z, Vector w)
+            {
+                float* destination = StreamColumn(stream, first, column);
+                destination[0] = x; destination[1] = y; destination[2] = z; destination[3] = w;
+            }
+        };
+
+#if defined(GEOMETRY_TRANSFORMATION_SSE)
+        struct SSELanes
+        {
+            using Vector = __m128;
+            static const uint32_t Width = 4;
+
+            static Vector Load(const float* data) { return _mm_loadu_ps(data); }
+            static Vector Set(float value) { return _mm_set1_ps(value); }
+            static Vector Add(Vector a, Vector b) { return _mm_add_ps(a, b); }
+            static Vector Sub(Vector a, Vector b) { return _mm_sub_ps(a, b); }
+            static Vector Mul(Vector a, Vector b) { return _mm_mul_ps(a, b); }
+            static Vector Div(Vector a, Vector b) { return _mm_div_ps(a, b); }
+
+            // Lanes hold one matrix element of 4 instances, transpose turns them into 4 instance columns
+            static void StoreColumn(const Matrix4x4Stream& stream, uint64_t first, uint32_t column, Vector x, Vector y, Vector z, Vector w)
+            {
+                _MM_TRANSPOSE4_PS(x, y, z, w);
+                _mm_storeu_ps(StreamColumn(stream, first + 0, column), x);
+                _mm_storeu_ps(StreamColumn(stream, first + 1, column), y);
+                _mm_storeu_ps(StreamColumn(stream, first + 2, column), z);
+                _mm_storeu_ps(StreamColumn(stream, first + 3, column), w);
+            }
+        };
+#endif
+
+#if defined(GEOMETRY_TRANSFORMATION_AVX) && defined(GEOMETRY_TRANSFORMATION_SSE)
+        struct AVXLanes
+        {
+            using Vector = __m256;
+            static const uint32_t Width = 8;
+
+            static Vector Load(const float* data) { return _mm256_loadu_ps(data); }
+            static Vector Set(float value) { return _mm256_set1_ps(value); }
+            static Vector Add(Vector a, Vector b) { return _mm256_add_ps(a, b); }
+            static Vector Sub(Vector a, Vector b) { return _mm256_sub_ps(a, b); }
+            static Vector Mul(Vector a, Vector b) { return _mm256_mul_ps(a, b); }
+            static Vector Div(Vector a, Vector b) { return _mm256_div_ps(a, b); }
+
+            static void StoreColumn(const Matrix4x4Stream& stream, uint64_t first, uint32_t column, Vector x, Vector y, Vector z, Vector w)
+            {
+                SSELanes::StoreColumn(stream, first, column, 
+                    _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z), _mm256_castps256_ps128(w));
+
+                SSELanes::StoreColumn(stream, first + 4, column, 
+                    _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1), _mm256_extractf128_ps(w, 1));
+            }
+        };
+#endif
+
+        // Computes matrices of Lanes::Width transformations starting at index first.
+        // Model matrix is T * R * S, so its columns are rotation columns scaled by S.
+        // Normal matrix is transpose(inverse(T * R * S)), which has rotation columns divided by S,
+        // while translation ends up in the last row.
+        template <class Lanes>
+        void ComputeMatricesLanes(const TransformationSoA& t, uint64_t first, const Matrix4x4Stream& modelMatrices, const Matrix4x4Stream& normalMatrices)
+        {
+            using V = typename Lanes::Vector;
+
+            V zero = Lanes::Set(0.0f);
+            V one = Lanes::Set(1.0f);
+            V two = Lanes::Set(2.0f);
+
+            V qx = Lanes::Load(t.RotationX + first);
+            V qy = Lanes::Load(t.RotationY + first);
+            V qz = Lanes::Load(t.RotationZ + first);
+            V qw = Lanes::Load(t.RotationW + first);
+
+            V xx = Lanes::Mul(qx, qx); V yy = Lanes::Mul(qy, qy); V zz = Lanes::Mul(qz, qz);
+            V xy = Lanes::Mul(qx, qy); V xz = Lanes::Mul(qx, qz); V yz = Lanes::Mul(qy, qz);
+            V wx = Lanes::Mul(qw, qx); V wy = Lanes::Mul(qw, qy); V wz = Lanes::Mul(qw, qz);
+
+            // Same element layout as glm::mat4_cast
+            V r[3][3] = {
+                { Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(yy, zz))), Lanes::Mul(two, Lanes::Add(xy, wz)), Lanes::Mul(two, Lanes::Sub(xz, wy)) },
+                { Lanes::Mul(two, Lanes::Sub(xy, wz)), Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(xx, zz))), Lanes::Mul(two, Lanes::Add(yz, wx)) },
+                { Lanes::Mul(two, Lanes::Add(xz, wy)), Lanes::Mul(two, Lanes::Sub(yz, wx)), Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(xx, yy))) }
+            };
+
+            V s[3] = { Lanes::Load(t.ScaleX + first), Lanes::Load(t.ScaleY + first), Lanes::Load(t.ScaleZ + first) };
+            V tx = Lanes::Load(t.TranslationX + first);
+            V ty = Lanes::Load(t.TranslationY + first);
+            V tz = Lanes::Load(t.TranslationZ + first);
+
+            if (modelMatrices.Data)
+            {
+                for (uint32_t c = 0; c < 3; ++c)
+                {
+                    Lanes::StoreColumn(modelMatrices, first, c, Lanes::Mul(r[c][0], s[c]), Lanes::Mul(r[c][1], s[c]), Lanes::Mul(r[c][2], s[c]), zero);
+                }
+
+                Lanes::StoreColumn(modelMatrices, first, 3, tx, ty, tz, one);
+            }
+
+            if (normalMatrices.Data)
+            {
+                for (uint32_t c = 0; c < 3; ++c)
+                {
+                    V inverseScale = Lanes::Div(one, s[c]);
+                    V translationProjection = Lanes::Add(Lanes::Add(Lanes::Mul(r[c][0], tx), Lanes::Mul(r[c][1], ty)), Lanes::Mul(r[c][2], tz));
+
+                    Lanes::StoreColumn(normalMatrices, first, c, 
+                        Lanes::Mul(r[c][0], inverseScale), 
+                        Lanes::Mul(r[c][1], inverseScale), 
+                        Lanes::Mul(r[c][2], inverseScale), 
+                        Lanes::Sub(zero, Lanes::Mul(translationProjection, inverseScale)));
+                }
+
+                Lanes::StoreColumn(normalMatrices, first, 3, zero, zero, zero, one);
+            }
+        }
+
+    }
+
     Transformation::Transformation() : Scale(glm::one<glm::vec3>()), Translation(glm::zero<glm::vec3>()), Rotation(glm::quat()) {}
 
     Transformation::Transformation(const glm::mat4 &matrix) 
@@ -63,4 +212,77 @@ namespace Geometry {
         return glm::inverse(glm::translate(Translation));
     }
 
+    void Transformation::ComputeMatrices(const TransformationSoA& transformations, const Matrix4x4Stream& modelMatrices, const Matrix4x4Stream& normalMatrices)
+    {
+        uint64_t i = 0;
+
+#if defined(GEOMETRY_TRANSFORMATION_AVX) && defined(GEOMETRY_TRANSFORMATION_SSE)
+        for (; i + AVXLanes::Width <= transformations.Count; i += AVXLanes::Width)
+        {
+            ComputeMatricesLanes<AVXLanes>(transformations, i, modelMatrices, normalMatrices);
+        }
+#endif
+
+#if defined(GEOMETRY_TRANSFORMATION_SSE)
+        for (; i + SSELanes::Width <= transformations.Count; i += SSELanes::Width)
+        {
+            ComputeMatricesLanes<SSELanes>(transformations, i, modelMatrices, normalMatrices);
+        }
+#endif
+
+        for (; i < transformations.Count; ++i)
+        {
+            ComputeMatricesLanes<ScalarLanes>(transformations, i, modelMatrices, normalMatrices);
+        }
+    }
+
+    void TransformationArrays::Resize(uint64_t count)
+    {
+        for (auto array : { &ScaleX, &ScaleY, &ScaleZ, &TranslationX, &TranslationY, &TranslationZ, &RotationX, &RotationY, &RotationZ, &RotationW })
+        {
+            array->resize(count);
+        }
+    }
+
+    void TransformationArrays::PushBack(const Transformation& transformation)
+    {
+        Resize(Count() + 1);
+        Set(Count() - 1, transformation);
+    }
+
+    void TransformationArrays::SwapRemove(uint64_t index)
+    {
+        for (auto array : { &ScaleX, &ScaleY, &ScaleZ, &TranslationX, &TranslationY, &TranslationZ, &RotationX, &RotationY, &RotationZ, &RotationW })
+        {
+            (*array)[index] = array->back();
+            array->pop_back();
+        }
+    }
+
+    void TransformationArrays::Set(uint64_t index, const Transformation& transformation)
+    {
+        ScaleX[index] = transformation.Scale.x; ScaleY[index] = transformation.Scale.y; ScaleZ[index] = transformation.Scale.z;
+        TranslationX[index] = transformation.Translation.x; TranslationY[index] = transformation.Translation.y; TranslationZ[index] = transformation.Translation.z;
+        RotationX[index] = transformation.Rotation.x; RotationY[index] = transformation.Rotation.y; RotationZ[index] = transformation.Rotation.z; RotationW[index] = transformation.Rotation.w;
+    }
+
+    Transformation TransformationArrays::Get(uint64_t index) const
+    {
+        return {
+            glm::vec3{ ScaleX[index], ScaleY[index], ScaleZ[index] },
+            glm::vec3{ TranslationX[index], TranslationY[index], TranslationZ[index] },
+            glm::quat{ RotationW[index], RotationX[index], RotationY[index], RotationZ[index] }
+        };
+    }
+
+    TransformationSoA TransformationArrays::View(uint64_t first, uint64_t count) const
+    {
+        return {
+            ScaleX.data() + first, ScaleY.data() + first, ScaleZ.data() + first,
+            TranslationX.data() + first, TranslationY.data() + first, TranslationZ.data() + first,
+            RotationX.data() + first, RotationY.data() + first, RotationZ.data() + first, RotationW.data() + first,
+            count
+        };
+    }
+
 }
@@ -6,9 +6,14 @@
 #include <bitsery/bitsery.h>
 #include <Utility/SerializationAdapters.hpp>
 
+#include <vector>
+
 namespace Geometry 
 {
 
+    struct TransformationSoA;
+    struct Matrix4x4Stream;
+
     struct Transformation
     {
         glm::vec3 Scale;
@@ -28,6 +33,59 @@ namespace Geometry
         glm::mat4 InverseScaleMatrix() const;
         glm::mat4 InverseRotationMatrix() const;
         glm::mat4 InverseTranslationMatrix() const;
+
+        // Batch variant of ModelMatrix and NormalMatrix. Vectorized with AVX or SSE depending on target architecture, scalar otherwise.
+        // Normal matrices are derived from rotation and scale analytically instead of general matrix inverse.
+        // Streams with null data are skipped.
+        static void ComputeMatrices(const TransformationSoA& transformations, const Matrix4x4Stream& modelMatrices, const Matrix4x4Stream& normalMatrices);
+    };
+
+    /**
+     Non-owning view of several transformations stored in structure of arrays layout.
+     */
+    struct TransformationSoA
+    {
+        const float* ScaleX = nullptr;
+        const float* ScaleY = nullptr;
+        const float* ScaleZ = nullptr;
+        const float* TranslationX = nullptr;
+        const float* TranslationY = nullptr;
+        const float* TranslationZ = nullptr;
+        const float* RotationX = nullptr;
+        const float* RotationY = nullptr;
+        const float* RotationZ = nullptr;
+        const float* RotationW = nullptr;
+        uint64_t Count = 0;
+    };
+
+    /**
+     Owning storage of transformations in structure of arrays layout, which batch computations can consume directly.
+     Removal moves the last transformation into the hole, same as dense storages it is kept parallel to.
+     */
+    struct TransformationArrays
+    {
+        std::vector<float> ScaleX, ScaleY, ScaleZ;
+        std::vector<float> TranslationX, TranslationY, TranslationZ;
+        std::vector<float> RotationX, RotationY, RotationZ, RotationW;
+
+        void Resize(uint64_t count);
+        void PushBack(const Transformation& transformation);
+        void SwapRemove(uint64_t index);
+        void Set(uint64_t index, const Transformation& transformation);
+        Transformation Get(uint64_t index) const;
+        TransformationSoA View(uint64_t first, uint64_t count) const;
+
+        inline uint64_t Count() const { return ScaleX.size(); }
+    };
+
+    /**
+     Destination of batch matrix computations. Consecutive matrices are Stride bytes apart,
+     which allows writing them straight into interleaved structures, like GPU instance tables.
+     */
+    struct Matrix4x4Stream
+    {
+        uint8_t* Data = nullptr;
+        uint64_t Stride = sizeof(glm::mat4);
     };
 
     template <typename S>
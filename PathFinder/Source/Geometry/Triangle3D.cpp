@@ -16,7 +16,7 @@ namespace Geometry {
         min = glm::min(min, p3);
 
         glm::vec3 max = glm::max(p1, p2);
-        max = glm::max(min, p3);
+        max = glm::max(max, p3);
 
         return { min, max };
     }
@@ -127,6 +127,17 @@ namespace HAL
         mList->CopyTextureRegion(&dstLocation, 0, 0, 0, &srcLocation, nullptr);
     }
 
+    void CopyCommandListBase::EndQuery(const QueryHeap& heap, uint32_t queryIndex)
+    {
+        // Both timestamp heap types are written with the same query type
+        mList->EndQuery(heap.D3DHeap(), D3D12_QUERY_TYPE_TIMESTAMP, queryIndex);
+    }
+
+    void CopyCommandListBase::ResolveQueryData(const QueryHeap& heap, uint32_t firstQueryIndex, uint32_t queryCount, const Buffer& destination, uint64_t destinationOffset)
+    {
+        mList->ResolveQueryData(heap.D3DHeap(), D3D12_QUERY_TYPE_TIMESTAMP, firstQueryIndex, queryCount, destination.D3DResource(), destinationOffset);
+    }
+
 
 
     void ComputeCommandListBase::SetComputeRootConstantBuffer(GPUAddress bufferAddress, uint32_t rootParameterIndex)
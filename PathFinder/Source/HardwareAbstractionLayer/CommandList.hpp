@@ -17,6 +17,7 @@
 #include "RayTracingAccelerationStructure.hpp"
 #include "ResourceFootprint.hpp"
 #include "ShaderRegister.hpp"
+#include "QueryHeap.hpp"
 #include "Types.hpp"
 
 #include <Geometry/Rect2D.hpp>
@@ -79,6 +80,9 @@ namespace HAL
 
         void CopyBufferToTexture(const Buffer& buffer, const Texture& texture, const SubresourceFootprint& footprint);
         void CopyTextureToBuffer(const Texture& texture, const Buffer& buffer, const SubresourceFootprint& footprint);
+
+        void EndQuery(const QueryHeap& heap, uint32_t queryIndex);
+        void ResolveQueryData(const QueryHeap& heap, uint32_t firstQueryIndex, uint32_t queryCount, const Buffer& destination, uint64_t destinationOffset);
     };
 
 
@@ -33,6 +33,21 @@ namespace HAL
         mQueue->SetName(StringToWString(name).c_str());
     }
 
+    uint64_t CommandQueue::TimestampFrequency() const
+    {
+        uint64_t frequency = 0;
+        ThrowIfFailed(mQueue->GetTimestampFrequency(&frequency));
+        return frequency;
+    }
+
+    std::pair<uint64_t, uint64_t> CommandQueue::ClockCalibration() const
+    {
+        uint64_t gpuTimestamp = 0;
+        uint64_t cpuTimestamp = 0;
+        ThrowIfFailed(mQueue->GetClockCalibration(&gpuTimestamp, &cpuTimestamp));
+        return { gpuTimestamp, cpuTimestamp };
+    }
+
 
 
     GraphicsCommandQueue::GraphicsCommandQueue(const Device& device)
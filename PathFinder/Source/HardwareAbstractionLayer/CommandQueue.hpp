@@ -21,6 +21,12 @@ namespace HAL
         void WaitFence(const Fence& fence, std::optional<uint64_t> explicitFenceValue = std::nullopt);
         void SetDebugName(const std::string& name) override;
 
+        // Ticks per second of GPU timestamps recorded on this queue
+        uint64_t TimestampFrequency() const;
+
+        // GPU timestamp and CPU performance counter value sampled at the same moment
+        std::pair<uint64_t, uint64_t> ClockCalibration() const;
+
     protected:
         template <class CommandListT>
         void ExecuteCommandListsInternal(const CommandListT* const* lists, uint64_t count);
@@ -4,8 +4,21 @@
 
 #include <aftermath/GFSDK_Aftermath.h>
 
+#include <functional>
+
 namespace HAL
 {
+
+    namespace
+    {
+
+        uint64_t HashCombine(uint64_t seed, uint64_t value)
+        {
+            return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+        }
+
+    }
+
     Device::Device(const DisplayAdapter& adapter, bool aftermathEnabled)
         : mAftermathEnabled{ aftermathEnabled }
     {
@@ -24,4 +37,90 @@ namespace HAL
         default: mSupportsUniversalHeaps = true; break;
         }
     }
+
+    D3D12_RESOURCE_ALLOCATION_INFO Device::ResourceAllocationInfo(const D3D12_RESOURCE_DESC& description) const
+    {
+        D3D12_RESOURCE_ALLOCATION_INFO info{};
+        ResourceAllocationInfo(&description, 1, &info);
+        return info;
+    }
+
+    void Device::ResourceAllocationInfo(const D3D12_RESOURCE_DESC* descriptions, uint64_t count, D3D12_RESOURCE_ALLOCATION_INFO* infos) const
+    {
+        std::lock_guard lock{ mAllocationInfoCacheMutex };
+
+        // Cache nodes are stable, so results can be read through them once misses are resolved
+        std::vector<const D3D12_RESOURCE_ALLOCATION_INFO*> cachedInfos(count);
+        std::vector<D3D12_RESOURCE_DESC> missedDescriptions;
+        std::vector<D3D12_RESOURCE_ALLOCATION_INFO*> missedInfos;
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            auto [it, inserted] = mAllocationInfoCache.try_emplace(descriptions[i]);
+            cachedInfos[i] = &it->second;
+
+            if (inserted)
+            {
+                missedDescriptions.push_back(descriptions[i]);
+                missedInfos.push_back(&it->second);
+                ++mAllocationInfoCacheMisses;
+            }
+            else
+            {
+                ++mAllocationInfoCacheHits;
+            }
+        }
+
+        if (!missedDescriptions.empty())
+        {
+            std::vector<D3D12_RESOURCE_ALLOCATION_INFO1> resourceInfos(missedDescriptions.size());
+
+            UINT GPUMask = 0;
+            mDevice->GetResourceAllocationInfo1(GPUMask, UINT(missedDescriptions.size()), missedDescriptions.data(), resourceInfos.data());
+
+            for (auto i = 0u; i < resourceInfos.size(); ++i)
+            {
+                missedInfos[i]->Alignment = resourceInfos[i].Alignment;
+                missedInfos[i]->SizeInBytes = resourceInfos[i].SizeInBytes;
+            }
+        }
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            infos[i] = *cachedInfos[i];
+        }
+    }
+
+    size_t Device::ResourceDescriptionHasher::operator()(const D3D12_RESOURCE_DESC& description) const
+    {
+        uint64_t hash = std::hash<uint64_t>{}(description.Width);
+        hash = HashCombine(hash, uint64_t(description.Dimension));
+        hash = HashCombine(hash, description.Alignment);
+        hash = HashCombine(hash, description.Height);
+        hash = HashCombine(hash, description.DepthOrArraySize);
+        hash = HashCombine(hash, description.MipLevels);
+        hash = HashCombine(hash, uint64_t(description.Format));
+        hash = HashCombine(hash, description.SampleDesc.Count);
+        hash = HashCombine(hash, description.SampleDesc.Quality);
+        hash = HashCombine(hash, uint64_t(description.Layout));
+        hash = HashCombine(hash, uint64_t(description.Flags));
+        return hash;
+    }
+
+    // Fields are compared one by one since padding bytes of a description are not guaranteed to be initialized
+    bool Device::ResourceDescriptionComparator::operator()(const D3D12_RESOURCE_DESC& a, const D3D12_RESOURCE_DESC& b) const
+    {
+        return a.Dimension == b.Dimension &&
+            a.Alignment == b.Alignment &&
+            a.Width == b.Width &&
+            a.Height == b.Height &&
+            a.DepthOrArraySize == b.DepthOrArraySize &&
+            a.MipLevels == b.MipLevels &&
+            a.Format == b.Format &&
+            a.SampleDesc.Count == b.SampleDesc.Count &&
+            a.SampleDesc.Quality == b.SampleDesc.Quality &&
+            a.Layout == b.Layout &&
+            a.Flags == b.Flags;
+    }
+
 }
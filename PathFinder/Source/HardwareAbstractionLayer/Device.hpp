@@ -2,6 +2,9 @@
 
 #include <d3d12.h>
 #include <wrl.h>
+#include <unordered_map>
+#include <vector>
+#include <mutex>
 
 #include "GraphicAPIObject.hpp"
 
@@ -14,7 +17,25 @@ namespace HAL
     public:
         Device(const DisplayAdapter& adapter, bool aftermathEnabled);
 
+        // Allocation info depends on resource description alone, so driver is queried once per unique description
+        D3D12_RESOURCE_ALLOCATION_INFO ResourceAllocationInfo(const D3D12_RESOURCE_DESC& description) const;
+
+        // Serves known descriptions from cache and queries the rest in a single driver call
+        void ResourceAllocationInfo(const D3D12_RESOURCE_DESC* descriptions, uint64_t count, D3D12_RESOURCE_ALLOCATION_INFO* infos) const;
+
     private:
+        struct ResourceDescriptionHasher
+        {
+            size_t operator()(const D3D12_RESOURCE_DESC& description) const;
+        };
+
+        struct ResourceDescriptionComparator
+        {
+            bool operator()(const D3D12_RESOURCE_DESC& a, const D3D12_RESOURCE_DESC& b) const;
+        };
+
+        using AllocationInfoCache = std::unordered_map<D3D12_RESOURCE_DESC, D3D12_RESOURCE_ALLOCATION_INFO, ResourceDescriptionHasher, ResourceDescriptionComparator>;
+
         Microsoft::WRL::ComPtr<ID3D12Device5> mDevice;
 
         bool mSupportsUniversalHeaps = false;
@@ -22,6 +43,11 @@ namespace HAL
         uint64_t mMinimumHeapSize = 1;
         uint64_t mHeapAlignment = 1;
 
+        mutable AllocationInfoCache mAllocationInfoCache;
+        mutable std::mutex mAllocationInfoCacheMutex;
+        mutable uint64_t mAllocationInfoCacheHits = 0;
+        mutable uint64_t mAllocationInfoCacheMisses = 0;
+
     public:
         inline ID3D12Device5* D3DDevice() const { return mDevice.Get(); }
 
@@ -29,5 +55,7 @@ namespace HAL
         inline auto MinimumHeapSize() const { return mMinimumHeapSize; }
         inline auto MandatoryHeapAlignment() const { return mHeapAlignment; }
         inline auto AftermathEnabled() const { return mAftermathEnabled; }
+        inline auto AllocationInfoCacheHits() const { return mAllocationInfoCacheHits; }
+        inline auto AllocationInfoCacheMisses() const { return mAllocationInfoCacheMisses; }
     };
 }
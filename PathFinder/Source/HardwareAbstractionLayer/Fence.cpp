@@ -23,9 +23,9 @@ namespace HAL
         return mFence->GetCompletedValue() >= mExpectedValue;
     }
 
-    void Fence::SetCompletionEventHandle(HANDLE handle)
+    void Fence::SetCompletionEventHandle(HANDLE handle, uint64_t value)
     {
-        ThrowIfFailed(mFence->SetEventOnCompletion(mExpectedValue, handle));
+        ThrowIfFailed(mFence->SetEventOnCompletion(value, handle));
     }
 
     void Fence::StallCurrentThreadUntilCompletion(uint8_t allowedSimultaneousFramesCount)
@@ -46,8 +46,9 @@ namespace HAL
         if (framesInFlight < allowedSimultaneousFramesCount) return;
 
         HANDLE eventHandle = CreateEventEx(nullptr, nullptr , false, EVENT_ALL_ACCESS);
-        // Fire event when GPU hits current fence.  
-        SetCompletionEventHandle(eventHandle);
+        // Fire event when GPU completes just enough frames to get below the allowed count,
+        // so that newer frames keep executing while CPU continues.
+        SetCompletionEventHandle(eventHandle, mExpectedValue - allowedSimultaneousFramesCount + 1);
         // Wait until the GPU hits current fence event is fired.
         WaitForSingleObject(eventHandle, INFINITE);
         CloseHandle(eventHandle);
@@ -19,7 +19,7 @@ namespace HAL
         void StallCurrentThreadUntilCompletion(uint8_t allowedSimultaneousFramesCount = 1);
     
     private:
-        void SetCompletionEventHandle(HANDLE handle);
+        void SetCompletionEventHandle(HANDLE handle, uint64_t value);
 
         Microsoft::WRL::ComPtr<ID3D12Fence> mFence;
         uint64_t mExpectedValue = 0;
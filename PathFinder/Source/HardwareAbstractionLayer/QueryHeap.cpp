@@ -0,0 +1,30 @@
+#include "QueryHeap.hpp"
+#include "Utils.h"
+
+#include <Foundation/StringUtils.hpp>
+
+namespace HAL
+{
+
+    QueryHeap::QueryHeap(const Device& device, QueryHeapType type, uint32_t queryCount)
+        : mType{ type }, mQueryCount{ queryCount }
+    {
+        D3D12_QUERY_HEAP_DESC desc{};
+        desc.Count = queryCount;
+        desc.NodeMask = 0;
+
+        switch (type)
+        {
+        case QueryHeapType::Timestamp: desc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP; break;
+        case QueryHeapType::CopyQueueTimestamp: desc.Type = D3D12_QUERY_HEAP_TYPE_COPY_QUEUE_TIMESTAMP; break;
+        }
+
+        ThrowIfFailed(device.D3DDevice()->CreateQueryHeap(&desc, IID_PPV_ARGS(mHeap.GetAddressOf())));
+    }
+
+    void QueryHeap::SetDebugName(const std::string& name)
+    {
+        mHeap->SetName(StringToWString(name).c_str());
+    }
+
+}
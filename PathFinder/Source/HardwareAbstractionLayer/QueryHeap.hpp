@@ -0,0 +1,42 @@
+#pragma once
+
+#include <d3d12.h>
+#include <wrl.h>
+#include <cstdint>
+
+#include "GraphicAPIObject.hpp"
+#include "Device.hpp"
+
+namespace HAL
+{
+
+    enum class QueryHeapType
+    {
+        Timestamp, CopyQueueTimestamp
+    };
+
+    class QueryHeap : public GraphicAPIObject
+    {
+    public:
+        QueryHeap(const Device& device, QueryHeapType type, uint32_t queryCount);
+        QueryHeap(const QueryHeap& that) = delete;
+        QueryHeap(QueryHeap&& that) = default;
+        ~QueryHeap() = default;
+
+        QueryHeap& operator=(const QueryHeap& that) = delete;
+        QueryHeap& operator=(QueryHeap&& that) = default;
+
+        void SetDebugName(const std::string& name) override;
+
+    private:
+        Microsoft::WRL::ComPtr<ID3D12QueryHeap> mHeap;
+        QueryHeapType mType;
+        uint32_t mQueryCount = 0;
+
+    public:
+        inline ID3D12QueryHeap* D3DHeap() const { return mHeap.Get(); }
+        inline auto Type() const { return mType; }
+        inline auto QueryCount() const { return mQueryCount; }
+    };
+
+}
@@ -1,6 +1,8 @@
 #include "ResourceBarrier.hpp"
 #include "Utils.h"
 
+#include <algorithm>
+
 namespace HAL
 {
     ResourceBarrier::~ResourceBarrier() {}
@@ -57,5 +59,129 @@ namespace HAL
         mD3DBarriers.insert(mD3DBarriers.end(), barriers.mD3DBarriers.begin(), barriers.mD3DBarriers.end());
     }
 
+    uint64_t ResourceBarrierCollection::Optimize()
+    {
+        std::vector<D3D12_RESOURCE_BARRIER> aliasingBarriers;
+        std::vector<D3D12_RESOURCE_BARRIER> transitionBarriers;
+        std::vector<D3D12_RESOURCE_BARRIER> uavBarriers;
+        bool globalUAVBarrierExists = false;
+
+        auto isSameSubresource = [](const D3D12_RESOURCE_BARRIER& first, const D3D12_RESOURCE_BARRIER& second)
+        {
+            return first.Transition.pResource == second.Transition.pResource && first.Transition.Subresource == second.Transition.Subresource;
+        };
+
+        for (const D3D12_RESOURCE_BARRIER& barrier : mD3DBarriers)
+        {
+            switch (barrier.Type)
+            {
+            case D3D12_RESOURCE_BARRIER_TYPE_ALIASING:
+            {
+                bool isDuplicate = std::any_of(aliasingBarriers.begin(), aliasingBarriers.end(), [&barrier](const D3D12_RESOURCE_BARRIER& other)
+                {
+                    return other.Aliasing.pResourceBefore == barrier.Aliasing.pResourceBefore && other.Aliasing.pResourceAfter == barrier.Aliasing.pResourceAfter;
+                });
+
+                if (!isDuplicate) aliasingBarriers.push_back(barrier);
+                break;
+            }
+
+            case D3D12_RESOURCE_BARRIER_TYPE_UAV:
+            {
+                bool isDuplicate = std::any_of(uavBarriers.begin(), uavBarriers.end(), [&barrier](const D3D12_RESOURCE_BARRIER& other)
+                {
+                    return other.UAV.pResource == barrier.UAV.pResource;
+                });
+
+                globalUAVBarrierExists = globalUAVBarrierExists || !barrier.UAV.pResource;
+                if (!isDuplicate) uavBarriers.push_back(barrier);
+                break;
+            }
+
+            case D3D12_RESOURCE_BARRIER_TYPE_TRANSITION:
+            {
+                auto previousIt = std::find_if(transitionBarriers.rbegin(), transitionBarriers.rend(), [&](const D3D12_RESOURCE_BARRIER& other)
+                {
+                    return isSameSubresource(barrier, other);
+                });
+
+                if (previousIt != transitionBarriers.rend())
+                {
+                    bool isDuplicate = previousIt->Flags == barrier.Flags && 
+                        previousIt->Transition.StateBefore == barrier.Transition.StateBefore && 
+                        previousIt->Transition.StateAfter == barrier.Transition.StateAfter;
+
+                    if (isDuplicate)
+                    {
+                        break;
+                    }
+
+                    // Split barriers have their counterparts elsewhere and can't be chained
+                    bool isChainable = previousIt->Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE &&
+                        barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE &&
+                        previousIt->Transition.StateAfter == barrier.Transition.StateBefore;
+
+                    if (isChainable)
+                    {
+                        previousIt->Transition.StateAfter = barrier.Transition.StateAfter;
+                        break;
+                    }
+                }
+
+                transitionBarriers.push_back(barrier);
+                break;
+            }
+
+            default:
+                break;
+            }
+        }
+
+        // Chaining can produce transitions that return subresource to its original state
+        transitionBarriers.erase(std::remove_if(transitionBarriers.begin(), transitionBarriers.end(), [](const D3D12_RESOURCE_BARRIER& barrier)
+        {
+            return barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE && barrier.Transition.StateBefore == barrier.Transition.StateAfter;
+        }), transitionBarriers.end());
+
+        // Global UAV barrier covers every other UAV barrier
+        if (globalUAVBarrierExists)
+        {
+            uavBarriers.erase(std::remove_if(uavBarriers.begin(), uavBarriers.end(), [](const D3D12_RESOURCE_BARRIER& barrier)
+            {
+                return barrier.UAV.pResource != nullptr;
+            }), uavBarriers.end());
+        }
+
+        uint64_t originalCount = mD3DBarriers.size();
+
+        mD3DBarriers = std::move(aliasingBarriers);
+        mD3DBarriers.insert(mD3DBarriers.end(), transitionBarriers.begin(), transitionBarriers.end());
+        mD3DBarriers.insert(mD3DBarriers.end(), uavBarriers.begin(), uavBarriers.end());
+
+        return originalCount - mD3DBarriers.size();
+    }
+
+    ResourceBarrierCollection::Composition ResourceBarrierCollection::GetComposition() const
+    {
+        Composition composition{};
+
+        for (const D3D12_RESOURCE_BARRIER& barrier : mD3DBarriers)
+        {
+            switch (barrier.Type)
+            {
+            case D3D12_RESOURCE_BARRIER_TYPE_ALIASING: composition.AliasingCount++; break;
+            case D3D12_RESOURCE_BARRIER_TYPE_UAV: composition.UnorderedAccessCount++; break;
+            case D3D12_RESOURCE_BARRIER_TYPE_TRANSITION:
+                if (barrier.Flags & D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY) composition.SplitBeginCount++;
+                else if (barrier.Flags & D3D12_RESOURCE_BARRIER_FLAG_END_ONLY) composition.SplitEndCount++;
+                else composition.TransitionCount++;
+                break;
+            default: break;
+            }
+        }
+
+        return composition;
+    }
+
 }
 
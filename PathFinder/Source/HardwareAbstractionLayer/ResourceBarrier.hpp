@@ -85,9 +85,25 @@ namespace HAL
     class ResourceBarrierCollection
     {
     public:
+        struct Composition
+        {
+            uint64_t TransitionCount = 0;
+            uint64_t SplitBeginCount = 0;
+            uint64_t SplitEndCount = 0;
+            uint64_t AliasingCount = 0;
+            uint64_t UnorderedAccessCount = 0;
+        };
+
         void AddBarrier(const ResourceBarrier& barrier);
         void AddBarriers(const ResourceBarrierCollection& barriers);
 
+        // Chains consecutive transitions of the same subresource, removes duplicates and no-op transitions
+        // and orders barriers: aliasing first, then transitions, then UAV barriers. 
+        // Returns number of eliminated barriers.
+        uint64_t Optimize();
+
+        Composition GetComposition() const;
+
     private:
         std::vector<D3D12_RESOURCE_BARRIER> mD3DBarriers;
 
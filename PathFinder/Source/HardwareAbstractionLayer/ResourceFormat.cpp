@@ -121,15 +121,42 @@ namespace HAL
         mDescription.MipLevels = mipCount;
     }
 
-    void ResourceFormat::SetExpectedStates(ResourceState expectedStates)
+    void ResourceFormat::SetExpectedStates(ResourceState expectedStates, bool queryAllocationInfo)
     {
         std::visit([expectedStates](auto&& resourceProperties) { resourceProperties.ExpectedStateMask = expectedStates; }, mResourceProperties);
 
         DetermineExpectedUsageFlags(expectedStates);
-        QueryAllocationInfo();
+        if (queryAllocationInfo) QueryAllocationInfo();
         DetermineAliasingGroup(expectedStates);
     }
 
+    void ResourceFormat::BatchQueryAllocationInfo(const std::vector<ResourceFormat*>& formats)
+    {
+        std::vector<ResourceFormat*> queriedFormats;
+        std::vector<D3D12_RESOURCE_DESC> descriptions;
+
+        for (ResourceFormat* format : formats)
+        {
+            if (format->mDescription.Width == 0) continue;
+
+            queriedFormats.push_back(format);
+            descriptions.push_back(format->mDescription);
+        }
+
+        if (queriedFormats.empty())
+        {
+            return;
+        }
+
+        std::vector<D3D12_RESOURCE_ALLOCATION_INFO> allocInfos(descriptions.size());
+        queriedFormats.front()->mDevice->ResourceAllocationInfo(descriptions.data(), descriptions.size(), allocInfos.data());
+
+        for (auto i = 0u; i < queriedFormats.size(); ++i)
+        {
+            queriedFormats[i]->ApplyAllocationInfo(allocInfos[i]);
+        }
+    }
+
     void ResourceFormat::QueryAllocationInfo()
     {
         if (mDescription.Width == 0)
@@ -137,9 +164,11 @@ namespace HAL
             return;
         }
 
-        UINT GPUMask = 0;
-        D3D12_RESOURCE_ALLOCATION_INFO allocInfo = mDevice->D3DDevice()->GetResourceAllocationInfo(GPUMask, 1, &mDescription);
+        ApplyAllocationInfo(mDevice->ResourceAllocationInfo(mDescription));
+    }
 
+    void ResourceFormat::ApplyAllocationInfo(const D3D12_RESOURCE_ALLOCATION_INFO& allocInfo)
+    {
         mResourceAlignment = allocInfo.Alignment;
         mResourceSizeInBytes = allocInfo.SizeInBytes;
         mDescription.Alignment = mResourceAlignment;
@@ -402,4 +431,26 @@ namespace HAL
         }
     }
 
+    bool IsBlockCompressed(FormatVariant format)
+    {
+        if (!std::holds_alternative<ColorFormat>(format))
+        {
+            return false;
+        }
+
+        switch (std::get<ColorFormat>(format))
+        {
+        case ColorFormat::BC1_Unsigned_Norm:
+        case ColorFormat::BC2_Unsigned_Norm:
+        case ColorFormat::BC3_Unsigned_Norm:
+        case ColorFormat::BC4_Unsigned_Norm:
+        case ColorFormat::BC5_Unsigned_Norm:
+        case ColorFormat::BC5_Signed_Norm:
+        case ColorFormat::BC7_Unsigned_Norm:
+            return true;
+        default:
+            return false;
+        }
+    }
+
 }
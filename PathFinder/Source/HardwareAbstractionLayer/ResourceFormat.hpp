@@ -4,6 +4,7 @@
 #include <optional>
 #include <variant>
 #include <array>
+#include <vector>
 
 #include "Device.hpp"
 #include "ResourceState.hpp"
@@ -83,6 +84,8 @@ namespace HAL
     FormatVariant FormatFromD3DFormat(DXGI_FORMAT format);
     ColorSpace ColorSpaceFromD3DSpace(DXGI_COLOR_SPACE_TYPE space);
 
+    bool IsBlockCompressed(FormatVariant format);
+
 
 
     struct TextureProperties
@@ -149,12 +152,17 @@ namespace HAL
         ResourceFormat(const Device* device, const TextureProperties& textureProperties);
         ResourceFormat(const Device* device, const BufferProperties& bufferProperties);
 
-        void SetExpectedStates(ResourceState expectedStates);
+        // Allocation info query can be deferred when many formats are resolved at once
+        void SetExpectedStates(ResourceState expectedStates, bool queryAllocationInfo = true);
+
+        // Resolves allocation info of several formats with a single device query
+        static void BatchQueryAllocationInfo(const std::vector<ResourceFormat*>& formats);
 
     private:
         void ResolveBufferDemensionData(uint64_t byteCount);
         void ResolveTextureDemensionData(TextureKind kind, const Geometry::Dimensions& dimensions, uint8_t mipCount);
         void QueryAllocationInfo();
+        void ApplyAllocationInfo(const D3D12_RESOURCE_ALLOCATION_INFO& allocInfo);
         void DetermineExpectedUsageFlags(ResourceState expectedStates);
         void DetermineAliasingGroup(ResourceState expectedStates);
 
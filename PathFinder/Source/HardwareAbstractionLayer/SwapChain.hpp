@@ -16,7 +16,7 @@ namespace HAL
 {
     enum class BackBufferingStrategy: uint8_t
     { 
-        Double = 2, Triple = 3 
+        Double = 2, Triple = 3, Quadruple = 4
     };
 
     class SwapChain
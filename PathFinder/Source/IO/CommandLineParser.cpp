@@ -1,5 +1,7 @@
 #include "CommandLineParser.hpp"
 
+#include <algorithm>
+
 
 
 namespace PathFinder
@@ -44,6 +46,32 @@ namespace PathFinder
         {
             mUseWARPDevice = true;
         }
+
+        // Deeper pipelining trades latency for CPU/GPU overlap.
+        // Limited to 2-4 frames, which is also the range of swap chain back buffer counts.
+        const char* framesInFlightArgument = "-frames_in_flight=";
+
+        if (strncmp(argv, framesInFlightArgument, strlen(framesInFlightArgument)) == 0)
+        {
+            int framesInFlight = atoi(argv + strlen(framesInFlightArgument));
+            mSimultaneousFramesInFlight = uint8_t(std::clamp(framesInFlight, 2, 4));
+        }
+
+        // Transient aliasing heap sizing, see PipelineResourceStorage::HeapGrowthSettings
+        const char* heapGrowthSlackArgument = "-heap_growth_slack=";
+        const char* heapShrinkThresholdArgument = "-heap_shrink_threshold=";
+
+        if (strncmp(argv, heapGrowthSlackArgument, strlen(heapGrowthSlackArgument)) == 0)
+        {
+            float slack = float(atof(argv + strlen(heapGrowthSlackArgument)));
+            mHeapGrowthSlack = std::clamp(slack, 0.0f, 4.0f);
+        }
+
+        if (strncmp(argv, heapShrinkThresholdArgument, strlen(heapShrinkThresholdArgument)) == 0)
+        {
+            float threshold = float(atof(argv + strlen(heapShrinkThresholdArgument)));
+            mHeapShrinkThreshold = std::clamp(threshold, 0.0f, 1.0f);
+        }
     }
 
 }
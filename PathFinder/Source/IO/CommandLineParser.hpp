@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <optional>
 
 namespace PathFinder 
 {
@@ -19,6 +20,9 @@ namespace PathFinder
         bool mDebugLayerEnabled = false;
         bool mAftermathEnabled = false;
         bool mUseWARPDevice = false;
+        uint8_t mSimultaneousFramesInFlight = 2;
+        std::optional<float> mHeapGrowthSlack;
+        std::optional<float> mHeapShrinkThreshold;
 
     public:
         inline auto ShouldEnableDebugLayer() const { return mDebugLayerEnabled; }
@@ -26,6 +30,9 @@ namespace PathFinder
         inline auto ShouldUseShadersFromProjectFolder() const { return mUseShadersInProjectFolder; }
         inline auto ShouldEnableAftermath() const { return mAftermathEnabled; }
         inline auto ShouldUseWARPDevice() const { return mUseWARPDevice; }
+        inline auto SimultaneousFramesInFlight() const { return mSimultaneousFramesInFlight; }
+        inline auto HeapGrowthSlack() const { return mHeapGrowthSlack; }
+        inline auto HeapShrinkThreshold() const { return mHeapShrinkThreshold; }
         inline const auto& ExecutableFolderPath() const { return mExecutableFolder; }
     };
 
@@ -5,9 +5,9 @@
 namespace Memory
 {
 
-    void CopyRequestManager::RequestUpload(const HAL::Resource* resource, const CopyCommand& copyCommand)
+    void CopyRequestManager::RequestUpload(const HAL::Resource* resource, const CopyCommand& copyCommand, bool isInitialUpload)
     {
-        mUploadRequests.emplace_back(CopyRequest{ resource, copyCommand });
+        mUploadRequests.emplace_back(CopyRequest{ resource, copyCommand, isInitialUpload });
     }
 
     void CopyRequestManager::RequestReadback(const HAL::Resource* resource, const CopyCommand& copyCommand)
@@ -17,9 +17,11 @@ namespace Memory
         {
             const HAL::Resource* Resource = nullptr;
             CopyCommand Command;
+            // First upload into the resource since it was created, so no earlier GPU work can be reading it
+            bool IsInitialUpload = false;
         };
 
-        void RequestUpload(const HAL::Resource* resource, const CopyCommand& copyCommand);
+        void RequestUpload(const HAL::Resource* resource, const CopyCommand& copyCommand, bool isInitialUpload = false);
         void RequestReadback(const HAL::Resource* resource, const CopyCommand& copyCommand);
 
         void FlushUploadRequests();
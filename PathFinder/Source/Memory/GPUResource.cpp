@@ -30,23 +30,27 @@ namespace Memory
 
         if (mUploadStrategy != UploadStrategy::DirectAccess)
         {
-            mCopyRequestManager->RequestUpload(HALResource(), GetUploadCommands());
+            mCopyRequestManager->RequestUpload(HALResource(), GetUploadCommands(), !mIsUploadRequested);
         }
+
+        mIsUploadRequested = true;
     }
 
-    void GPUResource::RequestRead()
+    ReadbackFuture GPUResource::RequestRead()
     {
         assert_format(mUploadStrategy != UploadStrategy::DirectAccess, "DirectAccess upload resource does not support reads");
 
         // Readback is already requested in current frame
-        if (!mReadbackBuffers.empty() && mReadbackBuffers.back().second == mFrameNumber)
+        if (!mReadbacks.empty() && mReadbacks.back().RequestFrameNumber() == mFrameNumber)
         {
-            return;
+            return mReadbacks.back();
         }
 
         AllocateNewReadbackBuffer();
 
         mCopyRequestManager->RequestReadback(HALResource(), GetReadbackCommands());
+
+        return mReadbacks.back();
     }
 
     void GPUResource::RequestNewState(HAL::ResourceState newState)
@@ -86,10 +90,11 @@ namespace Memory
         
         // Readback memory we just free unconditionally since reading upload only resources is not permitted in the first place.
         // A window to read back the data is after frame end but before new frame start.
-        mCompletedReadbackBuffer = nullptr;
+        // Memory stays alive for as long as anyone holds a future of that readback.
+        mCompletedReadback = {};
     }
 
-    void GPUResource::EndFrame(uint64_t frameNumber)
+    void GPUResource::EndFrame(uint64_t frameNumber, ReadbackCallbackDispatcher& readbackCallbackDispatcher)
     {
         // Release upload buffers for completed frames
         while (!mUploadBuffers.empty() && mUploadBuffers.front().second <= frameNumber)
@@ -98,11 +103,13 @@ namespace Memory
             mUploadBuffers.pop();
         }
 
-        // Get freshest completed readback buffer. Discard the rest.
-        while (!mReadbackBuffers.empty() && mReadbackBuffers.front().second <= frameNumber)
+        // Complete readbacks of finished frames in request order, so that futures don't miss data.
+        // Freshest one stays available through Read().
+        while (!mReadbacks.empty() && mReadbacks.front().RequestFrameNumber() <= frameNumber)
         {
-            mCompletedReadbackBuffer = std::move(mReadbackBuffers.front().first);
-            mReadbackBuffers.pop();
+            mCompletedReadback = std::move(mReadbacks.front());
+            mReadbacks.pop();
+            mCompletedReadback.Complete(mFrameNumber, &readbackCallbackDispatcher);
         }
     }
 
@@ -131,14 +138,18 @@ namespace Memory
 
     HAL::Buffer* GPUResource::CurrentFrameReadbackBuffer()
     {
-        return !mReadbackBuffers.empty() && mReadbackBuffers.back().second == mFrameNumber ?
-            mReadbackBuffers.back().first.get() : nullptr;
+        return CurrentFrameReadback().ReadbackBuffer();
     }
 
     const HAL::Buffer* GPUResource::CurrentFrameReadbackBuffer() const
     {
-        return !mReadbackBuffers.empty() && mReadbackBuffers.back().second == mFrameNumber ?
-            mReadbackBuffers.back().first.get() : nullptr;
+        return CurrentFrameReadback().ReadbackBuffer();
+    }
+
+    ReadbackFuture GPUResource::CurrentFrameReadback() const
+    {
+        return !mReadbacks.empty() && mReadbacks.back().RequestFrameNumber() == mFrameNumber ?
+            mReadbacks.back() : ReadbackFuture{};
     }
 
     void GPUResource::ApplyDebugName()
@@ -155,8 +166,8 @@ namespace Memory
     void GPUResource::AllocateNewReadbackBuffer()
     {
         auto properties = HAL::BufferProperties::Create<uint8_t>(ResourceSizeInBytes());
-        mReadbackBuffers.emplace(mResourceAllocator->AllocateBuffer(properties, HAL::CPUAccessibleHeapType::Readback), mFrameNumber);
-        mReadbackBuffers.back().first->SetDebugName(StringFormat("%s Readback Buffer [Frame %d]", mDebugName.c_str(), mFrameNumber));
+        mReadbacks.push(ReadbackFuture{ mResourceAllocator->AllocateBuffer(properties, HAL::CPUAccessibleHeapType::Readback), mFrameNumber });
+        mReadbacks.back().ReadbackBuffer()->SetDebugName(StringFormat("%s Readback Buffer [Frame %d]", mDebugName.c_str(), mFrameNumber));
     }
 
 }
@@ -4,6 +4,7 @@
 #include "ResourceStateTracker.hpp"
 #include "PoolDescriptorAllocator.hpp"
 #include "CopyRequestManager.hpp"
+#include "ReadbackFuture.hpp"
 
 #include <HardwareAbstractionLayer/Resource.hpp>
 #include <HardwareAbstractionLayer/CommandList.hpp>
@@ -37,8 +38,9 @@ namespace Memory
         virtual ~GPUResource() = 0;
 
         template <class T>
-        using ReadbackSession = std::function<void(const T*)>;
+        using ReadbackSession = ReadbackFuture::ReadbackSession<T>;
 
+        // Reads freshest readback completed by the end of previous frame
         template <class T = uint8_t>
         void Read(const ReadbackSession<T>& session) const;
 
@@ -49,15 +51,18 @@ namespace Memory
         void Write(const T* data, uint64_t startIndex, uint64_t objectCount, uint64_t objectAlignment = 1);
 
         void RequestWrite();
-        void RequestRead();
+        ReadbackFuture RequestRead();
         void RequestNewState(HAL::ResourceState newState);
         void RequestNewSubresourceStates(const ResourceStateTracker::SubresourceStateList& newStates);
         void BeginFrame(uint64_t frameNumber);
-        void EndFrame(uint64_t frameNumber);
+        void EndFrame(uint64_t frameNumber, ReadbackCallbackDispatcher& readbackCallbackDispatcher);
         void SetDebugName(const std::string& name);
 
         virtual const HAL::Resource* HALResource() const;
 
+        // Readback requested in current frame, if any
+        ReadbackFuture CurrentFrameReadback() const;
+
     protected:
         using BufferFrameNumberPair = std::pair<SegregatedPoolsResourceAllocator::BufferPtr, uint64_t>;
 
@@ -78,16 +83,17 @@ namespace Memory
         CopyRequestManager* mCopyRequestManager;
 
         std::queue<BufferFrameNumberPair> mUploadBuffers;
-        std::queue<BufferFrameNumberPair> mReadbackBuffers;
+        std::queue<ReadbackFuture> mReadbacks;
 
         std::string mDebugName;
         uint64_t mFrameNumber = 0;
+        bool mIsUploadRequested = false;
 
     private:
         void AllocateNewUploadBuffer();
         void AllocateNewReadbackBuffer();
 
-        SegregatedPoolsResourceAllocator::BufferPtr mCompletedReadbackBuffer;
+        ReadbackFuture mCompletedReadback;
         SegregatedPoolsResourceAllocator::BufferPtr mCompletedUploadBuffer;
     };
 
@@ -35,15 +35,7 @@ namespace Memory
     {
         assert_format(mUploadStrategy != UploadStrategy::DirectAccess, "DirectAccess upload resource does not support reads");
 
-        if (!mCompletedReadbackBuffer)
-        {
-            session(nullptr);
-            return;
-        }
-
-        const T* mappedMemory = reinterpret_cast<T*>(mCompletedReadbackBuffer->Map());
-        session(mappedMemory);
-        mCompletedReadbackBuffer->Unmap(); // Invalidate CPU cache before next read
+        mCompletedReadback.Read(session);
     }
 
 }
@@ -8,13 +8,15 @@ namespace Memory
         SegregatedPoolsResourceAllocator* resourceAllocator, 
         ResourceStateTracker* stateTracker, 
         PoolDescriptorAllocator* descriptorAllocator,
-        CopyRequestManager* copyRequestManager)
+        CopyRequestManager* copyRequestManager,
+        Foundation::TaskScheduler* taskScheduler)
         : 
         mDevice{ device },
         mResourceAllocator{ resourceAllocator }, 
         mStateTracker{ stateTracker }, 
         mDescriptorAllocator{ descriptorAllocator },
-        mCopyRequestManager{ copyRequestManager } {}
+        mCopyRequestManager{ copyRequestManager },
+        mReadbackCallbackDispatcher{ taskScheduler } {}
 
     GPUResourceProducer::TexturePtr GPUResourceProducer::NewTexture(const HAL::TextureProperties& properties)
     {
@@ -106,9 +108,11 @@ namespace Memory
 
     void GPUResourceProducer::EndFrame(uint64_t frameNumber)
     {
+        mReadbackCallbackDispatcher.ResetStatistics();
+
         for (GPUResource* resource : mAllocatedResources)
         {
-            resource->EndFrame(frameNumber);
+            resource->EndFrame(frameNumber, mReadbackCallbackDispatcher);
         }
     }
 
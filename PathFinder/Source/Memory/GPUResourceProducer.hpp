@@ -23,7 +23,8 @@ namespace Memory
             SegregatedPoolsResourceAllocator* resourceAllocator,
             ResourceStateTracker* stateTracker,
             PoolDescriptorAllocator* descriptorAllocator,
-            CopyRequestManager* copyRequestManager
+            CopyRequestManager* copyRequestManager,
+            Foundation::TaskScheduler* taskScheduler
         );
 
         BufferPtr NewBuffer(const HAL::BufferProperties& properties, GPUResource::UploadStrategy uploadStrategy = GPUResource::UploadStrategy::Automatic);
@@ -47,6 +48,11 @@ namespace Memory
         PoolDescriptorAllocator* mDescriptorAllocator = nullptr;
         CopyRequestManager* mCopyRequestManager = nullptr;
         std::unordered_set<GPUResource*> mAllocatedResources;
+        ReadbackCallbackDispatcher mReadbackCallbackDispatcher;
+
+    public:
+        // Readbacks completed at the end of last frame
+        inline const auto& ReadbackStatistics() const { return mReadbackCallbackDispatcher.FrameStatistics(); }
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "ReadbackFuture.hpp"
+
+#include <algorithm>
+
+namespace Memory
+{
+
+    ReadbackCallbackDispatcher::ReadbackCallbackDispatcher(Foundation::TaskScheduler* taskScheduler)
+        : mTaskScheduler{ taskScheduler } {}
+
+    ReadbackCallbackDispatcher::~ReadbackCallbackDispatcher()
+    {
+        mTaskScheduler->Wait(mCallbackCounter);
+    }
+
+    void ReadbackCallbackDispatcher::Dispatch(Foundation::TaskScheduler::Task callback)
+    {
+        mTaskScheduler->Schedule(std::move(callback), &mCallbackCounter);
+    }
+
+    void ReadbackCallbackDispatcher::RecordCompletion(const ReadbackFuture& readback)
+    {
+        mStatistics.CompletedReadbackCount++;
+        mStatistics.MaxFrameLatency = std::max(mStatistics.MaxFrameLatency, readback.FrameLatency());
+        mStatistics.TotalFrameLatency += readback.FrameLatency();
+    }
+
+    void ReadbackCallbackDispatcher::ResetStatistics()
+    {
+        mStatistics = {};
+    }
+
+    ReadbackFuture::ReadbackFuture(SegregatedPoolsResourceAllocator::BufferPtr buffer, uint64_t requestFrameNumber)
+        : mState{ std::make_shared<State>() }
+    {
+        mState->Buffer = std::move(buffer);
+        mState->RequestFrameNumber = requestFrameNumber;
+    }
+
+    void ReadbackFuture::Complete(uint64_t frameNumber, ReadbackCallbackDispatcher* dispatcher) const
+    {
+        std::vector<CompletionCallback<uint8_t>> callbacks;
+
+        {
+            std::lock_guard lock{ mState->CallbacksMutex };
+            mState->IsReady = true;
+            mState->CompletionFrameNumber = frameNumber;
+            mState->Dispatcher = dispatcher;
+            callbacks = std::move(mState->Callbacks);
+            mState->Callbacks.clear();
+        }
+
+        dispatcher->RecordCompletion(*this);
+
+        for (CompletionCallback<uint8_t>& callback : callbacks)
+        {
+            DispatchCallback(std::move(callback));
+        }
+    }
+
+    void ReadbackFuture::DispatchCallback(CompletionCallback<uint8_t> callback) const
+    {
+        mState->Dispatcher->Dispatch([readback = *this, callback = std::move(callback)]() mutable
+        {
+            readback.InvokeCallback(callback);
+
+            // Release readback memory before the task is reported as finished,
+            // so that nothing outlives the dispatcher waiting for callbacks
+            readback = ReadbackFuture{};
+        });
+    }
+
+    void ReadbackFuture::InvokeCallback(const CompletionCallback<uint8_t>& callback) const
+    {
+        std::lock_guard lock{ mState->MappingMutex };
+        const uint8_t* mappedMemory = mState->Buffer->Map();
+        callback(mappedMemory, *this);
+        mState->Buffer->Unmap(); // Invalidate CPU cache before next read
+    }
+
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "SegregatedPoolsResourceAllocator.hpp"
+
+#include <Foundation/Assert.hpp>
+#include <Foundation/TaskScheduler.hpp>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Memory
+{
+
+    class ReadbackFuture;
+
+    // Runs readback completion callbacks on task scheduler workers
+    // and keeps track of how many frames readbacks took to complete
+    class ReadbackCallbackDispatcher
+    {
+    public:
+        struct Statistics
+        {
+            uint64_t CompletedReadbackCount = 0;
+            uint64_t MaxFrameLatency = 0;
+            uint64_t TotalFrameLatency = 0;
+
+            inline float AverageFrameLatency() const { return CompletedReadbackCount ? float(TotalFrameLatency) / CompletedReadbackCount : 0.0f; }
+        };
+
+        ReadbackCallbackDispatcher(Foundation::TaskScheduler* taskScheduler);
+
+        // Callbacks reference readback memory, so they are waited for before resources can go away
+        ~ReadbackCallbackDispatcher();
+
+        void Dispatch(Foundation::TaskScheduler::Task callback);
+        void RecordCompletion(const ReadbackFuture& readback);
+        void ResetStatistics();
+
+    private:
+        Foundation::TaskScheduler* mTaskScheduler = nullptr;
+        Foundation::TaskCounter mCallbackCounter;
+        Statistics mStatistics;
+
+    public:
+        inline const Statistics& FrameStatistics() const { return mStatistics; }
+    };
+
+    // Handle to data of a readback requested in a certain frame.
+    // Readback completes at the end of the first frame that observes the fence of the request frame as passed.
+    // Copies of a handle share the same readback.
+    class ReadbackFuture
+    {
+    public:
+        template <class T>
+        using CompletionCallback = std::function<void(const T* data, const ReadbackFuture& readback)>;
+
+        template <class T>
+        using ReadbackSession = std::function<void(const T*)>;
+
+        ReadbackFuture() = default;
+
+        // Callback is executed by a task scheduler worker once readback completes, or right away when it already has.
+        // Callbacks of one readback don't overlap, but they run concurrently with the frame loop.
+        template <class T = uint8_t>
+        void OnCompletion(const CompletionCallback<T>& callback) const;
+
+        // Session receives nullptr until readback completes
+        template <class T = uint8_t>
+        void Read(const ReadbackSession<T>& session) const;
+
+    private:
+        friend class GPUResource;
+
+        struct State
+        {
+            SegregatedPoolsResourceAllocator::BufferPtr Buffer;
+            uint64_t RequestFrameNumber = 0;
+            uint64_t CompletionFrameNumber = 0;
+            bool IsReady = false;
+            ReadbackCallbackDispatcher* Dispatcher = nullptr;
+            std::vector<CompletionCallback<uint8_t>> Callbacks;
+
+            // Guards readiness and callback list
+            std::mutex CallbacksMutex;
+
+            // Buffer mapping isn't thread safe, while callbacks and reads may come from different threads
+            std::mutex MappingMutex;
+        };
+
+        ReadbackFuture(SegregatedPoolsResourceAllocator::BufferPtr buffer, uint64_t requestFrameNumber);
+
+        void Complete(uint64_t frameNumber, ReadbackCallbackDispatcher* dispatcher) const;
+        void DispatchCallback(CompletionCallback<uint8_t> callback) const;
+        void InvokeCallback(const CompletionCallback<uint8_t>& callback) const;
+
+        std::shared_ptr<State> mState;
+
+    public:
+        inline bool IsValid() const { return mState != nullptr; }
+        inline bool IsReady() const { return mState && mState->IsReady; }
+        inline auto RequestFrameNumber() const { return mState->RequestFrameNumber; }
+        inline auto CompletionFrameNumber() const { return mState->CompletionFrameNumber; }
+        // Number of frames between request and availability of data on CPU
+        inline auto FrameLatency() const { return mState->CompletionFrameNumber - mState->RequestFrameNumber; }
+        inline HAL::Buffer* ReadbackBuffer() const { return mState ? mState->Buffer.get() : nullptr; }
+    };
+
+}
+
+#include "ReadbackFuture.inl"
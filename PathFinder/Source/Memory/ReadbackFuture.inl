@@ -0,0 +1,42 @@
+namespace Memory
+{
+
+    template <class T>
+    void ReadbackFuture::OnCompletion(const CompletionCallback<T>& callback) const
+    {
+        assert_format(IsValid(), "Readback was never requested");
+
+        CompletionCallback<uint8_t> byteCallback = [callback](const uint8_t* data, const ReadbackFuture& readback)
+        {
+            callback(reinterpret_cast<const T*>(data), readback);
+        };
+
+        {
+            std::lock_guard lock{ mState->CallbacksMutex };
+
+            if (!mState->IsReady)
+            {
+                mState->Callbacks.push_back(std::move(byteCallback));
+                return;
+            }
+        }
+
+        DispatchCallback(std::move(byteCallback));
+    }
+
+    template <class T>
+    void ReadbackFuture::Read(const ReadbackSession<T>& session) const
+    {
+        if (!IsReady())
+        {
+            session(nullptr);
+            return;
+        }
+
+        std::lock_guard lock{ mState->MappingMutex };
+        const T* mappedMemory = reinterpret_cast<T*>(mState->Buffer->Map());
+        session(mappedMemory);
+        mState->Buffer->Unmap(); // Invalidate CPU cache before next read
+    }
+
+}
@@ -21,6 +21,12 @@ namespace Memory
         mCurrentResourceStates.erase(resource);
     }
 
+    void ResourceStateTracker::SetCurrentStates(const HAL::Resource* resource, const SubresourceStateList& states)
+    {
+        assert_format(states.size() == resource->SubresourceCount(), "State count doesn't match subresource count");
+        mCurrentResourceStates[resource] = states;
+    }
+
     void ResourceStateTracker::RequestTransition(const HAL::Resource* resource, HAL::ResourceState newState)
     {
         SubresourceStateList& pendingStates = mPendingResourceStates[resource];
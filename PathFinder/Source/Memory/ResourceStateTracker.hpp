@@ -22,6 +22,9 @@ namespace Memory
         void StartTrakingResource(const HAL::Resource* resource);
         void StopTrakingResource(const HAL::Resource* resource);
 
+        // Overrides states of a tracked resource that was already used by GPU before tracking started
+        void SetCurrentStates(const HAL::Resource* resource, const SubresourceStateList& states);
+
         // Queue state update but wait until ApplyRequestedTransitions
         void RequestTransition(const HAL::Resource* resource, HAL::ResourceState newState);
         void RequestTransitions(const HAL::Resource* resource, const SubresourceStateList& newStates);
@@ -1,8 +1,63 @@
 #include "SegregatedPoolsResourceAllocator.hpp"
 
+#include <functional>
+#include <utility>
+
 namespace Memory
 {
 
+    namespace
+    {
+
+        uint64_t HashCombine(uint64_t seed, uint64_t value)
+        {
+            return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+        }
+
+        // Clear value is left out of hash and only taken into account on comparison
+        uint64_t TexturePropertiesHash(const HAL::TextureProperties& properties)
+        {
+            uint64_t hash = std::hash<HAL::FormatVariant>{}(properties.Format);
+            hash = HashCombine(hash, uint64_t(properties.Kind));
+            hash = HashCombine(hash, properties.Dimensions.Width);
+            hash = HashCombine(hash, properties.Dimensions.Height);
+            hash = HashCombine(hash, properties.Dimensions.Depth);
+            hash = HashCombine(hash, uint64_t(properties.InitialStateMask));
+            hash = HashCombine(hash, uint64_t(properties.ExpectedStateMask));
+            hash = HashCombine(hash, properties.MipCount);
+            return hash;
+        }
+
+        bool AreClearValuesEqual(const HAL::ClearValue& a, const HAL::ClearValue& b)
+        {
+            if (a.index() != b.index()) return false;
+
+            if (auto color = std::get_if<HAL::ColorClearValue>(&a))
+            {
+                return *color == std::get<HAL::ColorClearValue>(b);
+            }
+
+            const HAL::DepthStencilClearValue& depthStencilA = std::get<HAL::DepthStencilClearValue>(a);
+            const HAL::DepthStencilClearValue& depthStencilB = std::get<HAL::DepthStencilClearValue>(b);
+
+            return depthStencilA.Depth == depthStencilB.Depth && depthStencilA.Stencil == depthStencilB.Stencil;
+        }
+
+        bool AreTexturePropertiesEqual(const HAL::TextureProperties& a, const HAL::TextureProperties& b)
+        {
+            return a.Format == b.Format &&
+                a.Kind == b.Kind &&
+                a.Dimensions.Width == b.Dimensions.Width &&
+                a.Dimensions.Height == b.Dimensions.Height &&
+                a.Dimensions.Depth == b.Dimensions.Depth &&
+                a.InitialStateMask == b.InitialStateMask &&
+                a.ExpectedStateMask == b.ExpectedStateMask &&
+                a.MipCount == b.MipCount &&
+                AreClearValuesEqual(a.OptimizedClearValue, b.OptimizedClearValue);
+        }
+
+    }
+
     SegregatedPoolsResourceAllocator::SegregatedPoolsResourceAllocator(const HAL::Device* device, uint8_t simultaneousFramesInFlight)
         : mDevice{ device }, 
         mRingFrameTracker{ simultaneousFramesInFlight },
@@ -23,6 +78,22 @@ namespace Memory
         });
     }
 
+    SegregatedPoolsResourceAllocator::~SegregatedPoolsResourceAllocator()
+    {
+        // Allocator outlives GPU work, so textures still waiting for their frames end up in the cache
+        for (auto frameIndex = 0u; frameIndex < mPendingDeallocations.size(); ++frameIndex)
+        {
+            ExecutePendingDeallocations(frameIndex);
+        }
+
+        for (auto& [cacheKey, cached] : mTextureCache)
+        {
+            DestroyCachedTexture(cached);
+        }
+
+        mTextureCache.clear();
+    }
+
     SegregatedPoolsResourceAllocator::BufferPtr SegregatedPoolsResourceAllocator::AllocateBuffer(const HAL::BufferProperties& properties, std::optional<HAL::CPUAccessibleHeapType> heapType)
     {
         HAL::ResourceFormat format{ mDevice, properties };
@@ -47,7 +118,7 @@ namespace Memory
             auto deallocationCallback = [this, poolAllocation, poolsThatProducedAllocation = allocation.PoolsPtr](HAL::Buffer* buffer)
             {
                 // Do not pass cpu accessible resource for deallocation. We can reuse it later.
-                mPendingDeallocations[mCurrentFrameIndex].emplace_back(Deallocation{ buffer, poolAllocation, poolsThatProducedAllocation, true });
+                EnqueueDeallocation(Deallocation{ buffer, poolAllocation, poolsThatProducedAllocation, true });
             };
 
             // Create unique_ptr with already existing buffer ptr that's being reused
@@ -57,7 +128,7 @@ namespace Memory
         {
             auto deallocationCallback = [this, poolAllocation, poolsThatProducedAllocation = allocation.PoolsPtr](HAL::Buffer* buffer)
             {
-                mPendingDeallocations[mCurrentFrameIndex].emplace_back(Deallocation{ buffer, poolAllocation, poolsThatProducedAllocation, false });
+                EnqueueDeallocation(Deallocation{ buffer, poolAllocation, poolsThatProducedAllocation, false });
             };
 
             HAL::Buffer* buffer = new HAL::Buffer{ *mDevice, properties, *allocation.HeapPtr, offsetInHeap };
@@ -69,30 +140,70 @@ namespace Memory
 
     SegregatedPoolsResourceAllocator::TexturePtr SegregatedPoolsResourceAllocator::AllocateTexture(const HAL::TextureProperties& properties)
     {
+        uint64_t cacheKey = TexturePropertiesHash(properties);
+        auto [cachedBegin, cachedEnd] = mTextureCache.equal_range(cacheKey);
+
+        for (auto cachedIt = cachedBegin; cachedIt != cachedEnd; ++cachedIt)
+        {
+            CachedTexture cached = cachedIt->second;
+
+            if (AreTexturePropertiesEqual(cached.Texture->Properties(), properties))
+            {
+                mTextureCache.erase(cachedIt);
+                ++mTextureCacheHitCount;
+                return MakeCachedTexturePtr(cached.Texture, cached.Allocation, cached.PoolsThatProducedAllocation, cacheKey);
+            }
+        }
+
+        ++mTextureCacheMissCount;
+
         HAL::ResourceFormat format{ mDevice, properties };
         Allocation allocation = FindOrAllocateMostFittingFreeSlot(format.ResourceSizeInBytes(), format, std::nullopt);
-        PoolsAllocation& poolAllocation = allocation.PoolAllocation;
 
         auto offsetInHeap = AdjustMemoryOffsetToPointInsideHeap(allocation);
 
-        auto deallocationCallback = [this, poolAllocation, poolsThatProducedAllocation = allocation.PoolsPtr](HAL::Texture* texture)
+        HAL::Texture* texture = new HAL::Texture{ *mDevice, *allocation.HeapPtr, offsetInHeap, properties };
+        mTextureStates[texture];
+
+        return MakeCachedTexturePtr(texture, allocation.PoolAllocation, allocation.PoolsPtr, cacheKey);
+    }
+
+    ResourceStateTracker::SubresourceStateList SegregatedPoolsResourceAllocator::TakeRecycledTextureStates(const HAL::Texture* texture)
+    {
+        auto statesIt = mTextureStates.find(texture);
+
+        if (statesIt == mTextureStates.end())
         {
-            mPendingDeallocations[mCurrentFrameIndex].emplace_back(Deallocation{ texture, poolAllocation, poolsThatProducedAllocation, false });
-        };
+            return {};
+        }
 
-        HAL::Texture* texture = new HAL::Texture{ *mDevice, *allocation.HeapPtr, offsetInHeap, properties };
+        return std::exchange(statesIt->second, {});
+    }
 
-        return TexturePtr{ texture, deallocationCallback };
+    void SegregatedPoolsResourceAllocator::SetFinalTextureStates(const HAL::Texture* texture, const ResourceStateTracker::SubresourceStateList& states)
+    {
+        auto statesIt = mTextureStates.find(texture);
+
+        // Textures not produced by the allocator are not recycled
+        if (statesIt != mTextureStates.end())
+        {
+            statesIt->second = states;
+        }
     }
 
     void SegregatedPoolsResourceAllocator::BeginFrame(uint64_t frameNumber)
     {
+        mCurrentFrameNumber = frameNumber;
+        EvictAgedTextures();
+
+        std::lock_guard lock{ mDeallocationMutex };
         mCurrentFrameIndex = mRingFrameTracker.Allocate(1);
         mRingFrameTracker.FinishCurrentFrame(frameNumber);
     }
 
     void SegregatedPoolsResourceAllocator::EndFrame(uint64_t frameNumber)
     {
+        std::lock_guard lock{ mDeallocationMutex };
         mRingFrameTracker.ReleaseCompletedFrames(frameNumber);
     }
 
@@ -194,10 +305,35 @@ namespace Memory
         return localOffset;
     }
 
+    void SegregatedPoolsResourceAllocator::EnqueueDeallocation(Deallocation&& deallocation)
+    {
+        std::lock_guard lock{ mDeallocationMutex };
+        mPendingDeallocations[mCurrentFrameIndex].emplace_back(std::move(deallocation));
+    }
+
     void SegregatedPoolsResourceAllocator::ExecutePendingDeallocations(uint64_t frameIndex)
     {
         for (Deallocation& deallocation : mPendingDeallocations[frameIndex])
         {
+            // Texture with unknown states can't be safely handed to a tracked user
+            if (deallocation.TextureCacheKey && mTextureStates[static_cast<const HAL::Texture*>(deallocation.Resource)].empty())
+            {
+                mTextureStates.erase(static_cast<const HAL::Texture*>(deallocation.Resource));
+                deallocation.ResourceWillBeReused = false;
+                deallocation.TextureCacheKey = std::nullopt;
+            }
+
+            // GPU is done with the texture, it can be handed out again
+            if (deallocation.TextureCacheKey)
+            {
+                deallocation.Resource->SetDebugName("Resource Allocator Cached Texture");
+
+                mTextureCache.emplace(*deallocation.TextureCacheKey, CachedTexture{
+                    static_cast<HAL::Texture*>(deallocation.Resource), deallocation.Allocation, deallocation.PoolsThatProducedAllocation, mCurrentFrameNumber });
+
+                continue;
+            }
+
             if (!deallocation.ResourceWillBeReused)
             {
                 delete deallocation.Resource;
@@ -212,4 +348,40 @@ namespace Memory
         mPendingDeallocations[frameIndex].clear();
     }
 
+    void SegregatedPoolsResourceAllocator::EvictAgedTextures()
+    {
+        for (auto cachedIt = mTextureCache.begin(); cachedIt != mTextureCache.end();)
+        {
+            CachedTexture& cached = cachedIt->second;
+
+            if (mCurrentFrameNumber - cached.ReleaseFrameNumber <= mMaxCachedTextureAge)
+            {
+                ++cachedIt;
+                continue;
+            }
+
+            DestroyCachedTexture(cached);
+            cachedIt = mTextureCache.erase(cachedIt);
+        }
+    }
+
+    void SegregatedPoolsResourceAllocator::DestroyCachedTexture(const CachedTexture& cached)
+    {
+        mTextureStates.erase(cached.Texture);
+        delete cached.Texture;
+        cached.PoolsThatProducedAllocation->Deallocate(cached.Allocation);
+    }
+
+    SegregatedPoolsResourceAllocator::TexturePtr SegregatedPoolsResourceAllocator::MakeCachedTexturePtr(
+        HAL::Texture* texture, const PoolsAllocation& allocation, Pools* pools, uint64_t cacheKey)
+    {
+        auto deallocationCallback = [this, allocation, pools, cacheKey](HAL::Texture* texture)
+        {
+            // Keep pool slot occupied, texture will go to the cache when frames in flight are done with it
+            EnqueueDeallocation(Deallocation{ texture, allocation, pools, true, cacheKey });
+        };
+
+        return TexturePtr{ texture, deallocationCallback };
+    }
+
 }
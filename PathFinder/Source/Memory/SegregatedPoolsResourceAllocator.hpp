@@ -2,6 +2,7 @@
 
 #include "SegregatedPools.hpp"
 #include "Ring.hpp"
+#include "ResourceStateTracker.hpp"
 
 #include <HardwareAbstractionLayer/Device.hpp>
 #include <HardwareAbstractionLayer/Heap.hpp>
@@ -9,7 +10,9 @@
 #include <HardwareAbstractionLayer/Texture.hpp>
 
 #include <memory>
+#include <mutex>
 #include <vector>
+#include <unordered_map>
 
 namespace Memory
 {
@@ -21,10 +24,18 @@ namespace Memory
         using TexturePtr = std::unique_ptr<HAL::Texture, std::function<void(HAL::Texture*)>>;
 
         SegregatedPoolsResourceAllocator(const HAL::Device* device, uint8_t simultaneousFramesInFlight);
+        ~SegregatedPoolsResourceAllocator();
 
         BufferPtr AllocateBuffer(const HAL::BufferProperties& properties, std::optional<HAL::CPUAccessibleHeapType> heapType = std::nullopt);
+        // Released textures are cached and handed out again for requests with identical properties
         TexturePtr AllocateTexture(const HAL::TextureProperties& properties);
 
+        // Recycled textures are left in states set by their previous user, which state tracking has to pick up.
+        // Returns empty list for textures that were created anew. States are reset on take, so a texture
+        // whose final states are not reported back by its user is destroyed instead of being cached.
+        ResourceStateTracker::SubresourceStateList TakeRecycledTextureStates(const HAL::Texture* texture);
+        void SetFinalTextureStates(const HAL::Texture* texture, const ResourceStateTracker::SubresourceStateList& states);
+
         void BeginFrame(uint64_t frameNumber);
         void EndFrame(uint64_t frameNumber);
 
@@ -38,7 +49,7 @@ namespace Memory
 
             // We only store buffers inside pool slots
             // to keep them alive and reuse on new buffer allocation requests.
-            // Textures are recreated on each allocation request and not stored here.
+            // Textures are cached separately, by their properties rather than slot size.
             // Manually managed.
             HAL::Buffer* Buffer = nullptr;
         };
@@ -66,15 +77,30 @@ namespace Memory
             PoolsAllocation Allocation;
             Pools* PoolsThatProducedAllocation;
             bool ResourceWillBeReused = false;
+            std::optional<uint64_t> TextureCacheKey = std::nullopt;
         };
 
+        struct CachedTexture
+        {
+            HAL::Texture* Texture = nullptr;
+            PoolsAllocation Allocation;
+            Pools* PoolsThatProducedAllocation;
+            uint64_t ReleaseFrameNumber = 0;
+        };
+
+        using TextureCache = std::unordered_multimap<uint64_t, CachedTexture>;
+
         Allocation FindOrAllocateMostFittingFreeSlot(
             uint64_t allocationSizeInBytes, 
             const HAL::ResourceFormat& resourceFormat, 
             std::optional<HAL::CPUAccessibleHeapType> cpuHeapType);
 
         uint64_t AdjustMemoryOffsetToPointInsideHeap(const SegregatedPoolsResourceAllocator::Allocation& allocation);
+        void EnqueueDeallocation(Deallocation&& deallocation);
         void ExecutePendingDeallocations(uint64_t frameIndex);
+        void EvictAgedTextures();
+        void DestroyCachedTexture(const CachedTexture& cached);
+        TexturePtr MakeCachedTexturePtr(HAL::Texture* texture, const PoolsAllocation& allocation, Pools* pools, uint64_t cacheKey);
 
         const HAL::Device* mDevice = nullptr;
 
@@ -82,6 +108,10 @@ namespace Memory
 
         uint8_t mSimultaneousFramesInFlight;
         uint64_t mCurrentFrameIndex = 0;
+        uint64_t mCurrentFrameNumber = 0;
+
+        // Cached textures not requested for this many frames are destroyed
+        uint64_t mMaxCachedTextureAge = 120;
 
         // Minimum allocation size
         uint64_t mMinimumSlotSize = 65536;
@@ -111,6 +141,23 @@ namespace Memory
         std::vector<HeapList> mDefaultNonRTDSHeapLists;
         
         std::vector<std::vector<Deallocation>> mPendingDeallocations;
+
+        // Resources can be released from task scheduler workers, e.g. by readback callbacks
+        std::mutex mDeallocationMutex;
+
+        // Released textures keyed by properties hash
+        TextureCache mTextureCache;
+
+        // States of textures produced by the allocator, left by their last user. Empty for new textures.
+        std::unordered_map<const HAL::Texture*, ResourceStateTracker::SubresourceStateList> mTextureStates;
+
+        uint64_t mTextureCacheHitCount = 0;
+        uint64_t mTextureCacheMissCount = 0;
+
+    public:
+        inline auto TextureCacheHitCount() const { return mTextureCacheHitCount; }
+        inline auto TextureCacheMissCount() const { return mTextureCacheMissCount; }
+        inline auto CachedTextureCount() const { return mTextureCache.size(); }
     };
 
 }
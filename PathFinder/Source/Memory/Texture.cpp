@@ -15,7 +15,19 @@ namespace Memory
         mTexturePtr{ resourceAllocator->AllocateTexture(properties) },
         mProperties{ properties }
     {
-        if (mStateTracker) mStateTracker->StartTrakingResource(mTexturePtr.get());
+        // Recycled texture stays in states it was left in by previous user
+        ResourceStateTracker::SubresourceStateList recycledStates = resourceAllocator->TakeRecycledTextureStates(mTexturePtr.get());
+
+        if (mStateTracker)
+        {
+            mStateTracker->StartTrakingResource(mTexturePtr.get());
+
+            if (!recycledStates.empty())
+            {
+                mStateTracker->SetCurrentStates(mTexturePtr.get(), recycledStates);
+            }
+        }
+
         ReserveDiscriptorArrays(properties.MipCount);
     }
 
@@ -62,7 +74,11 @@ namespace Memory
 
     Texture::~Texture()
     {
-        if (mStateTracker) mStateTracker->StopTrakingResource(mTexturePtr.get());
+        if (mStateTracker)
+        {
+            if (mResourceAllocator) mResourceAllocator->SetFinalTextureStates(mTexturePtr.get(), mStateTracker->ResourceCurrentStates(mTexturePtr.get()));
+            mStateTracker->StopTrakingResource(mTexturePtr.get());
+        }
     }
 
     const HAL::RTDescriptor* Texture::GetRTDescriptor(uint8_t mipLevel) const
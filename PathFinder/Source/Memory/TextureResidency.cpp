@@ -0,0 +1,221 @@
+#include "TextureResidency.hpp"
+
+#include <Foundation/Assert.hpp>
+
+#include <algorithm>
+
+namespace Memory
+{
+
+    TextureResidency::TextureResidency(uint64_t memoryBudget)
+        : mMemoryBudget{ memoryBudget } {}
+
+    TextureResidency::TextureID TextureResidency::Register(const std::vector<uint64_t>& mipSizes, uint32_t pinnedMipCount, uint32_t mostDetailedResidentMip)
+    {
+        assert_format(!mipSizes.empty(), "Texture must have at least one mip");
+
+        TextureID texture = 0;
+
+        if (!mFreeIDs.empty())
+        {
+            texture = mFreeIDs.back();
+            mFreeIDs.pop_back();
+        }
+        else
+        {
+            texture = mPageTables.size();
+            mPageTables.emplace_back();
+        }
+
+        uint32_t mipCount = mipSizes.size();
+        pinnedMipCount = std::clamp(pinnedMipCount, 1u, mipCount);
+
+        PageTable& table = mPageTables[texture];
+        table = PageTable{};
+        table.IsRegistered = true;
+        table.Mips.resize(mipCount);
+        table.MostDetailedResidentMip = mipCount;
+
+        for (auto mip = 0u; mip < mipCount; ++mip)
+        {
+            table.Mips[mip].Size = mipSizes[mip];
+            table.Mips[mip].IsPinned = mip >= mipCount - pinnedMipCount;
+        }
+
+        // Pinned mips are always resident. Making pages resident coarse to fine keeps the chain contiguous.
+        mostDetailedResidentMip = std::min(mostDetailedResidentMip, mipCount - pinnedMipCount);
+
+        for (auto mip = int64_t(mipCount) - 1; mip >= int64_t(mostDetailedResidentMip); --mip)
+        {
+            MakeResident(texture, mip);
+        }
+
+        // Caller already knows the initial state
+        table.IsChanged = false;
+
+        return texture;
+    }
+
+    void TextureResidency::Unregister(TextureID texture)
+    {
+        PageTable& table = mPageTables[texture];
+
+        assert_format(table.IsRegistered, "Texture is not registered");
+
+        for (Page& page : table.Mips)
+        {
+            if (!page.IsResident) continue;
+
+            if (!page.IsPinned) mLRU.erase(page.LRUPosition);
+            mResidentBytes -= page.Size;
+        }
+
+        table = PageTable{};
+        mFreeIDs.push_back(texture);
+    }
+
+    void TextureResidency::ReportUsage(TextureID texture, uint32_t desiredMip)
+    {
+        PageTable& table = mPageTables[texture];
+        desiredMip = std::min<uint32_t>(desiredMip, table.Mips.size() - 1);
+        table.DesiredMip = std::min(table.DesiredMip, desiredMip);
+
+        // Sampling a mip may touch every coarser one through filtering
+        for (auto mip = std::max(desiredMip, table.MostDetailedResidentMip); mip < table.Mips.size(); ++mip)
+        {
+            Touch(texture, mip);
+        }
+    }
+
+    std::vector<TextureResidency::ResidencyChange> TextureResidency::Update()
+    {
+        std::vector<TextureID> streamingCandidates;
+
+        for (auto texture = 0u; texture < mPageTables.size(); ++texture)
+        {
+            const PageTable& table = mPageTables[texture];
+
+            if (table.IsRegistered && table.DesiredMip < table.MostDetailedResidentMip)
+            {
+                streamingCandidates.push_back(texture);
+            }
+        }
+
+        // Textures furthest from their desired detail are served first
+        std::sort(streamingCandidates.begin(), streamingCandidates.end(), [this](TextureID a, TextureID b)
+        {
+            return mPageTables[a].MostDetailedResidentMip - mPageTables[a].DesiredMip >
+                mPageTables[b].MostDetailedResidentMip - mPageTables[b].DesiredMip;
+        });
+
+        for (TextureID texture : streamingCandidates)
+        {
+            PageTable& table = mPageTables[texture];
+            uint32_t mip = table.MostDetailedResidentMip - 1;
+            uint64_t size = table.Mips[mip].Size;
+
+            // Only pages not needed by the current frame make room for streamed ones
+            bool hasRoom = true;
+
+            while (mResidentBytes + size > mMemoryBudget && hasRoom)
+            {
+                hasRoom = EvictLeastRecentlyUsed(false);
+            }
+
+            if (hasRoom)
+            {
+                MakeResident(texture, mip);
+                Touch(texture, mip);
+            }
+        }
+
+        // Budget could have been lowered or exceeded by textures registered fully resident
+        while (mResidentBytes > mMemoryBudget && EvictLeastRecentlyUsed(false)) {}
+        while (mResidentBytes > mMemoryBudget && EvictLeastRecentlyUsed(true)) {}
+
+        std::vector<ResidencyChange> changes;
+
+        for (auto texture = 0u; texture < mPageTables.size(); ++texture)
+        {
+            PageTable& table = mPageTables[texture];
+
+            if (table.IsChanged)
+            {
+                changes.push_back({ texture, table.MostDetailedResidentMip });
+            }
+
+            table.IsChanged = false;
+            table.DesiredMip = NoDesiredMip;
+        }
+
+        ++mFrameNumber;
+
+        return changes;
+    }
+
+    void TextureResidency::SetMemoryBudget(uint64_t budget)
+    {
+        mMemoryBudget = budget;
+    }
+
+    void TextureResidency::MakeResident(TextureID texture, uint32_t mip)
+    {
+        PageTable& table = mPageTables[texture];
+        Page& page = table.Mips[mip];
+
+        assert_format(mip + 1 == table.MostDetailedResidentMip, "Resident mips must form a contiguous mip chain tail");
+
+        page.IsResident = true;
+        mResidentBytes += page.Size;
+        table.MostDetailedResidentMip = mip;
+        table.IsChanged = true;
+
+        if (!page.IsPinned)
+        {
+            page.LRUPosition = mLRU.insert(mLRU.end(), PageKey{ texture, mip });
+        }
+    }
+
+    void TextureResidency::Touch(TextureID texture, uint32_t mip)
+    {
+        Page& page = mPageTables[texture].Mips[mip];
+
+        if (!page.IsResident) return;
+
+        page.LastUsedFrame = mFrameNumber;
+
+        if (!page.IsPinned)
+        {
+            mLRU.splice(mLRU.end(), mLRU, page.LRUPosition);
+        }
+    }
+
+    bool TextureResidency::EvictLeastRecentlyUsed(bool allowCurrentFrameEviction)
+    {
+        if (mLRU.empty())
+        {
+            return false;
+        }
+
+        TextureID texture = mLRU.front().Texture;
+        PageTable& table = mPageTables[texture];
+
+        // Coarser mips may end up older in the list than finer ones, but only the most detailed one can go
+        uint32_t mip = table.MostDetailedResidentMip;
+        Page& page = table.Mips[mip];
+
+        if (!allowCurrentFrameEviction && table.Mips[mLRU.front().Mip].LastUsedFrame >= mFrameNumber)
+        {
+            return false;
+        }
+
+        mLRU.erase(page.LRUPosition);
+        mResidentBytes -= page.Size;
+        page.IsResident = false;
+        table.MostDetailedResidentMip = mip + 1;
+        table.IsChanged = true;
+
+        return true;
+    }
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+#include <list>
+#include <cstdint>
+
+namespace Memory
+{
+
+    // Decides which mip levels of streamed textures stay resident within a memory budget.
+    // Every mip is a page of its texture's page table. Pages are evicted in least recently used order,
+    // most detailed ones first, so that resident mips always form a contiguous tail of a mip chain.
+    // No GPU work is done here: usage can come from CPU heuristics or GPU feedback alike.
+    class TextureResidency
+    {
+    public:
+        using TextureID = uint32_t;
+
+        struct ResidencyChange
+        {
+            TextureID Texture;
+            uint32_t MostDetailedResidentMip;
+        };
+
+        TextureResidency(uint64_t memoryBudget);
+
+        // Coarsest pinned mips are never evicted
+        TextureID Register(const std::vector<uint64_t>& mipSizes, uint32_t pinnedMipCount, uint32_t mostDetailedResidentMip = 0);
+        void Unregister(TextureID texture);
+
+        // Records that texture is sampled at the given mip during the current frame
+        void ReportUsage(TextureID texture, uint32_t desiredMip);
+
+        // Streams in requested mips one level per frame and evicts least recently used ones to stay within budget.
+        // Returns textures whose resident mip range changed and advances to the next frame.
+        std::vector<ResidencyChange> Update();
+
+        void SetMemoryBudget(uint64_t budget);
+
+    private:
+        struct PageKey
+        {
+            TextureID Texture;
+            uint32_t Mip;
+        };
+
+        using LRUList = std::list<PageKey>;
+
+        struct Page
+        {
+            uint64_t Size = 0;
+            uint64_t LastUsedFrame = 0;
+            bool IsResident = false;
+            bool IsPinned = false;
+            LRUList::iterator LRUPosition;
+        };
+
+        struct PageTable
+        {
+            std::vector<Page> Mips;
+            uint32_t MostDetailedResidentMip = 0;
+            uint32_t DesiredMip = NoDesiredMip;
+            bool IsRegistered = false;
+            bool IsChanged = false;
+        };
+
+        inline static const uint32_t NoDesiredMip = ~0u;
+
+        void MakeResident(TextureID texture, uint32_t mip);
+        void Touch(TextureID texture, uint32_t mip);
+        // Evicts most detailed mip of the least recently used texture, optionally skipping textures used this frame
+        bool EvictLeastRecentlyUsed(bool allowCurrentFrameEviction);
+
+        std::vector<PageTable> mPageTables;
+        std::vector<TextureID> mFreeIDs;
+
+        // Front holds least recently used pages
+        LRUList mLRU;
+
+        uint64_t mMemoryBudget = 0;
+        uint64_t mResidentBytes = 0;
+        uint64_t mFrameNumber = 1;
+
+    public:
+        inline auto MemoryBudget() const { return mMemoryBudget; }
+        inline auto ResidentBytes() const { return mResidentBytes; }
+        inline auto MostDetailedResidentMip(TextureID texture) const { return mPageTables[texture].MostDetailedResidentMip; }
+        inline auto MipCount(TextureID texture) const { return uint32_t(mPageTables[texture].Mips.size()); }
+    };
+
+}
@@ -0,0 +1,47 @@
+#include "BarrierBatcher.hpp"
+
+namespace PathFinder
+{
+
+    float BarrierBatcher::Statistics::SplitRatio() const
+    {
+        uint64_t transitionCount = SplitBarrierCount + FullTransitionCount;
+        return transitionCount > 0 ? float(SplitBarrierCount) / transitionCount : 0.0f;
+    }
+
+    void BarrierBatcher::ResetStatistics()
+    {
+        mSubmittedBarrierCount = 0;
+        mSplitBarrierCount = 0;
+        mFullTransitionCount = 0;
+        mEliminatedBarrierCount = 0;
+    }
+
+    void BarrierBatcher::Submit(HAL::ResourceBarrierCollection& barriers, HAL::CopyCommandListBase& commandList)
+    {
+        mEliminatedBarrierCount += barriers.Optimize();
+        Account(barriers);
+        commandList.InsertBarriers(barriers);
+    }
+
+    void BarrierBatcher::Account(const HAL::ResourceBarrierCollection& barriers)
+    {
+        HAL::ResourceBarrierCollection::Composition composition = barriers.GetComposition();
+
+        mSubmittedBarrierCount += barriers.BarrierCount();
+        // Split pair is accounted once, when its beginning is submitted
+        mSplitBarrierCount += composition.SplitBeginCount;
+        mFullTransitionCount += composition.TransitionCount;
+    }
+
+    BarrierBatcher::Statistics BarrierBatcher::FrameStatistics() const
+    {
+        Statistics statistics{};
+        statistics.SubmittedBarrierCount = mSubmittedBarrierCount;
+        statistics.SplitBarrierCount = mSplitBarrierCount;
+        statistics.FullTransitionCount = mFullTransitionCount;
+        statistics.EliminatedBarrierCount = mEliminatedBarrierCount;
+        return statistics;
+    }
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <HardwareAbstractionLayer/ResourceBarrier.hpp>
+#include <HardwareAbstractionLayer/CommandList.hpp>
+
+#include <atomic>
+
+namespace PathFinder
+{
+
+    // Emits barrier collections gathered for a submission point as single optimized batches
+    // and accumulates frame statistics, since every barrier is potential GPU idle time
+    class BarrierBatcher
+    {
+    public:
+        struct Statistics
+        {
+            uint64_t SubmittedBarrierCount = 0;
+            uint64_t SplitBarrierCount = 0;
+            uint64_t FullTransitionCount = 0;
+            uint64_t EliminatedBarrierCount = 0;
+
+            // Portion of transitions that were issued as split barriers
+            float SplitRatio() const;
+        };
+
+        void ResetStatistics();
+
+        // Optimizes barriers and inserts them into command list in one call
+        void Submit(HAL::ResourceBarrierCollection& barriers, HAL::CopyCommandListBase& commandList);
+
+        // Accounts for barriers that are recorded outside of the batcher, e.g. UAV barriers between draws
+        void Account(const HAL::ResourceBarrierCollection& barriers);
+
+        Statistics FrameStatistics() const;
+
+    private:
+        // Submissions may come from multiple recording threads
+        std::atomic<uint64_t> mSubmittedBarrierCount = 0;
+        std::atomic<uint64_t> mSplitBarrierCount = 0;
+        std::atomic<uint64_t> mFullTransitionCount = 0;
+        std::atomic<uint64_t> mEliminatedBarrierCount = 0;
+    };
+
+}
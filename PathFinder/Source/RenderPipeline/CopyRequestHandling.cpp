@@ -46,6 +46,37 @@ namespace PathFinder
         copyManager.FlushUploadRequests();
     }
 
+    AsyncUploadBatch RecordAsyncUploadRequests(
+        HAL::CopyCommandListBase& copyCmdList, 
+        HAL::CopyCommandListBase& preparationCmdList, 
+        Memory::ResourceStateTracker& stateTracker, 
+        Memory::CopyRequestManager& copyManager)
+    {
+        AsyncUploadBatch batch{};
+        HAL::ResourceBarrierCollection preparationBarriers{};
+
+        for (const Memory::CopyRequestManager::CopyRequest& copyRequest : copyManager.UploadRequests())
+        {
+            // Copy queue implicitly promotes resources in Common state to copy destination 
+            // and decays them back to Common after execution, so tracked states remain valid.
+            // Resources left in other states by previous frames are returned to Common on graphics queue first.
+            HAL::ResourceBarrierCollection barriers = stateTracker.TransitionToStateImmediately(copyRequest.Resource, HAL::ResourceState::Common);
+
+            // Earlier GPU work may still read resources that were uploaded to before,
+            // so copy queue has to be ordered after graphics queue for them
+            batch.RequiresGraphicsQueueSync = batch.RequiresGraphicsQueueSync || !copyRequest.IsInitialUpload || barriers.BarrierCount() > 0;
+
+            preparationBarriers.AddBarriers(barriers);
+            copyRequest.Command(copyCmdList);
+            batch.UploadedResources.push_back(copyRequest.Resource);
+        }
+
+        preparationCmdList.InsertBarriers(preparationBarriers);
+        copyManager.FlushUploadRequests();
+
+        return batch;
+    }
+
     void RecordReadbackRequests(HAL::CopyCommandListBase& cmdList, Memory::ResourceStateTracker& stateTracker, Memory::CopyRequestManager& copyManager, bool applyBackTransition)
     {
         RecordCopyRequests(cmdList, stateTracker, copyManager.ReadbackRequests(), HAL::ResourceState::CopySource, applyBackTransition);
@@ -7,6 +7,20 @@ namespace PathFinder
 {
 
     void RecordUploadRequests(HAL::CopyCommandListBase& cmdList, Memory::ResourceStateTracker& stateTracker, Memory::CopyRequestManager& copyManager, bool applyBackTransition);
+
+    struct AsyncUploadBatch
+    {
+        std::vector<const HAL::Resource*> UploadedResources;
+
+        // Copy queue must wait for graphics queue to execute preparation command list
+        // and to finish reading resources that are uploaded to again
+        bool RequiresGraphicsQueueSync = false;
+    };
+
+    // Records all upload requests into copy queue command list and removes them from the manager.
+    // Transitions of resources into Common state, which copy queue can write, are recorded into preparation command list.
+    AsyncUploadBatch RecordAsyncUploadRequests(HAL::CopyCommandListBase& copyCmdList, HAL::CopyCommandListBase& preparationCmdList, Memory::ResourceStateTracker& stateTracker, Memory::CopyRequestManager& copyManager);
+
     void RecordReadbackRequests(HAL::CopyCommandListBase& cmdList, Memory::ResourceStateTracker& stateTracker, Memory::CopyRequestManager& copyManager, bool applyBackTransition);
 
 }
@@ -15,7 +15,7 @@ namespace PathFinder
             glm::vec3{-0.5f, -0.5f, 0.0f}, glm::vec3{-0.5f, 0.5f, 0.0f}, glm::vec3{0.5f, 0.5f, 0.0f}, glm::vec3{0.5f, -0.5f, 0.0f} 
         };
 
-        inline static const std::array<uint32_t, 6> UnitQuadIndices{ 0, 1, 2, 2, 3, 4 };
+        inline static const std::array<uint32_t, 6> UnitQuadIndices{ 0, 1, 2, 0, 2, 3 };
 
         inline static const DrawablePrimitive& Quad()
         {
@@ -0,0 +1,315 @@
+#include "FrameProfiler.hpp"
+
+#include <Foundation/StringUtils.hpp>
+
+#include <optick/optick.h>
+#include <fstream>
+#include <limits>
+#include <algorithm>
+#include <windows.h>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+
+        std::string EscapeJSONString(const std::string& string)
+        {
+            std::string escaped;
+            escaped.reserve(string.size());
+
+            for (char character : string)
+            {
+                switch (character)
+                {
+                case '"': escaped += "\\\""; break;
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n"; break;
+                case '\r': escaped += "\\r"; break;
+                case '\t': escaped += "\\t"; break;
+                default:
+                    // Remaining control characters are not allowed in JSON strings unescaped
+                    if (uint8_t(character) < 0x20) escaped += StringFormat("\\u%04x", uint32_t(character));
+                    else escaped += character;
+                    break;
+                }
+            }
+
+            return escaped;
+        }
+
+    }
+
+    FrameProfiler::CPUScope::CPUScope(FrameProfiler* profiler, const std::string& name)
+        : mProfiler{ profiler }
+    {
+        mProfiler->BeginCPUScope(name);
+    }
+
+    FrameProfiler::CPUScope::~CPUScope()
+    {
+        mProfiler->EndCPUScope();
+    }
+
+    FrameProfiler::FrameProfiler(const HAL::Device& device, uint8_t simultaneousFramesInFlight, uint64_t historyLength)
+        : mQueryHeap{ device, HAL::QueryHeapType::Timestamp, MaxQueriesPerFrame * simultaneousFramesInFlight },
+        mReadbackHeap{ device, sizeof(uint64_t) * MaxQueriesPerFrame * simultaneousFramesInFlight, HAL::HeapAliasingGroup::Buffers, HAL::CPUAccessibleHeapType::Readback },
+        mReadbackBuffer{ device, HAL::BufferProperties::Create<uint64_t>(MaxQueriesPerFrame * simultaneousFramesInFlight), mReadbackHeap, 0 },
+        mFrameSlots(simultaneousFramesInFlight),
+        mHistoryLength{ historyLength }
+    {
+        mQueryHeap.SetDebugName("Frame Profiler Timestamp Query Heap");
+        mReadbackBuffer.SetDebugName("Frame Profiler Timestamp Readback Buffer");
+
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        mCPUFrequency = frequency.QuadPart;
+        mCreationTimestamp = CPUTimestamp();
+    }
+
+    void FrameProfiler::BeginFrame(uint64_t frameNumber)
+    {
+        mCurrentSlotIndex = frameNumber % mFrameSlots.size();
+
+        FrameSlot& slot = mFrameSlots[mCurrentSlotIndex];
+
+        // Frame fence guarantees that frame previously occupying this slot is completed and harvested
+        assert_format(!slot.IsPending, "Profiler frame slot is reused before its GPU data was harvested");
+
+        slot.Timing = FrameTiming{};
+        slot.Timing.FrameNumber = frameNumber;
+        slot.CPUStartTimestamp = CPUTimestamp();
+        slot.Timing.StartMS = CPUTicksToMS(slot.CPUStartTimestamp - mCreationTimestamp);
+        slot.Passes.clear();
+        slot.IsPending = true;
+        slot.IsCPUWorkFinished = false;
+
+        mOpenCPUScopes.clear();
+    }
+
+    void FrameProfiler::EndFrame(uint64_t completedFrameNumber)
+    {
+        FrameSlot& currentSlot = mFrameSlots[mCurrentSlotIndex];
+        currentSlot.Timing.CPUDurationMS = CPUTicksToMS(CPUTimestamp() - currentSlot.CPUStartTimestamp);
+        currentSlot.IsCPUWorkFinished = true;
+
+        const uint64_t* timestamps = reinterpret_cast<const uint64_t*>(mReadbackBuffer.Map());
+
+        // Harvest in frame order so that history stays sorted
+        for (;;)
+        {
+            FrameSlot* oldestCompletedSlot = nullptr;
+
+            for (FrameSlot& slot : mFrameSlots)
+            {
+                if (!slot.IsPending || !slot.IsCPUWorkFinished || slot.Timing.FrameNumber > completedFrameNumber)
+                    continue;
+
+                if (!oldestCompletedSlot || slot.Timing.FrameNumber < oldestCompletedSlot->Timing.FrameNumber)
+                    oldestCompletedSlot = &slot;
+            }
+
+            if (!oldestCompletedSlot)
+                break;
+
+            HarvestSlot(*oldestCompletedSlot, timestamps);
+        }
+    }
+
+    void FrameProfiler::BeginCPUScope(const std::string& name)
+    {
+        OPTICK_PUSH_DYNAMIC(name.c_str());
+
+        FrameSlot& slot = mFrameSlots[mCurrentSlotIndex];
+        CPUScopeTiming& timing = slot.Timing.CPUScopes.emplace_back();
+        timing.Name = name;
+        timing.Depth = mOpenCPUScopes.size();
+        timing.StartMS = CPUTicksToMS(CPUTimestamp() - slot.CPUStartTimestamp);
+
+        mOpenCPUScopes.push_back(slot.Timing.CPUScopes.size() - 1);
+    }
+
+    void FrameProfiler::EndCPUScope()
+    {
+        assert_format(!mOpenCPUScopes.empty(), "No CPU scope to end");
+
+        FrameSlot& slot = mFrameSlots[mCurrentSlotIndex];
+        slot.Timing.CPUScopes[mOpenCPUScopes.back()].EndMS = CPUTicksToMS(CPUTimestamp() - slot.CPUStartTimestamp);
+        mOpenCPUScopes.pop_back();
+
+        OPTICK_POP();
+    }
+
+    void FrameProfiler::SetFenceWaitTime(double milliseconds)
+    {
+        mFrameSlots[mCurrentSlotIndex].Timing.FenceWaitMS = milliseconds;
+    }
+
+    void FrameProfiler::SetBarrierStatistics(const BarrierBatcher::Statistics& statistics)
+    {
+        mFrameSlots[mCurrentSlotIndex].Timing.Barriers = statistics;
+    }
+
+    void FrameProfiler::SetReadbackStatistics(const Memory::ReadbackCallbackDispatcher::Statistics& statistics)
+    {
+        mFrameSlots[mCurrentSlotIndex].Timing.Readbacks = statistics;
+    }
+
+    void FrameProfiler::SetPassCount(uint64_t passCount)
+    {
+        assert_format(passCount * 2 <= MaxQueriesPerFrame, "Render graph has more passes than profiler can track");
+
+        // Resized upfront so that passes could be recorded from multiple threads
+        mFrameSlots[mCurrentSlotIndex].Passes.resize(passCount);
+    }
+
+    void FrameProfiler::CalibrateQueue(uint64_t queueIndex, const HAL::CommandQueue& queue)
+    {
+        FrameSlot& slot = mFrameSlots[mCurrentSlotIndex];
+
+        if (slot.Calibrations.size() <= queueIndex)
+        {
+            slot.Calibrations.resize(queueIndex + 1);
+        }
+
+        QueueCalibration& calibration = slot.Calibrations[queueIndex];
+        calibration.Frequency = queue.TimestampFrequency();
+        std::tie(calibration.GPUTimestamp, calibration.CPUTimestamp) = queue.ClockCalibration();
+    }
+
+    void FrameProfiler::BeginPass(const RenderPassGraph::Node& node, HAL::CopyCommandListBase& commandList)
+    {
+        PassRecord& record = mFrameSlots[mCurrentSlotIndex].Passes[node.GlobalExecutionIndex()];
+        record.PassName = node.PassMetadata().Name;
+        record.QueueIndex = node.ExecutionQueueIndex;
+        record.CPUStartTimestamp = CPUTimestamp();
+
+        commandList.EndQuery(mQueryHeap, QueryIndex(node, false));
+    }
+
+    void FrameProfiler::EndPass(const RenderPassGraph::Node& node, HAL::CopyCommandListBase& commandList)
+    {
+        uint32_t startQueryIndex = QueryIndex(node, false);
+        commandList.EndQuery(mQueryHeap, QueryIndex(node, true));
+        commandList.ResolveQueryData(mQueryHeap, startQueryIndex, 2, mReadbackBuffer, startQueryIndex * sizeof(uint64_t));
+
+        PassRecord& record = mFrameSlots[mCurrentSlotIndex].Passes[node.GlobalExecutionIndex()];
+        record.CPUEndTimestamp = CPUTimestamp();
+        record.IsRecorded = true;
+    }
+
+    void FrameProfiler::ExportChromeTrace(const std::filesystem::path& filePath) const
+    {
+        std::ofstream file{ filePath };
+
+        if (!file.is_open())
+            return;
+
+        // Timestamps in Chrome trace format are in microseconds
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"CPU Main Thread\"}}";
+
+        uint64_t maxQueueIndex = 0;
+
+        for (const FrameTiming& frame : mHistory)
+        {
+            for (const PassTiming& pass : frame.Passes)
+            {
+                maxQueueIndex = std::max(maxQueueIndex, pass.QueueIndex);
+            }
+        }
+
+        for (auto queueIdx = 0u; queueIdx <= maxQueueIndex; ++queueIdx)
+        {
+            file << StringFormat(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"GPU Queue %u\"}}", queueIdx + 1, queueIdx);
+        }
+
+        auto writeEvent = [&file](const std::string& name, const char* category, uint64_t threadId, double startMS, double endMS)
+        {
+            file << StringFormat(",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%llu,\"ts\":%.3f,\"dur\":%.3f}",
+                EscapeJSONString(name).c_str(), category, threadId, startMS * 1000.0, (endMS - startMS) * 1000.0);
+        };
+
+        for (const FrameTiming& frame : mHistory)
+        {
+            writeEvent("Frame " + std::to_string(frame.FrameNumber), "Frame", 0, frame.StartMS, frame.StartMS + frame.CPUDurationMS);
+
+            for (const CPUScopeTiming& scope : frame.CPUScopes)
+            {
+                writeEvent(scope.Name, "CPU", 0, frame.StartMS + scope.StartMS, frame.StartMS + scope.EndMS);
+            }
+
+            for (const PassTiming& pass : frame.Passes)
+            {
+                writeEvent(pass.PassName.ToString(), "GPU", pass.QueueIndex + 1, frame.StartMS + pass.GPUStartMS, frame.StartMS + pass.GPUEndMS);
+            }
+        }
+
+        file << "\n]}\n";
+    }
+
+    uint64_t FrameProfiler::CPUTimestamp()
+    {
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+        return counter.QuadPart;
+    }
+
+    double FrameProfiler::CPUTicksToMS(uint64_t ticks) const
+    {
+        return double(ticks) * 1000.0 / mCPUFrequency;
+    }
+
+    uint32_t FrameProfiler::QueryIndex(const RenderPassGraph::Node& node, bool isPassEnd) const
+    {
+        return uint32_t(mCurrentSlotIndex * MaxQueriesPerFrame + node.GlobalExecutionIndex() * 2 + (isPassEnd ? 1 : 0));
+    }
+
+    void FrameProfiler::HarvestSlot(FrameSlot& slot, const uint64_t* timestamps)
+    {
+        uint64_t slotIndex = std::distance(mFrameSlots.data(), &slot);
+        const uint64_t* slotTimestamps = timestamps + slotIndex * MaxQueriesPerFrame;
+
+        double gpuFrameStart = std::numeric_limits<double>::max();
+        double gpuFrameEnd = 0.0;
+
+        for (auto passIdx = 0u; passIdx < slot.Passes.size(); ++passIdx)
+        {
+            const PassRecord& record = slot.Passes[passIdx];
+
+            if (!record.IsRecorded || record.QueueIndex >= slot.Calibrations.size())
+                continue;
+
+            const QueueCalibration& calibration = slot.Calibrations[record.QueueIndex];
+
+            // Bring GPU ticks to CPU timeline using calibration point sampled during the frame
+            auto gpuTicksToFrameMS = [&](uint64_t gpuTicks)
+            {
+                double msFromCalibration = (double(gpuTicks) - double(calibration.GPUTimestamp)) * 1000.0 / calibration.Frequency;
+                return CPUTicksToMS(calibration.CPUTimestamp - slot.CPUStartTimestamp) + msFromCalibration;
+            };
+
+            PassTiming& timing = slot.Timing.Passes.emplace_back();
+            timing.PassName = record.PassName;
+            timing.QueueIndex = record.QueueIndex;
+            timing.CPURecordingMS = CPUTicksToMS(record.CPUEndTimestamp - record.CPUStartTimestamp);
+            timing.GPUStartMS = gpuTicksToFrameMS(slotTimestamps[passIdx * 2]);
+            timing.GPUEndMS = gpuTicksToFrameMS(slotTimestamps[passIdx * 2 + 1]);
+
+            gpuFrameStart = std::min(gpuFrameStart, timing.GPUStartMS);
+            gpuFrameEnd = std::max(gpuFrameEnd, timing.GPUEndMS);
+        }
+
+        slot.Timing.GPUDurationMS = slot.Timing.Passes.empty() ? 0.0 : gpuFrameEnd - gpuFrameStart;
+        slot.IsPending = false;
+
+        mHistory.push_back(std::move(slot.Timing));
+
+        if (mHistory.size() > mHistoryLength)
+        {
+            mHistory.pop_front();
+        }
+    }
+
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "RenderPassGraph.hpp"
+#include "BarrierBatcher.hpp"
+
+#include <HardwareAbstractionLayer/Device.hpp>
+#include <HardwareAbstractionLayer/QueryHeap.hpp>
+#include <HardwareAbstractionLayer/Heap.hpp>
+#include <HardwareAbstractionLayer/Buffer.hpp>
+#include <HardwareAbstractionLayer/CommandList.hpp>
+#include <HardwareAbstractionLayer/CommandQueue.hpp>
+
+#include <Memory/ReadbackFuture.hpp>
+
+#include <Foundation/Name.hpp>
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <filesystem>
+
+namespace PathFinder
+{
+
+    // Collects CPU scope timings and per render pass GPU timestamps.
+    // GPU results become available when the frame that produced them is completed,
+    // so history lags behind the frame currently being recorded.
+    class FrameProfiler
+    {
+    public:
+        struct CPUScopeTiming
+        {
+            std::string Name;
+            uint32_t Depth = 0;
+            double StartMS = 0.0;
+            double EndMS = 0.0;
+        };
+
+        struct PassTiming
+        {
+            Foundation::Name PassName;
+            uint64_t QueueIndex = 0;
+            double CPURecordingMS = 0.0;
+            // Relative to frame start on CPU timeline
+            double GPUStartMS = 0.0;
+            double GPUEndMS = 0.0;
+        };
+
+        struct FrameTiming
+        {
+            uint64_t FrameNumber = 0;
+            // Relative to profiler creation
+            double StartMS = 0.0;
+            double CPUDurationMS = 0.0;
+            double GPUDurationMS = 0.0;
+            // Time CPU was blocked on frame fence waiting for GPU to free a frame slot
+            double FenceWaitMS = 0.0;
+            BarrierBatcher::Statistics Barriers;
+            // Readbacks completed at the end of the frame
+            Memory::ReadbackCallbackDispatcher::Statistics Readbacks;
+            std::vector<CPUScopeTiming> CPUScopes;
+            std::vector<PassTiming> Passes;
+        };
+
+        class CPUScope
+        {
+        public:
+            CPUScope(FrameProfiler* profiler, const std::string& name);
+            ~CPUScope();
+
+        private:
+            FrameProfiler* mProfiler = nullptr;
+        };
+
+        FrameProfiler(const HAL::Device& device, uint8_t simultaneousFramesInFlight, uint64_t historyLength = 240);
+
+        void BeginFrame(uint64_t frameNumber);
+        void EndFrame(uint64_t completedFrameNumber);
+
+        void BeginCPUScope(const std::string& name);
+        void EndCPUScope();
+        void SetFenceWaitTime(double milliseconds);
+        void SetBarrierStatistics(const BarrierBatcher::Statistics& statistics);
+        void SetReadbackStatistics(const Memory::ReadbackCallbackDispatcher::Statistics& statistics);
+
+        void SetPassCount(uint64_t passCount);
+        void CalibrateQueue(uint64_t queueIndex, const HAL::CommandQueue& queue);
+        void BeginPass(const RenderPassGraph::Node& node, HAL::CopyCommandListBase& commandList);
+        void EndPass(const RenderPassGraph::Node& node, HAL::CopyCommandListBase& commandList);
+
+        void ExportChromeTrace(const std::filesystem::path& filePath) const;
+
+    private:
+        struct QueueCalibration
+        {
+            uint64_t Frequency = 1;
+            uint64_t GPUTimestamp = 0;
+            uint64_t CPUTimestamp = 0;
+        };
+
+        struct PassRecord
+        {
+            Foundation::Name PassName;
+            uint64_t QueueIndex = 0;
+            uint64_t CPUStartTimestamp = 0;
+            uint64_t CPUEndTimestamp = 0;
+            bool IsRecorded = false;
+        };
+
+        struct FrameSlot
+        {
+            FrameTiming Timing;
+            uint64_t CPUStartTimestamp = 0;
+            std::vector<PassRecord> Passes;
+            std::vector<QueueCalibration> Calibrations;
+            bool IsPending = false;
+            bool IsCPUWorkFinished = false;
+        };
+
+        static const uint32_t MaxQueriesPerFrame = 1024;
+
+        static uint64_t CPUTimestamp();
+
+        double CPUTicksToMS(uint64_t ticks) const;
+        uint32_t QueryIndex(const RenderPassGraph::Node& node, bool isPassEnd) const;
+        void HarvestSlot(FrameSlot& slot, const uint64_t* timestamps);
+
+        HAL::QueryHeap mQueryHeap;
+        HAL::Heap mReadbackHeap;
+        HAL::Buffer mReadbackBuffer;
+        std::vector<FrameSlot> mFrameSlots;
+        std::vector<uint64_t> mOpenCPUScopes;
+        std::deque<FrameTiming> mHistory;
+        uint64_t mHistoryLength = 0;
+        uint64_t mCPUFrequency = 1;
+        uint64_t mCreationTimestamp = 0;
+        uint64_t mCurrentSlotIndex = 0;
+
+    public:
+        inline const std::deque<FrameTiming>& History() const { return mHistory; }
+        inline const FrameTiming* MostRecentFrame() const { return mHistory.empty() ? nullptr : &mHistory.back(); }
+        inline uint64_t SimultaneousFramesInFlight() const { return mFrameSlots.size(); }
+    };
+
+}
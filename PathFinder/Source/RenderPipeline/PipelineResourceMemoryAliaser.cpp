@@ -12,9 +12,9 @@ namespace PathFinder
         : mRenderPassGraph{ renderPassGraph },
         mSchedulingInfos{ &AliasingMetadata::SortDescending } {}
 
-    void PipelineResourceMemoryAliaser::AddSchedulingInfo(PipelineResourceSchedulingInfo* scheudlingInfo)
+    void PipelineResourceMemoryAliaser::AddSchedulingInfo(PipelineResourceSchedulingInfo* scheudlingInfo, std::optional<uint64_t> preferredHeapOffset)
     {
-        mSchedulingInfos.emplace(scheudlingInfo);
+        mSchedulingInfos.emplace(scheudlingInfo, preferredHeapOffset);
     }
 
     uint64_t PipelineResourceMemoryAliaser::Alias()
@@ -52,6 +52,90 @@ namespace PathFinder
         return optimalHeapSize == 0 ? 1 : optimalHeapSize;
     }
 
+    bool PipelineResourceMemoryAliaser::AliasIntoExistingHeap(uint64_t heapSize, uint64_t& occupiedSize)
+    {
+        std::vector<AliasingMetadataIterator> placedAllocations;
+        std::vector<AliasingMetadataIterator> unplacedAllocations;
+
+        auto conflictsWithPlacedAllocations = [&](const PipelineResourceSchedulingInfo& schedulingInfo, uint64_t offset)
+        {
+            return std::any_of(placedAllocations.begin(), placedAllocations.end(), [&](AliasingMetadataIterator placedIt)
+            {
+                const PipelineResourceSchedulingInfo& placedInfo = *placedIt->SchedulingInfo;
+                return TimelinesIntersect(schedulingInfo, placedInfo) && MemoryRegionsIntersect(schedulingInfo, offset, placedInfo);
+            });
+        };
+
+        // Keep unchanged allocations in place first, largest ones have priority
+        for (auto schedulingInfoIt = mSchedulingInfos.begin(); schedulingInfoIt != mSchedulingInfos.end(); ++schedulingInfoIt)
+        {
+            PipelineResourceSchedulingInfo& schedulingInfo = *schedulingInfoIt->SchedulingInfo;
+            std::optional<uint64_t> preferredOffset = schedulingInfoIt->PreferredHeapOffset;
+
+            if (preferredOffset &&
+                *preferredOffset + schedulingInfo.TotalRequiredMemory() <= heapSize &&
+                !conflictsWithPlacedAllocations(schedulingInfo, *preferredOffset))
+            {
+                schedulingInfo.HeapOffset = *preferredOffset;
+                placedAllocations.push_back(schedulingInfoIt);
+            }
+            else 
+            {
+                unplacedAllocations.push_back(schedulingInfoIt);
+            }
+        }
+
+        // Lowest free offset is either heap start or an end of an allocation that is alive at the same time
+        for (AliasingMetadataIterator schedulingInfoIt : unplacedAllocations)
+        {
+            PipelineResourceSchedulingInfo& schedulingInfo = *schedulingInfoIt->SchedulingInfo;
+            std::vector<uint64_t> candidateOffsets{ 0 };
+
+            for (AliasingMetadataIterator placedIt : placedAllocations)
+            {
+                if (TimelinesIntersect(schedulingInfo, *placedIt->SchedulingInfo))
+                {
+                    candidateOffsets.push_back(placedIt->SchedulingInfo->HeapOffset + placedIt->SchedulingInfo->TotalRequiredMemory());
+                }
+            }
+
+            std::sort(candidateOffsets.begin(), candidateOffsets.end());
+
+            auto offsetIt = std::find_if(candidateOffsets.begin(), candidateOffsets.end(), [&](uint64_t offset)
+            {
+                return offset + schedulingInfo.TotalRequiredMemory() <= heapSize && !conflictsWithPlacedAllocations(schedulingInfo, offset);
+            });
+
+            if (offsetIt == candidateOffsets.end())
+            {
+                return false;
+            }
+
+            schedulingInfo.HeapOffset = *offsetIt;
+            placedAllocations.push_back(schedulingInfoIt);
+        }
+
+        occupiedSize = 0;
+
+        // Allocations sharing memory need aliasing barriers before their first use
+        for (auto i = 0u; i < placedAllocations.size(); ++i)
+        {
+            const PipelineResourceSchedulingInfo& schedulingInfo = *placedAllocations[i]->SchedulingInfo;
+            occupiedSize = std::max(occupiedSize, schedulingInfo.HeapOffset + schedulingInfo.TotalRequiredMemory());
+
+            for (auto j = i + 1; j < placedAllocations.size(); ++j)
+            {
+                if (MemoryRegionsIntersect(schedulingInfo, schedulingInfo.HeapOffset, *placedAllocations[j]->SchedulingInfo))
+                {
+                    GetFirstPassInfo(placedAllocations[i])->NeedsAliasingBarrier = true;
+                    GetFirstPassInfo(placedAllocations[j])->NeedsAliasingBarrier = true;
+                }
+            }
+        }
+
+        return true;
+    }
+
     bool PipelineResourceMemoryAliaser::IsEmpty() const
     {
         return mSchedulingInfos.empty();
@@ -63,6 +147,12 @@ namespace PathFinder
             second.AliasingLifetime.first <= first.AliasingLifetime.second;
     }
 
+    bool PipelineResourceMemoryAliaser::MemoryRegionsIntersect(const PipelineResourceSchedulingInfo& first, uint64_t firstOffset, const PipelineResourceSchedulingInfo& second) const
+    {
+        return firstOffset < second.HeapOffset + second.TotalRequiredMemory() &&
+            second.HeapOffset < firstOffset + first.TotalRequiredMemory();
+    }
+
     void PipelineResourceMemoryAliaser::FitAliasableMemoryRegion(const MemoryRegion& nextAliasableRegion, uint64_t nextAllocationSize, MemoryRegion& optimalRegion) const
     {
         bool nextRegionValid = nextAliasableRegion.Size > 0;
@@ -190,8 +280,8 @@ namespace PathFinder
         mAlreadyAliasedAllocations.clear();
     }
 
-    PipelineResourceMemoryAliaser::AliasingMetadata::AliasingMetadata(PipelineResourceSchedulingInfo* schedulingInfo)
-        : SchedulingInfo{ schedulingInfo } {}
+    PipelineResourceMemoryAliaser::AliasingMetadata::AliasingMetadata(PipelineResourceSchedulingInfo* schedulingInfo, std::optional<uint64_t> preferredHeapOffset)
+        : SchedulingInfo{ schedulingInfo }, PreferredHeapOffset{ preferredHeapOffset } {}
 
     bool PipelineResourceMemoryAliaser::AliasingMetadata::SortAscending(const AliasingMetadata& first, const AliasingMetadata& second)
     {
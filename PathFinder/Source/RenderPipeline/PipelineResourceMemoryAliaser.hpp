@@ -8,6 +8,7 @@
 #include "RenderPassGraph.hpp"
 
 #include <set>
+#include <optional>
 
 namespace PathFinder
 {
@@ -19,8 +20,14 @@ namespace PathFinder
     public:
         PipelineResourceMemoryAliaser(const RenderPassGraph* renderPassGraph);
 
-        void AddSchedulingInfo(PipelineResourceSchedulingInfo* schedulingInfo);
+        void AddSchedulingInfo(PipelineResourceSchedulingInfo* schedulingInfo, std::optional<uint64_t> preferredHeapOffset = std::nullopt);
         uint64_t Alias();
+
+        // Places allocations into already existing heap, keeping preferred offsets where possible
+        // so that resources that did not change don't need to be recreated.
+        // Returns false if allocations don't fit, full aliasing is required then.
+        bool AliasIntoExistingHeap(uint64_t heapSize, uint64_t& occupiedSize);
+
         bool IsEmpty() const;
 
     private:
@@ -40,8 +47,9 @@ namespace PathFinder
         struct AliasingMetadata
         {
             PipelineResourceSchedulingInfo* SchedulingInfo;
+            std::optional<uint64_t> PreferredHeapOffset;
 
-            AliasingMetadata(PipelineResourceSchedulingInfo* schedulingInfo);
+            AliasingMetadata(PipelineResourceSchedulingInfo* schedulingInfo, std::optional<uint64_t> preferredHeapOffset);
     
             static bool SortAscending(const AliasingMetadata& first, const AliasingMetadata& second);
             static bool SortDescending(const AliasingMetadata& first, const AliasingMetadata& second);
@@ -51,6 +59,7 @@ namespace PathFinder
         using AliasingMetadataIterator = AliasingMetadataSet::iterator;
 
         bool TimelinesIntersect(const PipelineResourceSchedulingInfo& first, const PipelineResourceSchedulingInfo& second) const;
+        bool MemoryRegionsIntersect(const PipelineResourceSchedulingInfo& first, uint64_t firstOffset, const PipelineResourceSchedulingInfo& second) const;
         void FitAliasableMemoryRegion(const MemoryRegion& nextAliasableRegion, uint64_t nextAllocationSize, MemoryRegion& optimalRegion) const;
         void FindCurrentBucketNonAliasableMemoryRegions(AliasingMetadataIterator nextSchedulingInfoIt);
         bool AliasAsFirstAllocation(AliasingMetadataIterator nextSchedulingInfoIt);
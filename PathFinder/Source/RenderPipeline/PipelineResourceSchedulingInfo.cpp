@@ -22,10 +22,10 @@ namespace PathFinder
         mCombinedResourceNames += " | " + alias.ToString();
     }
 
-    void PipelineResourceSchedulingInfo::ApplyExpectedStates()
+    void PipelineResourceSchedulingInfo::ApplyExpectedStates(bool queryAllocationInfo)
     {
         // Determine final memory requirements
-        mResourceFormat.SetExpectedStates(mExpectedStates);
+        mResourceFormat.SetExpectedStates(mExpectedStates, queryAllocationInfo);
     }
 
     const PipelineResourceSchedulingInfo::PassInfo* PipelineResourceSchedulingInfo::GetInfoForPass(Foundation::Name passName) const
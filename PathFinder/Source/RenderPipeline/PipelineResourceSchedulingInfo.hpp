@@ -42,7 +42,7 @@ namespace PathFinder
 
         void AddExpectedStates(HAL::ResourceState states);
         void AddNameAlias(Foundation::Name alias);
-        void ApplyExpectedStates();
+        void ApplyExpectedStates(bool queryAllocationInfo = true);
         const PassInfo* GetInfoForPass(Foundation::Name passName) const;
         PassInfo* GetInfoForPass(Foundation::Name passName);
 
@@ -76,6 +76,7 @@ namespace PathFinder
 
     public:
         inline const HAL::ResourceFormat& ResourceFormat() const { return mResourceFormat; }
+        inline HAL::ResourceFormat& ResourceFormat() { return mResourceFormat; }
         inline HAL::ResourceState ExpectedStates() const { return mExpectedStates; }
         inline Foundation::Name ResourceName() const { return mResourceName; }
         inline const auto& Aliases() const { return mAliases; }
@@ -11,6 +11,49 @@
 namespace PathFinder
 {
 
+    namespace
+    {
+
+        bool AreClearValuesEqual(const HAL::ClearValue& a, const HAL::ClearValue& b)
+        {
+            if (a.index() != b.index()) return false;
+
+            if (auto color = std::get_if<HAL::ColorClearValue>(&a))
+            {
+                return *color == std::get<HAL::ColorClearValue>(b);
+            }
+
+            const auto& depthStencil = std::get<HAL::DepthStencilClearValue>(a);
+            const auto& thatDepthStencil = std::get<HAL::DepthStencilClearValue>(b);
+            return depthStencil.Depth == thatDepthStencil.Depth && depthStencil.Stencil == thatDepthStencil.Stencil;
+        }
+
+        bool AreResourcePropertiesEqual(const HAL::ResourcePropertiesVariant& a, const HAL::ResourcePropertiesVariant& b)
+        {
+            if (a.index() != b.index()) return false;
+
+            if (auto buffer = std::get_if<HAL::BufferProperties>(&a))
+            {
+                const auto& thatBuffer = std::get<HAL::BufferProperties>(b);
+
+                return buffer->Size == thatBuffer.Size && buffer->Stride == thatBuffer.Stride &&
+                    buffer->InitialStateMask == thatBuffer.InitialStateMask && buffer->ExpectedStateMask == thatBuffer.ExpectedStateMask;
+            }
+
+            const auto& texture = std::get<HAL::TextureProperties>(a);
+            const auto& thatTexture = std::get<HAL::TextureProperties>(b);
+
+            return texture.Format == thatTexture.Format && texture.Kind == thatTexture.Kind &&
+                texture.Dimensions.Width == thatTexture.Dimensions.Width &&
+                texture.Dimensions.Height == thatTexture.Dimensions.Height &&
+                texture.Dimensions.Depth == thatTexture.Dimensions.Depth &&
+                texture.MipCount == thatTexture.MipCount &&
+                texture.InitialStateMask == thatTexture.InitialStateMask && texture.ExpectedStateMask == thatTexture.ExpectedStateMask &&
+                AreClearValuesEqual(texture.OptimizedClearValue, thatTexture.OptimizedClearValue);
+        }
+
+    }
+
     PipelineResourceStorage::PipelineResourceStorage(
         HAL::Device* device, 
         Memory::GPUResourceProducer* resourceProducer,
@@ -195,15 +238,22 @@ namespace PathFinder
         mBufferMemoryAliaser = { mPassExecutionGraph };
         mUniversalMemoryAliaser = { mPassExecutionGraph };
 
+        CullUnusedResources();
+
         // Determine resource effective lifetimes
         auto joinAliasingLifetimes = [this](PipelineResourceStorageResource& resourceData, Foundation::Name resourceName)
         {
+            // Alias may only be used by culled render passes
+            if (!mPassExecutionGraph->IsResourceUsed(resourceName)) return;
+
             const RenderPassGraph::ResourceUsageTimeline& usageTimeline = mPassExecutionGraph->GetResourceUsageTimeline(resourceName);
             uint64_t start = std::min(resourceData.SchedulingInfo.AliasingLifetime.first, usageTimeline.first);
             uint64_t end = std::max(resourceData.SchedulingInfo.AliasingLifetime.second, usageTimeline.second);
             resourceData.SchedulingInfo.AliasingLifetime = { start, end };
         };
 
+        std::vector<HAL::ResourceFormat*> resourceFormats;
+
         for (PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
         {
             // Accumulate expected states for resource from previous frame to avoid reallocations 
@@ -215,7 +265,8 @@ namespace PathFinder
                 resourceData.SchedulingInfo.AddExpectedStates(previousResourceData.SchedulingInfo.ExpectedStates());
             }
 
-            resourceData.SchedulingInfo.ApplyExpectedStates();
+            resourceData.SchedulingInfo.ApplyExpectedStates(false);
+            resourceFormats.push_back(&resourceData.SchedulingInfo.ResourceFormat());
 
             if (resourceData.SchedulingInfo.CanBeAliased)
             {
@@ -225,17 +276,12 @@ namespace PathFinder
                 {
                     joinAliasingLifetimes(resourceData, alias);
                 }
-
-                switch (resourceData.SchedulingInfo.ResourceFormat().ResourceAliasingGroup())
-                {
-                case HAL::HeapAliasingGroup::RTDSTextures: mRTDSMemoryAliaser.AddSchedulingInfo(&resourceData.SchedulingInfo); break;
-                case HAL::HeapAliasingGroup::NonRTDSTextures: mNonRTDSMemoryAliaser.AddSchedulingInfo(&resourceData.SchedulingInfo); break;
-                case HAL::HeapAliasingGroup::Buffers: mBufferMemoryAliaser.AddSchedulingInfo(&resourceData.SchedulingInfo); break;
-                case HAL::HeapAliasingGroup::Universal: mUniversalMemoryAliaser.AddSchedulingInfo(&resourceData.SchedulingInfo); break;
-                }
             }
         }
 
+        // Memory requirements of all scheduled resources are resolved in one go
+        HAL::ResourceFormat::BatchQueryAllocationInfo(resourceFormats);
+
         // See whether resource reallocation and therefore memory layout invalidation is required
         mMemoryLayoutChanged = !TransferPreviousFrameResources();
 
@@ -243,16 +289,59 @@ namespace PathFinder
         {
             // Re-alias memory, then reallocate resources only if memory was invalidated
             // which can happen on first run or when resource properties were changed by the user.
+            // Heaps are only grown and resources that did not change are kept in place when possible.
             //
-            if (!mRTDSMemoryAliaser.IsEmpty()) mRTDSHeap = std::make_unique<HAL::Heap>(*mDevice, mRTDSMemoryAliaser.Alias(), HAL::HeapAliasingGroup::RTDSTextures);
-            if (!mNonRTDSMemoryAliaser.IsEmpty()) mNonRTDSHeap = std::make_unique<HAL::Heap>(*mDevice, mNonRTDSMemoryAliaser.Alias(), HAL::HeapAliasingGroup::NonRTDSTextures);
-            if (!mBufferMemoryAliaser.IsEmpty()) mBufferHeap = std::make_unique<HAL::Heap>(*mDevice, mBufferMemoryAliaser.Alias(), HAL::HeapAliasingGroup::Buffers);
-            if (!mUniversalMemoryAliaser.IsEmpty()) mUniversalHeap = std::make_unique<HAL::Heap>(*mDevice, mUniversalMemoryAliaser.Alias(), HAL::HeapAliasingGroup::Universal);
+            robin_hood::unordered_flat_set<ResourceName> changedResources{ 
+                mResourcesRequiringReallocation.begin(), mResourcesRequiringReallocation.end() };
+
+            auto findPreviousFrameResource = [this](ResourceName name) -> PipelineResourceStorageResource*
+            {
+                auto prevIndexIt = mPreviousFrameResourceMap->find(name);
+                return prevIndexIt != mPreviousFrameResourceMap->end() ? &mPreviousFrameResources->at(prevIndexIt->second) : nullptr;
+            };
+
+            for (PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
+            {
+                if (!resourceData.SchedulingInfo.CanBeAliased) continue;
+
+                std::optional<uint64_t> preferredHeapOffset;
+                PipelineResourceStorageResource* prevResourceData = findPreviousFrameResource(resourceData.ResourceName());
+
+                if (prevResourceData && changedResources.find(resourceData.ResourceName()) == changedResources.end())
+                {
+                    preferredHeapOffset = prevResourceData->SchedulingInfo.HeapOffset;
+                }
+
+                GetAliaserForAliasingGroup(resourceData.SchedulingInfo.ResourceFormat().ResourceAliasingGroup())
+                    .AddSchedulingInfo(&resourceData.SchedulingInfo, preferredHeapOffset);
+            }
+
+            std::vector<HAL::HeapAliasingGroup> recreatedHeapGroups;
+
+            if (AliasIntoHeap(mRTDSMemoryAliaser, mRTDSHeap, HAL::HeapAliasingGroup::RTDSTextures)) recreatedHeapGroups.push_back(HAL::HeapAliasingGroup::RTDSTextures);
+            if (AliasIntoHeap(mNonRTDSMemoryAliaser, mNonRTDSHeap, HAL::HeapAliasingGroup::NonRTDSTextures)) recreatedHeapGroups.push_back(HAL::HeapAliasingGroup::NonRTDSTextures);
+            if (AliasIntoHeap(mBufferMemoryAliaser, mBufferHeap, HAL::HeapAliasingGroup::Buffers)) recreatedHeapGroups.push_back(HAL::HeapAliasingGroup::Buffers);
+            if (AliasIntoHeap(mUniversalMemoryAliaser, mUniversalHeap, HAL::HeapAliasingGroup::Universal)) recreatedHeapGroups.push_back(HAL::HeapAliasingGroup::Universal);
 
             for (PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
             {
                 const HAL::ResourceFormat& format = resourceData.SchedulingInfo.ResourceFormat();
                 HAL::Heap* heap = GetHeapForAliasingGroup(format.ResourceAliasingGroup());
+                PipelineResourceStorageResource* prevResourceData = findPreviousFrameResource(resourceData.ResourceName());
+
+                bool isUnchanged = prevResourceData && changedResources.find(resourceData.ResourceName()) == changedResources.end();
+
+                bool isDisplaced = resourceData.SchedulingInfo.CanBeAliased && isUnchanged && (
+                    std::find(recreatedHeapGroups.begin(), recreatedHeapGroups.end(), format.ResourceAliasingGroup()) != recreatedHeapGroups.end() ||
+                    resourceData.SchedulingInfo.HeapOffset != prevResourceData->SchedulingInfo.HeapOffset);
+
+                // Unchanged resources that kept their placement keep their GPU resources and descriptors
+                if (isUnchanged && !isDisplaced)
+                {
+                    resourceData.Texture = std::move(prevResourceData->Texture);
+                    resourceData.Buffer = std::move(prevResourceData->Buffer);
+                    continue;
+                }
 
                 std::visit(Foundation::MakeVisitor(
                     [&resourceData, heap, this](const HAL::TextureProperties& textureProps)
@@ -274,6 +363,8 @@ namespace PathFinder
                     format.ResourceProperties());
             }
         }
+
+        MapHALResources();
     }
 
     void PipelineResourceStorage::QueueResourceAllocationIfNeeded(
@@ -339,6 +430,49 @@ namespace PathFinder
         return resourceObjects;
     }
 
+    PipelineResourceMemoryAliaser& PipelineResourceStorage::GetAliaserForAliasingGroup(HAL::HeapAliasingGroup group)
+    {
+        switch (group)
+        {
+        case HAL::HeapAliasingGroup::RTDSTextures: return mRTDSMemoryAliaser;
+        case HAL::HeapAliasingGroup::NonRTDSTextures: return mNonRTDSMemoryAliaser;
+        case HAL::HeapAliasingGroup::Buffers: return mBufferMemoryAliaser;
+        default: return mUniversalMemoryAliaser;
+        }
+    }
+
+    bool PipelineResourceStorage::AliasIntoHeap(PipelineResourceMemoryAliaser& aliaser, std::unique_ptr<HAL::Heap>& heap, HAL::HeapAliasingGroup group)
+    {
+        if (aliaser.IsEmpty())
+        {
+            return false;
+        }
+
+        if (heap)
+        {
+            uint64_t occupiedSize = 0;
+
+            // Hysteresis: keep heap unless new layout doesn't fit or occupies only a small part of it
+            if (aliaser.AliasIntoExistingHeap(heap->AlighnedSize(), occupiedSize) &&
+                occupiedSize >= heap->AlighnedSize() * mHeapGrowthSettings.ShrinkThreshold)
+            {
+                return false;
+            }
+        }
+
+        uint64_t requiredSize = aliaser.Alias();
+        uint64_t sizeWithSlack = requiredSize + uint64_t(requiredSize * mHeapGrowthSettings.Slack);
+
+        heap = std::make_unique<HAL::Heap>(*mDevice, sizeWithSlack, group);
+
+        return true;
+    }
+
+    void PipelineResourceStorage::SetHeapGrowthSettings(const HeapGrowthSettings& settings)
+    {
+        mHeapGrowthSettings = settings;
+    }
+
     HAL::Heap* PipelineResourceStorage::GetHeapForAliasingGroup(HAL::HeapAliasingGroup group)
     {
         switch (group)
@@ -351,62 +485,186 @@ namespace PathFinder
         }
     }
 
+    void PipelineResourceStorage::CullUnusedResources()
+    {
+        auto isUsed = [this](const PipelineResourceStorageResource& resourceData)
+        {
+            if (mPassExecutionGraph->IsResourceUsed(resourceData.ResourceName())) return true;
+
+            const auto& aliases = resourceData.SchedulingInfo.Aliases();
+            return std::any_of(aliases.begin(), aliases.end(), [this](Foundation::Name alias) { return mPassExecutionGraph->IsResourceUsed(alias); });
+        };
+
+        if (std::all_of(mCurrentFrameResources->begin(), mCurrentFrameResources->end(), isUsed))
+        {
+            return;
+        }
+
+        // Resources touched only by culled render passes are neither allocated nor aliased
+        mCurrentFrameResources->erase(
+            std::remove_if(mCurrentFrameResources->begin(), mCurrentFrameResources->end(), [&isUsed](auto& resourceData) { return !isUsed(resourceData); }),
+            mCurrentFrameResources->end());
+
+        mCurrentFrameResourceMap->clear();
+
+        for (auto resourceIdx = 0; resourceIdx < mCurrentFrameResources->size(); ++resourceIdx)
+        {
+            const PipelineResourceStorageResource& resourceData = mCurrentFrameResources->at(resourceIdx);
+            mCurrentFrameResourceMap->emplace(resourceData.ResourceName(), resourceIdx);
+
+            for (Foundation::Name alias : resourceData.SchedulingInfo.Aliases())
+            {
+                mCurrentFrameResourceMap->emplace(alias, resourceIdx);
+            }
+        }
+    }
+
+    void PipelineResourceStorage::MapHALResources()
+    {
+        mHALResourceMap.clear();
+
+        for (auto resourceIdx = 0u; resourceIdx < mCurrentFrameResources->size(); ++resourceIdx)
+        {
+            const Memory::GPUResource* gpuResource = mCurrentFrameResources->at(resourceIdx).GetGPUResource();
+
+            if (gpuResource)
+            {
+                mHALResourceMap.emplace(gpuResource->HALResource(), resourceIdx);
+            }
+        }
+    }
+
     bool PipelineResourceStorage::TransferPreviousFrameResources()
     {
+        // Sum of entry hashes does not depend on resource order
+        uint64_t layoutHash = mCurrentFrameResources->size();
+
         for (PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
         {
             PipelineResourceStorageResource::DiffEntry diffEntry = resourceData.GetDiffEntry();
             mCurrentFrameDiffEntries->push_back(diffEntry);
+            layoutHash += diffEntry.Hash();
         }
 
-        // Make diff independent from order by sorting first
-        std::sort(mCurrentFrameDiffEntries->begin(), mCurrentFrameDiffEntries->end(), [](auto& first, auto& second)
+        // Diff entries are stored in the same order as resources, 
+        // so previous frame resource map indexes both
+        auto isResourceUnchanged = [this](uint64_t resourceIdx)
         {
-            return first.ResourceName.ToId() < second.ResourceName.ToId();
-        });
+            const PipelineResourceStorageResource::DiffEntry& diffEntry = mCurrentFrameDiffEntries->at(resourceIdx);
+            auto prevIndexIt = mPreviousFrameResourceMap->find(diffEntry.ResourceName);
 
-        dtl::Diff<PipelineResourceStorageResource::DiffEntry> diff{ *mPreviousFrameDiffEntries, *mCurrentFrameDiffEntries };
+            if (prevIndexIt == mPreviousFrameResourceMap->end() || !(mPreviousFrameDiffEntries->at(prevIndexIt->second) == diffEntry))
+            {
+                return false;
+            }
+
+            // Memory footprint alone does not tell apart formats or dimensions of the same size
+            const HAL::ResourceFormat& format = mCurrentFrameResources->at(resourceIdx).SchedulingInfo.ResourceFormat();
+            const HAL::ResourceFormat& prevFormat = mPreviousFrameResources->at(prevIndexIt->second).SchedulingInfo.ResourceFormat();
 
-        diff.compose();
-        dtl::Ses ses = diff.getSes();
-        auto sequence = ses.getSequence();
+            return AreResourcePropertiesEqual(format.ResourceProperties(), prevFormat.ResourceProperties());
+        };
 
-        if (ses.isChange())
+        // Matching hash is only a hint, entries are still compared to rule out collisions
+        bool isLayoutUnchanged = layoutHash == mMemoryLayoutHash && mCurrentFrameResources->size() == mPreviousFrameResources->size();
+
+        for (auto resourceIdx = 0u; isLayoutUnchanged && resourceIdx < mCurrentFrameResources->size(); ++resourceIdx)
         {
-            // Any ADD or DELETE will invalidate aliased memory layout
-            // so we'll need to reallocate everything.
-            // Return because there is nothing to transfer from previous frame:
-            // whole memory is invalidated.
-            return false;
+            isLayoutUnchanged = isResourceUnchanged(resourceIdx);
         }
 
-        for (auto& [diffEntry, elementInfo] : sequence)
-        {
-            dtl::edit_t diffOperation = elementInfo.type;
+        mMemoryLayoutHash = layoutHash;
+        mResourcesRequiringReallocation.clear();
 
-            switch (diffOperation)
-            {
-            case dtl::SES_COMMON:
+        if (!isLayoutUnchanged)
+        {
+            for (auto resourceIdx = 0u; resourceIdx < mCurrentFrameResources->size(); ++resourceIdx)
             {
-                // COMMON case means resource should be transfered from previous frame
-                uint64_t indexInPrevFrame = mPreviousFrameResourceMap->at(diffEntry.ResourceName);
-                uint64_t indexInCurrFrame = mCurrentFrameResourceMap->at(diffEntry.ResourceName);
-                PipelineResourceStorageResource& prevResourceData = mPreviousFrameResources->at(indexInPrevFrame);
-                PipelineResourceStorageResource& resourceData = mCurrentFrameResources->at(indexInCurrFrame);
-
-                // Transfer GPU resources from previous frame
-                resourceData.Texture = std::move(prevResourceData.Texture);
-                resourceData.Buffer = std::move(prevResourceData.Buffer);
-            }
-                
-            default:
-                break;
+                if (!isResourceUnchanged(resourceIdx))
+                {
+                    mResourcesRequiringReallocation.push_back(mCurrentFrameDiffEntries->at(resourceIdx).ResourceName);
+                }
             }
+
+            // Any addition, deletion or property change invalidates aliased memory layout,
+            // so there is nothing to transfer from previous frame
+            return false;
+        }
+
+        for (PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
+        {
+            // Every resource was found in previous frame by the check above
+            uint64_t indexInPrevFrame = mPreviousFrameResourceMap->find(resourceData.ResourceName())->second;
+            PipelineResourceStorageResource& prevResourceData = mPreviousFrameResources->at(indexInPrevFrame);
+
+            // Transfer GPU resources from previous frame
+            resourceData.Texture = std::move(prevResourceData.Texture);
+            resourceData.Buffer = std::move(prevResourceData.Buffer);
+
+            // Aliasing is skipped for unchanged layout, carry placement over for future incremental updates
+            resourceData.SchedulingInfo.HeapOffset = prevResourceData.SchedulingInfo.HeapOffset;
         }
 
         return true;
     }
 
+    void PipelineResourceStorage::ResetPassConstantArena()
+    {
+        constexpr uint64_t GrowAlignment = 65536;
+
+        // Offset keeps counting past arena capacity, so it holds full demand of previous frame
+        uint64_t requiredSize = Foundation::MemoryUtils::Align(std::max(mPassConstantArenaOffset.load(), GrowAlignment), GrowAlignment);
+
+        if (!mPassConstantArena || mPassConstantArena->Capacity() < requiredSize)
+        {
+            auto properties = HAL::BufferProperties::Create<uint8_t>(requiredSize, 1, HAL::ResourceState::ConstantBuffer);
+            mPassConstantArena = mResourceProducer->NewBuffer(properties, Memory::GPUResource::UploadStrategy::DirectAccess);
+            mPassConstantArena->SetDebugName("Pass Constant Arena");
+        }
+
+        mPassConstantArena->RequestWrite();
+        mPassConstantArenaOffset = 0;
+        mPassConstantOverflowBlocks.clear();
+        mPassConstantOverflowBlockOffset = 0;
+    }
+
+    HAL::GPUAddress PipelineResourceStorage::AllocatePassConstants(const void* data, uint64_t size)
+    {
+        constexpr uint64_t Alignment = 256;
+
+        uint64_t alignedSize = Foundation::MemoryUtils::Align(size, Alignment);
+        uint64_t offset = mPassConstantArenaOffset.fetch_add(alignedSize);
+
+        if (offset + alignedSize <= mPassConstantArena->Capacity())
+        {
+            memcpy(mPassConstantArena->WriteOnlyPtr() + offset, data, size);
+            return mPassConstantArena->HALBuffer()->GPUVirtualAddress() + offset;
+        }
+
+        // Rare path: arena was sized by previous frame demand which turned out to be insufficient
+        std::lock_guard lock{ mPassConstantOverflowMutex };
+
+        Memory::Buffer* overflowBlock = mPassConstantOverflowBlocks.empty() ? nullptr : mPassConstantOverflowBlocks.back().get();
+
+        if (!overflowBlock || mPassConstantOverflowBlockOffset + alignedSize > overflowBlock->Capacity())
+        {
+            uint64_t blockSize = std::max(alignedSize, mPassConstantArena->Capacity());
+            auto properties = HAL::BufferProperties::Create<uint8_t>(blockSize, 1, HAL::ResourceState::ConstantBuffer);
+
+            mPassConstantOverflowBlocks.emplace_back(mResourceProducer->NewBuffer(properties, Memory::GPUResource::UploadStrategy::DirectAccess));
+            overflowBlock = mPassConstantOverflowBlocks.back().get();
+            overflowBlock->SetDebugName("Pass Constant Arena Overflow Block");
+            overflowBlock->RequestWrite();
+            mPassConstantOverflowBlockOffset = 0;
+        }
+
+        uint64_t blockOffset = mPassConstantOverflowBlockOffset;
+        mPassConstantOverflowBlockOffset += alignedSize;
+
+        memcpy(overflowBlock->WriteOnlyPtr() + blockOffset, data, size);
+        return overflowBlock->HALBuffer()->GPUVirtualAddress() + blockOffset;
+    }
+
     const Memory::Buffer* PipelineResourceStorage::GlobalRootConstantsBuffer() const
     {
         return mGlobalRootConstantsBuffer.get();
@@ -445,6 +703,38 @@ namespace PathFinder
         return &mCurrentFrameResources->at(indexIt->second);
     }
 
+    const PipelineResourceStorageResource* PipelineResourceStorage::GetPerResourceData(const HAL::Resource* resource) const
+    {
+        auto indexIt = mHALResourceMap.find(resource);
+        return indexIt != mHALResourceMap.end() ? &mCurrentFrameResources->at(indexIt->second) : nullptr;
+    }
+
+    RenderPassGraph::TransientResourceFootprint PipelineResourceStorage::GetTransientResourceFootprint(ResourceName name) const
+    {
+        const PipelineResourceStorageResource* resourceData = GetPerResourceData(name);
+
+        if (!resourceData || !resourceData->SchedulingInfo.CanBeAliased)
+        {
+            return { name, 0 };
+        }
+
+        return { resourceData->ResourceName(), resourceData->SchedulingInfo.TotalRequiredMemory() };
+    }
+
+    PipelineResourceStorage::TransientMemoryReport PipelineResourceStorage::GetTransientMemoryReport() const
+    {
+        TransientMemoryReport report;
+        report.DependencyDepthOrderPeak = mPassExecutionGraph->DependencyDepthOrderTransientMemoryPeak();
+        report.ExecutionOrderPeak = mPassExecutionGraph->TransientMemoryPeak();
+
+        for (const HAL::Heap* heap : { mRTDSHeap.get(), mNonRTDSHeap.get(), mBufferHeap.get(), mUniversalHeap.get() })
+        {
+            if (heap) report.HeapsSize += heap->AlighnedSize();
+        }
+
+        return report;
+    }
+
     void PipelineResourceStorage::IterateDebugBuffers(const DebugBufferIteratorFunc& func) const
     {
         /*for (auto& [resourceName, passObjects] : mPerPassData)
@@ -20,9 +20,10 @@
 #include <tuple>
 #include <memory>
 #include <optional>
+#include <atomic>
+#include <mutex>
 
 #include <robinhood/robin_hood.h>
-#include <dtl/dtl.hpp>
 
 namespace PathFinder
 {
@@ -47,6 +48,28 @@ namespace PathFinder
         using DebugBufferIteratorFunc = std::function<void(PassName passName, const float* debugData)>;
         using SchedulingInfoConfigurator = std::function<void(PipelineResourceSchedulingInfo&)>;
 
+        struct TransientMemoryReport
+        {
+            // Peak of concurrently alive aliased resources with passes ordered by dependency depth
+            uint64_t DependencyDepthOrderPeak = 0;
+
+            // Same peak for pass order that was actually used
+            uint64_t ExecutionOrderPeak = 0;
+
+            // Combined size of aliasing heaps. Can exceed the peak due to imperfect packing.
+            uint64_t HeapsSize = 0;
+        };
+
+        struct HeapGrowthSettings
+        {
+            // Extra capacity requested when aliasing heap has to be created,
+            // so that small growth of transient resources fits into the same heap
+            float Slack = 0.25f;
+
+            // Heap is recreated with smaller size only when its occupied part falls below this fraction
+            float ShrinkThreshold = 0.5f;
+        };
+
         const HAL::RTDescriptor* GetRenderTargetDescriptor(Foundation::Name resourceName, Foundation::Name passName, uint64_t mipIndex = 0) const;
         const HAL::DSDescriptor* GetDepthStencilDescriptor(Foundation::Name resourceName, Foundation::Name passName) const;
         const HAL::SamplerDescriptor* GetSamplerDescriptor(Foundation::Name resourceName) const;
@@ -61,6 +84,10 @@ namespace PathFinder
         void StartResourceScheduling();
         void EndResourceScheduling();
         void AllocateScheduledResources();
+
+        // Sizes frame constant arena by previous frame demand and rewinds it.
+        // Must be called before command list recording.
+        void ResetPassConstantArena();
         
         template <class Constants> 
         void UpdateGlobalRootConstants(const Constants& constants);
@@ -78,6 +105,12 @@ namespace PathFinder
         PipelineResourceStorageResource* GetPerResourceData(ResourceName name);
         const PipelineResourceStoragePass* GetPerPassData(PassName name) const;
         const PipelineResourceStorageResource* GetPerResourceData(ResourceName name) const;
+        const PipelineResourceStorageResource* GetPerResourceData(const HAL::Resource* resource) const;
+
+        void SetHeapGrowthSettings(const HeapGrowthSettings& settings);
+
+        RenderPassGraph::TransientResourceFootprint GetTransientResourceFootprint(ResourceName name) const;
+        TransientMemoryReport GetTransientMemoryReport() const;
 
         void IterateDebugBuffers(const DebugBufferIteratorFunc& func) const;
 
@@ -96,6 +129,7 @@ namespace PathFinder
         using ResourceMap = robin_hood::unordered_flat_map<ResourceName, uint64_t>;
         using SamplerMap = robin_hood::unordered_flat_map<ResourceName, SamplerDescriptorPair>;
         using ResourceAliasMap = robin_hood::unordered_flat_map<ResourceName, ResourceName>;
+        using HALResourceMap = robin_hood::unordered_flat_map<const HAL::Resource*, uint64_t>;
         using ResourceList = std::vector<PipelineResourceStorageResource>;
         using DiffEntryList = std::vector<PipelineResourceStorageResource::DiffEntry>;
 
@@ -114,8 +148,17 @@ namespace PathFinder
 
         PipelineResourceStorageResource& CreatePerResourceData(ResourceName name, const HAL::ResourceFormat& resourceFormat);
         HAL::Heap* GetHeapForAliasingGroup(HAL::HeapAliasingGroup group);
+        PipelineResourceMemoryAliaser& GetAliaserForAliasingGroup(HAL::HeapAliasingGroup group);
+
+        // Reuses existing heap when new memory layout fits into it. Returns true if heap was recreated.
+        bool AliasIntoHeap(PipelineResourceMemoryAliaser& aliaser, std::unique_ptr<HAL::Heap>& heap, HAL::HeapAliasingGroup group);
+
+        void CullUnusedResources();
 
+        // Thread-safe bump allocation in frame constant arena. Returns GPU address of written data.
+        HAL::GPUAddress AllocatePassConstants(const void* data, uint64_t size);
         bool TransferPreviousFrameResources();
+        void MapHALResources();
 
         HAL::Device* mDevice;
         Memory::GPUResourceProducer* mResourceProducer;
@@ -135,12 +178,24 @@ namespace PathFinder
         PipelineResourceMemoryAliaser mBufferMemoryAliaser;
         PipelineResourceMemoryAliaser mUniversalMemoryAliaser;
 
+        HeapGrowthSettings mHeapGrowthSettings;
+
         // Constant buffer for global data that changes rarely
         Memory::GPUResourceProducer::BufferPtr mGlobalRootConstantsBuffer;
 
         // Constant buffer for data that changes every frame
         Memory::GPUResourceProducer::BufferPtr mPerFrameRootConstantsBuffer;
 
+        // Frame-wide persistently mapped memory for constants of all render passes
+        Memory::GPUResourceProducer::BufferPtr mPassConstantArena;
+        std::atomic<uint64_t> mPassConstantArenaOffset = 0;
+
+        // Blocks requested when arena runs out of space mid-frame.
+        // Arena is grown to fit all of the demand on the next frame.
+        std::vector<Memory::GPUResourceProducer::BufferPtr> mPassConstantOverflowBlocks;
+        uint64_t mPassConstantOverflowBlockOffset = 0;
+        std::mutex mPassConstantOverflowMutex;
+
         robin_hood::unordered_node_map<PassName, PipelineResourceStoragePass> mPerPassData;
 
         std::vector<SchedulingRequest> mSchedulingCreationRequests;
@@ -159,15 +214,27 @@ namespace PathFinder
         ResourceAliasMap mAliasMap;
         SamplerMap mSamplers;
 
+        // Current frame resource data indices keyed by underlying HAL resources
+        HALResourceMap mHALResourceMap;
+
         // Resource diff entries to determine resource allocation needs
         std::pair<DiffEntryList, DiffEntryList> mDiffEntries;
         DiffEntryList* mPreviousFrameDiffEntries = &mDiffEntries.first;
         DiffEntryList* mCurrentFrameDiffEntries = &mDiffEntries.second;
 
+        // Order-independent hash of diff entries of the last scheduled frame
+        uint64_t mMemoryLayoutHash = 0;
+
+        // New resources and resources whose properties changed since previous frame
+        std::vector<ResourceName> mResourcesRequiringReallocation;
+
         // Transitions for resources scheduled for readback
         HAL::ResourceBarrierCollection mReadbackBarriers;
 
         bool mMemoryLayoutChanged = false;
+
+    public:
+        inline const auto& ResourcesRequiringReallocation() const { return mResourcesRequiringReallocation; }
     };
 
 }
@@ -38,40 +38,8 @@ namespace PathFinder
     template <class Constants>
     void PipelineResourceStorage::UpdatePassRootConstants(const Constants& constants, const RenderPassGraph::Node& passNode)
     {
-        constexpr uint64_t Alignment = 256;
-        constexpr uint64_t GrowAlignment = 4096;
-
         PipelineResourceStoragePass* passData = GetPerPassData(passNode.PassMetadata().Name);
-
-        uint64_t alignedBytesToWrite = Foundation::MemoryUtils::Align(sizeof(Constants), Alignment);
-        uint64_t alreadyWrittenBytes = passData->PassConstantBufferMemoryOffset;
-        uint64_t newBufferSize = alignedBytesToWrite + alreadyWrittenBytes;
-
-        // Advance offset once if allowed and transition to non-allowed state
-        if (passData->IsAllowedToAdvanceConstantBufferOffset)
-        {
-            passData->PassConstantBufferMemoryOffset += passData->LastSetConstantBufferDataSize;
-            passData->IsAllowedToAdvanceConstantBufferOffset = false;
-        }
-
-        passData->LastSetConstantBufferDataSize = alignedBytesToWrite;
-
-        // Allocate on demand
-        if (!passData->PassConstantBuffer || passData->PassConstantBuffer->Capacity() < newBufferSize)
-        {
-            uint64_t grownBufferSize = Foundation::MemoryUtils::Align(newBufferSize, GrowAlignment);
-            auto properties = HAL::BufferProperties::Create<uint8_t>(grownBufferSize, 1, HAL::ResourceState::ConstantBuffer);
-
-            passData->PassConstantBuffer = mResourceProducer->NewBuffer(properties, Memory::GPUResource::UploadStrategy::DirectAccess);
-            passData->PassConstantBuffer->SetDebugName(passNode.PassMetadata().Name.ToString() + " Constant Buffer");
-            passData->PassConstantData.resize(grownBufferSize);
-        }
-
-        passData->PassConstantBuffer->RequestWrite();
-
-        // Store data in CPU storage 
-        const uint8_t* data = reinterpret_cast<const uint8_t*>(&constants);
-        std::copy(data, data + sizeof(Constants), passData->PassConstantData.begin() + passData->PassConstantBufferMemoryOffset);
+        passData->PassConstantBufferAddress = AllocatePassConstants(&constants, sizeof(Constants));
     }
 
 }
\ No newline at end of file
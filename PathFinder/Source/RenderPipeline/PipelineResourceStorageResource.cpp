@@ -3,6 +3,7 @@
 #include <Foundation/StringUtils.hpp>
 
 #include <Foundation/STDHelpers.hpp>
+#include <robinhood/robin_hood.h>
 
 namespace PathFinder
 {
@@ -56,4 +57,27 @@ namespace PathFinder
         return equal;
     }
 
+    uint64_t PipelineResourceStorageResource::DiffEntry::Hash() const
+    {
+        uint64_t hash = 0;
+
+        auto combine = [&hash](uint64_t value)
+        {
+            hash ^= robin_hood::hash_int(value) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        };
+
+        combine(ResourceName.ToId());
+        combine(MemoryFootprint);
+        combine(CanBeAliased);
+        combine(std::underlying_type_t<HAL::ResourceState>(ExpectedStates));
+
+        if (CanBeAliased)
+        {
+            combine(LifetimeStart);
+            combine(LifetimeEnd);
+        }
+
+        return hash;
+    }
+
 }
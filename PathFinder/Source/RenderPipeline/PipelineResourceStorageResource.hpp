@@ -17,6 +17,9 @@ namespace PathFinder
         public:
             bool operator==(const DiffEntry& that) const;
 
+            // Hashes same fields that are compared for equality
+            uint64_t Hash() const;
+
             // Compare by name to detect new or deleted resources
             Foundation::Name ResourceName;
 
@@ -12,16 +12,12 @@ namespace PathFinder
     {
         for (auto& [asset, callback] : mAssets)
         {
-            asset->RequestRead();
+            asset->RequestRead().OnCompletion([asset = asset, callback = callback](const uint8_t*, const Memory::ReadbackFuture&)
+            {
+                callback(asset);
+            });
         }
-    }
 
-    void PreprocessableAssetStorage::ReportAllAssetsPostprocessed()
-    {
-        for (auto& [asset, callback] : mAssets)
-        {
-            callback(asset);
-        }
         mAssets.clear();
     }
 
@@ -13,8 +13,9 @@ namespace PathFinder
         using PostprocessCallback = std::function<void(Memory::GPUResource* asset)>;
 
         void PreprocessAsset(Memory::GPUResource* asset, const PostprocessCallback& callback);
+
+        // Postprocess callbacks are invoked as soon as readback of each asset completes
         void ReadbackAllAssets();
-        void ReportAllAssetsPostprocessed();
 
     private:
         std::vector<std::pair<Memory::GPUResource*, PostprocessCallback>> mAssets;
@@ -14,10 +14,12 @@ namespace PathFinder
         PipelineResourceStorage* resourceStorage,
         PipelineStateManager* pipelineStateManager,
         const RenderPassGraph* renderPassGraph,
+        FrameProfiler* frameProfiler,
         const RenderSurfaceDescription& defaultRenderSurface)
         :
         mGraphicsQueue{ device },
         mComputeQueue{ device },
+        mCopyQueue{ device },
         mDescriptorAllocator{ descriptorAllocator },
         mCommandListAllocator{ commandListAllocator },
         mResourceStateTracker{ resourceStateTracker },
@@ -25,13 +27,16 @@ namespace PathFinder
         mResourceStorage{ resourceStorage },
         mPipelineStateManager{ pipelineStateManager },
         mRenderPassGraph{ renderPassGraph },
+        mFrameProfiler{ frameProfiler },
         mDefaultRenderSurface{ defaultRenderSurface },
         mGraphicsQueueFence{ device },
         mComputeQueueFence{ device },
-        mBVHFence{ device }
+        mBVHFence{ device },
+        mCopyQueueFence{ device }
     {
         mGraphicsQueue.SetDebugName("Graphics Queue");
         mComputeQueue.SetDebugName("Async Compute Queue");
+        mCopyQueue.SetDebugName("Async Upload Queue");
     }
 
     RenderDevice::PassCommandLists& RenderDevice::CommandListsForNode(const RenderPassGraph::Node& node)
@@ -60,6 +65,10 @@ namespace PathFinder
         mPreRenderUploadsCommandList->Reset();
         mPreRenderUploadsCommandList->SetDebugName("Prerender Data Upload Cmd List");
         mEventTracker.StartGPUEvent("Prerender Data Upload", *mPreRenderUploadsCommandList);
+
+        mAsyncUploadsCommandList = mCommandListAllocator->AllocateCopyCommandList();
+        mAsyncUploadsCommandList->Reset();
+        mAsyncUploadsCommandList->SetDebugName("Async Data Upload Cmd List");
     }
 
     void RenderDevice::AllocateRTASBuildsCommandList()
@@ -72,6 +81,8 @@ namespace PathFinder
 
     void RenderDevice::AllocateWorkerCommandLists()
     {
+        mBarrierBatcher.ResetStatistics();
+
         mPassHelpers.resize(mRenderPassGraph->NodesInGlobalExecutionOrder().size());
 
         for (const RenderPassGraph::Node* node : mRenderPassGraph->NodesInGlobalExecutionOrder())
@@ -80,14 +91,16 @@ namespace PathFinder
             mPassHelpers[node->GlobalExecutionIndex()] = PassHelpers{};
             PassHelpers& helpers = mPassHelpers[node->GlobalExecutionIndex()];
             helpers.ResourceStoragePassData = mResourceStorage->GetPerPassData(node->PassMetadata().Name);
-            helpers.ResourceStoragePassData->LastSetConstantBufferDataSize = 0;
-            helpers.ResourceStoragePassData->PassConstantBufferMemoryOffset = 0;
-            helpers.ResourceStoragePassData->IsAllowedToAdvanceConstantBufferOffset = false;
+            helpers.ResourceStoragePassData->PassConstantBufferAddress = 0;
         }
 
+        mResourceStorage->ResetPassConstantArena();
+
         mPassCommandLists.clear();
         mPassCommandLists.resize(mRenderPassGraph->NodesInGlobalExecutionOrder().size());
 
+        mFrameProfiler->SetPassCount(mRenderPassGraph->NodesInGlobalExecutionOrder().size());
+
         // If memory layout did not change we reuse aliasing barriers from previous frame.
         // Otherwise we start from scratch.
         if (mResourceStorage->HasMemoryLayoutChange())
@@ -125,6 +138,9 @@ namespace PathFinder
                     mPassHelpers[node->GlobalExecutionIndex()].UAVBarriers.AddBarrier(HAL::UnorderedAccessResourceBarrier{ resourceData->GetGPUResource()->HALResource() });
                 }
             }
+
+            // Same UAV barriers are inserted between every draw/dispatch, optimize them once up front
+            mPassHelpers[node->GlobalExecutionIndex()].UAVBarriers.Optimize();
         }
     }
 
@@ -132,13 +148,22 @@ namespace PathFinder
     {
         // https://levelup.gitconnected.com/organizing-gpu-work-with-directed-acyclic-graphs-f3fd5f2c2af3
         //
+        // Sample clocks of every queue to put pass timestamps on a common timeline
+        for (auto queueIdx = 0u; queueIdx < mQueueCount; ++queueIdx)
+        {
+            mFrameProfiler->CalibrateQueue(queueIdx, GetCommandQueue(queueIdx));
+        }
+
         // Execute fixed workloads early to save correct fence values
         ExecuteUploadCommands();
+        ExecuteAsyncUploadCommands();
         ExecuteBVHBuildCommands();
 
         BatchCommandLists();
-        UploadPassConstants();
         ExetuteCommandLists();
+        WaitAsyncUploadsBeforeFrameEnd();
+
+        mFrameProfiler->SetBarrierStatistics(mBarrierBatcher.FrameStatistics());
     }
 
     void RenderDevice::BatchCommandLists()
@@ -407,6 +432,13 @@ namespace PathFinder
                     mostCompetentQueueBatches[reroutedTransitionsBatchIndex].EventNamesToWait.emplace_back(StringFormat("Waiting Queue %d (BVH Build)", mBVHBuildsQueueIndex));
                 }
 
+                // Transitions of async uploaded resources must happen after copy queue is done with them
+                if (mNodesWaitingForAsyncUploads.find(node) != mNodesWaitingForAsyncUploads.end())
+                {
+                    mostCompetentQueueBatches[reroutedTransitionsBatchIndex].FencesToWait.push_back({ &mCopyQueueFence, mCopyQueueFence.ExpectedValue() });
+                    mostCompetentQueueBatches[reroutedTransitionsBatchIndex].EventNamesToWait.emplace_back("Waiting Copy Queue (Async Uploads)");
+                }
+
                 CommandListBatch* latestBatchAfterRerouting = dependencyLevelPerQueueBatches[node->ExecutionQueueIndex];
 
                 if (!latestBatchAfterRerouting)
@@ -450,7 +482,7 @@ namespace PathFinder
         }
 
         transitionsCommandList->Reset();
-        transitionsCommandList->InsertBarriers(reroutedTransitionBarrires);
+        mBarrierBatcher.Submit(reroutedTransitionBarrires, *transitionsCommandList);
         transitionsCommandList->Close();
     }
 
@@ -480,8 +512,9 @@ namespace PathFinder
                 CommandListBatch* currentBatch = &mCommandListBatches[queueIdx].back();
 
                 bool usesRT = mRenderPassGraph->FirstNodeThatUsesRayTracing() == node;
+                bool waitsForAsyncUploads = mNodesWaitingForAsyncUploads.find(node) != mNodesWaitingForAsyncUploads.end();
 
-                if (!node->NodesToSyncWith().empty() || usesRT)
+                if (!node->NodesToSyncWith().empty() || usesRT || waitsForAsyncUploads)
                 {
                     if (!currentBatch->IsEmpty)
                     {
@@ -500,6 +533,12 @@ namespace PathFinder
                         currentBatch->FencesToWait.push_back({ &mBVHFence, mBVHFence.ExpectedValue() });
                         currentBatch->EventNamesToWait.emplace_back(StringFormat("Waiting Queue %d (BVH Build)", mBVHBuildsQueueIndex));
                     }
+
+                    if (waitsForAsyncUploads)
+                    {
+                        currentBatch->FencesToWait.push_back({ &mCopyQueueFence, mCopyQueueFence.ExpectedValue() });
+                        currentBatch->EventNamesToWait.emplace_back("Waiting Copy Queue (Async Uploads)");
+                    }
                 }
 
                 // On queues that do not require transition rerouting each node will have its own transition collection
@@ -523,7 +562,7 @@ namespace PathFinder
                     transitionsCommandList->SetDebugName(node->PassMetadata().Name.ToString() + " Transitions Cmd List");
                     transitionsCommandList->Reset();
                     mEventTracker.StartGPUEvent(node->PassMetadata().Name.ToString() + " Pre Work (Transitions)", *transitionsCommandList);
-                    transitionsCommandList->InsertBarriers(nodeBarriers);
+                    mBarrierBatcher.Submit(nodeBarriers, *transitionsCommandList);
                     mEventTracker.EndGPUEvent(*transitionsCommandList);
                     transitionsCommandList->Close();
 
@@ -590,7 +629,7 @@ namespace PathFinder
             // Read back resources
             if (readbackRequestsExist)
             {
-                cmdList->InsertBarriers(readbackInfo.ToCopyStateTransitions);
+                mBarrierBatcher.Submit(readbackInfo.ToCopyStateTransitions, *cmdList);
                 
                 for (const Memory::CopyRequestManager::CopyCommand& command : readbackInfo.CopyCommands)
                 {
@@ -599,7 +638,7 @@ namespace PathFinder
             }
 
             // Then apply begin and back buffer barriers
-            cmdList->InsertBarriers(barriers);
+            mBarrierBatcher.Submit(barriers, *cmdList);
 
             mEventTracker.EndGPUEvent(*cmdList);
             cmdList->Close();
@@ -623,12 +662,95 @@ namespace PathFinder
         }
     }
 
+    void RenderDevice::SetAsyncUploadBatch(AsyncUploadBatch&& batch)
+    {
+        mAsyncUploadBatch = std::move(batch);
+    }
+
+    void RenderDevice::ExecuteAsyncUploadCommands()
+    {
+        mNodesWaitingForAsyncUploads.clear();
+        mBVHBuildsWaitForAsyncUploads = false;
+
+        if (mAsyncUploadBatch.UploadedResources.empty())
+        {
+            return;
+        }
+
+        // Preparation transitions are executed and resources that are uploaded to again are released by earlier work
+        if (mAsyncUploadBatch.RequiresGraphicsQueueSync)
+        {
+            mEventTracker.StartGPUEvent("Waiting Upload Preparation on Graphics Queue", mCopyQueue);
+            mCopyQueue.WaitFence(mGraphicsQueueFence);
+            mEventTracker.EndGPUEvent(mCopyQueue);
+        }
+
+        mCopyQueue.ExecuteCommandList(*mAsyncUploadsCommandList);
+
+        mEventTracker.StartGPUEvent("Async Uploads Done Signal", mCopyQueue);
+        mCopyQueue.SignalFence(mCopyQueueFence, mCopyQueueFence.IncrementExpectedValue());
+        mEventTracker.EndGPUEvent(mCopyQueue);
+
+        bool hasResourcesUnknownToGraph = false;
+
+        // Hand off render graph resources to their first consumer, known from usage timelines
+        for (const HAL::Resource* resource : mAsyncUploadBatch.UploadedResources)
+        {
+            const PipelineResourceStorageResource* resourceData = mResourceStorage->GetPerResourceData(resource);
+
+            if (!resourceData)
+            {
+                hasResourcesUnknownToGraph = true;
+                continue;
+            }
+
+            std::optional<uint64_t> firstUsageIndex;
+
+            auto findFirstUsage = [&](Foundation::Name name)
+            {
+                if (!mRenderPassGraph->IsResourceUsed(name)) return;
+                uint64_t usageIndex = mRenderPassGraph->GetResourceUsageTimeline(name).first;
+                firstUsageIndex = std::min(firstUsageIndex.value_or(usageIndex), usageIndex);
+            };
+
+            findFirstUsage(resourceData->ResourceName());
+
+            for (Foundation::Name alias : resourceData->SchedulingInfo.Aliases())
+            {
+                findFirstUsage(alias);
+            }
+
+            // Resources unused this frame are covered by end of frame wait
+            if (firstUsageIndex)
+            {
+                mNodesWaitingForAsyncUploads.insert(mRenderPassGraph->NodesInGlobalExecutionOrder()[*firstUsageIndex]);
+            }
+        }
+
+        if (hasResourcesUnknownToGraph)
+        {
+            mBVHBuildsWaitForAsyncUploads = true;
+
+            std::vector<bool> queuesWithFirstNodeFound(mQueueCount, false);
+
+            for (const RenderPassGraph::Node* node : mRenderPassGraph->NodesInGlobalExecutionOrder())
+            {
+                if (!queuesWithFirstNodeFound[node->ExecutionQueueIndex])
+                {
+                    queuesWithFirstNodeFound[node->ExecutionQueueIndex] = true;
+                    mNodesWaitingForAsyncUploads.insert(node);
+                }
+            }
+        }
+    }
+
     void RenderDevice::ExecuteUploadCommands()
     {
-        // Run initial upload commands
+        // Prepare resources for copy queue uploads
         mGraphicsQueueFence.IncrementExpectedValue();
         // Transition uploaded resources to readable states
-        mPreRenderUploadsCommandList->InsertBarriers(mResourceStateTracker->ApplyRequestedTransitions());
+        HAL::ResourceBarrierCollection uploadedResourcesTransitions = mResourceStateTracker->ApplyRequestedTransitions();
+        mBarrierBatcher.Submit(uploadedResourcesTransitions, *mPreRenderUploadsCommandList);
         mGraphicsQueue.ExecuteCommandList(*mPreRenderUploadsCommandList);
         mEventTracker.EndGPUEvent(mGraphicsQueue);
 
@@ -637,6 +759,23 @@ namespace PathFinder
         mEventTracker.EndGPUEvent(mGraphicsQueue);
     }
 
+    void RenderDevice::WaitAsyncUploadsBeforeFrameEnd()
+    {
+        if (mAsyncUploadBatch.UploadedResources.empty())
+        {
+            return;
+        }
+
+        // Upload buffers are released by frame fence signaled on graphics queue,
+        // so it must also cover uploads of resources nobody consumed this frame.
+        // Copy is normally long done by now, so the wait is effectively free.
+        mEventTracker.StartGPUEvent("Waiting Async Uploads on Copy Queue", mGraphicsQueue);
+        mGraphicsQueue.WaitFence(mCopyQueueFence);
+        mEventTracker.EndGPUEvent(mGraphicsQueue);
+
+        mAsyncUploadBatch = {};
+    }
+
     void RenderDevice::ExecuteBVHBuildCommands()
     {
         // Wait for uploads, run RT AS builds
@@ -646,6 +785,13 @@ namespace PathFinder
         mComputeQueue.WaitFence(mGraphicsQueueFence);
         mEventTracker.EndGPUEvent(mComputeQueue);
 
+        if (mBVHBuildsWaitForAsyncUploads)
+        {
+            mEventTracker.StartGPUEvent("Waiting Async Uploads on Copy Queue", mComputeQueue);
+            mComputeQueue.WaitFence(mCopyQueueFence);
+            mEventTracker.EndGPUEvent(mComputeQueue);
+        }
+
         mComputeQueue.ExecuteCommandList(*mRTASBuildsCommandList);
         mEventTracker.EndGPUEvent(mComputeQueue);
 
@@ -691,18 +837,6 @@ namespace PathFinder
         }
     }
 
-    void RenderDevice::UploadPassConstants()
-    {
-        for (PassHelpers& passHelpers : mPassHelpers)
-        {
-            if (Memory::Buffer* passConstantBuffer = passHelpers.ResourceStoragePassData->PassConstantBuffer.get())
-            {
-                const auto& bytes = passHelpers.ResourceStoragePassData->PassConstantData;
-                passConstantBuffer->Write(bytes.data(), 0, bytes.size());
-            }
-        }
-    }
-
     bool RenderDevice::IsStateTransitionSupportedOnQueue(uint64_t queueIndex, HAL::ResourceState beforeState, HAL::ResourceState afterState) const
     {
         return IsStateTransitionSupportedOnQueue(queueIndex, beforeState) && IsStateTransitionSupportedOnQueue(queueIndex, afterState);
@@ -4,6 +4,9 @@
 #include "PipelineResourceStorage.hpp"
 #include "PipelineStateManager.hpp"
 #include "RenderPassMetadata.hpp"
+#include "FrameProfiler.hpp"
+#include "BarrierBatcher.hpp"
+#include "CopyRequestHandling.hpp"
 
 #include <Foundation/Name.hpp>
 #include <Utility/EventTracker.hpp>
@@ -83,6 +86,7 @@ namespace PathFinder
             PipelineResourceStorage* resourceStorage,
             PipelineStateManager* pipelineStateManager,
             const RenderPassGraph* renderPassGraph,
+            FrameProfiler* frameProfiler,
             const RenderSurfaceDescription& defaultRenderSurface
         );
 
@@ -102,6 +106,9 @@ namespace PathFinder
 
         void ExecuteRenderGraph();
 
+        // Uploads recorded into async uploads command list for copy queue in current frame
+        void SetAsyncUploadBatch(AsyncUploadBatch&& batch);
+
         template <class Lambda>
         void RecordWorkerCommandList(const RenderPassGraph::Node& passNode, const Lambda& action);
 
@@ -141,7 +148,6 @@ namespace PathFinder
 
         void BatchCommandLists();
         void ExetuteCommandLists();
-        void UploadPassConstants();
 
         void GatherResourceTransitionKnowledge(const RenderPassGraph::DependencyLevel& dependencyLevel);
         void CollectNodeTransitions(const RenderPassGraph::Node* node, uint64_t currentCommandListBatchIndex, HAL::ResourceBarrierCollection& collection);
@@ -150,7 +156,9 @@ namespace PathFinder
         void RecordPostWorkCommandLists();
         void InsertCommandListsIntoCorrespondingBatches();
         void ExecuteUploadCommands();
+        void ExecuteAsyncUploadCommands();
         void ExecuteBVHBuildCommands();
+        void WaitAsyncUploadsBeforeFrameEnd();
 
         bool IsStateTransitionSupportedOnQueue(uint64_t queueIndex, HAL::ResourceState beforeState, HAL::ResourceState afterState) const;
         bool IsStateTransitionSupportedOnQueue(uint64_t queueIndex, HAL::ResourceState afterState) const;
@@ -171,22 +179,27 @@ namespace PathFinder
         PipelineResourceStorage* mResourceStorage;
         PipelineStateManager* mPipelineStateManager;
         const RenderPassGraph* mRenderPassGraph;
+        FrameProfiler* mFrameProfiler;
         RenderSurfaceDescription mDefaultRenderSurface;
         EventTracker mEventTracker;
+        BarrierBatcher mBarrierBatcher;
 
         Memory::Texture* mBackBuffer = nullptr;
         Memory::PoolCommandListAllocator::GraphicsCommandListPtr mPreRenderUploadsCommandList;
         Memory::PoolCommandListAllocator::ComputeCommandListPtr mRTASBuildsCommandList;
+        Memory::PoolCommandListAllocator::CopyCommandListPtr mAsyncUploadsCommandList;
         std::vector<PassCommandLists> mPassCommandLists;
         std::vector<CommandListPtrVariant> mReroutedTransitionsCommandLists;
         std::vector<std::vector<CommandListBatch>> mCommandListBatches;
         std::vector<PassHelpers> mPassHelpers;
         HAL::GraphicsCommandQueue mGraphicsQueue;
         HAL::ComputeCommandQueue mComputeQueue;
+        HAL::CopyCommandQueue mCopyQueue;
 
         HAL::Fence mGraphicsQueueFence;
         HAL::Fence mComputeQueueFence;
         HAL::Fence mBVHFence;
+        HAL::Fence mCopyQueueFence;
         uint64_t mQueueCount = 2;
         uint64_t mBVHBuildsQueueIndex = 1;
 
@@ -211,12 +224,24 @@ namespace PathFinder
         // Collect readback requests to be executed after passes that require them
         std::vector<ResourceReadbackInfo> mPerNodeReadbackInfo;
 
+        // Uploads executed on copy queue in current frame
+        AsyncUploadBatch mAsyncUploadBatch;
+
+        // First consumers of async uploaded resources, which wait for copy queue
+        robin_hood::unordered_flat_set<const RenderPassGraph::Node*> mNodesWaitingForAsyncUploads;
+
+        // Consumers of resources unknown to render graph can't be determined, 
+        // so first work on every queue, including BVH builds, waits for copy queue
+        bool mBVHBuildsWaitForAsyncUploads = false;
+
     public:
         inline HAL::GraphicsCommandQueue& GraphicsCommandQueue() { return mGraphicsQueue; }
         inline HAL::ComputeCommandQueue& ComputeCommandQueue() { return mComputeQueue; }
         inline HAL::GraphicsCommandList* PreRenderUploadsCommandList() { return mPreRenderUploadsCommandList.get(); }
         inline HAL::ComputeCommandList* RTASBuildsCommandList() { return mRTASBuildsCommandList.get(); }
+        inline HAL::CopyCommandList* AsyncUploadsCommandList() { return mAsyncUploadsCommandList.get(); }
         inline const RenderSurfaceDescription& DefaultRenderSurfaceDesc() { return mDefaultRenderSurface; }
+        inline BarrierBatcher& Barriers() { return mBarrierBatcher; }
     };
 
 }
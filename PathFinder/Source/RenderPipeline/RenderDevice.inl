@@ -18,7 +18,9 @@ namespace PathFinder
         }
 
         worker->SetDescriptorHeaps(mDescriptorAllocator->CBSRUADescriptorHeap(), mDescriptorAllocator->SamplerDescriptorHeap());
+        mFrameProfiler->BeginPass(passNode, *worker);
         action();
+        mFrameProfiler->EndPass(passNode, *worker);
         mEventTracker.EndGPUEvent(*worker);
         worker->Close();
     }
@@ -12,6 +12,7 @@
 
 #include <Scene/Scene.hpp>
 #include <Foundation/Event.hpp>
+#include <Foundation/TaskScheduler.hpp>
 #include <IO/CommandLineParser.hpp>
 #include <Utility/AftermathCrashTracker.hpp>
 
@@ -33,6 +34,7 @@
 #include "PipelineResourceStorage.hpp"
 #include "PreprocessableAssetStorage.hpp"
 #include "RenderDevice.hpp"
+#include "FrameProfiler.hpp"
 #include "ShaderManager.hpp"
 #include "PipelineStateManager.hpp"
 #include "RenderContext.hpp"
@@ -62,6 +64,8 @@ namespace PathFinder
         void AddTopRayTracingAccelerationStructure(const TopRTAS* topRTAS);
 
         void SetContentMediator(ContentMediator* mediator);
+        void SetPassOrderingPolicy(RenderPassGraph::OrderingPolicy policy);
+        void SetQueueAssignmentPolicy(RenderPassGraph::QueueAssignmentPolicy policy);
 
         template <class Constants>
         void SetGlobalRootConstants(const Constants& constants);
@@ -77,19 +81,24 @@ namespace PathFinder
         void BuildAccelerationStructures();
         void RecordCommandLists();
         void ScheduleFrame();
+        void EstimatePassCosts();
         void UpdateBackBuffers();
 
         RenderPassGraph mRenderPassGraph;
+        RenderPassGraph::OrderingPolicy mPassOrderingPolicy = RenderPassGraph::OrderingPolicy::DependencyDepth;
+        RenderPassGraph::QueueAssignmentPolicy mQueueAssignmentPolicy = RenderPassGraph::QueueAssignmentPolicy::Manual;
 
         uint8_t mCurrentBackBufferIndex = 0;
         uint8_t mSimultaneousFramesInFlight = 2;
         uint64_t mFrameNumber = 0;
         std::chrono::time_point<std::chrono::steady_clock> mFrameStartTimestamp;
         std::chrono::microseconds mFrameDuration = std::chrono::microseconds::zero();
+        std::chrono::microseconds mFenceWaitDuration = std::chrono::microseconds::zero();
 
         RenderSurfaceDescription mRenderSurfaceDescription;
         HAL::DisplayAdapterFetcher mAdapterFetcher;
 
+        std::unique_ptr<Foundation::TaskScheduler> mTaskScheduler;
         std::unique_ptr<HAL::Device> mDevice;
 
         std::unique_ptr<Memory::SegregatedPoolsResourceAllocator> mResourceAllocator;
@@ -110,6 +119,7 @@ namespace PathFinder
         std::unique_ptr<PipelineStateManager> mPipelineStateManager;
         std::unique_ptr<PipelineStateCreator> mPipelineStateCreator;
         std::unique_ptr<RootSignatureCreator> mRootSignatureCreator;
+        std::unique_ptr<FrameProfiler> mFrameProfiler;
         std::unique_ptr<RenderDevice> mRenderDevice;
         std::unique_ptr<RenderPassContainer<ContentMediator>> mRenderPassContainer;
 
@@ -131,12 +141,17 @@ namespace PathFinder
         inline PipelineResourceStorage* ResourceStorage() { return mPipelineResourceStorage.get(); }
         inline const RenderSurfaceDescription& RenderSurface() const { return mRenderSurfaceDescription; }
         inline Memory::GPUResourceProducer* ResourceProducer() { return mResourceProducer.get(); }
+        inline const Memory::SegregatedPoolsResourceAllocator* ResourceAllocator() const { return mResourceAllocator.get(); }
         inline HAL::Device* Device() { return mDevice.get(); }
+        inline Foundation::TaskScheduler* TaskScheduler() { return mTaskScheduler.get(); }
         inline HAL::SwapChain* SwapChain() { return mSwapChain.get(); }
         inline HAL::DisplayAdapter* SelectedAdapter() { return mSelectedAdapter; }
+        inline const FrameProfiler* Profiler() const { return mFrameProfiler.get(); }
         inline Event& PreRenderEvent() { return mPreRenderEvent; }
         inline Event& PostRenderEvent() { return mPostRenderEvent; }
         inline uint64_t FrameDurationUS() const { return mFrameDuration.count(); }
+        inline uint64_t FenceWaitDurationUS() const { return mFenceWaitDuration.count(); }
+        inline uint8_t SimultaneousFramesInFlight() const { return mSimultaneousFramesInFlight; }
     };
 
 }
@@ -2,6 +2,7 @@
 #include "CopyRequestHandling.hpp"
 
 #include <pix.h>
+#include <optick/optick.h>
 
 namespace PathFinder
 {
@@ -23,6 +24,11 @@ namespace PathFinder
             mAftermathCrashTracker->Initialize();
         }
 
+        mSimultaneousFramesInFlight = commandLineParser.SimultaneousFramesInFlight();
+
+        // Engine is constructed on the main thread, which scheduler uses for main thread affine tasks
+        mTaskScheduler = std::make_unique<Foundation::TaskScheduler>();
+
         HAL::DisplayAdapter* hwAdapter = &mAdapterFetcher.GetHardwareAdapter(0);
         mSelectedAdapter = hwAdapter;
 
@@ -45,7 +51,8 @@ namespace PathFinder
             mResourceAllocator.get(), 
             mResourceStateTracker.get(), 
             mDescriptorAllocator.get(),
-            mCopyRequestManager.get());
+            mCopyRequestManager.get(),
+            mTaskScheduler.get());
 
         mPipelineResourceStorage = std::make_unique<PipelineResourceStorage>(
             mDevice.get(), 
@@ -55,6 +62,11 @@ namespace PathFinder
             mRenderSurfaceDescription, 
             &mRenderPassGraph);
 
+        PipelineResourceStorage::HeapGrowthSettings heapGrowthSettings;
+        heapGrowthSettings.Slack = commandLineParser.HeapGrowthSlack().value_or(heapGrowthSettings.Slack);
+        heapGrowthSettings.ShrinkThreshold = commandLineParser.HeapShrinkThreshold().value_or(heapGrowthSettings.ShrinkThreshold);
+        mPipelineResourceStorage->SetHeapGrowthSettings(heapGrowthSettings);
+
         mResourceScheduler = std::make_unique<ResourceScheduler>(
             mPipelineResourceStorage.get(),
             mPassUtilityProvider.get(),
@@ -76,6 +88,7 @@ namespace PathFinder
         mPipelineStateCreator = std::make_unique<PipelineStateCreator>(mPipelineStateManager.get());
         mRootSignatureCreator = std::make_unique<RootSignatureCreator>(mPipelineStateManager.get());
         mSamplerCreator = std::make_unique<SamplerCreator>(mPipelineResourceStorage.get());
+        mFrameProfiler = std::make_unique<FrameProfiler>(*mDevice, mSimultaneousFramesInFlight);
 
         mRenderDevice = std::make_unique<RenderDevice>(
             *mDevice,
@@ -86,14 +99,16 @@ namespace PathFinder
             mPipelineResourceStorage.get(), 
             mPipelineStateManager.get(), 
             &mRenderPassGraph, 
+            mFrameProfiler.get(),
             mRenderSurfaceDescription);
 
+        // One back buffer per frame in flight, so that CPU never waits for presentation to free a buffer
         mSwapChain = std::make_unique<HAL::SwapChain>(
             &hwAdapter->Displays().front(),
             mRenderDevice->GraphicsCommandQueue(),
             windowHandle,
             true,
-            HAL::BackBufferingStrategy::Double, 
+            HAL::BackBufferingStrategy(mSimultaneousFramesInFlight), 
             mRenderSurfaceDescription.Dimensions());
 
         mRenderPassContainer = std::make_unique<RenderPassContainer<ContentMediator>>(
@@ -140,11 +155,27 @@ namespace PathFinder
         mContentMediator = mediator;
     }
 
+    template <class ContentMediator>
+    void RenderEngine<ContentMediator>::SetPassOrderingPolicy(RenderPassGraph::OrderingPolicy policy)
+    {
+        mPassOrderingPolicy = policy;
+    }
+
+    template <class ContentMediator>
+    void RenderEngine<ContentMediator>::SetQueueAssignmentPolicy(RenderPassGraph::QueueAssignmentPolicy policy)
+    {
+        mQueueAssignmentPolicy = policy;
+    }
+
     template <class ContentMediator>
     void RenderEngine<ContentMediator>::Render()
     {
         if (mRenderPassGraph.Nodes().empty()) return;
 
+        OPTICK_FRAME("Main Thread");
+
+        mTaskScheduler->ExecuteMainThreadTasks();
+
         // First frame statrts in constructor
         if (mFrameNumber > 0)
         {
@@ -154,13 +185,22 @@ namespace PathFinder
         }
 
         // Scheduler resources, build graph
-        ScheduleFrame();
+        {
+            FrameProfiler::CPUScope scope{ mFrameProfiler.get(), "Schedule Frame" };
+            ScheduleFrame();
+        }
 
         // Compile new states and signatures, if any
-        mPipelineStateManager->CompileUncompiledSignaturesAndStates();
+        {
+            FrameProfiler::CPUScope scope{ mFrameProfiler.get(), "Compile States" };
+            mPipelineStateManager->CompileUncompiledSignaturesAndStates();
+        }
 
         // Notify external listeners
-        mPreRenderEvent.Raise();
+        {
+            FrameProfiler::CPUScope scope{ mFrameProfiler.get(), "Pre Render Event" };
+            mPreRenderEvent.Raise();
+        }
 
         // External listeners might've caused back buffer reallocation
         if (mSwapChain->AreBackBuffersUpdated())
@@ -169,20 +209,45 @@ namespace PathFinder
         // Update render device with current frame back buffer
         mRenderDevice->SetBackBuffer(mBackBuffers[mCurrentBackBufferIndex].get());
 
-        UploadAssets();
-        BuildAccelerationStructures();
+        {
+            FrameProfiler::CPUScope scope{ mFrameProfiler.get(), "Upload Assets" };
+            UploadAssets();
+        }
+
+        {
+            FrameProfiler::CPUScope scope{ mFrameProfiler.get(), "Build Acceleration Structures" };
+            BuildAccelerationStructures();
+        }
 
         // Render
-        mRenderDevice->AllocateWorkerCommandLists();
-        RecordCommandLists();
-        mRenderDevice->ExecuteRenderGraph();
+        {
+            FrameProfiler::CPUScope scope{ mFrameProfiler.get(), "Record Command Lists" };
+            mRenderDevice->AllocateWorkerCommandLists();
+            RecordCommandLists();
+        }
+
+        {
+            FrameProfiler::CPUScope scope{ mFrameProfiler.get(), "Execute Render Graph" };
+            mRenderDevice->ExecuteRenderGraph();
+        }
 
         // Put the picture on the screen
-        mSwapChain->Present();
+        {
+            FrameProfiler::CPUScope scope{ mFrameProfiler.get(), "Present" };
+            mSwapChain->Present();
+        }
 
         // Issue a CPU wait if necessary
-        mRenderDevice->GraphicsCommandQueue().SignalFence(*mFrameFence);
-        mFrameFence->StallCurrentThreadUntilCompletion(mSimultaneousFramesInFlight);
+        {
+            FrameProfiler::CPUScope scope{ mFrameProfiler.get(), "Wait For GPU" };
+            mRenderDevice->GraphicsCommandQueue().SignalFence(*mFrameFence);
+
+            using namespace std::chrono;
+            auto waitStartTimestamp = steady_clock::now();
+            mFrameFence->StallCurrentThreadUntilCompletion(mSimultaneousFramesInFlight);
+            mFenceWaitDuration = duration_cast<microseconds>(steady_clock::now() - waitStartTimestamp);
+            mFrameProfiler->SetFenceWaitTime(mFenceWaitDuration.count() / 1000.0);
+        }
 
         // Notify internal listeners
         NotifyEndFrame(mFrameFence->CompletedValue());
@@ -208,6 +273,7 @@ namespace PathFinder
         mDescriptorAllocator->BeginFrame(newFrameNumber);
         mCommandListAllocator->BeginFrame(newFrameNumber);
         mResourceProducer->BeginFrame(newFrameNumber);
+        mFrameProfiler->BeginFrame(newFrameNumber);
 
         mFrameStartTimestamp = std::chrono::steady_clock::now();
     }
@@ -221,6 +287,8 @@ namespace PathFinder
         mResourceAllocator->EndFrame(completedFrameNumber);
         mDescriptorAllocator->EndFrame(completedFrameNumber);
         mCommandListAllocator->EndFrame(completedFrameNumber);
+        mFrameProfiler->SetReadbackStatistics(mResourceProducer->ReadbackStatistics());
+        mFrameProfiler->EndFrame(completedFrameNumber);
 
         using namespace std::chrono;
         mFrameDuration = duration_cast<microseconds>(steady_clock::now() - mFrameStartTimestamp);
@@ -241,7 +309,12 @@ namespace PathFinder
     void RenderEngine<ContentMediator>::UploadAssets()
     {
         mRenderDevice->AllocateUploadCommandList();
-        RecordUploadRequests(*mRenderDevice->PreRenderUploadsCommandList(), *mResourceStateTracker, *mCopyRequestManager, true);
+
+        // Uploads go to copy queue and overlap graphics work, consumers wait for them on first use
+        mRenderDevice->SetAsyncUploadBatch(RecordAsyncUploadRequests(
+            *mRenderDevice->AsyncUploadsCommandList(), *mRenderDevice->PreRenderUploadsCommandList(), *mResourceStateTracker, *mCopyRequestManager));
+
+        mRenderDevice->AsyncUploadsCommandList()->Close();
         mRenderDevice->PreRenderUploadsCommandList()->Close();
 
         assert_format(mCopyRequestManager->ReadbackRequests().empty(), "We shouldn't have any readback requests at this stage");
@@ -315,6 +388,12 @@ namespace PathFinder
     {
         mRenderPassGraph.Clear();
 
+        // Consumers may adapt their scheduling to disabled producers, so all passes report first
+        for (auto& [passName, passHelpers] : mRenderPassContainer->RenderPasses())
+        {
+            mRenderPassGraph.Nodes()[passHelpers.GraphNodeIndex].IsDisabled = !passHelpers.Pass->IsEnabled(mContentMediator);
+        }
+
         // Run scheduling for standard render passes
         mPipelineResourceStorage->StartResourceScheduling();
 
@@ -355,16 +434,66 @@ namespace PathFinder
 
         mPipelineResourceStorage->EndResourceScheduling();
 
+        if (mQueueAssignmentPolicy != RenderPassGraph::QueueAssignmentPolicy::Manual)
+        {
+            EstimatePassCosts();
+        }
+
         // Finish graph and allocate memory 
-        mRenderPassGraph.Build();
+        mRenderPassGraph.Build(mPassOrderingPolicy, mQueueAssignmentPolicy, [this](Foundation::Name resourceName)
+        {
+            return mPipelineResourceStorage->GetTransientResourceFootprint(resourceName);
+        });
+
         mPipelineResourceStorage->AllocateScheduledResources();
     }
 
+    template <class ContentMediator>
+    void RenderEngine<ContentMediator>::EstimatePassCosts()
+    {
+        const FrameProfiler::FrameTiming* frame = mFrameProfiler->MostRecentFrame();
+
+        if (!frame)
+        {
+            return;
+        }
+
+        robin_hood::unordered_flat_map<Foundation::Name, float> measuredCosts;
+
+        for (const FrameProfiler::PassTiming& pass : frame->Passes)
+        {
+            measuredCosts[pass.PassName] = pass.GPUEndMS - pass.GPUStartMS;
+        }
+
+        if (measuredCosts.empty())
+        {
+            return;
+        }
+
+        float totalMeasuredCost = 0.0f;
+
+        for (const auto& [passName, cost] : measuredCosts)
+        {
+            totalMeasuredCost += cost;
+        }
+
+        // Passes that were not executed last frame are assumed to be average in milliseconds,
+        // a unitless default would be meaningless next to measured costs
+        float meanMeasuredCost = totalMeasuredCost / measuredCosts.size();
+
+        for (RenderPassGraph::Node& node : mRenderPassGraph.Nodes())
+        {
+            auto costIt = measuredCosts.find(node.PassMetadata().Name);
+            node.EstimatedCost = costIt != measuredCosts.end() ? costIt->second : meanMeasuredCost;
+        }
+    }
+
     template <class ContentMediator>
     void RenderEngine<ContentMediator>::UpdateBackBuffers()
     {
+        // Back buffers can only be released when GPU is idle regardless of frames in flight count.
         // Because this function is called before rendering, but after new frame fence increase,
-        // we pass 2 instead of 1 to stall CPU thread
+        // we pass 2 instead of 1 to wait for all submitted frames
         mFrameFence->StallCurrentThreadUntilCompletion(2);
         mBackBuffers.clear();
 
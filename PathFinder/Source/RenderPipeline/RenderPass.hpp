@@ -31,6 +31,10 @@ namespace PathFinder
         virtual void ScheduleSamplers(SamplerCreator* samplerCreator) {};
         virtual void Render(RenderContext<ContentMediator>* context) {};
 
+        // Queried every frame before scheduling. Disabled passes still schedule resources for their consumers to resolve,
+        // but are culled from the graph together with passes that only they depend on.
+        virtual bool IsEnabled(const ContentMediator*) const { return true; }
+
     private:
         RenderPassMetadata mMetadata;
 
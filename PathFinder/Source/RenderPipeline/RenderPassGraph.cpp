@@ -1,6 +1,10 @@
 #include "RenderPassGraph.hpp"
 
-#include "RenderPass.hpp"
+#include <Foundation/Assert.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 
 
 
@@ -40,18 +44,32 @@ namespace PathFinder
         return it->second;
     }
 
+    const RenderPassGraph::Node& RenderPassGraph::GetNode(Foundation::Name passName) const
+    {
+        auto it = mRenderPassRegistry.find(passName);
+        assert_format(it != mRenderPassRegistry.end(), "Render pass ", passName.ToString(), " is not added to the graph.");
+        return mPassNodes[it->second];
+    }
+
     uint64_t RenderPassGraph::AddPass(const RenderPassMetadata& passMetadata)
     {
-        EnsureRenderPassUniqueness(passMetadata.Name);
+        EnsureRenderPassUniqueness(passMetadata.Name, mPassNodes.size());
         mPassNodes.emplace_back(Node{ passMetadata, &mGlobalWriteDependencyRegistry });
         mPassNodes.back().mIndexInUnorderedList = mPassNodes.size() - 1;
         return mPassNodes.size() - 1;
     }
 
-    void RenderPassGraph::Build()
+    void RenderPassGraph::Build(OrderingPolicy orderingPolicy, QueueAssignmentPolicy queueAssignmentPolicy, const TransientResourceFootprintQuery& footprintQuery)
     {
+        mOrderingPolicy = orderingPolicy;
+        mQueueAssignmentPolicy = queueAssignmentPolicy;
+        mTransientResourceFootprintQuery = footprintQuery;
+
+        CullUnreachableNodes();
         BuildAdjacencyLists();
         TopologicalSort();
+        AssignExecutionQueues();
+        BuildCrossQueueDependencies();
         BuildDependencyLevels();
         FinalizeDependencyLevels();
         CullRedundantSynchronizations();
@@ -66,8 +84,14 @@ namespace PathFinder
         mTopologicallySortedNodes.clear();
         mNodesInGlobalExecutionOrder.clear();
         mAdjacencyLists.clear();
+        mWrittenSubresourceToPassMap.clear();
         mFirstNodeThatUsesRayTracing = nullptr;
         mDetectedQueueCount = 1;
+        mCulledNodeCount = 0;
+        mNodeTransientResources.clear();
+        mDependencyDepthOrderTransientMemoryPeak = 0;
+        mTransientMemoryPeak = 0;
+        mCriticalPathCost = 0.0f;
 
         for (Node& node : mPassNodes)
         {
@@ -75,12 +99,82 @@ namespace PathFinder
         }
     }
 
-    void RenderPassGraph::EnsureRenderPassUniqueness(Foundation::Name passName)
+    void RenderPassGraph::EnsureRenderPassUniqueness(Foundation::Name passName, uint64_t nodeIndex)
     {
         assert_format(mRenderPassRegistry.find(passName) == mRenderPassRegistry.end(),
             "Render pass ", passName.ToString(), " is already added to the graph.");
 
-        mRenderPassRegistry.insert(passName);
+        mRenderPassRegistry[passName] = nodeIndex;
+    }
+
+    void RenderPassGraph::CullUnreachableNodes()
+    {
+        robin_hood::unordered_flat_map<SubresourceName, uint64_t> writers;
+
+        for (auto nodeIdx = 0; nodeIdx < mPassNodes.size(); ++nodeIdx)
+        {
+            for (SubresourceName subresourceName : mPassNodes[nodeIdx].WrittenSubresources())
+            {
+                writers[subresourceName] = nodeIdx;
+            }
+        }
+
+        SubresourceName backBufferSubresource = ConstructSubresourceName(Node::BackBufferName, 0);
+        std::vector<uint64_t> liveNodeStack;
+
+        // Graph sinks: passes that output to the screen, to the CPU or to the next frame
+        for (auto nodeIdx = 0; nodeIdx < mPassNodes.size(); ++nodeIdx)
+        {
+            Node& node = mPassNodes[nodeIdx];
+
+            bool isSink = !node.IsDisabled && (node.ExportsResources || node.WritesCrossFrameReadResources || node.WrittenSubresources().contains(backBufferSubresource) ||
+                std::any_of(node.WrittenSubresources().begin(), node.WrittenSubresources().end(), [this](SubresourceName subresourceName)
+                {
+                    return mCrossFrameReadSubresources.contains(subresourceName);
+                }));
+
+            node.mIsCulled = !isSink;
+
+            if (isSink)
+            {
+                liveNodeStack.push_back(nodeIdx);
+            }
+        }
+
+        SubresourceSet crossFrameReadSubresources;
+
+        // Walk dependencies backwards from sinks, whatever is not reached contributes to nothing
+        while (!liveNodeStack.empty())
+        {
+            const Node& node = mPassNodes[liveNodeStack.back()];
+            liveNodeStack.pop_back();
+
+            auto markWriterLive = [&](SubresourceName subresourceName)
+            {
+                auto writerIt = writers.find(subresourceName);
+
+                if (writerIt == writers.end())
+                {
+                    crossFrameReadSubresources.insert(subresourceName);
+                    return;
+                }
+
+                Node& writer = mPassNodes[writerIt->second];
+
+                // Dependency walk stops at disabled passes, so whatever only they consume stays culled
+                if (writer.mIsCulled && !writer.IsDisabled)
+                {
+                    writer.mIsCulled = false;
+                    liveNodeStack.push_back(writerIt->second);
+                }
+            };
+
+            for (SubresourceName subresourceName : node.ReadSubresources()) markWriterLive(subresourceName);
+            for (SubresourceName subresourceName : node.mAliasedSubresources) markWriterLive(subresourceName);
+        }
+
+        mCrossFrameReadSubresources = std::move(crossFrameReadSubresources);
+        mCulledNodeCount = std::count_if(mPassNodes.begin(), mPassNodes.end(), [](const Node& node) { return node.mIsCulled; });
     }
 
     void RenderPassGraph::BuildAdjacencyLists()
@@ -91,7 +185,7 @@ namespace PathFinder
         {
             Node& node = mPassNodes[nodeIdx];
 
-            if (!node.HasAnyDependencies())
+            if (!node.HasAnyDependencies() || node.IsCulled())
             {
                 continue;
             }
@@ -105,6 +199,8 @@ namespace PathFinder
 
                 Node& otherNode = mPassNodes[otherNodeIdx];
 
+                if (otherNode.IsCulled()) continue;
+
                 auto establishAdjacency = [&](SubresourceName otherNodeReadResource) -> bool
                 {
                     // If other node reads a subresource written by the current node, then it depends on current node and is an adjacent dependency
@@ -114,13 +210,6 @@ namespace PathFinder
                     if (otherNodeDependsOnCurrentNode)
                     {
                         adjacentNodeIndices.push_back(otherNodeIdx);
-
-                        if (node.ExecutionQueueIndex != otherNode.ExecutionQueueIndex)
-                        {
-                            node.mSyncSignalRequired = true;
-                            otherNode.mNodesToSyncWith.push_back(&node);
-                        }
-
                         return true;
                     }
 
@@ -178,8 +267,8 @@ namespace PathFinder
         {
             const Node& node = mPassNodes[nodeIndex];
 
-            // Visited nodes and nodes without outputs are not processed
-            if (!visitedNodes[nodeIndex] && node.HasAnyDependencies())
+            // Visited nodes, culled nodes and nodes without outputs are not processed
+            if (!visitedNodes[nodeIndex] && node.HasAnyDependencies() && !node.IsCulled())
             {
                 DepthFirstSearch(nodeIndex, visitedNodes, onStackNodes, isCyclic);
                 assert_format(!isCyclic, "Detected cyclic dependency in pass: ", node.PassMetadata().Name.ToString());
@@ -189,6 +278,77 @@ namespace PathFinder
         std::reverse(mTopologicallySortedNodes.begin(), mTopologicallySortedNodes.end());
     }
 
+    void RenderPassGraph::AssignExecutionQueues()
+    {
+        // Longest cost paths leading to the node and starting after it
+        std::vector<float> headCosts(mPassNodes.size(), 0.0f);
+        std::vector<float> tailCosts(mPassNodes.size(), 0.0f);
+
+        for (const Node* node : mTopologicallySortedNodes)
+        {
+            uint64_t nodeIndex = node->mIndexInUnorderedList;
+
+            for (uint64_t adjacentNodeIndex : mAdjacencyLists[nodeIndex])
+            {
+                headCosts[adjacentNodeIndex] = std::max(headCosts[adjacentNodeIndex], headCosts[nodeIndex] + node->EstimatedCost);
+            }
+        }
+
+        for (auto nodeIt = mTopologicallySortedNodes.rbegin(); nodeIt != mTopologicallySortedNodes.rend(); ++nodeIt)
+        {
+            uint64_t nodeIndex = (*nodeIt)->mIndexInUnorderedList;
+
+            for (uint64_t adjacentNodeIndex : mAdjacencyLists[nodeIndex])
+            {
+                tailCosts[nodeIndex] = std::max(tailCosts[nodeIndex], mPassNodes[adjacentNodeIndex].EstimatedCost + tailCosts[adjacentNodeIndex]);
+            }
+        }
+
+        for (const Node* node : mTopologicallySortedNodes)
+        {
+            uint64_t nodeIndex = node->mIndexInUnorderedList;
+            mCriticalPathCost = std::max(mCriticalPathCost, headCosts[nodeIndex] + node->EstimatedCost + tailCosts[nodeIndex]);
+        }
+
+        for (Node* node : mTopologicallySortedNodes)
+        {
+            uint64_t nodeIndex = node->mIndexInUnorderedList;
+            node->mCriticalPathSlack = mCriticalPathCost - (headCosts[nodeIndex] + node->EstimatedCost + tailCosts[nodeIndex]);
+
+            if (mQueueAssignmentPolicy != QueueAssignmentPolicy::CriticalPath ||
+                node->IsExecutionQueueFixed || 
+                node->UsesRasterization ||
+                node->PassMetadata().Purpose != RenderPassPurpose::Default)
+            {
+                continue;
+            }
+
+            // Pass must be able to run entirely in parallel with the critical path, 
+            // otherwise moving it only adds synchronization without shortening the frame
+            if (node->mCriticalPathSlack >= node->EstimatedCost)
+            {
+                node->ExecutionQueueIndex = std::underlying_type_t<RenderPassExecutionQueue>(RenderPassExecutionQueue::AsyncCompute);
+            }
+        }
+    }
+
+    void RenderPassGraph::BuildCrossQueueDependencies()
+    {
+        for (Node* node : mTopologicallySortedNodes)
+        {
+            for (uint64_t adjacentNodeIndex : mAdjacencyLists[node->mIndexInUnorderedList])
+            {
+                Node& adjacentNode = mPassNodes[adjacentNodeIndex];
+
+                if (node->ExecutionQueueIndex != adjacentNode.ExecutionQueueIndex)
+                {
+                    node->mSyncSignalRequired = true;
+                    adjacentNode.mNodesToSyncWith.push_back(node);
+                }
+            }
+        }
+    }
+
     void RenderPassGraph::BuildDependencyLevels()
     {
         std::vector<int64_t> longestDistances(mPassNodes.size(), 0);
@@ -212,6 +372,44 @@ namespace PathFinder
             }
         }
 
+        if (mTransientResourceFootprintQuery)
+        {
+            mNodeTransientResources.resize(mPassNodes.size());
+
+            for (const Node* node : mTopologicallySortedNodes)
+            {
+                std::vector<TransientResourceFootprint>& resources = mNodeTransientResources[node->mIndexInUnorderedList];
+
+                for (Foundation::Name resourceName : node->AllResources())
+                {
+                    TransientResourceFootprint footprint = mTransientResourceFootprintQuery(resourceName);
+
+                    // Aliases of the same resource are counted once
+                    bool isKnown = std::any_of(resources.begin(), resources.end(), [&footprint](auto& resource) { return resource.ResourceName == footprint.ResourceName; });
+
+                    if (footprint.SizeInBytes > 0 && !isKnown)
+                    {
+                        resources.push_back(footprint);
+                    }
+                }
+            }
+
+            OrderedNodeList dependencyDepthOrder = mTopologicallySortedNodes;
+            std::stable_sort(dependencyDepthOrder.begin(), dependencyDepthOrder.end(), [&longestDistances](const Node* a, const Node* b)
+            {
+                return longestDistances[a->mIndexInUnorderedList] < longestDistances[b->mIndexInUnorderedList];
+            });
+
+            mDependencyDepthOrderTransientMemoryPeak = EstimateTransientMemoryPeak(dependencyDepthOrder);
+            mTransientMemoryPeak = mDependencyDepthOrderTransientMemoryPeak;
+
+            if (mOrderingPolicy == OrderingPolicy::TransientMemory)
+            {
+                ReorderForTransientMemory(longestDistances, dependencyLevelCount);
+                mTransientMemoryPeak = EstimateTransientMemoryPeak(mTopologicallySortedNodes);
+            }
+        }
+
         mDependencyLevels.resize(dependencyLevelCount);
         mDetectedQueueCount = 1;
 
@@ -228,6 +426,167 @@ namespace PathFinder
         }
     }
 
+    void RenderPassGraph::ReorderForTransientMemory(std::vector<int64_t>& dependencyLevelIndices, uint64_t dependencyLevelCount)
+    {
+        // Latest dependency level each node can be postponed to without increasing level count
+        std::vector<int64_t> latestLevels(mPassNodes.size(), dependencyLevelCount - 1);
+        std::vector<uint64_t> unscheduledDependencyCounts(mPassNodes.size(), 0);
+
+        for (auto nodeIt = mTopologicallySortedNodes.rbegin(); nodeIt != mTopologicallySortedNodes.rend(); ++nodeIt)
+        {
+            uint64_t nodeIndex = (*nodeIt)->mIndexInUnorderedList;
+
+            for (uint64_t adjacentNodeIndex : mAdjacencyLists[nodeIndex])
+            {
+                latestLevels[nodeIndex] = std::min(latestLevels[nodeIndex], latestLevels[adjacentNodeIndex] - 1);
+                unscheduledDependencyCounts[adjacentNodeIndex]++;
+            }
+        }
+
+        robin_hood::unordered_flat_map<Foundation::Name, uint64_t> remainingUserCounts;
+        robin_hood::unordered_flat_set<Foundation::Name> allocatedResources;
+        std::vector<Node*> readyNodes;
+
+        for (Node* node : mTopologicallySortedNodes)
+        {
+            for (const TransientResourceFootprint& resource : mNodeTransientResources[node->mIndexInUnorderedList])
+            {
+                remainingUserCounts[resource.ResourceName]++;
+            }
+
+            if (unscheduledDependencyCounts[node->mIndexInUnorderedList] == 0)
+            {
+                readyNodes.push_back(node);
+            }
+        }
+
+        // Bytes that become alive minus bytes that die if node is scheduled next
+        auto memoryDelta = [&](const Node* node) -> int64_t
+        {
+            int64_t delta = 0;
+
+            for (const TransientResourceFootprint& resource : mNodeTransientResources[node->mIndexInUnorderedList])
+            {
+                bool isAllocated = allocatedResources.contains(resource.ResourceName);
+                bool isLastUser = remainingUserCounts[resource.ResourceName] == 1;
+
+                if (!isAllocated && !isLastUser) delta += resource.SizeInBytes;
+                else if (isAllocated && isLastUser) delta -= resource.SizeInBytes;
+            }
+
+            return delta;
+        };
+
+        OrderedNodeList reorderedNodes;
+        reorderedNodes.reserve(mTopologicallySortedNodes.size());
+
+        for (int64_t levelIndex = 0; levelIndex < dependencyLevelCount; ++levelIndex)
+        {
+            std::vector<std::pair<int64_t, Node*>> levelNodes;
+
+            auto scheduleIf = [&](auto&& predicate)
+            {
+                bool isAnyScheduled = false;
+
+                for (auto nodeIt = readyNodes.begin(); nodeIt != readyNodes.end();)
+                {
+                    Node* node = *nodeIt;
+                    int64_t delta = memoryDelta(node);
+
+                    if (!predicate(node, delta))
+                    {
+                        ++nodeIt;
+                        continue;
+                    }
+
+                    for (const TransientResourceFootprint& resource : mNodeTransientResources[node->mIndexInUnorderedList])
+                    {
+                        allocatedResources.insert(resource.ResourceName);
+                        remainingUserCounts[resource.ResourceName]--;
+                    }
+
+                    levelNodes.emplace_back(delta, node);
+                    nodeIt = readyNodes.erase(nodeIt);
+                    isAnyScheduled = true;
+                }
+
+                return isAnyScheduled;
+            };
+
+            // Nodes that can't be postponed any further
+            scheduleIf([&](const Node* node, int64_t) { return latestLevels[node->mIndexInUnorderedList] == levelIndex; });
+
+            // Nodes that release at least as much as they allocate are pulled in as early as possible,
+            // the rest is postponed to shorten lifetimes of resources they produce
+            while (scheduleIf([](const Node*, int64_t delta) { return delta <= 0; })) {}
+
+            // Release memory as early as possible inside the level
+            std::stable_sort(levelNodes.begin(), levelNodes.end(), [](auto& a, auto& b) { return a.first < b.first; });
+
+            for (auto& [delta, node] : levelNodes)
+            {
+                dependencyLevelIndices[node->mIndexInUnorderedList] = levelIndex;
+                reorderedNodes.push_back(node);
+            }
+
+            // Successors become available on the next level only
+            for (auto& [delta, node] : levelNodes)
+            {
+                for (uint64_t adjacentNodeIndex : mAdjacencyLists[node->mIndexInUnorderedList])
+                {
+                    if (--unscheduledDependencyCounts[adjacentNodeIndex] == 0)
+                    {
+                        readyNodes.push_back(&mPassNodes[adjacentNodeIndex]);
+                    }
+                }
+            }
+        }
+
+        assert_format(reorderedNodes.size() == mTopologicallySortedNodes.size(), "Memory-aware ordering lost render passes");
+
+        mTopologicallySortedNodes = std::move(reorderedNodes);
+    }
+
+    uint64_t RenderPassGraph::EstimateTransientMemoryPeak(const OrderedNodeList& executionOrder) const
+    {
+        struct Lifetime
+        {
+            uint64_t Start = 0;
+            uint64_t End = 0;
+            uint64_t SizeInBytes = 0;
+        };
+
+        robin_hood::unordered_flat_map<Foundation::Name, Lifetime> lifetimes;
+
+        for (uint64_t executionIndex = 0; executionIndex < executionOrder.size(); ++executionIndex)
+        {
+            for (const TransientResourceFootprint& resource : mNodeTransientResources[executionOrder[executionIndex]->mIndexInUnorderedList])
+            {
+                auto [lifetimeIt, isNew] = lifetimes.try_emplace(resource.ResourceName, Lifetime{ executionIndex, executionIndex, resource.SizeInBytes });
+                lifetimeIt->second.End = executionIndex;
+            }
+        }
+
+        std::vector<int64_t> memoryDeltas(executionOrder.size() + 1, 0);
+
+        for (auto& [resourceName, lifetime] : lifetimes)
+        {
+            memoryDeltas[lifetime.Start] += lifetime.SizeInBytes;
+            memoryDeltas[lifetime.End + 1] -= lifetime.SizeInBytes;
+        }
+
+        int64_t aliveMemory = 0;
+        int64_t peak = 0;
+
+        for (int64_t delta : memoryDeltas)
+        {
+            aliveMemory += delta;
+            peak = std::max(peak, aliveMemory);
+        }
+
+        return peak;
+    }
+
     void RenderPassGraph::FinalizeDependencyLevels()
     {
         uint64_t globalExecutionIndex = 0;
@@ -584,6 +943,14 @@ namespace PathFinder
         mSyncSignalRequired = false;
         ExecutionQueueIndex = 0;
         UsesRayTracing = false;
+        ExportsResources = false;
+        WritesCrossFrameReadResources = false;
+        UsesRasterization = false;
+        IsExecutionQueueFixed = false;
+        IsDisabled = false;
+        EstimatedCost = 1.0f;
+        mIsCulled = false;
+        mCriticalPathSlack = 0.0f;
         mGlobalExecutionIndex = 0;
         mLocalToDependencyLevelExecutionIndex = 0;
     }
@@ -52,6 +52,26 @@ namespace PathFinder
             uint64_t ExecutionQueueIndex = 0;
             bool UsesRayTracing = false;
 
+            // Resources exported to CPU are consumed outside of the graph, so such passes are never culled
+            bool ExportsResources = false;
+
+            // Resources declared as read across frames feed next frame, so their writers are never culled either,
+            // even on the first frame after a rebuild when no history reads were observed yet
+            bool WritesCrossFrameReadResources = false;
+
+            // Disabled passes are always culled, and so are passes whose outputs only disabled passes consume.
+            // Live passes reading outputs of a disabled pass read them unwritten.
+            bool IsDisabled = false;
+
+            // Passes that use render targets or depth-stencil attachments can only be executed on graphics queue
+            bool UsesRasterization = false;
+
+            // Queue was requested by the pass explicitly and must not be changed by automatic assignment
+            bool IsExecutionQueueFixed = false;
+
+            // Relative GPU cost used to find critical path, for example measured duration from previous frames
+            float EstimatedCost = 1.0f;
+
         private:
             using SynchronizationIndexSet = std::vector<uint64_t>;
             inline static const uint64_t InvalidSynchronizationIndex = std::numeric_limits<uint64_t>::max();
@@ -82,6 +102,8 @@ namespace PathFinder
             SynchronizationIndexSet mSynchronizationIndexSet;
             std::vector<const Node*> mNodesToSyncWith;
             bool mSyncSignalRequired = false;
+            bool mIsCulled = false;
+            float mCriticalPathSlack = 0.0f;
 
         public:
             inline const auto& PassMetadata() const { return mPassMetadata; }
@@ -95,6 +117,8 @@ namespace PathFinder
             inline auto LocalToDependencyLevelExecutionIndex() const { return mLocalToDependencyLevelExecutionIndex; }
             inline auto LocalToQueueExecutionIndex() const { return mLocalToQueueExecutionIndex; }
             inline bool IsSyncSignalRequired() const { return mSyncSignalRequired; }
+            inline bool IsCulled() const { return mIsCulled; }
+            inline auto CriticalPathSlack() const { return mCriticalPathSlack; }
         };
 
         class DependencyLevel
@@ -131,25 +155,60 @@ namespace PathFinder
         using ResourceUsageTimeline = std::pair<uint64_t, uint64_t>;
         using ResourceUsageTimelines = robin_hood::unordered_flat_map<Foundation::Name, ResourceUsageTimeline>;
 
+        enum class OrderingPolicy
+        {
+            // Passes are executed as early as their dependencies allow
+            DependencyDepth,
+
+            // Passes are moved within their dependency slack to minimize peak of concurrently alive transient memory
+            TransientMemory
+        };
+
+        enum class QueueAssignmentPolicy
+        {
+            // Passes execute on queues they requested, graphics by default
+            Manual,
+
+            // Compute passes that fit into their slack off the critical path are moved to asynchronous compute queue
+            CriticalPath
+        };
+
+        struct TransientResourceFootprint
+        {
+            // Name of the actual resource in case queried name is an alias
+            Foundation::Name ResourceName;
+
+            // Zero for resources that do not occupy aliased memory
+            uint64_t SizeInBytes = 0;
+        };
+
+        using TransientResourceFootprintQuery = std::function<TransientResourceFootprint(Foundation::Name)>;
+
         static SubresourceName ConstructSubresourceName(Foundation::Name resourceName, uint32_t subresourceIndex);
         static std::pair<Foundation::Name, uint32_t> DecodeSubresourceName(SubresourceName name);
 
         uint64_t NodeCountForQueue(uint64_t queueIndex) const;
         const ResourceUsageTimeline& GetResourceUsageTimeline(Foundation::Name resourceName) const;
         const Node* GetNodeThatWritesToSubresource(SubresourceName subresourceName) const;
+        const Node& GetNode(Foundation::Name passName) const;
 
         uint64_t AddPass(const RenderPassMetadata& passMetadata);
 
-        void Build();
+        // Transient memory estimates are only produced when footprint query is provided
+        void Build(
+            OrderingPolicy orderingPolicy = OrderingPolicy::DependencyDepth,
+            QueueAssignmentPolicy queueAssignmentPolicy = QueueAssignmentPolicy::Manual,
+            const TransientResourceFootprintQuery& footprintQuery = nullptr);
         void Clear();
 
     private:
         using DependencyLevelList = std::vector<DependencyLevel>;
         using OrderedNodeList = std::vector<Node*>;
-        using RenderPassRegistry = robin_hood::unordered_flat_set<Foundation::Name>;
+        using RenderPassRegistry = robin_hood::unordered_flat_map<Foundation::Name, uint64_t>;
         using QueueNodeCounters = robin_hood::unordered_flat_map<uint64_t, uint64_t>;
         using AdjacencyLists = std::vector<std::vector<uint64_t>>;
         using WrittenSubresourceToPassMap = robin_hood::unordered_flat_map<SubresourceName, const Node*>;
+        using SubresourceSet = robin_hood::unordered_flat_set<SubresourceName>;
 
         struct SyncCoverage
         {
@@ -158,11 +217,16 @@ namespace PathFinder
             std::vector<uint64_t> SyncedQueueIndices;
         };
 
-        void EnsureRenderPassUniqueness(Foundation::Name passName);
+        void EnsureRenderPassUniqueness(Foundation::Name passName, uint64_t nodeIndex);
+        void CullUnreachableNodes();
         void BuildAdjacencyLists();
         void DepthFirstSearch(uint64_t nodeIndex, std::vector<bool>& visited, std::vector<bool>& onStack, bool& isCyclic);
         void TopologicalSort();
+        void AssignExecutionQueues();
+        void BuildCrossQueueDependencies();
         void BuildDependencyLevels();
+        void ReorderForTransientMemory(std::vector<int64_t>& dependencyLevelIndices, uint64_t dependencyLevelCount);
+        uint64_t EstimateTransientMemoryPeak(const OrderedNodeList& executionOrder) const;
         void FinalizeDependencyLevels();
         void CullRedundantSynchronizations();
 
@@ -183,6 +247,18 @@ namespace PathFinder
         WrittenSubresourceToPassMap mWrittenSubresourceToPassMap;
         const Node* mFirstNodeThatUsesRayTracing = nullptr;
         uint64_t mDetectedQueueCount = 1;
+        uint64_t mCulledNodeCount = 0;
+        OrderingPolicy mOrderingPolicy = OrderingPolicy::DependencyDepth;
+        QueueAssignmentPolicy mQueueAssignmentPolicy = QueueAssignmentPolicy::Manual;
+        float mCriticalPathCost = 0.0f;
+        TransientResourceFootprintQuery mTransientResourceFootprintQuery;
+        std::vector<std::vector<TransientResourceFootprint>> mNodeTransientResources;
+        uint64_t mDependencyDepthOrderTransientMemoryPeak = 0;
+        uint64_t mTransientMemoryPeak = 0;
+
+        // Subresources that live passes read without anyone writing them in the same frame,
+        // i.e. history produced by previous frame. Passes writing them next frame must not be culled.
+        SubresourceSet mCrossFrameReadSubresources;
 
     public:
         inline const auto& NodesInGlobalExecutionOrder() const { return mNodesInGlobalExecutionOrder; }
@@ -191,6 +267,11 @@ namespace PathFinder
         inline const auto& DependencyLevels() const { return mDependencyLevels; }
         inline const Node* FirstNodeThatUsesRayTracing() const { return mFirstNodeThatUsesRayTracing; }
         inline auto DetectedQueueCount() const { return mDetectedQueueCount; }
+        inline auto CulledNodeCount() const { return mCulledNodeCount; }
+        inline auto DependencyDepthOrderTransientMemoryPeak() const { return mDependencyDepthOrderTransientMemoryPeak; }
+        inline auto TransientMemoryPeak() const { return mTransientMemoryPeak; }
+        inline auto CriticalPathCost() const { return mCriticalPathCost; }
+        inline bool IsResourceUsed(Foundation::Name resourceName) const { return mResourceUsageTimelines.contains(resourceName); }
     };
 
 }
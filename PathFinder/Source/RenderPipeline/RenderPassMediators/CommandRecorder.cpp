@@ -132,13 +132,13 @@ namespace PathFinder
         // Inset UAV barriers between draws
         if (passHelpers.ExecutedRenderCommandsCount > 0)
         {
+            mRenderDevice->Barriers().Account(passHelpers.UAVBarriers);
             cmdList->InsertBarriers(passHelpers.UAVBarriers);
         }
 
         BindGraphicsPassRootConstantBuffer(cmdList);
         cmdList->Draw(vertexCount, 0);
 
-        passHelpers.ResourceStoragePassData->IsAllowedToAdvanceConstantBufferOffset = true;
         passHelpers.ExecutedRenderCommandsCount++;
     }
 
@@ -154,13 +154,13 @@ namespace PathFinder
 
         if (passHelpers.ExecutedRenderCommandsCount > 0)
         {
+            mRenderDevice->Barriers().Account(passHelpers.UAVBarriers);
             cmdList->InsertBarriers(passHelpers.UAVBarriers);
         }
 
         BindComputePassRootConstantBuffer(cmdList);
         cmdList->Dispatch(groupCountX, groupCountY, groupCountZ);
 
-        passHelpers.ResourceStoragePassData->IsAllowedToAdvanceConstantBufferOffset = true;
         passHelpers.ExecutedRenderCommandsCount++;
     }
 
@@ -185,12 +185,12 @@ namespace PathFinder
 
         if (passHelpers.ExecutedRenderCommandsCount > 0)
         {
+            mRenderDevice->Barriers().Account(passHelpers.UAVBarriers);
             cmdList->InsertBarriers(passHelpers.UAVBarriers);
         }
 
         BindComputePassRootConstantBuffer(cmdList);
         cmdList->DispatchRays(dispatchInfo);
-        passHelpers.ResourceStoragePassData->IsAllowedToAdvanceConstantBufferOffset = true;
         passHelpers.ExecutedRenderCommandsCount++;
     }
 
@@ -273,15 +273,13 @@ namespace PathFinder
 
         auto commonParametersIndexOffset = passHelpers.LastSetRootSignature->ParameterCount() - mPipelineStateManager->CommonRootSignatureParameterCount();
 
-        if (!passHelpers.ResourceStoragePassData->PassConstantBuffer)
+        HAL::GPUAddress address = passHelpers.ResourceStoragePassData->PassConstantBufferAddress;
+
+        if (!address)
         {
             return;
         }
 
-        HAL::GPUAddress address =
-            passHelpers.ResourceStoragePassData->PassConstantBuffer->HALBuffer()->GPUVirtualAddress() +
-            passHelpers.ResourceStoragePassData->PassConstantBufferMemoryOffset;
-
         // Already bound
         if (passHelpers.LastBoundRootConstantBufferAddress == address)
         {
@@ -299,15 +297,13 @@ namespace PathFinder
 
         auto commonParametersIndexOffset = passHelpers.LastSetRootSignature->ParameterCount() - mPipelineStateManager->CommonRootSignatureParameterCount();
 
-        if (!passHelpers.ResourceStoragePassData->PassConstantBuffer)
+        HAL::GPUAddress address = passHelpers.ResourceStoragePassData->PassConstantBufferAddress;
+
+        if (!address)
         {
             return;
         }
 
-        HAL::GPUAddress address =
-            passHelpers.ResourceStoragePassData->PassConstantBuffer->HALBuffer()->GPUVirtualAddress() +
-            passHelpers.ResourceStoragePassData->PassConstantBufferMemoryOffset;
-
         // Already bound
         if (passHelpers.LastBoundRootConstantBufferAddress == address)
         {
@@ -15,9 +15,12 @@ namespace PathFinder
 
     void ResourceScheduler::NewRenderTarget(Foundation::Name resourceName, const MipSet& writtenMips, std::optional<NewTextureProperties> properties)
     {
+        mCurrentlySchedulingPassNode->UsesRasterization = true;
+
         NewTextureProperties props = FillMissingFields(properties);
 
         bool canBeReadAcrossFrames = EnumMaskEquals(properties->Flags, Flags::CrossFrameRead);
+        MarkCrossFrameReadWrite(canBeReadAcrossFrames, writtenMips);
 
         HAL::FormatVariant format = *props.ShaderVisibleFormat;
         if (props.TypelessFormat) format = *props.TypelessFormat;
@@ -51,8 +54,11 @@ namespace PathFinder
 
     void ResourceScheduler::NewDepthStencil(Foundation::Name resourceName, std::optional<NewDepthStencilProperties> properties)
     {
+        mCurrentlySchedulingPassNode->UsesRasterization = true;
+
         NewDepthStencilProperties props = FillMissingFields(properties);
         bool canBeReadAcrossFrames = EnumMaskEquals(properties->Flags, Flags::CrossFrameRead);
+        MarkCrossFrameReadWrite(canBeReadAcrossFrames, MipSet::FirstMip());
         HAL::DepthStencilClearValue clearValue{ 1.0, 0 };
 
         mResourceStorage->QueueResourceAllocationIfNeeded(
@@ -88,6 +94,7 @@ namespace PathFinder
     {
         NewTextureProperties props = FillMissingFields(properties);
         bool canBeReadAcrossFrames = EnumMaskEquals(properties->Flags, Flags::CrossFrameRead);
+        MarkCrossFrameReadWrite(canBeReadAcrossFrames, writtenMips);
 
         HAL::FormatVariant format = *props.ShaderVisibleFormat;
         if (props.TypelessFormat) format = *props.TypelessFormat;
@@ -126,6 +133,8 @@ namespace PathFinder
 
     void ResourceScheduler::AliasAndUseRenderTarget(Foundation::Name resourceName, Foundation::Name outputAliasName, const MipSet& writtenMips, std::optional<HAL::ColorFormat> concreteFormat)
     {
+        mCurrentlySchedulingPassNode->UsesRasterization = true;
+
         mResourceStorage->QueueResourceUsage(resourceName, outputAliasName.IsValid() ? std::optional(outputAliasName) : std::nullopt,
 
             [passNode = mCurrentlySchedulingPassNode,
@@ -159,6 +168,8 @@ namespace PathFinder
 
     void ResourceScheduler::AliasAndUseDepthStencil(Foundation::Name resourceName, Foundation::Name outputAliasName)
     {
+        mCurrentlySchedulingPassNode->UsesRasterization = true;
+
         mResourceStorage->QueueResourceUsage(resourceName, outputAliasName.IsValid() ? std::optional(outputAliasName) : std::nullopt, 
 
             [passNode = mCurrentlySchedulingPassNode,
@@ -261,12 +272,14 @@ namespace PathFinder
 
     void ResourceScheduler::WriteToBackBuffer()
     {
+        mCurrentlySchedulingPassNode->UsesRasterization = true;
         mCurrentlySchedulingPassNode->AddWriteDependency(RenderPassGraph::Node::BackBufferName, std::nullopt, 1);
     }
 
     void ResourceScheduler::ExecuteOnQueue(RenderPassExecutionQueue queue)
     {
         mCurrentlySchedulingPassNode->ExecutionQueueIndex = std::underlying_type_t<RenderPassExecutionQueue>(queue);
+        mCurrentlySchedulingPassNode->IsExecutionQueueFixed = true;
     }
 
     void ResourceScheduler::UseRayTracing()
@@ -276,6 +289,8 @@ namespace PathFinder
 
     void ResourceScheduler::Export(Foundation::Name resourceName)
     {
+        mCurrentlySchedulingPassNode->ExportsResources = true;
+
         mResourceStorage->QueueResourceReadback(resourceName, [resourceName, node = mCurrentlySchedulingPassNode](PipelineResourceSchedulingInfo& schedulingInfo)
         {
             PipelineResourceSchedulingInfo::PassInfo* passInfo = schedulingInfo.GetInfoForPass(node->PassMetadata().Name);
@@ -284,6 +299,11 @@ namespace PathFinder
         });
     }
 
+    bool ResourceScheduler::IsPassEnabled(Foundation::Name passName) const
+    {
+        return !mRenderPassGraph->GetNode(passName).IsDisabled;
+    }
+
     void ResourceScheduler::SetCurrentlySchedulingPassNode(RenderPassGraph::Node* node)
     {
         mCurrentlySchedulingPassNode = node;
@@ -352,6 +372,15 @@ namespace PathFinder
         return 1 + floor(log2(dimensions.LargestDimension()));
     }
 
+    void ResourceScheduler::MarkCrossFrameReadWrite(bool canBeReadAcrossFrames, const MipSet& writtenMips)
+    {
+        // Declaring a history resource without writing it (empty mip set) only makes it available for reading
+        if (canBeReadAcrossFrames && writtenMips.Combination)
+        {
+            mCurrentlySchedulingPassNode->WritesCrossFrameReadResources = true;
+        }
+    }
+
     void ResourceScheduler::RegisterGraphDependency(
         RenderPassGraph::Node& passNode, 
         const MipSet& mips, 
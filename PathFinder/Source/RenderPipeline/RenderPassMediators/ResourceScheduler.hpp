@@ -196,7 +196,8 @@ namespace PathFinder
         // Indicate that pass will write to back buffer
         void WriteToBackBuffer();
 
-        // Explicitly set a queue to execute render pass on
+        // Explicitly set a queue to execute render pass on. 
+        // Such passes are excluded from automatic queue assignment.
         void ExecuteOnQueue(RenderPassExecutionQueue queue);
 
         // Indicate that pass will use Ray Tracing Acceleration structures.
@@ -207,6 +208,10 @@ namespace PathFinder
         // Can only be called for resource that is being written in requesting render pass.
         void Export(Foundation::Name resourceName);
 
+        // Whether another render pass is enabled this frame. 
+        // Outputs of disabled passes are never written, so consumers should fall back to other inputs.
+        bool IsPassEnabled(Foundation::Name passName) const;
+
         // To be called by the engine, not render passes
         void SetCurrentlySchedulingPassNode(RenderPassGraph::Node* node);
 
@@ -214,6 +219,7 @@ namespace PathFinder
         NewTextureProperties FillMissingFields(std::optional<NewTextureProperties> properties) const;
         NewDepthStencilProperties FillMissingFields(std::optional<NewDepthStencilProperties> properties) const;
         uint32_t MaxMipCount(const Geometry::Dimensions& dimensions) const;
+        void MarkCrossFrameReadWrite(bool canBeReadAcrossFrames, const MipSet& writtenMips);
 
         void RegisterGraphDependency(
             RenderPassGraph::Node& passNode, 
@@ -5,6 +5,7 @@ namespace PathFinder
     void ResourceScheduler::NewBuffer(Foundation::Name resourceName, const NewBufferProperties<T>& bufferProperties)
     {
         bool canBeReadAcrossFrames = EnumMaskEquals(bufferProperties.Flags, Flags::CrossFrameRead);
+        MarkCrossFrameReadWrite(canBeReadAcrossFrames, MipSet::FirstMip());
 
         mResourceStorage->QueueResourceAllocationIfNeeded(
             resourceName,
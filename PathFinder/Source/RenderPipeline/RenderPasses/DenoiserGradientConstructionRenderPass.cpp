@@ -9,6 +9,11 @@ namespace PathFinder
     DenoiserGradientConstructionRenderPass::DenoiserGradientConstructionRenderPass()
         : RenderPass("DenoiserGradientConstruction") {}
 
+    bool DenoiserGradientConstructionRenderPass::IsEnabled(const RenderPassContentMediator* content) const
+    {
+        return content->GetSettings()->IsDenoiserEnabled;
+    }
+
     void DenoiserGradientConstructionRenderPass::SetupPipelineStates(PipelineStateCreator* stateCreator, RootSignatureCreator* rootSignatureCreator)
     {
         stateCreator->CreateComputeState(PSONames::DenoiserGradientConstruction, [](ComputeStateProxy& state)
@@ -9,6 +9,11 @@ namespace PathFinder
     DenoiserGradientFilteringRenderPass::DenoiserGradientFilteringRenderPass()
         : RenderPass("DenoiserGradientFiltering") {}
 
+    bool DenoiserGradientFilteringRenderPass::IsEnabled(const RenderPassContentMediator* content) const
+    {
+        return content->GetSettings()->IsDenoiserEnabled;
+    }
+
     void DenoiserGradientFilteringRenderPass::SetupPipelineStates(PipelineStateCreator* stateCreator, RootSignatureCreator* rootSignatureCreator)
     {
         stateCreator->CreateComputeState(PSONames::DenoiserGradientFiltering, [](ComputeStateProxy& state)
@@ -8,6 +8,11 @@ namespace PathFinder
     DenoiserHistoryFixRenderPass::DenoiserHistoryFixRenderPass()
         : RenderPass("DenoiserHistoryFix") {}
 
+    bool DenoiserHistoryFixRenderPass::IsEnabled(const RenderPassContentMediator* content) const
+    {
+        return content->GetSettings()->IsDenoiserEnabled;
+    }
+
     void DenoiserHistoryFixRenderPass::SetupPipelineStates(PipelineStateCreator* stateCreator, RootSignatureCreator* rootSignatureCreator)
     {
         stateCreator->CreateComputeState(PSONames::DenoiserHistoryFix, [](ComputeStateProxy& state)
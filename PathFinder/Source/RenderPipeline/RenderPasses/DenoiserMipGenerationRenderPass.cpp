@@ -11,6 +11,11 @@ namespace PathFinder
     DenoiserMipGenerationRenderPass::DenoiserMipGenerationRenderPass()
         : RenderPass("DenoiserMipGeneration") {}
 
+    bool DenoiserMipGenerationRenderPass::IsEnabled(const RenderPassContentMediator* content) const
+    {
+        return content->GetSettings()->IsDenoiserEnabled;
+    }
+
     void DenoiserMipGenerationRenderPass::ScheduleSubPasses(SubPassScheduler<RenderPassContentMediator>* scheduler)
     {
         auto frameIndex = scheduler->FrameNumber() % 2;
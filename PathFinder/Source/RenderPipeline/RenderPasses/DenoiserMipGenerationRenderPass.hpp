@@ -17,6 +17,7 @@ namespace PathFinder
         ~DenoiserMipGenerationRenderPass() = default;
 
         virtual void ScheduleSubPasses(SubPassScheduler<RenderPassContentMediator>* scheduler) override;
+        virtual bool IsEnabled(const RenderPassContentMediator* content) const override;
 
     private:
         std::vector<std::unique_ptr<DownsamplingRenderSubPass>> mDownsamplingSubPasses;
@@ -33,6 +33,15 @@ namespace PathFinder
         scheduler->NewTexture(ResourceNames::CombinedShadingOversaturated, oversaturatedProps);
 
         scheduler->ReadTexture(ResourceNames::ShadingAnalyticOutput);
+
+        // Denoiser chain is culled when disabled, raw stochastic shading is combined instead
+        if (!scheduler->IsPassEnabled("SpecularDenoiser"))
+        {
+            scheduler->ReadTexture(ResourceNames::StochasticShadowedShadingOutput);
+            scheduler->ReadTexture(ResourceNames::StochasticUnshadowedShadingOutput);
+            return;
+        }
+
         scheduler->ReadTexture(ResourceNames::StochasticShadowedShadingDenoised[frameIndex]);
         scheduler->ReadTexture(ResourceNames::StochasticUnshadowedShadingDenoised[frameIndex]);
         scheduler->ReadTexture(ResourceNames::DenoiserReprojectedFramesCount[frameIndex]);
@@ -54,10 +63,20 @@ namespace PathFinder
         DenoiserPostBlurCBContent cbContent{};
         cbContent.DispatchGroupCount = { groupCount.Width, groupCount.Height };
         cbContent.AnalyticShadingTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::ShadingAnalyticOutput);
-        cbContent.SecondaryGradientTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::DenoiserSecondaryGradient);
-        cbContent.AccumulatedFramesCountTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::DenoiserReprojectedFramesCount[frameIndex]);
-        cbContent.ShadowedShadingTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::StochasticShadowedShadingDenoised[frameIndex]);
-        cbContent.UnshadowedShadingTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::StochasticUnshadowedShadingDenoised[frameIndex]);
+
+        if (settings->IsDenoiserEnabled)
+        {
+            cbContent.SecondaryGradientTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::DenoiserSecondaryGradient);
+            cbContent.AccumulatedFramesCountTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::DenoiserReprojectedFramesCount[frameIndex]);
+            cbContent.ShadowedShadingTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::StochasticShadowedShadingDenoised[frameIndex]);
+            cbContent.UnshadowedShadingTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::StochasticUnshadowedShadingDenoised[frameIndex]);
+        }
+        else
+        {
+            // Gradient and frame count textures are not produced, shader doesn't touch them
+            cbContent.ShadowedShadingTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::StochasticShadowedShadingOutput);
+            cbContent.UnshadowedShadingTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::StochasticUnshadowedShadingOutput);
+        }
         cbContent.ShadowedShadingBlurredOutputTexIdx = resourceProvider->GetUATextureIndex(ResourceNames::StochasticShadowedShadingPostBlurred);
         cbContent.UnshadowedShadingBlurredOutputTexIdx = resourceProvider->GetUATextureIndex(ResourceNames::StochasticUnshadowedShadingPostBlurred);
         cbContent.CombinedShadingTexIdx = resourceProvider->GetUATextureIndex(ResourceNames::CombinedShading);
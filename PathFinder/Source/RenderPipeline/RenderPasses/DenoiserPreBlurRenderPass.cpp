@@ -9,6 +9,11 @@ namespace PathFinder
     DenoiserPreBlurRenderPass::DenoiserPreBlurRenderPass()
         : RenderPass("DenoiserPreBlur") {}
 
+    bool DenoiserPreBlurRenderPass::IsEnabled(const RenderPassContentMediator* content) const
+    {
+        return content->GetSettings()->IsDenoiserEnabled;
+    }
+
     void DenoiserPreBlurRenderPass::SetupPipelineStates(PipelineStateCreator* stateCreator, RootSignatureCreator* rootSignatureCreator)
     {
     }
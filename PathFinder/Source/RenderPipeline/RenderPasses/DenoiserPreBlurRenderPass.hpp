@@ -19,6 +19,7 @@ namespace PathFinder
         virtual void SetupPipelineStates(PipelineStateCreator* stateCreator, RootSignatureCreator* rootSignatureCreator) override;
         virtual void ScheduleResources(ResourceScheduler* scheduler) override;
         virtual void Render(RenderContext<RenderPassContentMediator>* context) override;
+        virtual bool IsEnabled(const RenderPassContentMediator* content) const override;
 
     private:
         void BlurTexture(RenderContext<RenderPassContentMediator>* context, Foundation::Name inputName, Foundation::Name outputName);
@@ -8,6 +8,11 @@ namespace PathFinder
     DenoiserReprojectionRenderPass::DenoiserReprojectionRenderPass()
         : RenderPass("DenoiserReprojection") {}
 
+    bool DenoiserReprojectionRenderPass::IsEnabled(const RenderPassContentMediator* content) const
+    {
+        return content->GetSettings()->IsDenoiserEnabled;
+    }
+
     void DenoiserReprojectionRenderPass::SetupPipelineStates(PipelineStateCreator* stateCreator, RootSignatureCreator* rootSignatureCreator)
     {
         stateCreator->CreateComputeState(PSONames::DenoiserReprojection, [](ComputeStateProxy& state)
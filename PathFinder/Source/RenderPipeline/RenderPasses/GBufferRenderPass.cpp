@@ -109,7 +109,8 @@ namespace PathFinder
     {
         context->GetCommandRecorder()->ApplyPipelineState(PSONames::GBufferMeshes);
 
-        auto& instances = context->GetContent()->GetScene()->MeshInstances();
+        // Instance table still contains every instance for ray tracing, only draws are culled
+        auto& instances = context->GetContent()->GetScene()->Culler().VisibleMeshInstances();
 
         if (instances.empty()) 
             return;
@@ -121,10 +122,10 @@ namespace PathFinder
         context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MeshInstanceTable(), 2, 0, HAL::ShaderRegister::ShaderResource);
         context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MaterialTable(), 3, 0, HAL::ShaderRegister::ShaderResource);
 
-        for (const MeshInstance& instance : instances)
+        for (const MeshInstance* instance : instances)
         {
-            context->GetCommandRecorder()->SetRootConstants(instance.IndexInGPUTable(), 0, 0);
-            context->GetCommandRecorder()->Draw(instance.AssociatedMesh()->LocationInVertexStorage().IndexCount);
+            context->GetCommandRecorder()->SetRootConstants(instance->IndexInGPUTable(), 0, 0);
+            context->GetCommandRecorder()->Draw(instance->AssociatedMesh()->LocationInVertexStorage(instance->SelectedLOD()).IndexCount);
         }
     }
 
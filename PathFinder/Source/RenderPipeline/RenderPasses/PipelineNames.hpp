@@ -65,8 +65,6 @@ namespace PathFinder
         inline Foundation::Name SMAADetectedEdges{ "Resource_SMAA_Detected_Edges" };
         inline Foundation::Name SMAABlendingWeights{ "Resource_SMAA_Blending_Weights" };
         inline Foundation::Name SMAAAntialiased{ "Resource_SMAA_Antialiased_Image" };
-
-        inline Foundation::Name PickedGeometryInfo{ "Resource_Picked_Geometry_Info" };
     }
 
     namespace PSONames
@@ -79,7 +77,6 @@ namespace PathFinder
         inline Foundation::Name GBufferMeshes{ "PSO_GBufferMeshes" };
         inline Foundation::Name GBufferLights{ "PSO_GBufferLights" };
         inline Foundation::Name Shading{ "PSO_Shading" };
-        inline Foundation::Name GeometryPicking{ "PSO_GeometryPicking" };
         inline Foundation::Name DeferredLighting{ "PSO_DeferredLighting" };
         inline Foundation::Name SeparableBlur{ "PSO_SeparableBlur" };
         inline Foundation::Name BloomBlur{ "PSO_BloomBlur" };
@@ -112,7 +109,6 @@ namespace PathFinder
         inline Foundation::Name DeferredLighting{ "Deferred_Lighting_Root_Sig" };
         inline Foundation::Name Shading{ "Shading_Root_Sig" };
         inline Foundation::Name ToneMapping{ "Tone_Mapping_Root_Sig" };
-        inline Foundation::Name GeometryPicking{ "Geometry_Picking_Root_Sig" };
         inline Foundation::Name UI{ "UI_Root_Sig" };
         inline Foundation::Name DisplacementDistanceMapGeneration{ "Distance_Map_Generation_Root_Sig" };
     }
@@ -12,10 +12,12 @@ namespace PathFinder
     {
         rootSignatureCreator->CreateRootSignature(RootSignatureNames::Shading, [](RootSignatureProxy& signatureProxy)
         {
-            signatureProxy.AddRootConstantsParameter<uint32_t>(0, 0);
             signatureProxy.AddShaderResourceBufferParameter(0, 0); // Scene BVH | t0 - s0
             signatureProxy.AddShaderResourceBufferParameter(1, 0); // Light Table | t1 - s0
             signatureProxy.AddShaderResourceBufferParameter(2, 0); // Material Table | t2 - s0
+            signatureProxy.AddShaderResourceBufferParameter(3, 0); // Light Clusters | t3 - s0
+            signatureProxy.AddShaderResourceBufferParameter(4, 0); // Light Cluster Indices | t4 - s0
+            signatureProxy.AddShaderResourceBufferParameter(5, 0); // Light Tree Nodes | t5 - s0
         });
 
         stateCreator->CreateRayTracingState(PSONames::Shading, [this](RayTracingStateProxy& state)
@@ -68,6 +70,9 @@ namespace PathFinder
         cbContent.BlueNoiseTextureSize = { blueNoiseTexture->Properties().Dimensions.Width, blueNoiseTexture->Properties().Dimensions.Height };
         cbContent.RngSeedsTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::RngSeedsCorrelated);
         cbContent.FrameNumber = context->FrameNumber();
+        cbContent.LightClusterGridDimensions = sceneStorage->LightClusters().GridDimensions();
+        cbContent.LightTreeNodeCount = sceneStorage->LightTreeNodeCount();
+        cbContent.LightPartitionInfo = sceneStorage->LightTablePartitionInfo();
 
         auto haltonSequence = Foundation::Halton::Sequence(0, 3);
 
@@ -77,27 +82,22 @@ namespace PathFinder
         }
 
         context->GetConstantsUpdater()->UpdateRootConstantBuffer(cbContent);
-        context->GetCommandRecorder()->SetRootConstants(CompressLightPartitionInfo(sceneStorage->LightTablePartitionInfo()), 0, 0);
 
         const Memory::Buffer* bvh = sceneStorage->TopAccelerationStructure().AccelerationStructureBuffer();
         const Memory::Buffer* lights = sceneStorage->LightTable();
         const Memory::Buffer* materials = sceneStorage->MaterialTable();
+        const Memory::Buffer* lightClusters = sceneStorage->LightClusterTable();
+        const Memory::Buffer* lightClusterIndices = sceneStorage->LightClusterIndexList();
+        const Memory::Buffer* lightTreeNodes = sceneStorage->LightTreeNodes();
 
         if (bvh) context->GetCommandRecorder()->BindExternalBuffer(*bvh, 0, 0, HAL::ShaderRegister::ShaderResource);
         if (lights) context->GetCommandRecorder()->BindExternalBuffer(*lights, 1, 0, HAL::ShaderRegister::ShaderResource);
         if (materials) context->GetCommandRecorder()->BindExternalBuffer(*materials, 2, 0, HAL::ShaderRegister::ShaderResource);
+        if (lightClusters) context->GetCommandRecorder()->BindExternalBuffer(*lightClusters, 3, 0, HAL::ShaderRegister::ShaderResource);
+        if (lightClusterIndices) context->GetCommandRecorder()->BindExternalBuffer(*lightClusterIndices, 4, 0, HAL::ShaderRegister::ShaderResource);
+        if (lightTreeNodes) context->GetCommandRecorder()->BindExternalBuffer(*lightTreeNodes, 5, 0, HAL::ShaderRegister::ShaderResource);
         
         context->GetCommandRecorder()->DispatchRays(context->GetDefaultRenderSurfaceDesc().Dimensions());
     }
 
-    uint32_t ShadingRenderPass::CompressLightPartitionInfo(const GPULightTablePartitionInfo& info) const
-    {
-        uint32_t compressed = 0;
-        compressed |= (info.SphericalLightsOffset & 0xFF) << 24;
-        compressed |= (info.RectangularLightsOffset & 0xFF) << 16;
-        compressed |= (info.EllipticalLightsOffset & 0xFF) << 8;
-        compressed |= (info.TotalLightsCount & 0xFF);
-        return compressed;
-    }
-
 }
@@ -24,6 +24,11 @@ namespace PathFinder
         glm::uvec2 BlueNoiseTextureSize;
         uint32_t RngSeedsTexIdx;
         uint32_t FrameNumber;
+        // 16 byte boundary
+        glm::uvec3 LightClusterGridDimensions;
+        uint32_t LightTreeNodeCount;
+        // 16 byte boundary
+        GPULightTablePartitionInfo LightPartitionInfo;
     };
 
     class ShadingRenderPass : public RenderPass<RenderPassContentMediator>
@@ -35,9 +40,6 @@ namespace PathFinder
         virtual void SetupPipelineStates(PipelineStateCreator* stateCreator, RootSignatureCreator* rootSignatureCreator) override;
         virtual void ScheduleResources(ResourceScheduler* scheduler) override; 
         virtual void Render(RenderContext<RenderPassContentMediator>* context) override;
-
-    private:
-        uint32_t CompressLightPartitionInfo(const GPULightTablePartitionInfo& info) const;
     };
 
 }
@@ -8,6 +8,11 @@ namespace PathFinder
     SpecularDenoiserRenderPass::SpecularDenoiserRenderPass()
         : RenderPass("SpecularDenoiser") {}
 
+    bool SpecularDenoiserRenderPass::IsEnabled(const RenderPassContentMediator* content) const
+    {
+        return content->GetSettings()->IsDenoiserEnabled;
+    }
+
     void SpecularDenoiserRenderPass::SetupPipelineStates(PipelineStateCreator* stateCreator, RootSignatureCreator* rootSignatureCreator)
     {
         stateCreator->CreateComputeState(PSONames::SpecularDenoiser, [](ComputeStateProxy& state)
@@ -36,6 +36,9 @@ namespace PathFinder
         case KeyboardKey::Y: VolatileSettings.IsDenoiserGradientDebugRenderingEnabled = !VolatileSettings.IsDenoiserGradientDebugRenderingEnabled; break;
         case KeyboardKey::U: VolatileSettings.IsDenoiserMotionDebugRenderingEnabled = !VolatileSettings.IsDenoiserMotionDebugRenderingEnabled; break;
         case KeyboardKey::I: VolatileSettings.IsDenoiserAntilagEnabled = !VolatileSettings.IsDenoiserAntilagEnabled; break;
+        case KeyboardKey::O: VolatileSettings.IsOcclusionCullingEnabled = !VolatileSettings.IsOcclusionCullingEnabled; break;
+        case KeyboardKey::P: VolatileSettings.IsMemoryAwarePassOrderingEnabled = !VolatileSettings.IsMemoryAwarePassOrderingEnabled; break;
+        case KeyboardKey::K: VolatileSettings.IsAutomaticAsyncComputeEnabled = !VolatileSettings.IsAutomaticAsyncComputeEnabled; break;
         }
     }
 
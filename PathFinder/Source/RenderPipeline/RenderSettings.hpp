@@ -12,6 +12,9 @@ namespace PathFinder
         bool IsDenoiserGradientDebugRenderingEnabled = false;
         bool IsDenoiserMotionDebugRenderingEnabled = false;
         bool IsDenoiserAntilagEnabled = true;
+        bool IsOcclusionCullingEnabled = false;
+        bool IsMemoryAwarePassOrderingEnabled = false;
+        bool IsAutomaticAsyncComputeEnabled = false;
     };
 
     class RenderSettingsController
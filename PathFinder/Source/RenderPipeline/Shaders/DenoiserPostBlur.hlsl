@@ -75,7 +75,13 @@ void CSMain(uint3 groupThreadID : SV_GroupThreadID, uint3 groupID : SV_GroupID)
 
     // Get a random rotation to be applied for each sample
     float vogelDiskRotation = Random(pixelIndex.xy) * TwoPi;
-    float2 gradients = gradientTexture[pixelIndex].rg;
+    // Gradients aren't produced when denoiser is disabled, raw shading gets full blur then
+    float2 gradients = 1.0;
+
+    if (FrameDataCB.IsDenoiserEnabled)
+    {
+        gradients = gradientTexture[pixelIndex].rg;
+    }
 
     float3 stochasticShadowed = Blur(shadowedShadingTexture, uv, pixelIndex, texelSize, gradients.x, vogelDiskRotation);
     float3 stochasticUnshadowed = Blur(unshadowedShadingTexture, uv, pixelIndex, texelSize, gradients.x, vogelDiskRotation);
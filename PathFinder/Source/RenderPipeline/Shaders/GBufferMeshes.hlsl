@@ -81,8 +81,9 @@ float3 FetchNormalMap(VertexOut vertex, Material material)
 {
     Texture2D normalMap = Textures2D[material.NormalMapIndex];
     
-    float3 normal = normalMap.Sample(AnisotropicClampSampler(), vertex.UV).xyz;
-    normal = normal * 2.0 - 1.0;
+    // Normal maps are baked to two channel formats, Z is reconstructed from unit length
+    float2 normalXY = normalMap.Sample(AnisotropicClampSampler(), vertex.UV).xy * 2.0 - 1.0;
+    float3 normal = float3(normalXY, sqrt(saturate(1.0 - dot(normalXY, normalXY))));
 
     return normalize(mul(vertex.TBN, normal));
 }
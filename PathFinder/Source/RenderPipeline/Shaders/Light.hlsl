@@ -31,15 +31,21 @@ struct Light
 struct LightTablePartitionInfo
 {
     uint SphericalLightsOffset;
-    uint RectangularLightsOffset;
     uint EllipticalLightsOffset;
+    uint RectangularLightsOffset;
     uint SphericalLightsCount;
-    uint RectangularLightsCount;
     uint EllipticalLightsCount;
+    uint RectangularLightsCount;
     uint TotalLightsCount;
     uint Pad1__;
 };
 
+struct LightCluster
+{
+    uint LightIndexOffset;
+    uint LightCount;
+};
+
 struct LTCTerms
 {
     float3x3 MInvSpecular;
@@ -0,0 +1,139 @@
+#ifndef _LightTree__
+#define _LightTree__
+
+struct LightTreeNode
+{
+    float3 BoundsMin;
+    float Flux;
+    float3 BoundsMax;
+    float CosThetaO;
+    float3 ConeAxis;
+    float CosThetaE;
+    uint ChildOrLightIndex;
+    uint IsLeaf;
+    uint Pad0__;
+    uint Pad1__;
+};
+
+struct LightTreeSample
+{
+    uint LightIndex;
+    // Probability of picking the light, zero when no light was picked
+    float PDF;
+};
+
+// Tree is built with median splits, so depth is logarithmic to light count
+static const uint LightTreeMaxDepth = 32;
+
+// cos(max(0, a - b)) given sines and cosines of both angles
+float CosSubClamped(float sinA, float cosA, float sinB, float cosB)
+{
+    return cosA > cosB ? 1.0 : cosA * cosB + sinA * sinB;
+}
+
+float SinSubClamped(float sinA, float cosA, float sinB, float cosB)
+{
+    return cosA > cosB ? 0.0 : sinA * cosB - cosA * sinB;
+}
+
+// Conservative estimate of light a node can deliver to a surface point
+// https://fpsunflower.github.io/ckulla/data/many-lights-hpg2018.pdf
+float LightTreeNodeImportance(LightTreeNode node, float3 surfacePosition, float3 surfaceNormal)
+{
+    float3 center = (node.BoundsMin + node.BoundsMax) * 0.5;
+    float radius = length(node.BoundsMax - node.BoundsMin) * 0.5;
+    float3 centerToSurface = surfacePosition - center;
+
+    // Keep importance finite for points inside or close to bounds
+    float distanceSq = max(dot(centerToSurface, centerToSurface), radius * radius);
+    float3 surfaceToCenterDir = -normalize(centerToSurface);
+
+    // Angle between cone axis and direction towards surface
+    float cosThetaW = dot(node.ConeAxis, -surfaceToCenterDir);
+    float sinThetaW = sqrt(max(0.0, 1.0 - cosThetaW * cosThetaW));
+
+    // Angle subtended by bounds as seen from surface
+    float sinThetaBSq = radius * radius / dot(centerToSurface, centerToSurface);
+    float cosThetaB = sinThetaBSq < 1.0 ? sqrt(1.0 - sinThetaBSq) : -1.0;
+    float sinThetaB = sqrt(max(0.0, 1.0 - cosThetaB * cosThetaB));
+
+    float sinThetaO = sqrt(max(0.0, 1.0 - node.CosThetaO * node.CosThetaO));
+    float cosThetaX = CosSubClamped(sinThetaW, cosThetaW, sinThetaO, node.CosThetaO);
+    float sinThetaX = SinSubClamped(sinThetaW, cosThetaW, sinThetaO, node.CosThetaO);
+    float cosThetaP = CosSubClamped(sinThetaX, cosThetaX, sinThetaB, cosThetaB);
+
+    // Surface is outside of emission cone
+    if (cosThetaP <= node.CosThetaE)
+    {
+        return 0.0;
+    }
+
+    // Incident angle at the surface, relaxed by bounds extent
+    float cosThetaI = dot(surfaceNormal, surfaceToCenterDir);
+    float sinThetaI = sqrt(max(0.0, 1.0 - cosThetaI * cosThetaI));
+    float cosThetaIP = CosSubClamped(sinThetaI, cosThetaI, sinThetaB, cosThetaB);
+
+    return max(0.0, node.Flux * cosThetaP * cosThetaIP / distanceSq);
+}
+
+// Descends the tree choosing children proportionally to their importance, reusing random number on every level
+LightTreeSample SampleLightTree(StructuredBuffer<LightTreeNode> tree, uint nodeCount, float3 surfacePosition, float3 surfaceNormal, float u)
+{
+    LightTreeSample treeSample;
+    treeSample.LightIndex = 0;
+    treeSample.PDF = 0.0;
+
+    if (nodeCount == 0)
+    {
+        return treeSample;
+    }
+
+    uint nodeIndex = 0;
+    float pdf = 1.0;
+
+    [loop]
+    for (uint depth = 0; depth < LightTreeMaxDepth; ++depth)
+    {
+        LightTreeNode node = tree[nodeIndex];
+
+        if (node.IsLeaf)
+        {
+            treeSample.LightIndex = node.ChildOrLightIndex;
+            treeSample.PDF = pdf;
+            break;
+        }
+
+        uint leftChildIndex = nodeIndex + 1;
+        uint rightChildIndex = node.ChildOrLightIndex;
+        float leftImportance = LightTreeNodeImportance(tree[leftChildIndex], surfacePosition, surfaceNormal);
+        float rightImportance = LightTreeNodeImportance(tree[rightChildIndex], surfacePosition, surfaceNormal);
+        float totalImportance = leftImportance + rightImportance;
+
+        if (totalImportance <= 0.0)
+        {
+            break;
+        }
+
+        float leftProbability = leftImportance / totalImportance;
+
+        if (u < leftProbability)
+        {
+            u = u / leftProbability;
+            pdf *= leftProbability;
+            nodeIndex = leftChildIndex;
+        }
+        else
+        {
+            u = (u - leftProbability) / (1.0 - leftProbability);
+            pdf *= 1.0 - leftProbability;
+            nodeIndex = rightChildIndex;
+        }
+
+        // Rescaling may push the number to 1 due to precision loss
+        u = min(u, 0.99999994);
+    }
+
+    return treeSample;
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include "GBuffer.hlsl"
 #include "ShadingPacking.hlsl"
 #include "Random.hlsl"
+#include "LightTree.hlsl"
 
 struct ShadingResult
 {
@@ -32,56 +33,79 @@ struct PassData
     uint2 BlueNoiseTextureSize;
     uint RngSeedsTexIdx;
     uint FrameNumber;
+    // 16 byte boundary
+    uint3 LightClusterGridDimensions;
+    uint LightTreeNodeCount;
+    // 16 byte boundary
+    LightTablePartitionInfo LightPartitionInfo;
 };
 
-struct RootConstants
-{
-    uint CompressedLightPartitionInfo;
-};
-
-// Turing-level hardware can realistically work with 4 lights and 1 ray per light, per tile.
+// Turing-level hardware can realistically work with 4 rays per pixel.
 // We should not bother with more to make space for other rendering workloads.
+// Rays are distributed between lights by importance sampling the light tree, so the budget does not depend on light count.
 static const uint TotalMaxRayCount = 4;
 
 #define PassDataType PassData
 
 #include "MandatoryEntryPointInclude.hlsl"
 
-ConstantBuffer<RootConstants> RootConstantBuffer : register(b0);
 RaytracingAccelerationStructure SceneBVH : register(t0, space0);
 StructuredBuffer<Light> LightTable : register(t1, space0);
 StructuredBuffer<Material> MaterialTable : register(t2, space0);
+StructuredBuffer<LightCluster> LightClusters : register(t3, space0);
+StructuredBuffer<uint> LightClusterIndices : register(t4, space0);
+StructuredBuffer<LightTreeNode> LightTree : register(t5, space0);
 
 // An implementation of Combining Analytic Direct Illumination and Stochastic Shadows
 // http://casual-effects.com/research/Heitz2018Shadow/Heitz2018SIGGRAPHTalk.pdf
 // https://hal.archives-ouvertes.fr/hal-01761558/file/heitzI3D2018_slides.pdf
 // https://research.nvidia.com/sites/default/files/pubs/2018-05_Combining-Analytic-Direct//I3D2018_combining.pdf
 
-LightTablePartitionInfo DecompressLightPartitionInfo()
+LightCluster FetchLightCluster(uint2 pixelIndex, float viewDepth)
+{
+    uint3 gridDimensions = PassDataCB.LightClusterGridDimensions;
+    float nearPlane = FrameDataCB.CurrentFrameCamera.NearPlane;
+    float farPlane = FrameDataCB.CurrentFrameCamera.FarPlane;
+
+    uint2 tile = min(pixelIndex * gridDimensions.xy / DispatchRaysDimensions().xy, gridDimensions.xy - 1);
+
+    // Depth slices are distributed exponentially between near and far planes
+    float slice = log(viewDepth / nearPlane) / log(farPlane / nearPlane) * gridDimensions.z;
+    uint sliceIndex = clamp(slice, 0.0, gridDimensions.z - 1);
+
+    return LightClusters[(sliceIndex * gridDimensions.y + tile.y) * gridDimensions.x + tile.x];
+}
+
+// Cluster light lists contain light table indices of all types sorted in ascending order
+bool IsInLightTablePartition(uint lightTableOffset, uint partitionOffset, uint partitionCount)
 {
-    // Light table offsets are supplied through root constants to speed up access
-    // Lights are expected to be placed in order: spherical -> rectangular -> disk
-    // Offsets are encoded in 8 bits each which means there can be no more than 256 lights total
-    uint compressed = RootConstantBuffer.CompressedLightPartitionInfo;
-    static const uint sphericalLightsOffset = (compressed >> 24) & 0xFF;
-    static const uint rectangularLightsOffset = (compressed >> 16) & 0xFF;
-    static const uint ellipticalLightsOffset = (compressed >> 8) & 0xFF;
-    static const uint totalLightsCount = compressed & 0xFF;
-
-    static const uint sphericalLightsCount = rectangularLightsOffset - sphericalLightsOffset;
-    static const uint rectangularLightsCount = ellipticalLightsOffset - rectangularLightsOffset;
-    static const uint ellipticalLightsCount = totalLightsCount - rectangularLightsCount - sphericalLightsCount;
-
-    LightTablePartitionInfo info;
-    info.EllipticalLightsCount = ellipticalLightsCount;
-    info.EllipticalLightsOffset = ellipticalLightsOffset;
-    info.RectangularLightsCount = rectangularLightsCount;
-    info.RectangularLightsOffset = rectangularLightsOffset;
-    info.SphericalLightsCount = sphericalLightsCount;
-    info.SphericalLightsOffset = sphericalLightsOffset;
-    info.TotalLightsCount = totalLightsCount;
-
-    return info;
+    return lightTableOffset >= partitionOffset && lightTableOffset < partitionOffset + partitionCount;
+}
+
+// Binary search relying on ascending order of cluster light lists
+bool IsInLightCluster(uint lightTableOffset, LightCluster lightCluster)
+{
+    uint first = lightCluster.LightIndexOffset;
+    uint count = lightCluster.LightCount;
+
+    [loop]
+    while (count > 0)
+    {
+        uint halfCount = count / 2;
+        uint middle = first + halfCount;
+
+        if (LightClusterIndices[middle] < lightTableOffset)
+        {
+            first = middle + 1;
+            count -= halfCount + 1;
+        }
+        else
+        {
+            count = halfCount;
+        }
+    }
+
+    return first < lightCluster.LightIndexOffset + lightCluster.LightCount && LightClusterIndices[first] == lightTableOffset;
 }
 
 ShadingResult ZeroShadingResult()
@@ -93,31 +117,32 @@ ShadingResult ZeroShadingResult()
     return result;
 }
 
-// Distributes rays between lights depending on their total amount
-uint RaysPerLight(LightTablePartitionInfo lightTableInfo)
-{
-    uint raysPerLight = TotalMaxRayCount / lightTableInfo.TotalLightsCount;
-    return raysPerLight;
-}
-
-float4 RandomNumbersForLight(uint lightIndex, uint rayIndex, uint raysPerLight, float4 blueNoise)
+float4 RandomNumbersForRay(uint rayIndex, float4 blueNoise)
 {
-    // Halton sequence array must accommodate RaysPerLight number of sets
+    // Halton sequence array must accommodate TotalMaxRayCount number of sets
     float4 additionalShift = PassDataCB.Halton;
 
+    // Decorrelate rays of a pixel by shifting them along R4 sequence
+    float4 rayShift = rayIndex * float4(0.8566748838545, 0.7338918566271, 0.6287067210378, 0.5385972572236);
+
     // Used for 2D position on light/BRDF
-    float u1 = frac(additionalShift.r + blueNoise.r);
-    float u2 = frac(additionalShift.g + blueNoise.g);
+    float u1 = frac(additionalShift.r + blueNoise.r + rayShift.x);
+    float u2 = frac(additionalShift.g + blueNoise.g + rayShift.y);
 
     // Choosing BRDF lobes
-    float u3 = frac(additionalShift.b + blueNoise.b);
+    float u3 = frac(additionalShift.b + blueNoise.b + rayShift.z);
 
     // Choosing between light and BRDF sampling
-    float u4 = frac(additionalShift.a + blueNoise.a);
+    float u4 = frac(additionalShift.a + blueNoise.a + rayShift.w);
 
     return float4(u1, u2, u3, u4);
 }
 
+float RandomNumberForLightSelection(uint rayIndex, float4 blueNoise)
+{
+    return Random(float4(blueNoise.xy, rayIndex, PassDataCB.FrameNumber));
+}
+
 //--------------------------------------------------------------------------------------------------
 
 LTCTerms FetchLTCTerms(GBufferStandard gBuffer, Material material, float3 viewDirWS)
@@ -235,50 +260,24 @@ void ShadeWithSphericalLights(
     GBufferStandard gBuffer,
     LTCTerms ltcTerms,
     LightTablePartitionInfo lightPartitionInfo,
-    float4 blueNoise,
+    LightCluster lightCluster,
     float3 viewDirection,
     float3 surfacePosition,
-    inout RTData rtData,
     inout ShadingResult shadingResult)
 {
-    uint raysPerLight = RaysPerLight(lightPartitionInfo);
-
-    for (uint lightIdx = 0; lightIdx < lightPartitionInfo.SphericalLightsCount; ++lightIdx)
+    for (uint clusterLightIdx = 0; clusterLightIdx < lightCluster.LightCount; ++clusterLightIdx)
     {
-        uint lightTableOffset = lightIdx + lightPartitionInfo.SphericalLightsOffset;
+        uint lightTableOffset = LightClusterIndices[lightCluster.LightIndexOffset + clusterLightIdx];
 
-        Light light = LightTable[lightTableOffset];
+        if (!IsInLightTablePartition(lightTableOffset, lightPartitionInfo.SphericalLightsOffset, lightPartitionInfo.SphericalLightsCount))
+        {
+            continue;
+        }
 
+        Light light = LightTable[lightTableOffset];
         LightPoints lightPoints = ComputeLightPoints(light, surfacePosition);
-        ShereLightSolidAngleSamplingInputs samplingInputs = ComputeSphericalLightSamplingInputs(light, surfacePosition);
         LTCAnalyticEvaluationResult directLightingEvaluationResult = EvaluateDirectSphericalLighting(light, lightPoints, gBuffer, ltcTerms, viewDirection, surfacePosition);
 
-        [unroll]
-        for (uint rayIdx = 0; rayIdx < raysPerLight; ++rayIdx)
-        {
-            float4 randomNumbers = RandomNumbersForLight(lightTableOffset, rayIdx, raysPerLight, blueNoise);
-
-            // Randomly pick specular or diffuse lobe based on diffuse probability
-            bool isSpecular = randomNumbers.z > directLightingEvaluationResult.DiffuseProbability;
-            float3x3 M = isSpecular ? ltcTerms.MSpecular : ltcTerms.MDiffuse;
-
-            // Pick a light sampling vector based on probability of taking a vector from BRDF distribution
-            // versus picking a direct vector to one of random points on the light's surface
-            bool sampleBRDF = randomNumbers.w <= directLightingEvaluationResult.BRDFProbability;
-
-            float3 sampleVector = sampleBRDF ?
-                LTCSampleVector(M, randomNumbers.x, randomNumbers.y) :
-                SphericalLightSampleVector(samplingInputs, randomNumbers.x, randomNumbers.y);
-
-            LightSample lightSample = SampleSphericalLight(light, samplingInputs, sampleVector);
-
-            float3 brdf = SampleBRDF(light, ltcTerms, directLightingEvaluationResult, lightSample, surfacePosition) / raysPerLight;
-
-            uint rayLightPairIndex = lightTableOffset * raysPerLight + rayIdx;
-            SetStochasticBRDFMagnitude(rtData, brdf, rayLightPairIndex);
-            SetRaySphericalLightIntersectionPoint(rtData, light, lightSample.IntersectionPoint, rayLightPairIndex);
-        }
-
         shadingResult.AnalyticUnshadowedOutgoingLuminance += directLightingEvaluationResult.OutgoingLuminance;
     }
 }
@@ -287,44 +286,24 @@ void ShadeWithRectangularLights(
     GBufferStandard gBuffer,
     LTCTerms ltcTerms,
     LightTablePartitionInfo lightPartitionInfo,
-    float4 blueNoise,
+    LightCluster lightCluster,
     float3 viewDirection,
     float3 surfacePosition,
-    inout RTData rtData,
     inout ShadingResult shadingResult)
 {
-    uint raysPerLight = RaysPerLight(lightPartitionInfo);
-
-    for (uint lightIdx = 0; lightIdx < lightPartitionInfo.RectangularLightsCount; ++lightIdx)
+    for (uint clusterLightIdx = 0; clusterLightIdx < lightCluster.LightCount; ++clusterLightIdx)
     {
-        uint lightTableOffset = lightIdx + lightPartitionInfo.RectangularLightsOffset;
+        uint lightTableOffset = LightClusterIndices[lightCluster.LightIndexOffset + clusterLightIdx];
 
-        Light light = LightTable[lightTableOffset];
+        if (!IsInLightTablePartition(lightTableOffset, lightPartitionInfo.RectangularLightsOffset, lightPartitionInfo.RectangularLightsCount))
+        {
+            continue;
+        }
 
+        Light light = LightTable[lightTableOffset];
         LightPoints lightPoints = ComputeLightPoints(light, surfacePosition);
-        RectLightSolidAngleSamplingInputs samplingInputs = ComputeRectLightSolidAngleSamplingInputs(lightPoints, surfacePosition);
         LTCAnalyticEvaluationResult directLightingEvaluationResult = EvaluateDirectRectangularLighting(light, lightPoints, gBuffer, ltcTerms, viewDirection, surfacePosition);
 
-        [unroll]
-        for (uint rayIdx = 0; rayIdx < raysPerLight; ++rayIdx)
-        {
-            float4 randomNumbers = RandomNumbersForLight(lightTableOffset, rayIdx, raysPerLight, blueNoise);
-            bool isSpecular = randomNumbers.z > directLightingEvaluationResult.DiffuseProbability;
-            float3x3 M = isSpecular ? ltcTerms.MSpecular : ltcTerms.MDiffuse;
-            bool sampleBRDF = randomNumbers.w <= directLightingEvaluationResult.BRDFProbability;
-
-            float3 sampleVector = sampleBRDF ?
-                LTCSampleVector(M, randomNumbers.x, randomNumbers.y) :
-                RectangularLightSampleVector(samplingInputs, randomNumbers.x, randomNumbers.y);
-
-            LightSample lightSample = SampleRectangularLight(light, samplingInputs, lightPoints, sampleVector);
-            float3 brdf = SampleBRDF(light, ltcTerms, directLightingEvaluationResult, lightSample, surfacePosition) / raysPerLight;
-
-            uint rayLightPairIndex = lightTableOffset * raysPerLight + rayIdx;
-            SetStochasticBRDFMagnitude(rtData, brdf, rayLightPairIndex);
-            SetRayRectangularLightIntersectionPoint(rtData, light, lightPoints.LightRotation, lightSample.IntersectionPoint, rayLightPairIndex);
-        }
-
         shadingResult.AnalyticUnshadowedOutgoingLuminance += directLightingEvaluationResult.OutgoingLuminance;
     }
 }
@@ -333,57 +312,142 @@ void ShadeWithEllipticalLights(
     GBufferStandard gBuffer,
     LTCTerms ltcTerms,
     LightTablePartitionInfo lightPartitionInfo,
-    float4 blueNoise,
+    LightCluster lightCluster,
     float3 viewDirection,
     float3 surfacePosition,
-    inout RTData rtData,
     inout ShadingResult shadingResult)
 {
-    uint raysPerLight = RaysPerLight(lightPartitionInfo);
-
-    for (uint lightIdx = 0; lightIdx < lightPartitionInfo.EllipticalLightsCount; ++lightIdx)
+    for (uint clusterLightIdx = 0; clusterLightIdx < lightCluster.LightCount; ++clusterLightIdx)
     {
-        uint lightTableOffset = lightIdx + lightPartitionInfo.EllipticalLightsOffset;
+        uint lightTableOffset = LightClusterIndices[lightCluster.LightIndexOffset + clusterLightIdx];
 
-        Light light = LightTable[lightTableOffset];
+        if (!IsInLightTablePartition(lightTableOffset, lightPartitionInfo.EllipticalLightsOffset, lightPartitionInfo.EllipticalLightsCount))
+        {
+            continue;
+        }
 
-        // Treat elliptical light as rectangular because solid angle sampling of spherical ellipsoids 
-        // is long, branch heavy and not very suited for real-time application, IMO.
-        // Treating ellipse as rectangle means we will have some of the rays miss the light,
-        // leading to a slightly increased variance, but it still will be better than area sampling.
+        Light light = LightTable[lightTableOffset];
         LightPoints lightPoints = ComputeLightPoints(light, surfacePosition);
-        RectLightSolidAngleSamplingInputs samplingInputs = ComputeRectLightSolidAngleSamplingInputs(lightPoints, surfacePosition);
         LTCAnalyticEvaluationResult directLightingEvaluationResult = EvaluateDirectRectangularLighting(light, lightPoints, gBuffer, ltcTerms, viewDirection, surfacePosition);
 
-        [unroll]
-        for (uint rayIdx = 0; rayIdx < raysPerLight; ++rayIdx)
-        {
-            float4 randomNumbers = RandomNumbersForLight(lightTableOffset, rayIdx, raysPerLight, blueNoise);
-            bool isSpecular = randomNumbers.z > directLightingEvaluationResult.DiffuseProbability;
-            float3x3 M = isSpecular ? ltcTerms.MSpecular : ltcTerms.MDiffuse;
-            bool sampleBRDF = randomNumbers.w <= directLightingEvaluationResult.BRDFProbability;
+        shadingResult.AnalyticUnshadowedOutgoingLuminance += directLightingEvaluationResult.OutgoingLuminance;
+    }
+}
+
+void SampleSphericalLightStochastically(
+    Light light,
+    GBufferStandard gBuffer,
+    LTCTerms ltcTerms,
+    float4 randomNumbers,
+    float3 viewDirection,
+    float3 surfacePosition,
+    uint rayIdx,
+    inout RTData rtData)
+{
+    LightPoints lightPoints = ComputeLightPoints(light, surfacePosition);
+    ShereLightSolidAngleSamplingInputs samplingInputs = ComputeSphericalLightSamplingInputs(light, surfacePosition);
+    LTCAnalyticEvaluationResult directLightingEvaluationResult = EvaluateDirectSphericalLighting(light, lightPoints, gBuffer, ltcTerms, viewDirection, surfacePosition);
+
+    // Randomly pick specular or diffuse lobe based on diffuse probability
+    bool isSpecular = randomNumbers.z > directLightingEvaluationResult.DiffuseProbability;
+    float3x3 M = isSpecular ? ltcTerms.MSpecular : ltcTerms.MDiffuse;
+
+    // Pick a light sampling vector based on probability of taking a vector from BRDF distribution
+    // versus picking a direct vector to one of random points on the light's surface
+    bool sampleBRDF = randomNumbers.w <= directLightingEvaluationResult.BRDFProbability;
+
+    float3 sampleVector = sampleBRDF ?
+        LTCSampleVector(M, randomNumbers.x, randomNumbers.y) :
+        SphericalLightSampleVector(samplingInputs, randomNumbers.x, randomNumbers.y);
+
+    LightSample lightSample = SampleSphericalLight(light, samplingInputs, sampleVector);
+    float3 brdf = SampleBRDF(light, ltcTerms, directLightingEvaluationResult, lightSample, surfacePosition);
+
+    SetStochasticBRDFMagnitude(rtData, brdf, rayIdx);
+    SetRaySphericalLightIntersectionPoint(rtData, light, lightSample.IntersectionPoint, rayIdx);
+}
 
-            float3 sampleVector = sampleBRDF ?
-                LTCSampleVector(M, randomNumbers.x, randomNumbers.y) :
-                RectangularLightSampleVector(samplingInputs, randomNumbers.x, randomNumbers.y);
+void SampleFlatLightStochastically(
+    Light light,
+    GBufferStandard gBuffer,
+    LTCTerms ltcTerms,
+    float4 randomNumbers,
+    float3 viewDirection,
+    float3 surfacePosition,
+    uint rayIdx,
+    inout RTData rtData)
+{
+    // Treat elliptical light as rectangular because solid angle sampling of spherical ellipsoids 
+    // is long, branch heavy and not very suited for real-time application, IMO.
+    // Treating ellipse as rectangle means we will have some of the rays miss the light,
+    // leading to a slightly increased variance, but it still will be better than area sampling.
+    LightPoints lightPoints = ComputeLightPoints(light, surfacePosition);
+    RectLightSolidAngleSamplingInputs samplingInputs = ComputeRectLightSolidAngleSamplingInputs(lightPoints, surfacePosition);
+    LTCAnalyticEvaluationResult directLightingEvaluationResult = EvaluateDirectRectangularLighting(light, lightPoints, gBuffer, ltcTerms, viewDirection, surfacePosition);
+
+    bool isSpecular = randomNumbers.z > directLightingEvaluationResult.DiffuseProbability;
+    float3x3 M = isSpecular ? ltcTerms.MSpecular : ltcTerms.MDiffuse;
+    bool sampleBRDF = randomNumbers.w <= directLightingEvaluationResult.BRDFProbability;
+
+    float3 sampleVector = sampleBRDF ?
+        LTCSampleVector(M, randomNumbers.x, randomNumbers.y) :
+        RectangularLightSampleVector(samplingInputs, randomNumbers.x, randomNumbers.y);
+
+    LightSample lightSample = light.LightType == LightTypeRectangle ?
+        SampleRectangularLight(light, samplingInputs, lightPoints, sampleVector) :
+        SampleEllipticalLight(light, samplingInputs, lightPoints, sampleVector);
+
+    float3 brdf = SampleBRDF(light, ltcTerms, directLightingEvaluationResult, lightSample, surfacePosition);
+
+    SetStochasticBRDFMagnitude(rtData, brdf, rayIdx);
+    SetRayRectangularLightIntersectionPoint(rtData, light, lightPoints.LightRotation, lightSample.IntersectionPoint, rayIdx);
+}
 
-            LightSample lightSample = SampleEllipticalLight(light, samplingInputs, lightPoints, sampleVector);
-            float3 brdf = SampleBRDF(light, ltcTerms, directLightingEvaluationResult, lightSample, surfacePosition) / raysPerLight;
+// Every ray picks a light from the light tree proportionally to its estimated importance,
+// so that ray budget stays constant regardless of how many lights there are in the scene.
+// Analytic term only accounts for lights of the cluster, so lights picked outside of it contribute nothing
+// to either stochastic term, which keeps shadowed to unshadowed ratio an estimate over the same light set.
+void SampleLightsStochastically(
+    GBufferStandard gBuffer,
+    LTCTerms ltcTerms,
+    LightCluster lightCluster,
+    float4 blueNoise,
+    float3 viewDirection,
+    float3 surfacePosition,
+    inout RTData rtData)
+{
+    [unroll]
+    for (uint rayIdx = 0; rayIdx < TotalMaxRayCount; ++rayIdx)
+    {
+        float lightSelectionNumber = RandomNumberForLightSelection(rayIdx, blueNoise);
+        LightTreeSample treeSample = SampleLightTree(LightTree, PassDataCB.LightTreeNodeCount, surfacePosition, gBuffer.Normal, lightSelectionNumber);
 
-            uint rayLightPairIndex = lightTableOffset * raysPerLight + rayIdx;
-            SetStochasticBRDFMagnitude(rtData, brdf, rayLightPairIndex);
-            SetRayRectangularLightIntersectionPoint(rtData, light, lightPoints.LightRotation, lightSample.IntersectionPoint, rayLightPairIndex);
+        if (treeSample.PDF <= 0.0 || !IsInLightCluster(treeSample.LightIndex, lightCluster))
+        {
+            continue;
         }
 
-        shadingResult.AnalyticUnshadowedOutgoingLuminance += directLightingEvaluationResult.OutgoingLuminance;
+        Light light = LightTable[treeSample.LightIndex];
+        float4 randomNumbers = RandomNumbersForRay(rayIdx, blueNoise);
+
+        [branch]
+        if (light.LightType == LightTypeSphere)
+        {
+            SampleSphericalLightStochastically(light, gBuffer, ltcTerms, randomNumbers, viewDirection, surfacePosition, rayIdx, rtData);
+        }
+        else
+        {
+            SampleFlatLightStochastically(light, gBuffer, ltcTerms, randomNumbers, viewDirection, surfacePosition, rayIdx, rtData);
+        }
+
+        SetRayLight(rtData, treeSample.LightIndex, 1.0 / (treeSample.PDF * TotalMaxRayCount), rayIdx);
     }
 }
 
-float4 TraceShadows(RTData rtData, LightTablePartitionInfo lightPartitionInfo, float3 surfacePosition, float4 blueNoise)
+float4 TraceShadows(RTData rtData, float3 surfacePosition, float4 blueNoise)
 {
-    // Shadow values for hard coded maximum of 4 lights
+    // Shadow values for hard coded maximum of 4 rays
     float4 shadowValues = 0.xxxx;
-    uint raysPerLight = RaysPerLight(lightPartitionInfo);
 
     [unroll]
     for (uint i = 0; i < TotalMaxRayCount; ++i)
@@ -393,8 +457,7 @@ float4 TraceShadows(RTData rtData, LightTablePartitionInfo lightPartitionInfo, f
             continue;
         }
 
-        uint lightIndex = i / raysPerLight;
-        Light light = LightTable[lightIndex];
+        Light light = LightTable[rtData.LightIndices[i]];
         float3 lightIntersectionPoint = 0.xxx;
         float3x3 lightRotation = RotationMatrix3x3(light.Orientation.xyz);
 
@@ -442,10 +505,8 @@ float4 TraceShadows(RTData rtData, LightTablePartitionInfo lightPartitionInfo, f
     return shadowValues;
 }
 
-void CombineStochasticLightingAndShadows(RTData rtData, LightTablePartitionInfo lightPartitionInfo, inout ShadingResult shadingResult)
+void CombineStochasticLightingAndShadows(RTData rtData, inout ShadingResult shadingResult)
 {
-    uint raysPerLight = RaysPerLight(lightPartitionInfo);
-
     [unroll]
     for (uint i = 0; i < TotalMaxRayCount; ++i)
     {
@@ -454,10 +515,9 @@ void CombineStochasticLightingAndShadows(RTData rtData, LightTablePartitionInfo
             continue;
         }
 
-        uint lightIndex = i / raysPerLight;
-        Light light = LightTable[lightIndex];
+        Light light = LightTable[rtData.LightIndices[i]];
         float3 brdf = GetStochasticBRDFMagnitude(rtData, i);
-        float3 unshadowed = brdf * light.Color.rgb * light.Luminance;
+        float3 unshadowed = brdf * light.Color.rgb * light.Luminance * rtData.SampleWeights[i];
 
         shadingResult.StochasticUnshadowedOutgoingLuminance += unshadowed;
         shadingResult.StochasticShadowedOutgoingLuminance += unshadowed * rtData.ShadowFactors[i];
@@ -473,23 +533,28 @@ ShadingResult EvaluateStandardGBufferLighting(GBufferTexturePack gBufferTextures
     LoadStandardGBuffer(gBuffer, gBufferTextures, pixelIndex);
 
     Material material = MaterialTable[gBuffer.MaterialIndex];
-    LightTablePartitionInfo partitionInfo = DecompressLightPartitionInfo();
+    LightTablePartitionInfo partitionInfo = PassDataCB.LightPartitionInfo;
 
     float4 blueNoise = blueNoiseTexture[rngSeeds[pixelIndex].xyz];
-    float3 surfacePosition = NDCDepthToWorldPosition(depth, uv, FrameDataCB.CurrentFrameCamera);
+    float3 viewPosition;
+    float3 surfacePosition;
+    NDCDepthToViewAndWorldPositions(depth, uv, FrameDataCB.CurrentFrameCamera, viewPosition, surfacePosition);
+
+    LightCluster lightCluster = FetchLightCluster(pixelIndex, viewPosition.z);
     float3 viewDirection = normalize(FrameDataCB.CurrentFrameCamera.Position.xyz - surfacePosition);
 
     LTCTerms ltcTerms = FetchLTCTerms(gBuffer, material, viewDirection);
     ShadingResult shadingResult = ZeroShadingResult();
     RTData rtData = ZeroRTData();
 
-    ShadeWithSphericalLights(gBuffer, ltcTerms, partitionInfo, blueNoise, viewDirection, surfacePosition, rtData, shadingResult);
-    ShadeWithRectangularLights(gBuffer, ltcTerms, partitionInfo, blueNoise, viewDirection, surfacePosition, rtData, shadingResult);
-    ShadeWithEllipticalLights(gBuffer, ltcTerms, partitionInfo, blueNoise, viewDirection, surfacePosition, rtData, shadingResult);
+    ShadeWithSphericalLights(gBuffer, ltcTerms, partitionInfo, lightCluster, viewDirection, surfacePosition, shadingResult);
+    ShadeWithRectangularLights(gBuffer, ltcTerms, partitionInfo, lightCluster, viewDirection, surfacePosition, shadingResult);
+    ShadeWithEllipticalLights(gBuffer, ltcTerms, partitionInfo, lightCluster, viewDirection, surfacePosition, shadingResult);
+    SampleLightsStochastically(gBuffer, ltcTerms, lightCluster, blueNoise, viewDirection, surfacePosition, rtData);
 
-    rtData.ShadowFactors = TraceShadows(rtData, partitionInfo, surfacePosition, blueNoise);
+    rtData.ShadowFactors = TraceShadows(rtData, surfacePosition, blueNoise);
 
-    CombineStochasticLightingAndShadows(rtData, partitionInfo, shadingResult);
+    CombineStochasticLightingAndShadows(rtData, shadingResult);
 
     return shadingResult;
 }
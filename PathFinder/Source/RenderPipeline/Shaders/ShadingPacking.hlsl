@@ -21,6 +21,9 @@ struct RTData
     uint4 BRDFResponses;
     uint4 RayLightIntersectionData;
     float4 ShadowFactors;
+    // Light table index of a light picked for each ray and its inverse selection probability
+    uint4 LightIndices;
+    float4 SampleWeights;
 };
 
 RTData ZeroRTData()
@@ -29,6 +32,8 @@ RTData ZeroRTData()
     data.BRDFResponses = 0.xxxx;
     data.RayLightIntersectionData = 0.xxxx;
     data.ShadowFactors = 1.xxxx;
+    data.LightIndices = 0.xxxx;
+    data.SampleWeights = 0.xxxx;
     return data;
 }
 
@@ -74,6 +79,12 @@ float3 GetStochasticBRDFMagnitude(RTData rtData, uint rayLightPairIndex)
     return rgb;
 }
 
+void SetRayLight(inout RTData rtData, uint lightIndex, float sampleWeight, uint rayLightPairIndex)
+{
+    rtData.LightIndices[rayLightPairIndex] = lightIndex;
+    rtData.SampleWeights[rayLightPairIndex] = sampleWeight;
+}
+
 void SetRaySphericalLightIntersectionPoint(inout RTData rtData, Light light, float3 interectionPoint, uint rayLightPairIndex)
 {
     // For spherical lights we encode a normalized direction from light's center to intersection point
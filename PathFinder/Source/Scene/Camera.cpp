@@ -95,6 +95,20 @@ namespace PathFinder
         return fabs(clipSpaceVector.w) > std::numeric_limits<float>::epsilon() ? clipSpaceVector / clipSpaceVector.w : clipSpaceVector;
     }
 
+    Geometry::Ray3D Camera::WorldRay(const glm::vec2 &screenUV) const
+    {
+        glm::vec2 ndcXY{ screenUV.x * 2.0f - 1.0f, 1.0f - screenUV.y * 2.0f };
+        glm::mat4 inverseViewProjection = InverseViewProjection();
+
+        glm::vec4 nearPoint = inverseViewProjection * glm::vec4{ ndcXY, 0.0f, 1.0f };
+        glm::vec4 farPoint = inverseViewProjection * glm::vec4{ ndcXY, 1.0f, 1.0f };
+
+        nearPoint /= nearPoint.w;
+        farPoint /= farPoint.w;
+
+        return { glm::vec3{ nearPoint }, glm::vec3{ farPoint - nearPoint } };
+    }
+
     glm::mat4 Camera::ViewProjection() const
     {
         return Projection() * View();
@@ -2,6 +2,7 @@
 
 #include <Geometry/Ray3D.hpp>
 #include <bitsery/bitsery.h>
+#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/mat4x4.hpp>
 #include <Utility/SerializationAdapters.hpp>
@@ -42,6 +43,10 @@ namespace PathFinder
 
         glm::vec3 WorldToNDC(const glm::vec3 &v) const;
 
+        /// Ray from the near plane through a point on screen.
+        /// Screen UV origin is top left corner.
+        Geometry::Ray3D WorldRay(const glm::vec2 &screenUV) const;
+
     private:
         glm::vec3 mFront;
         glm::vec3 mRight;
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <HardwareAbstractionLayer/RayTracingAccelerationStructure.hpp>
 #include <Foundation/BitwiseEnum.hpp>
+#include <Foundation/Assert.hpp>
 
 namespace PathFinder 
 {
@@ -11,6 +12,43 @@ namespace PathFinder
 
     inline static const auto NoEntityID = std::numeric_limits<EntityID>::max();
 
+    enum class EntityType : uint8_t
+    {
+        MeshInstance, SphericalLight, DiskLight, RectangularLight
+    };
+
+    // IDs are persistent for entity lifetime and are composed of entity type and its scene storage slot.
+    // They're used as ray tracing instance IDs, therefore must fit into 24 bits.
+    inline static const uint32_t EntityIDTypeBitCount = 2;
+    inline static const uint32_t EntityIDSlotBitCount = 22;
+    inline static const uint32_t EntityIDSlotMask = (1u << EntityIDSlotBitCount) - 1;
+
+    inline EntityID MakeEntityID(EntityType type, uint32_t slotIndex)
+    {
+        assert_format(slotIndex <= EntityIDSlotMask, "Entity storage slot index doesn't fit into entity ID");
+        return (EntityID(type) << EntityIDSlotBitCount) | (slotIndex & EntityIDSlotMask);
+    }
+
+    inline EntityType EntityIDType(EntityID id)
+    {
+        return EntityType(id >> EntityIDSlotBitCount);
+    }
+
+    inline uint32_t EntityIDSlotIndex(EntityID id)
+    {
+        return id & EntityIDSlotMask;
+    }
+
+    // IDs have no room for generations, so an ID may refer to another entity once the slot is reused.
+    // Pairing ID with generation of its slot detects that.
+    struct EntityHandle
+    {
+        EntityID ID = NoEntityID;
+        uint32_t Generation = 0;
+
+        inline bool IsValid() const { return ID != NoEntityID; }
+    };
+
     enum class EntityMask : uint8_t
     {
         Unknown = 0, MeshInstance = 1 << 0, Light = 1 << 1
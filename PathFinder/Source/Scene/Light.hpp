@@ -33,7 +33,7 @@ namespace PathFinder
         void SetArea(float area);
 
         glm::mat4 mModelMatrix;
-        EntityID mEntityID = 0;
+        EntityID mEntityID = NoEntityID;
         uint32_t mIndexInGPUTable = 0;
 
     private:
@@ -0,0 +1,144 @@
+#include "LightClusterBuilder.hpp"
+
+#include <Foundation/Pi.hpp>
+#include <Foundation/Assert.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace PathFinder
+{
+
+    LightClusterBuilder::LightClusterBuilder(Foundation::TaskScheduler* taskScheduler)
+        : mTaskScheduler{ taskScheduler } {}
+
+    float LightClusterBuilder::InfluenceRadius(float luminousPower)
+    {
+        // Illuminance of isotropic emitter: E = Phi / (4 * Pi * d^2)
+        return std::sqrt(std::max(luminousPower, 0.0f) / (4.0f * M_PI * MinIlluminance));
+    }
+
+    void LightClusterBuilder::Build(const Camera& camera, const std::vector<LightBounds>& lights)
+    {
+        glm::mat4 view = camera.View();
+        float tanHalfFOVV = std::tan(glm::radians(camera.FOVV()) * 0.5f);
+        float tanHalfFOVH = tanHalfFOVV * camera.AspectRatio();
+
+        std::vector<ViewSpaceSphere> spheres;
+        spheres.reserve(lights.size());
+
+        for (const LightBounds& light : lights)
+        {
+            glm::vec3 center = view * glm::vec4{ light.Position, 1.0f };
+            
+            // Lights entirely behind the camera or beyond far plane can't affect visible surfaces
+            if (center.z + light.Radius < camera.NearClipPlane() || center.z - light.Radius > camera.FarClipPlane())
+                continue;
+
+            spheres.push_back({ center, light.Radius, light.IndexInGPUTable });
+        }
+
+        mSliceLightIndices.resize(SliceCount);
+        mSliceClusters.resize(SliceCount);
+
+        // Slices are independent, each one fills its own light list
+        mTaskScheduler->ParallelFor(0, SliceCount, 1, [&](uint64_t slice)
+        {
+            float nearZ = SliceDepth(camera, slice);
+            float farZ = SliceDepth(camera, slice + 1);
+
+            std::vector<uint32_t>& sliceIndices = mSliceLightIndices[slice];
+            std::vector<GPULightCluster>& sliceClusters = mSliceClusters[slice];
+            sliceIndices.clear();
+            sliceClusters.assign(TileCountX * TileCountY, GPULightCluster{});
+
+            std::vector<const ViewSpaceSphere*> sliceSpheres;
+
+            for (const ViewSpaceSphere& sphere : spheres)
+            {
+                if (sphere.Center.z + sphere.Radius >= nearZ && sphere.Center.z - sphere.Radius <= farZ)
+                    sliceSpheres.push_back(&sphere);
+            }
+
+            for (auto tileY = 0u; tileY < TileCountY; ++tileY)
+            {
+                // Tile rows go top to bottom, while view space Y points up
+                float ndcTop = 1.0f - 2.0f * tileY / TileCountY;
+                float ndcBottom = 1.0f - 2.0f * (tileY + 1) / TileCountY;
+
+                for (auto tileX = 0u; tileX < TileCountX; ++tileX)
+                {
+                    float ndcLeft = -1.0f + 2.0f * tileX / TileCountX;
+                    float ndcRight = -1.0f + 2.0f * (tileX + 1) / TileCountX;
+
+                    // View space bounds of the froxel: extremes are reached at either near or far depth
+                    glm::vec3 froxelMin{
+                        std::min(ndcLeft * tanHalfFOVH * nearZ, ndcLeft * tanHalfFOVH * farZ),
+                        std::min(ndcBottom * tanHalfFOVV * nearZ, ndcBottom * tanHalfFOVV * farZ),
+                        nearZ
+                    };
+
+                    glm::vec3 froxelMax{
+                        std::max(ndcRight * tanHalfFOVH * nearZ, ndcRight * tanHalfFOVH * farZ),
+                        std::max(ndcTop * tanHalfFOVV * nearZ, ndcTop * tanHalfFOVV * farZ),
+                        farZ
+                    };
+
+                    GPULightCluster& cluster = sliceClusters[tileY * TileCountX + tileX];
+                    cluster.LightIndexOffset = static_cast<uint32_t>(sliceIndices.size());
+
+                    for (const ViewSpaceSphere* sphere : sliceSpheres)
+                    {
+                        glm::vec3 closestPoint = glm::clamp(sphere->Center, froxelMin, froxelMax);
+                        glm::vec3 delta = closestPoint - sphere->Center;
+
+                        if (glm::dot(delta, delta) <= sphere->Radius * sphere->Radius)
+                            sliceIndices.push_back(sphere->IndexInGPUTable);
+                    }
+
+                    cluster.LightCount = static_cast<uint32_t>(sliceIndices.size()) - cluster.LightIndexOffset;
+
+                    // Shading partitions lights by type through table ranges, which requires sorted indices
+                    std::sort(sliceIndices.begin() + cluster.LightIndexOffset, sliceIndices.end());
+                }
+            }
+        });
+
+        uint64_t totalIndexCount = 0;
+
+        for (const std::vector<uint32_t>& sliceIndices : mSliceLightIndices)
+        {
+            totalIndexCount += sliceIndices.size();
+        }
+
+        // Offsets are 32-bit on GPU. Slice lists are never longer than the compacted one, so this covers them too.
+        assert_format(totalIndexCount <= std::numeric_limits<uint32_t>::max(), "Light cluster index list exceeds 32-bit offset range");
+
+        // Compact per slice lists into one
+        mClusters.clear();
+        mLightIndices.clear();
+        mLightIndices.reserve(totalIndexCount);
+
+        for (auto slice = 0u; slice < SliceCount; ++slice)
+        {
+            uint32_t sliceOffset = static_cast<uint32_t>(mLightIndices.size());
+
+            for (GPULightCluster cluster : mSliceClusters[slice])
+            {
+                cluster.LightIndexOffset += sliceOffset;
+                mClusters.push_back(cluster);
+            }
+
+            mLightIndices.insert(mLightIndices.end(), mSliceLightIndices[slice].begin(), mSliceLightIndices[slice].end());
+        }
+    }
+
+    float LightClusterBuilder::SliceDepth(const Camera& camera, uint32_t slice) const
+    {
+        // Exponential distribution keeps froxels roughly cubical
+        float near = camera.NearClipPlane();
+        float far = camera.FarClipPlane();
+        return near * std::pow(far / near, float(slice) / SliceCount);
+    }
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Camera.hpp"
+
+#include <Foundation/TaskScheduler.hpp>
+
+#include <glm/vec3.hpp>
+#include <vector>
+
+namespace PathFinder
+{
+
+    struct GPULightCluster
+    {
+        uint32_t LightIndexOffset = 0;
+        uint32_t LightCount = 0;
+    };
+
+    // Bins lights into a froxel grid: screen tiles subdivided into exponentially distributed depth slices.
+    // Result is a cluster table pointing into one compact list of light table indices,
+    // so that shading only has to consider lights that can reach the cluster it is in.
+    class LightClusterBuilder
+    {
+    public:
+        struct LightBounds
+        {
+            glm::vec3 Position;
+            float Radius = 0.0f;
+            uint32_t IndexInGPUTable = 0;
+        };
+
+        static const uint32_t TileCountX = 16;
+        static const uint32_t TileCountY = 9;
+        static const uint32_t SliceCount = 24;
+
+        // Illuminance in lux below which light contribution is considered negligible
+        inline static const float MinIlluminance = 0.05f;
+
+        LightClusterBuilder(Foundation::TaskScheduler* taskScheduler);
+
+        // Distance at which point light of given power falls below MinIlluminance
+        static float InfluenceRadius(float luminousPower);
+
+        void Build(const Camera& camera, const std::vector<LightBounds>& lights);
+
+    private:
+        struct ViewSpaceSphere
+        {
+            glm::vec3 Center;
+            float Radius;
+            uint32_t IndexInGPUTable;
+        };
+
+        float SliceDepth(const Camera& camera, uint32_t slice) const;
+
+        Foundation::TaskScheduler* mTaskScheduler;
+        std::vector<std::vector<uint32_t>> mSliceLightIndices;
+        std::vector<std::vector<GPULightCluster>> mSliceClusters;
+        std::vector<GPULightCluster> mClusters;
+        std::vector<uint32_t> mLightIndices;
+
+    public:
+        inline const auto& Clusters() const { return mClusters; }
+        inline const auto& LightIndices() const { return mLightIndices; }
+        inline glm::uvec3 GridDimensions() const { return { TileCountX, TileCountY, SliceCount }; }
+    };
+
+}
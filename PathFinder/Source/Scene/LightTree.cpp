@@ -0,0 +1,222 @@
+#include "LightTree.hpp"
+
+#include <Foundation/Pi.hpp>
+
+#include <glm/geometric.hpp>
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace PathFinder
+{
+
+    void LightTree::Build(const std::vector<LightBounds>& lights)
+    {
+        if (!CanRefit(lights))
+        {
+            Rebuild(lights);
+            return;
+        }
+
+        Refit(lights);
+
+        // Moved lights may have made refitted nodes overlap a lot, making traversal less selective
+        if (TotalSurfaceArea() > mBuiltSurfaceArea * RefitDegradationThreshold)
+        {
+            Rebuild(lights);
+        }
+    }
+
+    uint32_t LightTree::BuildRecursive(const std::vector<LightBounds>& lights, std::vector<uint32_t>& lightOrder, uint64_t begin, uint64_t end)
+    {
+        uint32_t nodeIndex = mNodes.size();
+        mNodes.emplace_back();
+
+        if (end - begin == 1)
+        {
+            uint32_t lightIndex = lightOrder[begin];
+            mNodes[nodeIndex] = MakeLeaf(lights[lightIndex]);
+            mLeafNodeIndices[lightIndex] = nodeIndex;
+            return nodeIndex;
+        }
+
+        auto centroid = [&lights](uint32_t lightIndex)
+        {
+            return (lights[lightIndex].BoundsMin + lights[lightIndex].BoundsMax) * 0.5f;
+        };
+
+        glm::vec3 centroidsMin = centroid(lightOrder[begin]);
+        glm::vec3 centroidsMax = centroidsMin;
+
+        for (uint64_t i = begin + 1; i < end; ++i)
+        {
+            centroidsMin = glm::min(centroidsMin, centroid(lightOrder[i]));
+            centroidsMax = glm::max(centroidsMax, centroid(lightOrder[i]));
+        }
+
+        // Median split along the widest centroid extent keeps tree balanced and its depth logarithmic
+        glm::vec3 extent = centroidsMax - centroidsMin;
+        uint32_t axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+        uint64_t middle = (begin + end) / 2;
+
+        std::nth_element(lightOrder.begin() + begin, lightOrder.begin() + middle, lightOrder.begin() + end, [&](uint32_t a, uint32_t b)
+        {
+            return centroid(a)[axis] < centroid(b)[axis];
+        });
+
+        BuildRecursive(lights, lightOrder, begin, middle);
+        uint32_t rightChildIndex = BuildRecursive(lights, lightOrder, middle, end);
+
+        mNodes[nodeIndex] = MakeUnion(mNodes[nodeIndex + 1], mNodes[rightChildIndex]);
+        mNodes[nodeIndex].ChildOrLightIndex = rightChildIndex;
+
+        return nodeIndex;
+    }
+
+    void LightTree::Rebuild(const std::vector<LightBounds>& lights)
+    {
+        mNodes.clear();
+        mLeafNodeIndices.resize(lights.size());
+        mLightTableIndices.resize(lights.size());
+
+        for (auto i = 0u; i < lights.size(); ++i)
+        {
+            mLightTableIndices[i] = lights[i].IndexInGPUTable;
+        }
+
+        if (lights.empty())
+        {
+            mBuiltSurfaceArea = 0.0f;
+            return;
+        }
+
+        mNodes.reserve(lights.size() * 2 - 1);
+
+        std::vector<uint32_t> lightOrder(lights.size());
+        std::iota(lightOrder.begin(), lightOrder.end(), 0);
+
+        BuildRecursive(lights, lightOrder, 0, lights.size());
+
+        mBuiltSurfaceArea = TotalSurfaceArea();
+    }
+
+    void LightTree::Refit(const std::vector<LightBounds>& lights)
+    {
+        for (auto i = 0u; i < lights.size(); ++i)
+        {
+            mNodes[mLeafNodeIndices[i]] = MakeLeaf(lights[i]);
+        }
+
+        // Children are always placed after their parents, so reverse order visits them first
+        for (auto nodeIdx = int64_t(mNodes.size()) - 1; nodeIdx >= 0; --nodeIdx)
+        {
+            GPULightTreeNode& node = mNodes[nodeIdx];
+
+            if (node.IsLeaf)
+            {
+                continue;
+            }
+
+            uint32_t rightChildIndex = node.ChildOrLightIndex;
+            node = MakeUnion(mNodes[nodeIdx + 1], mNodes[rightChildIndex]);
+            node.ChildOrLightIndex = rightChildIndex;
+        }
+    }
+
+    bool LightTree::CanRefit(const std::vector<LightBounds>& lights) const
+    {
+        if (lights.size() != mLightTableIndices.size())
+        {
+            return false;
+        }
+
+        for (auto i = 0u; i < lights.size(); ++i)
+        {
+            if (lights[i].IndexInGPUTable != mLightTableIndices[i])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    float LightTree::TotalSurfaceArea() const
+    {
+        float area = 0.0f;
+
+        for (const GPULightTreeNode& node : mNodes)
+        {
+            glm::vec3 extent = node.BoundsMax - node.BoundsMin;
+            area += 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+        }
+
+        return area;
+    }
+
+    GPULightTreeNode LightTree::MakeLeaf(const LightBounds& light) const
+    {
+        GPULightTreeNode node{};
+        node.BoundsMin = light.BoundsMin;
+        node.BoundsMax = light.BoundsMax;
+        node.ConeAxis = light.Normal;
+        node.CosThetaO = light.CosThetaO;
+        node.CosThetaE = light.CosThetaE;
+        node.Flux = light.Flux;
+        node.ChildOrLightIndex = light.IndexInGPUTable;
+        node.IsLeaf = 1;
+        return node;
+    }
+
+    GPULightTreeNode LightTree::MakeUnion(const GPULightTreeNode& left, const GPULightTreeNode& right) const
+    {
+        GPULightTreeNode node{};
+        node.BoundsMin = glm::min(left.BoundsMin, right.BoundsMin);
+        node.BoundsMax = glm::max(left.BoundsMax, right.BoundsMax);
+        node.Flux = left.Flux + right.Flux;
+        node.CosThetaE = std::min(left.CosThetaE, right.CosThetaE);
+
+        // Bounding cone of two cones, as described in Importance Sampling of Many Lights with Adaptive Tree Splitting
+        float thetaLeft = std::acos(glm::clamp(left.CosThetaO, -1.0f, 1.0f));
+        float thetaRight = std::acos(glm::clamp(right.CosThetaO, -1.0f, 1.0f));
+        float thetaDelta = std::acos(glm::clamp(glm::dot(left.ConeAxis, right.ConeAxis), -1.0f, 1.0f));
+
+        if (std::min(thetaDelta + thetaRight, float(M_PI)) <= thetaLeft)
+        {
+            node.ConeAxis = left.ConeAxis;
+            node.CosThetaO = left.CosThetaO;
+            return node;
+        }
+
+        if (std::min(thetaDelta + thetaLeft, float(M_PI)) <= thetaRight)
+        {
+            node.ConeAxis = right.ConeAxis;
+            node.CosThetaO = right.CosThetaO;
+            return node;
+        }
+
+        float thetaO = (thetaLeft + thetaDelta + thetaRight) * 0.5f;
+        glm::vec3 rotationAxis = glm::cross(left.ConeAxis, right.ConeAxis);
+
+        // Cone covering whole sphere
+        if (thetaO >= M_PI || glm::dot(rotationAxis, rotationAxis) < 1e-12f)
+        {
+            node.ConeAxis = left.ConeAxis;
+            node.CosThetaO = -1.0f;
+            return node;
+        }
+
+        // Rotate left axis towards the right one around their common perpendicular (Rodrigues' formula)
+        float thetaRotation = thetaO - thetaLeft;
+        rotationAxis = glm::normalize(rotationAxis);
+        node.ConeAxis = glm::normalize(
+            left.ConeAxis * std::cos(thetaRotation) +
+            glm::cross(rotationAxis, left.ConeAxis) * std::sin(thetaRotation) +
+            rotationAxis * glm::dot(rotationAxis, left.ConeAxis) * (1.0f - std::cos(thetaRotation)));
+        node.CosThetaO = std::cos(thetaO);
+
+        return node;
+    }
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <vector>
+
+namespace PathFinder
+{
+
+    struct GPULightTreeNode
+    {
+        glm::vec3 BoundsMin;
+        float Flux = 0.0f;
+        // 16 byte boundary
+        glm::vec3 BoundsMax;
+        // Cosine of the angle bounding emitter normals around cone axis
+        float CosThetaO = 1.0f;
+        // 16 byte boundary
+        glm::vec3 ConeAxis;
+        // Cosine of the angle emission spreads beyond normals bound
+        float CosThetaE = 0.0f;
+        // 16 byte boundary
+        // Left child immediately follows its parent, so inner nodes only store right child index.
+        // Leaves store light table index instead.
+        uint32_t ChildOrLightIndex = 0;
+        uint32_t IsLeaf = 0;
+        uint32_t Pad0__;
+        uint32_t Pad1__;
+    };
+
+    // Bounding volume hierarchy over scene lights. Every node bounds position, emission directions and total power
+    // of lights beneath it, which allows shading to descend the tree picking lights proportionally to their
+    // estimated contribution, keeping ray budget constant regardless of light count.
+    // https://fpsunflower.github.io/ckulla/data/many-lights-hpg2018.pdf
+    class LightTree
+    {
+    public:
+        struct LightBounds
+        {
+            glm::vec3 BoundsMin;
+            glm::vec3 BoundsMax;
+            glm::vec3 Normal;
+            float CosThetaO = 1.0f;
+            float CosThetaE = 0.0f;
+            float Flux = 0.0f;
+            uint32_t IndexInGPUTable = 0;
+        };
+
+        // Refitted tree is rebuilt from scratch when its total node surface area
+        // grows past the one of a freshly built tree by this factor
+        inline static const float RefitDegradationThreshold = 1.5f;
+
+        // Refits existing hierarchy when light set did not change, rebuilds it otherwise
+        void Build(const std::vector<LightBounds>& lights);
+
+    private:
+        uint32_t BuildRecursive(const std::vector<LightBounds>& lights, std::vector<uint32_t>& lightOrder, uint64_t begin, uint64_t end);
+        void Rebuild(const std::vector<LightBounds>& lights);
+        void Refit(const std::vector<LightBounds>& lights);
+        bool CanRefit(const std::vector<LightBounds>& lights) const;
+        float TotalSurfaceArea() const;
+
+        GPULightTreeNode MakeLeaf(const LightBounds& light) const;
+        GPULightTreeNode MakeUnion(const GPULightTreeNode& left, const GPULightTreeNode& right) const;
+
+        std::vector<GPULightTreeNode> mNodes;
+
+        // Leaf node index and light table index for each input light of the last build
+        std::vector<uint32_t> mLeafNodeIndices;
+        std::vector<uint32_t> mLightTableIndices;
+
+        float mBuiltSurfaceArea = 0.0f;
+
+    public:
+        inline const auto& Nodes() const { return mNodes; }
+    };
+
+}
@@ -1,12 +1,18 @@
 #include "MaterialLoader.hpp"
+#include "Scene.hpp"
 
 #include <glm/gtc/type_precision.hpp>
+#include <glm/geometric.hpp>
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
 
 namespace PathFinder
 {
 
-    MaterialLoader::MaterialLoader(const std::filesystem::path& executableFolder, PreprocessableAssetStorage* assetStorage, Memory::GPUResourceProducer* resourceProducer)
-        : mAssetStorage{ assetStorage }, mResourceLoader{ executableFolder, resourceProducer }, mResourceProducer{ resourceProducer }
+    MaterialLoader::MaterialLoader(const std::filesystem::path& executableFolder, PreprocessableAssetStorage* assetStorage, Memory::GPUResourceProducer* resourceProducer, Foundation::TaskScheduler* taskScheduler)
+        : mAssetStorage{ assetStorage }, mResourceLoader{ executableFolder, resourceProducer }, mTextureBaker{ executableFolder, taskScheduler }, mTextureResidency{ StreamedTextureMemoryBudget }, mResourceProducer{ resourceProducer }
     {
         CreateDefaultTextures();
         LoadLTCLookupTables();
@@ -23,13 +29,13 @@ namespace PathFinder
     {
         Material material{};
 
-        material.AlbedoMap = GetOrAllocateTexture(albedoMapRelativePath);
-        material.NormalMap = GetOrAllocateTexture(normalMapRelativePath);
+        material.AlbedoMap = GetOrAllocateTexture(albedoMapRelativePath, TextureBaker::MapSemantic::Albedo);
+        material.NormalMap = GetOrAllocateTexture(normalMapRelativePath, TextureBaker::MapSemantic::Normal);
 
-        if (roughnessMapRelativePath) material.RoughnessMap = GetOrAllocateTexture(*roughnessMapRelativePath);
-        if (metalnessMapRelativePath) material.MetalnessMap = GetOrAllocateTexture(*metalnessMapRelativePath);
+        if (roughnessMapRelativePath) material.RoughnessMap = GetOrAllocateTexture(*roughnessMapRelativePath, TextureBaker::MapSemantic::Roughness);
+        if (metalnessMapRelativePath) material.MetalnessMap = GetOrAllocateTexture(*metalnessMapRelativePath, TextureBaker::MapSemantic::Metalness);
         if (displacementMapRelativePath) material.DisplacementMap = GetOrAllocateTexture(*displacementMapRelativePath);
-        if (AOMapRelativePath) material.AOMap = GetOrAllocateTexture(*AOMapRelativePath);
+        if (AOMapRelativePath) material.AOMap = GetOrAllocateTexture(*AOMapRelativePath, TextureBaker::MapSemantic::AO);
 
         if (material.DisplacementMap && distanceFieldRelativePath)
         {
@@ -69,7 +75,7 @@ namespace PathFinder
         return material;
     }
 
-    Memory::Texture* MaterialLoader::GetOrAllocateTexture(const std::string& relativePath)
+    Memory::Texture* MaterialLoader::GetOrAllocateTexture(const std::string& relativePath, std::optional<TextureBaker::MapSemantic> semantic)
     {
         auto textureIt = mMaterialTextures.find(relativePath);
 
@@ -79,6 +85,11 @@ namespace PathFinder
         }
         else
         {
+            if (semantic)
+            {
+                return RegisterStreamedTexture(relativePath, mTextureBaker.GetOrBake(relativePath, *semantic));
+            }
+
             auto [iter, success] = mMaterialTextures.emplace(relativePath, mResourceLoader.LoadTexture(relativePath));
             return iter->second.get();
         }
@@ -90,6 +101,147 @@ namespace PathFinder
         return iter->second.get();
     }
 
+    bool MaterialLoader::UpdateTextureResidency(Scene& scene, uint64_t viewportHeight)
+    {
+        const Camera& camera = scene.MainCamera();
+        float pixelsPerUnit = camera.Projection()[1][1] * viewportHeight * 0.5f;
+
+        // Instances culled this frame don't touch their pages, so LRU eviction reclaims textures nobody sees
+        for (const MeshInstance* instance : scene.Culler().VisibleMeshInstances())
+        {
+            const Material* material = scene.MeshInstanceMaterial(*instance);
+            Geometry::AxisAlignedBox3D bounds = scene.MeshInstanceBoundingBox(*instance);
+            glm::vec3 center = (bounds.Min + bounds.Max) * 0.5f;
+            float radius = glm::length(bounds.Max - bounds.Min) * 0.5f;
+            float distance = glm::length(center - camera.Position());
+
+            // Assume material maps are stretched over instance once, which gives texels per screen pixel
+            float projectedDiameter = distance > radius ? 2.0f * radius * pixelsPerUnit / distance : std::numeric_limits<float>::max();
+
+            for (const Memory::Texture* map : { material->AlbedoMap, material->NormalMap, material->RoughnessMap, material->MetalnessMap, material->AOMap })
+            {
+                auto idIt = mStreamedTextureIDs.find(map);
+
+                if (idIt == mStreamedTextureIDs.end())
+                {
+                    continue;
+                }
+
+                const StreamedTexture& streamedTexture = mStreamedTextures[idIt->second];
+                float texelsPerPixel = streamedTexture.Resolution / std::max(projectedDiameter, 1.0f);
+                uint32_t desiredMip = texelsPerPixel > 1.0f ? uint32_t(std::log2(texelsPerPixel)) : 0;
+
+                // Page that contains desired mip
+                auto pageIt = std::upper_bound(streamedTexture.PageMips.begin(), streamedTexture.PageMips.end(), desiredMip);
+                uint32_t desiredPage = uint32_t(std::distance(streamedTexture.PageMips.begin(), pageIt)) - 1;
+
+                mTextureResidency.ReportUsage(idIt->second, desiredPage);
+            }
+        }
+
+        for (const Memory::TextureResidency::ResidencyChange& change : mTextureResidency.Update())
+        {
+            mPendingTextureReloads[change.Texture] = change.MostDetailedResidentMip;
+        }
+
+        uint32_t reloadCount = 0;
+
+        while (!mPendingTextureReloads.empty() && reloadCount < MaxTextureReloadsPerFrame)
+        {
+            auto reloadIt = mPendingTextureReloads.begin();
+            ReplaceStreamedTexture(scene, reloadIt->first, reloadIt->second);
+            mPendingTextureReloads.erase(reloadIt);
+            ++reloadCount;
+        }
+
+        return reloadCount > 0;
+    }
+
+    Memory::Texture* MaterialLoader::RegisterStreamedTexture(const std::string& relativePath, const std::string& loadPath)
+    {
+        std::optional<ResourceLoader::TextureFileInfo> fileInfo = mResourceLoader.ReadTextureFileInfo(loadPath);
+
+        if (!fileInfo)
+        {
+            return nullptr;
+        }
+
+        std::vector<uint64_t> pageSizes;
+        std::vector<uint32_t> pageMips;
+        uint32_t pinnedPageCount = 0;
+
+        for (auto mip = 0u; mip < fileInfo->MipSizes.size(); ++mip)
+        {
+            // Mip 0 is always loadable, so there is a page to add to
+            if (ResourceLoader::LoadableMostDetailedMip(fileInfo->Dimensions, fileInfo->IsBlockCompressed, mip) == mip)
+            {
+                pageMips.push_back(mip);
+                pageSizes.push_back(0);
+            }
+
+            pageSizes.back() += fileInfo->MipSizes[mip];
+        }
+
+        for (uint64_t pageSize : pageSizes)
+        {
+            if (pageSize <= PinnedMipMaxSize) ++pinnedPageCount;
+        }
+
+        // Only pinned mip tail is loaded up front, more detailed mips are streamed in once instances need them
+        uint32_t pageCount = uint32_t(pageSizes.size());
+        uint32_t mostDetailedResidentPage = pageCount - std::max(pinnedPageCount, 1u);
+
+        Memory::GPUResourceProducer::TexturePtr texture = mResourceLoader.LoadTexture(loadPath, pageMips[mostDetailedResidentPage]);
+
+        if (!texture)
+        {
+            return nullptr;
+        }
+
+        Memory::TextureResidency::TextureID textureID = mTextureResidency.Register(pageSizes, pinnedPageCount, mostDetailedResidentPage);
+
+        if (textureID >= mStreamedTextures.size())
+        {
+            mStreamedTextures.resize(textureID + 1);
+        }
+
+        mStreamedTextures[textureID] = { texture.get(), relativePath, loadPath, uint32_t(std::max(fileInfo->Dimensions.Width, fileInfo->Dimensions.Height)), std::move(pageMips) };
+        mStreamedTextureIDs[texture.get()] = textureID;
+
+        auto [iter, success] = mMaterialTextures.emplace(relativePath, std::move(texture));
+        return iter->second.get();
+    }
+
+    void MaterialLoader::ReplaceStreamedTexture(Scene& scene, Memory::TextureResidency::TextureID textureID, uint32_t mostDetailedPage)
+    {
+        StreamedTexture& streamedTexture = mStreamedTextures[textureID];
+
+        // Evicted mips are streamed back from baked file on disk
+        Memory::GPUResourceProducer::TexturePtr newTexture = mResourceLoader.LoadTexture(streamedTexture.LoadPath, streamedTexture.PageMips[mostDetailedPage]);
+
+        if (!newTexture)
+        {
+            return;
+        }
+
+        Memory::Texture* oldTexture = streamedTexture.Texture;
+
+        for (Material& material : scene.Materials())
+        {
+            for (Memory::Texture** map : { &material.AlbedoMap, &material.NormalMap, &material.RoughnessMap, &material.MetalnessMap, &material.AOMap })
+            {
+                if (*map == oldTexture) *map = newTexture.get();
+            }
+        }
+
+        mStreamedTextureIDs.erase(oldTexture);
+        mStreamedTextureIDs[newTexture.get()] = textureID;
+        streamedTexture.Texture = newTexture.get();
+
+        // Old texture memory is reclaimed by allocator once frames in flight no longer use it
+        mMaterialTextures[streamedTexture.RelativePath] = std::move(newTexture);
+    }
+
     void MaterialLoader::CreateDefaultTextures()
     {
         HAL::TextureProperties dummy2DTextureProperties{
@@ -2,24 +2,31 @@
 
 #include "Material.hpp"
 #include "ResourceLoader.hpp"
+#include "TextureBaker.hpp"
 
 #include <RenderPipeline/PreprocessableAssetStorage.hpp>
 #include <HardwareAbstractionLayer/Buffer.hpp>
 #include <Memory/GPUResourceProducer.hpp>
+#include <Memory/TextureResidency.hpp>
 
 #include <filesystem>
 #include <string>
 #include <optional>
+#include <vector>
+#include <unordered_map>
+#include <map>
 
 namespace PathFinder 
 {
 
+    class Scene;
+
     class MaterialLoader
     {
     public:
         inline static const Geometry::Dimensions DistanceFieldTextureSize{ 128, 128, 64 };
 
-        MaterialLoader(const std::filesystem::path& executableFolder, PreprocessableAssetStorage* assetStorage, Memory::GPUResourceProducer* resourceProducer);
+        MaterialLoader(const std::filesystem::path& executableFolder, PreprocessableAssetStorage* assetStorage, Memory::GPUResourceProducer* resourceProducer, Foundation::TaskScheduler* taskScheduler);
 
         Material LoadMaterial(
             const std::string& albedoMapRelativePath,
@@ -30,7 +37,30 @@ namespace PathFinder
             std::optional<std::string> distanceMapRelativePath = std::nullopt,
             std::optional<std::string> AOMapRelativePath = std::nullopt);
 
+        // Estimates mips sampled by visible instances, evicts and streams in material map mips within memory budget.
+        // Returns true when textures of scene materials were replaced and material table needs to be uploaded again.
+        bool UpdateTextureResidency(Scene& scene, uint64_t viewportHeight);
+
     private:
+        inline static const uint64_t StreamedTextureMemoryBudget = 1024ull * 1024 * 1024;
+
+        // Mips of this size and smaller are always resident
+        inline static const uint64_t PinnedMipMaxSize = 64 * 1024;
+
+        // Textures are reloaded from disk synchronously, so only a few are replaced per frame and the rest wait
+        inline static const uint32_t MaxTextureReloadsPerFrame = 2;
+
+        struct StreamedTexture
+        {
+            Memory::Texture* Texture = nullptr;
+            std::string RelativePath;
+            std::string LoadPath;
+            uint32_t Resolution = 0;
+            // First texture mip of every residency page. Mips that can't be loaded as the most detailed one
+            // share a page with the finer mip, so that residency accounts for what is actually loaded.
+            std::vector<uint32_t> PageMips;
+        };
+
         struct SerializationData
         {
             std::string DistanceMapReltivePath;
@@ -39,8 +69,11 @@ namespace PathFinder
             const HAL::Buffer* DistanceAtlasCounterBuffer;
         };
 
-        Memory::Texture* GetOrAllocateTexture(const std::string& relativePath);
+        // Maps with known semantic are loaded from their block compressed baked versions
+        Memory::Texture* GetOrAllocateTexture(const std::string& relativePath, std::optional<TextureBaker::MapSemantic> semantic = std::nullopt);
         Memory::Texture* AllocateAndStoreTexture(const HAL::TextureProperties& properties, const std::string& relativePath);
+        Memory::Texture* RegisterStreamedTexture(const std::string& relativePath, const std::string& loadPath);
+        void ReplaceStreamedTexture(Scene& scene, Memory::TextureResidency::TextureID textureID, uint32_t mostDetailedPage);
 
         void CreateDefaultTextures();
         void LoadLTCLookupTables();
@@ -61,6 +94,15 @@ namespace PathFinder
         Memory::GPUResourceProducer* mResourceProducer;
         PreprocessableAssetStorage* mAssetStorage;
         ResourceLoader mResourceLoader;
+        TextureBaker mTextureBaker;
+        Memory::TextureResidency mTextureResidency;
+
+        // Indexed by residency texture id
+        std::vector<StreamedTexture> mStreamedTextures;
+        std::unordered_map<const Memory::Texture*, Memory::TextureResidency::TextureID> mStreamedTextureIDs;
+
+        // Residency changes not yet applied to textures, latest most detailed resident page per texture
+        std::map<Memory::TextureResidency::TextureID, uint32_t> mPendingTextureReloads;
     };
 
 }
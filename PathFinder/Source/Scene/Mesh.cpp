@@ -10,6 +10,11 @@ namespace PathFinder
         return mName;
     }
 
+    uint64_t Mesh::ID() const
+    {
+        return mID;
+    }
+
     std::vector<Vertex1P1N1UV1T1BT>& Mesh::Vertices()
     {
         return mVertices;
@@ -30,9 +35,24 @@ namespace PathFinder
         return mBoundingBox;
     }
 
-    const VertexStorageLocation& Mesh::LocationInVertexStorage() const
+    const VertexStorageLocation& Mesh::LocationInVertexStorage(uint32_t lod) const
+    {
+        return lod == 0 ? mVertexStorageLocation : mLODs[lod - 1].LocationInVertexStorage;
+    }
+
+    const std::vector<uint32_t>& Mesh::Indices(uint32_t lod) const
+    {
+        return lod == 0 ? mIndices : mLODs[lod - 1].Indices;
+    }
+
+    float Mesh::LODError(uint32_t lod) const
     {
-        return mVertexStorageLocation;
+        return lod == 0 ? 0.0f : mLODs[lod - 1].Error;
+    }
+
+    uint32_t Mesh::LODCount() const
+    {
+        return mLODs.size() + 1;
     }
 
     float Mesh::SurfaceArea() const
@@ -50,14 +70,25 @@ namespace PathFinder
         mName = name;
     }
 
+    void Mesh::SetID(uint64_t id)
+    {
+        mID = id;
+    }
+
     void Mesh::SetHasTangentSpace(bool hts)
     {
         mHasTangentSpace = hts;
     }
 
-    void Mesh::SetVertexStorageLocation(const VertexStorageLocation& location)
+    void Mesh::SetVertexStorageLocation(const VertexStorageLocation& location, uint32_t lod)
+    {
+        if (lod == 0) mVertexStorageLocation = location;
+        else mLODs[lod - 1].LocationInVertexStorage = location;
+    }
+
+    void Mesh::AddLOD(std::vector<uint32_t>&& indices, float error)
     {
-        mVertexStorageLocation = location;
+        mLODs.push_back({ std::move(indices), error });
     }
 
     void Mesh::AddVertex(const Vertex1P1N1UV1T1BT& vertex)
@@ -16,18 +16,42 @@ namespace PathFinder
     class Mesh
     {
     public:
+        // Simplified version of the mesh. Shares vertices with the full detail mesh and only has its own indices.
+        struct LOD
+        {
+            std::vector<uint32_t> Indices;
+            // Object space distance from full detail surface
+            float Error = 0.0f;
+            VertexStorageLocation LocationInVertexStorage;
+
+            template <typename S>
+            void serialize(S& s)
+            {
+                s.container(Indices);
+                s.value(Error);
+            }
+        };
+
         const std::string& Name() const;
+        // Assigned by the scene and never reused, unlike mesh addresses. Zero for meshes outside of the scene.
+        uint64_t ID() const;
         std::vector<Vertex1P1N1UV1T1BT>& Vertices();
         const std::vector<Vertex1P1N1UV1T1BT>& Vertices() const;
         const std::vector<uint32_t>& Indices() const;
         const Geometry::AxisAlignedBox3D& BoundingBox() const;
-        const VertexStorageLocation& LocationInVertexStorage() const;
+        // Level 0 is the full detail mesh, followed by progressively coarser levels
+        const VertexStorageLocation& LocationInVertexStorage(uint32_t lod = 0) const;
+        const std::vector<uint32_t>& Indices(uint32_t lod) const;
+        float LODError(uint32_t lod) const;
+        uint32_t LODCount() const;
         float SurfaceArea() const;
         bool HasTangentSpace() const;
 
         void SetName(const std::string& name);
+        void SetID(uint64_t id);
         void SetHasTangentSpace(bool hts);
-        void SetVertexStorageLocation(const VertexStorageLocation& location);
+        void SetVertexStorageLocation(const VertexStorageLocation& location, uint32_t lod = 0);
+        void AddLOD(std::vector<uint32_t>&& indices, float error);
         void AddVertex(const Vertex1P1N1UV1T1BT& vertex);
         void AddIndex(uint32_t index);
 
@@ -44,11 +68,14 @@ namespace PathFinder
             s.object(mBoundingBox.Max);
             s.value(mArea);
             s.value(mHasTangentSpace);
+            s.container(mLODs);
         }
 
         std::string mName;
+        uint64_t mID = 0;
         std::vector<Vertex1P1N1UV1T1BT> mVertices;
         std::vector<uint32_t> mIndices;
+        std::vector<LOD> mLODs;
         VertexStorageLocation mVertexStorageLocation;
         Geometry::AxisAlignedBox3D mBoundingBox = Geometry::AxisAlignedBox3D::MaximumReversed();
         float mArea = 0.0;
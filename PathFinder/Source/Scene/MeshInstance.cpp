@@ -3,12 +3,7 @@
 namespace PathFinder
 {
 
-    MeshInstance::MeshInstance(const Mesh* mesh, const Material* material)
-        : mMesh{ mesh }, mMaterial{ material } {}
-
-    void MeshInstance::UpdatePreviousTransform()
-    {
-        mPrevTransformation = mTransformation;
-    }
+    MeshInstance::MeshInstance(const Mesh* mesh)
+        : mMesh{ mesh } {}
 
 }
@@ -18,12 +18,16 @@
 namespace PathFinder
 {
 
+    enum class MeshInstanceFlags : uint8_t
+    {
+        None = 0, Selected = 1 << 0, Highlighted = 1 << 1
+    };
+
+    // Transformations, material and flags are per-frame state kept by the scene in columns parallel to instance storage
     class MeshInstance
     {
     public:
-        MeshInstance(const Mesh* mesh, const Material* material);
-
-        void UpdatePreviousTransform();
+        MeshInstance(const Mesh* mesh);
 
     private:
         friend bitsery::Access;
@@ -32,38 +36,24 @@ namespace PathFinder
         void serialize(S& s)
         {
             s.ext(mMesh, bitsery::ext::PointerObserver{});
-            s.ext(mMaterial, bitsery::ext::PointerObserver{});
-            s.value(mIsSelected);
-            s.value(mIsHighlighted);
-            s.object(mPrevTransformation);
-            s.object(mTransformation);
         }
 
         const Mesh* mMesh;
-        const Material* mMaterial;
-        bool mIsSelected = false;
-        bool mIsHighlighted = false;
-        Geometry::Transformation mTransformation;
-        Geometry::Transformation mPrevTransformation;
-        EntityID mEntityID = 0;
+        EntityID mEntityID = NoEntityID;
         uint32_t mIndexInGPUTable = 0;
+        uint32_t mSelectedLOD = 0;
 
     public:
-        inline bool IsSelected() const { return mIsSelected; }
-        inline bool IsHighlighted() const { return mIsHighlighted; }
-        inline const Geometry::Transformation& Transformation() const { return mTransformation; }
-        inline const Geometry::Transformation& PrevTransformation() { return mPrevTransformation; }
-        inline Geometry::AxisAlignedBox3D BoundingBox(const Mesh& mesh) const { return mesh.BoundingBox().TransformedBy(mTransformation); }
         inline const Mesh* AssociatedMesh() const { return mMesh; }
-        inline const Material* AssociatedMaterial() const { return mMaterial; }
         inline const EntityID& ID() const { return mEntityID; }
         inline auto IndexInGPUTable () const { return mIndexInGPUTable; }
+        inline auto SelectedLOD() const { return mSelectedLOD; }
 
-        inline void SetIsSelected(bool selected) { mIsSelected = selected; }
-        inline void SetIsHighlighted(bool highlighted) { mIsHighlighted = highlighted; }
-        inline void SetTransformation(const Geometry::Transformation& transform) { mTransformation = transform; }
         inline void SetIndexInGPUTable(uint32_t index) { mIndexInGPUTable = index; }
         inline void SetEntityID(EntityID id) { mEntityID = id; }
+        inline void SetSelectedLOD(uint32_t lod) { mSelectedLOD = lod; }
     };
 
 }
+
+ENABLE_BITMASK_OPERATORS(PathFinder::MeshInstanceFlags);
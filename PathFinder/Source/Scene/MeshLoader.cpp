@@ -1,6 +1,6 @@
 #include "MeshLoader.hpp"
 
-
+#include <glm/gtc/type_ptr.hpp>
 
 namespace PathFinder
 {
@@ -8,7 +8,7 @@ namespace PathFinder
     MeshLoader::MeshLoader(const std::filesystem::path& fileRoot)
         : mRootPath{ fileRoot } {}
 
-    std::vector<Mesh> MeshLoader::Load(const std::string& fileName)
+    MeshLoader::Model MeshLoader::LoadModel(const std::string& fileName)
     {
         Assimp::Importer importer;
         auto rootPath = mRootPath;
@@ -29,11 +29,18 @@ namespace PathFinder
 
         assert_format(pScene, "Unable to read mesh file"); 
 
-        mLoadedMeshes.clear();
+        mLoadedModel = {};
+        mLoadedMeshIndices.clear();
+        mLoadedMeshIndices.resize(pScene->mNumMeshes);
+
+        ProcessNode(pScene->mRootNode, pScene, aiMatrix4x4{});
 
-        ProcessNode(pScene->mRootNode, pScene);
+        return std::move(mLoadedModel);
+    }
 
-        return mLoadedMeshes;
+    std::vector<Mesh> MeshLoader::Load(const std::string& fileName)
+    {
+        return LoadModel(fileName).Meshes;
     }
 
     Mesh MeshLoader::ProcessMesh(aiMesh* mesh, const aiScene* scene)
@@ -89,20 +96,65 @@ namespace PathFinder
 
         subMesh.SetName(mesh->mName.data);
 
+        GenerateLODs(subMesh);
+
         return subMesh;
     }
 
-    void MeshLoader::ProcessNode(aiNode* node, const aiScene* scene)
+    void MeshLoader::GenerateLODs(Mesh& mesh) const
+    {
+        MeshSimplifier simplifier;
+
+        float radius = glm::length(mesh.BoundingBox().Max - mesh.BoundingBox().Min) * 0.5f;
+        float maxError = radius * MaxRelativeLODError;
+
+        // Every level is simplified from full detail mesh, so error doesn't accumulate through levels
+        for (auto lod = 1u; lod < MaxLODCount; ++lod)
+        {
+            uint64_t previousIndexCount = mesh.Indices(lod - 1).size();
+            uint64_t targetIndexCount = uint64_t(previousIndexCount * LODTriangleRatio) / 3 * 3;
+
+            if (targetIndexCount < MinLODTriangleCount * 3)
+                break;
+
+            MeshSimplifier::Result result = simplifier.Simplify(mesh.Vertices(), mesh.Indices(), targetIndexCount, maxError);
+
+            if (result.Indices.size() > previousIndexCount * MinLODReduction)
+                break;
+
+            mesh.AddLOD(std::move(result.Indices), result.Error);
+        }
+    }
+
+    void MeshLoader::ProcessNode(aiNode* node, const aiScene* scene, const aiMatrix4x4& parentTransform)
     {
+        aiMatrix4x4 nodeTransform = parentTransform * node->mTransformation;
+
         for (auto i = 0u; i < node->mNumMeshes; i++)
         {
-            aiMesh* assimpMesh = scene->mMeshes[node->mMeshes[i]];
-            mLoadedMeshes.emplace_back(ProcessMesh(assimpMesh, scene));
+            uint32_t assimpMeshIndex = node->mMeshes[i];
+            std::optional<uint64_t>& meshIndex = mLoadedMeshIndices[assimpMeshIndex];
+
+            // Repeated references become instances of a single mesh
+            if (!meshIndex)
+            {
+                meshIndex = mLoadedModel.Meshes.size();
+                mLoadedModel.Meshes.emplace_back(ProcessMesh(scene->mMeshes[assimpMeshIndex], scene));
+            }
+
+            MeshReference reference{};
+            reference.MeshIndex = *meshIndex;
+            reference.MaterialIndex = scene->mMeshes[assimpMeshIndex]->mMaterialIndex;
+            // Assimp matrices are row-major
+            reference.Transformation = Geometry::Transformation{ glm::transpose(glm::make_mat4(&nodeTransform.a1)) };
+            reference.NodeName = node->mName.data;
+
+            mLoadedModel.References.push_back(reference);
         }
 
         for (auto i = 0u; i < node->mNumChildren; i++)
         {
-            ProcessNode(node->mChildren[i], scene);
+            ProcessNode(node->mChildren[i], scene, nodeTransform);
         }
     }
 
@@ -2,6 +2,9 @@
 
 #include "Vertices/Vertex1P1N1UV1T1BT.hpp"
 #include "Mesh.hpp"
+#include "MeshSimplifier.hpp"
+
+#include <Geometry/Transformation.hpp>
 
 // Assimp is in conflict with windows.h definitions of min and max
 #ifndef NOMINMAX 
@@ -17,6 +20,7 @@
 #endif
 
 #include <vector>
+#include <optional>
 #include <filesystem>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
@@ -28,16 +32,51 @@ namespace PathFinder
     class MeshLoader
     {
     public:
+        struct MeshReference
+        {
+            // Index of referenced mesh in Model::Meshes
+            uint64_t MeshIndex = 0;
+            // Index of the material the file assigns to referenced mesh
+            uint32_t MaterialIndex = 0;
+            // Transformation accumulated through node hierarchy
+            Geometry::Transformation Transformation;
+            std::string NodeName;
+        };
+
+        struct Model
+        {
+            // Every mesh of the file is loaded once, no matter how many nodes reference it
+            std::vector<Mesh> Meshes;
+            std::vector<MeshReference> References;
+        };
+
         MeshLoader(const std::filesystem::path& fileRoot);
 
+        Model LoadModel(const std::string& fileName);
+
+        // Unique meshes of a file without node hierarchy
         std::vector<Mesh> Load(const std::string& fileName);
 
     private:
+        // Each level of detail targets this fraction of the previous level's triangles
+        inline static const float LODTriangleRatio = 0.5f;
+        inline static const uint32_t MaxLODCount = 5;
+        inline static const uint64_t MinLODTriangleCount = 64;
+
+        // Simplification error limit relative to mesh bounding sphere radius
+        inline static const float MaxRelativeLODError = 0.05f;
+
+        // Level is discarded when locked seams and borders keep it from getting this much smaller than the previous one
+        inline static const float MinLODReduction = 0.8f;
+
         Mesh ProcessMesh(aiMesh* mesh, const aiScene* scene);
-        void ProcessNode(aiNode* node, const aiScene* scene);
+        void GenerateLODs(Mesh& mesh) const;
+        void ProcessNode(aiNode* node, const aiScene* scene, const aiMatrix4x4& parentTransform);
         void CalculateTangentSpace(Mesh* mesh);
 
-        std::vector<Mesh> mLoadedMeshes;
+        Model mLoadedModel;
+        // Maps Assimp mesh index to index of already loaded mesh
+        std::vector<std::optional<uint64_t>> mLoadedMeshIndices;
         std::filesystem::path mRootPath;
     };
 
@@ -0,0 +1,329 @@
+#include "MeshSimplifier.hpp"
+
+#include <glm/geometric.hpp>
+#include <robinhood/robin_hood.h>
+
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+
+        // Area weighted sum of squared distances to a set of planes, stored as symmetric 4x4 matrix
+        struct Quadric
+        {
+            double A2 = 0, AB = 0, AC = 0, AD = 0, B2 = 0, BC = 0, BD = 0, C2 = 0, CD = 0, D2 = 0;
+            double Weight = 0;
+
+            static Quadric FromPlane(const glm::dvec3& normal, double distance, double weight)
+            {
+                double a = normal.x, b = normal.y, c = normal.z, d = distance, w = weight;
+                return { w * a * a, w * a * b, w * a * c, w * a * d, w * b * b, w * b * c, w * b * d, w * c * c, w * c * d, w * d * d, w };
+            }
+
+            void Add(const Quadric& other)
+            {
+                A2 += other.A2; AB += other.AB; AC += other.AC; AD += other.AD; B2 += other.B2;
+                BC += other.BC; BD += other.BD; C2 += other.C2; CD += other.CD; D2 += other.D2;
+                Weight += other.Weight;
+            }
+
+            double Evaluate(const glm::dvec3& p) const
+            {
+                double x = p.x, y = p.y, z = p.z;
+                double error =
+                    A2 * x * x + 2 * AB * x * y + 2 * AC * x * z + 2 * AD * x +
+                    B2 * y * y + 2 * BC * y * z + 2 * BD * y +
+                    C2 * z * z + 2 * CD * z + D2;
+
+                // Mean squared distance, so error doesn't grow with amount of planes merged
+                return Weight > 0.0 ? std::max(error, 0.0) / Weight : 0.0;
+            }
+        };
+
+        struct Collapse
+        {
+            uint32_t From = 0;
+            uint32_t To = 0;
+            double Cost = 0.0;
+        };
+
+        uint64_t EdgeKey(uint32_t a, uint32_t b)
+        {
+            return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+        }
+
+    }
+
+    MeshSimplifier::Result MeshSimplifier::Simplify(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices, uint64_t targetIndexCount, float maxError) const
+    {
+        Result result{ indices, 0.0f };
+
+        if (indices.size() <= targetIndexCount)
+            return result;
+
+        // Vertices sharing a position are one point of topology. 
+        // Mesh is expected to have identical vertices joined, so shared position means a seam.
+        std::vector<uint32_t> positionIDs(vertices.size());
+        std::vector<uint32_t> vertexCountPerPosition;
+        std::vector<glm::dvec3> positions;
+
+        {
+            struct PositionHash
+            {
+                size_t operator()(const glm::vec3& p) const { return robin_hood::hash_bytes(&p, sizeof(p)); }
+            };
+
+            robin_hood::unordered_flat_map<glm::vec3, uint32_t, PositionHash> positionMap;
+
+            for (auto i = 0u; i < vertices.size(); ++i)
+            {
+                glm::vec3 position{ vertices[i].Position };
+                auto [it, inserted] = positionMap.insert({ position, uint32_t(positions.size()) });
+
+                if (inserted)
+                {
+                    positions.push_back(position);
+                    vertexCountPerPosition.push_back(0);
+                }
+
+                positionIDs[i] = it->second;
+                ++vertexCountPerPosition[it->second];
+            }
+        }
+
+        std::vector<uint8_t> isLocked(positions.size(), 0);
+        std::vector<Quadric> quadrics(positions.size());
+
+        for (auto p = 0u; p < positions.size(); ++p)
+        {
+            isLocked[p] = vertexCountPerPosition[p] > 1;
+        }
+
+        // Edges used by single triangle form open borders, edges used by more than two are non-manifold
+        robin_hood::unordered_flat_map<uint64_t, uint32_t> edgeUseCounts;
+
+        for (auto t = 0u; t + 2 < indices.size(); t += 3)
+        {
+            uint32_t p[3] = { positionIDs[indices[t]], positionIDs[indices[t + 1]], positionIDs[indices[t + 2]] };
+
+            for (auto e = 0u; e < 3; ++e)
+            {
+                ++edgeUseCounts[EdgeKey(p[e], p[(e + 1) % 3])];
+            }
+
+            glm::dvec3 normal = glm::cross(positions[p[1]] - positions[p[0]], positions[p[2]] - positions[p[0]]);
+            double length = glm::length(normal);
+
+            if (length <= 0.0)
+                continue;
+
+            normal /= length;
+            Quadric quadric = Quadric::FromPlane(normal, -glm::dot(normal, positions[p[0]]), length * 0.5);
+
+            for (auto v = 0u; v < 3; ++v)
+            {
+                quadrics[p[v]].Add(quadric);
+            }
+        }
+
+        for (const auto& [key, useCount] : edgeUseCounts)
+        {
+            if (useCount != 2)
+            {
+                isLocked[key >> 32] = 1;
+                isLocked[key & 0xFFFFFFFF] = 1;
+            }
+        }
+
+        double maxCost = 0.0;
+        double costLimit = double(maxError) * maxError;
+        std::vector<uint32_t>& currentIndices = result.Indices;
+        std::vector<uint32_t> triangleOffsets;
+        std::vector<uint32_t> positionTriangles;
+        std::vector<uint32_t> fromNeighbours;
+        std::vector<uint32_t> toNeighbours;
+        std::vector<Collapse> collapses;
+        std::vector<uint32_t> remap(vertices.size());
+        std::vector<uint8_t> isTouched(positions.size());
+
+        // Each pass collapses a set of independent edges, cheapest first
+        while (currentIndices.size() > targetIndexCount)
+        {
+            // Triangles adjacent to each position
+            triangleOffsets.assign(positions.size() + 1, 0);
+
+            for (uint32_t index : currentIndices)
+            {
+                ++triangleOffsets[positionIDs[index] + 1];
+            }
+
+            std::partial_sum(triangleOffsets.begin(), triangleOffsets.end(), triangleOffsets.begin());
+            positionTriangles.resize(currentIndices.size());
+
+            {
+                std::vector<uint32_t> fillCounts(positions.size(), 0);
+
+                for (auto i = 0u; i < currentIndices.size(); ++i)
+                {
+                    uint32_t position = positionIDs[currentIndices[i]];
+                    positionTriangles[triangleOffsets[position] + fillCounts[position]++] = i / 3;
+                }
+            }
+
+            collapses.clear();
+
+            for (auto t = 0u; t < currentIndices.size(); t += 3)
+            {
+                for (auto e = 0u; e < 3; ++e)
+                {
+                    uint32_t from = currentIndices[t + e];
+                    uint32_t to = currentIndices[t + (e + 1) % 3];
+                    uint32_t fromPosition = positionIDs[from];
+                    uint32_t toPosition = positionIDs[to];
+
+                    for (auto [a, b, aPosition, bPosition] : { std::tuple{ from, to, fromPosition, toPosition }, std::tuple{ to, from, toPosition, fromPosition } })
+                    {
+                        if (isLocked[aPosition])
+                            continue;
+
+                        // Only surface represented by collapsed vertex moves, so error is measured against its planes alone.
+                        // Mixing in planes of the target would dilute the error when target represents a large area.
+                        collapses.push_back({ a, b, quadrics[aPosition].Evaluate(positions[bPosition]) });
+                    }
+                }
+            }
+
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.Cost < b.Cost; });
+
+            std::iota(remap.begin(), remap.end(), 0);
+            std::fill(isTouched.begin(), isTouched.end(), 0);
+
+            uint64_t triangleCount = currentIndices.size() / 3;
+            uint64_t targetTriangleCount = targetIndexCount / 3;
+            uint64_t collapseCount = 0;
+
+            for (const Collapse& collapse : collapses)
+            {
+                if (triangleCount <= targetTriangleCount || collapse.Cost > costLimit)
+                    break;
+
+                uint32_t fromPosition = positionIDs[collapse.From];
+                uint32_t toPosition = positionIDs[collapse.To];
+
+                if (isTouched[fromPosition] || isTouched[toPosition])
+                    continue;
+
+                auto gatherNeighbours = [&](uint32_t position, std::vector<uint32_t>& neighbours)
+                {
+                    neighbours.clear();
+
+                    for (auto i = triangleOffsets[position]; i < triangleOffsets[position + 1]; ++i)
+                    {
+                        for (auto v = 0u; v < 3; ++v)
+                        {
+                            uint32_t neighbour = positionIDs[currentIndices[positionTriangles[i] * 3 + v]];
+                            if (neighbour != position) neighbours.push_back(neighbour);
+                        }
+                    }
+
+                    std::sort(neighbours.begin(), neighbours.end());
+                    neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+                };
+
+                gatherNeighbours(fromPosition, fromNeighbours);
+                gatherNeighbours(toPosition, toNeighbours);
+
+                uint64_t sharedNeighbourCount = 0;
+
+                for (uint32_t neighbour : fromNeighbours)
+                {
+                    sharedNeighbourCount += std::binary_search(toNeighbours.begin(), toNeighbours.end(), neighbour);
+                }
+
+                uint64_t removedTriangleCount = 0;
+                bool flipsTriangle = false;
+
+                // Moving a vertex must not turn any of its remaining triangles over
+                for (auto i = triangleOffsets[fromPosition]; i < triangleOffsets[fromPosition + 1] && !flipsTriangle; ++i)
+                {
+                    const uint32_t* triangle = &currentIndices[positionTriangles[i] * 3];
+                    glm::dvec3 before[3];
+                    glm::dvec3 after[3];
+                    bool isRemoved = false;
+
+                    for (auto v = 0u; v < 3; ++v)
+                    {
+                        isRemoved |= positionIDs[triangle[v]] == toPosition;
+                        before[v] = positions[positionIDs[triangle[v]]];
+                        after[v] = triangle[v] == collapse.From ? positions[toPosition] : before[v];
+                    }
+
+                    if (isRemoved)
+                    {
+                        ++removedTriangleCount;
+                        continue;
+                    }
+
+                    glm::dvec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+                    glm::dvec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+
+                    flipsTriangle = glm::dot(normalBefore, normalAfter) <= 0.0;
+                }
+
+                // Neighbours shared by edge ends other than the ones of removed triangles
+                // would end up connected by more than two triangles, folding the surface
+                if (flipsTriangle || sharedNeighbourCount != removedTriangleCount)
+                    continue;
+
+                remap[collapse.From] = collapse.To;
+                quadrics[toPosition].Add(quadrics[fromPosition]);
+                maxCost = std::max(maxCost, collapse.Cost);
+                triangleCount -= removedTriangleCount;
+                ++collapseCount;
+
+                // Adjacency of the whole neighbourhood is stale until next pass
+                for (auto i = triangleOffsets[fromPosition]; i < triangleOffsets[fromPosition + 1]; ++i)
+                {
+                    const uint32_t* triangle = &currentIndices[positionTriangles[i] * 3];
+
+                    for (auto v = 0u; v < 3; ++v)
+                    {
+                        isTouched[positionIDs[triangle[v]]] = 1;
+                    }
+                }
+            }
+
+            if (collapseCount == 0)
+                break;
+
+            uint64_t writeIndex = 0;
+
+            for (auto t = 0u; t < currentIndices.size(); t += 3)
+            {
+                uint32_t a = remap[currentIndices[t]];
+                uint32_t b = remap[currentIndices[t + 1]];
+                uint32_t c = remap[currentIndices[t + 2]];
+
+                // Drop triangles collapsed into a line or a point
+                if (positionIDs[a] == positionIDs[b] || positionIDs[b] == positionIDs[c] || positionIDs[a] == positionIDs[c])
+                    continue;
+
+                currentIndices[writeIndex++] = a;
+                currentIndices[writeIndex++] = b;
+                currentIndices[writeIndex++] = c;
+            }
+
+            currentIndices.resize(writeIndex);
+        }
+
+        result.Error = float(std::sqrt(maxCost));
+
+        return result;
+    }
+
+}
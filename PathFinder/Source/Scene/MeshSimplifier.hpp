@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Vertices/Vertex1P1N1UV1T1BT.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    // Reduces triangle count of indexed meshes by collapsing edges in order of quadric error.
+    // Vertices are never moved or created, so simplified index lists refer to the original vertex array
+    // and all levels of detail of a mesh can share a single vertex range.
+    // Vertices on open borders and on normal or texture seams stay in place to preserve silhouette and attributes.
+    // https://www.cs.cmu.edu/~garland/Papers/quadrics.pdf
+    class MeshSimplifier
+    {
+    public:
+        struct Result
+        {
+            std::vector<uint32_t> Indices;
+            // Approximate object space distance between simplified and original surfaces
+            float Error = 0.0f;
+        };
+
+        // Stops at target index count or when next collapse would exceed max error, whichever comes first
+        Result Simplify(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices, uint64_t targetIndexCount, float maxError) const;
+    };
+
+}
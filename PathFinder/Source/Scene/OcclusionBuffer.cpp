@@ -0,0 +1,138 @@
+#include "OcclusionBuffer.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        // Geometry crossing the near plane is not clipped, such triangles and boxes are skipped
+        // which is always safe: missing occluders can only make more objects visible
+        const float MinClipW = 1e-4f;
+
+        bool IsInFrontOfNearPlane(const glm::vec4& clipPosition)
+        {
+            return clipPosition.w >= MinClipW && clipPosition.z >= 0.0f;
+        }
+    }
+
+    OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height)
+        : mWidth{ width }, mHeight{ height }, mDepth(width * height, 1.0f) {}
+
+    void OcclusionBuffer::Clear()
+    {
+        std::fill(mDepth.begin(), mDepth.end(), 1.0f);
+    }
+
+    void OcclusionBuffer::RasterizeMesh(const Mesh& mesh, const glm::mat4& modelViewProjection)
+    {
+        const auto& vertices = mesh.Vertices();
+        const auto& indices = mesh.Indices();
+
+        for (auto i = 0u; i + 2 < indices.size(); i += 3)
+        {
+            glm::vec4 a = modelViewProjection * glm::vec4{ glm::vec3{ vertices[indices[i]].Position }, 1.0f };
+            glm::vec4 b = modelViewProjection * glm::vec4{ glm::vec3{ vertices[indices[i + 1]].Position }, 1.0f };
+            glm::vec4 c = modelViewProjection * glm::vec4{ glm::vec3{ vertices[indices[i + 2]].Position }, 1.0f };
+
+            if (!IsInFrontOfNearPlane(a) || !IsInFrontOfNearPlane(b) || !IsInFrontOfNearPlane(c))
+                continue;
+
+            RasterizeTriangle(ClipToScreen(a), ClipToScreen(b), ClipToScreen(c));
+        }
+    }
+
+    bool OcclusionBuffer::IsOccluded(const Geometry::AxisAlignedBox3D& box, const glm::mat4& viewProjection) const
+    {
+        glm::vec2 screenMin{ std::numeric_limits<float>::max() };
+        glm::vec2 screenMax{ std::numeric_limits<float>::lowest() };
+        float nearestDepth = std::numeric_limits<float>::max();
+
+        for (const glm::vec4& corner : box.CornerPoints())
+        {
+            glm::vec4 clipPosition = viewProjection * corner;
+
+            if (!IsInFrontOfNearPlane(clipPosition))
+                return false;
+
+            glm::vec3 screenPosition = ClipToScreen(clipPosition);
+            screenMin = glm::min(screenMin, glm::vec2{ screenPosition });
+            screenMax = glm::max(screenMax, glm::vec2{ screenPosition });
+            nearestDepth = std::min(nearestDepth, screenPosition.z);
+        }
+
+        int32_t minX = std::max(int32_t(std::floor(screenMin.x)), 0);
+        int32_t minY = std::max(int32_t(std::floor(screenMin.y)), 0);
+        int32_t maxX = std::min(int32_t(std::floor(screenMax.x)), int32_t(mWidth) - 1);
+        int32_t maxY = std::min(int32_t(std::floor(screenMax.y)), int32_t(mHeight) - 1);
+
+        if (minX > maxX || minY > maxY)
+            return false;
+
+        for (auto y = minY; y <= maxY; ++y)
+        {
+            const float* row = mDepth.data() + y * mWidth;
+
+            for (auto x = minX; x <= maxX; ++x)
+            {
+                if (row[x] >= nearestDepth)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    void OcclusionBuffer::RasterizeTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+    {
+        float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+
+        if (std::abs(area) < std::numeric_limits<float>::epsilon())
+            return;
+
+        // Both windings are rasterized, occluders do not need to be closed meshes
+        float inverseArea = 1.0f / area;
+
+        int32_t minX = std::max(int32_t(std::floor(std::min({ a.x, b.x, c.x }))), 0);
+        int32_t minY = std::max(int32_t(std::floor(std::min({ a.y, b.y, c.y }))), 0);
+        int32_t maxX = std::min(int32_t(std::ceil(std::max({ a.x, b.x, c.x }))), int32_t(mWidth) - 1);
+        int32_t maxY = std::min(int32_t(std::ceil(std::max({ a.y, b.y, c.y }))), int32_t(mHeight) - 1);
+
+        for (auto y = minY; y <= maxY; ++y)
+        {
+            float* row = mDepth.data() + y * mWidth;
+            float py = y + 0.5f;
+
+            for (auto x = minX; x <= maxX; ++x)
+            {
+                float px = x + 0.5f;
+
+                float w0 = ((c.x - b.x) * (py - b.y) - (c.y - b.y) * (px - b.x)) * inverseArea;
+                float w1 = ((a.x - c.x) * (py - c.y) - (a.y - c.y) * (px - c.x)) * inverseArea;
+                float w2 = 1.0f - w0 - w1;
+
+                if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+                    continue;
+
+                // NDC depth is linear in screen space
+                float depth = w0 * a.z + w1 * b.z + w2 * c.z;
+                row[x] = std::min(row[x], depth);
+            }
+        }
+    }
+
+    glm::vec3 OcclusionBuffer::ClipToScreen(const glm::vec4& clipPosition) const
+    {
+        glm::vec3 ndc = glm::vec3{ clipPosition } / clipPosition.w;
+
+        return {
+            (ndc.x * 0.5f + 0.5f) * mWidth,
+            (0.5f - ndc.y * 0.5f) * mHeight,
+            ndc.z
+        };
+    }
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Mesh.hpp"
+
+#include <Geometry/AxisAlignedBox3D.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <vector>
+
+namespace PathFinder
+{
+
+    // Low resolution depth buffer rasterized on the CPU from a handful of large occluders.
+    // Stores NDC depth, so that tests against it are done before any GPU work is recorded.
+    class OcclusionBuffer
+    {
+    public:
+        OcclusionBuffer(uint32_t width = 256, uint32_t height = 128);
+
+        void Clear();
+        void RasterizeMesh(const Mesh& mesh, const glm::mat4& modelViewProjection);
+
+        // Conservative: box is reported occluded only when every pixel
+        // its screen rectangle touches holds depth closer than the box's nearest point
+        bool IsOccluded(const Geometry::AxisAlignedBox3D& box, const glm::mat4& viewProjection) const;
+
+    private:
+        void RasterizeTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+        glm::vec3 ClipToScreen(const glm::vec4& clipPosition) const;
+
+        uint32_t mWidth;
+        uint32_t mHeight;
+        std::vector<float> mDepth;
+
+    public:
+        inline auto Width() const { return mWidth; }
+        inline auto Height() const { return mHeight; }
+    };
+
+}
@@ -7,6 +7,7 @@
 #include <fstream>
 #include <iterator>
 #include <vector>
+#include <algorithm>
 
 namespace PathFinder
 {
@@ -14,45 +15,36 @@ namespace PathFinder
     ResourceLoader::ResourceLoader(const std::filesystem::path& rootPath, Memory::GPUResourceProducer* resourceProducer)
         : mRootPath{ rootPath }, mResourceProducer{ resourceProducer } {}
 
-    Memory::GPUResourceProducer::TexturePtr ResourceLoader::LoadTexture(const std::string& relativeFilePath) const
+    Memory::GPUResourceProducer::TexturePtr ResourceLoader::LoadTexture(const std::string& relativeFilePath, uint32_t mostDetailedMip) const
     {
         std::filesystem::path fullPath = mRootPath;
         fullPath += relativeFilePath;
 
-        std::ifstream input{ fullPath.string(), std::ios::binary };
-
-        if (!input.is_open())
-        {
-            return nullptr;
-        }
-        
-        std::uintmax_t fileSize = std::filesystem::file_size(fullPath);
-
         std::vector<uint8_t> bytes;
-        bytes.resize(fileSize);
-
-        input.read((char *)bytes.data(), bytes.size());
-
         ddsktx_texture_info textureInfo;
-        ddsktx_error error;
 
-        if (!ddsktx_parse(&textureInfo, bytes.data(), (int)bytes.size(), &error))
+        if (!ReadTextureFile(fullPath, bytes, textureInfo))
         {
             return nullptr;
         }
 
         assert_format(textureInfo.num_layers == 1, "Texture arrays are not supported yet");
 
-        auto texture = AllocateTexture(textureInfo);
+        mostDetailedMip = LoadableMostDetailedMip(
+            Geometry::Dimensions{ uint64_t(textureInfo.width), uint64_t(textureInfo.height) },
+            ddsktx_format_compressed(textureInfo.format),
+            std::min<uint32_t>(mostDetailedMip, textureInfo.num_mips - 1));
+
+        auto texture = AllocateTexture(textureInfo, mostDetailedMip);
         HAL::ResourceFootprint textureFootprint{ *texture->HALTexture() };
 
         texture->RequestWrite();
 
         uint64_t uploadMemoryOffset = 0;
 
-        for (int mip = 0; mip < textureInfo.num_mips; ++mip)
+        for (int mip = mostDetailedMip; mip < textureInfo.num_mips; ++mip)
         {
-            const HAL::SubresourceFootprint& mipFootprint = textureFootprint.GetSubresourceFootprint(mip);
+            const HAL::SubresourceFootprint& mipFootprint = textureFootprint.GetSubresourceFootprint(mip - mostDetailedMip);
             uploadMemoryOffset = mipFootprint.Offset();
 
             for (int depthLayer = 0; depthLayer < textureInfo.depth; ++depthLayer)
@@ -88,11 +80,73 @@ namespace PathFinder
         }
 
         texture->SetDebugName(fullPath.filename().string());
-        input.close();
         
         return std::move(texture);
     }
 
+    std::optional<ResourceLoader::TextureFileInfo> ResourceLoader::ReadTextureFileInfo(const std::string& relativeFilePath) const
+    {
+        std::filesystem::path fullPath = mRootPath;
+        fullPath += relativeFilePath;
+
+        std::vector<uint8_t> bytes;
+        ddsktx_texture_info textureInfo;
+
+        if (!ReadTextureFile(fullPath, bytes, textureInfo))
+        {
+            return std::nullopt;
+        }
+
+        TextureFileInfo info{};
+        info.Dimensions = Geometry::Dimensions{ uint64_t(textureInfo.width), uint64_t(textureInfo.height), uint64_t(textureInfo.depth) };
+        info.IsBlockCompressed = ddsktx_format_compressed(textureInfo.format);
+
+        for (int mip = 0; mip < textureInfo.num_mips; ++mip)
+        {
+            uint64_t& mipSize = info.MipSizes.emplace_back(0);
+
+            for (int depthLayer = 0; depthLayer < textureInfo.depth; ++depthLayer)
+            {
+                ddsktx_sub_data subData;
+                ddsktx_get_sub(&textureInfo, &subData, bytes.data(), (int)bytes.size(), 0, depthLayer, mip);
+                mipSize += subData.size_bytes;
+            }
+        }
+
+        return info;
+    }
+
+    bool ResourceLoader::ReadTextureFile(const std::filesystem::path& fullPath, std::vector<uint8_t>& bytes, ddsktx_texture_info& textureInfo) const
+    {
+        std::ifstream input{ fullPath.string(), std::ios::binary };
+
+        if (!input.is_open())
+        {
+            return false;
+        }
+
+        bytes.resize(std::filesystem::file_size(fullPath));
+        input.read((char *)bytes.data(), bytes.size());
+
+        ddsktx_error error;
+        return ddsktx_parse(&textureInfo, bytes.data(), (int)bytes.size(), &error);
+    }
+
+    uint32_t ResourceLoader::LoadableMostDetailedMip(const Geometry::Dimensions& dimensions, bool isBlockCompressed, uint32_t mostDetailedMip)
+    {
+        if (!isBlockCompressed)
+        {
+            return mostDetailedMip;
+        }
+
+        while (mostDetailedMip > 0 && ((dimensions.Width >> mostDetailedMip) % 4 != 0 || (dimensions.Height >> mostDetailedMip) % 4 != 0))
+        {
+            --mostDetailedMip;
+        }
+
+        return mostDetailedMip;
+    }
+
     void ResourceLoader::StoreResource(const Memory::GPUResource& resource, const std::string& relativeFilePath) const
     {
 
@@ -167,13 +221,17 @@ namespace PathFinder
         }
     }
 
-    Memory::GPUResourceProducer::TexturePtr ResourceLoader::AllocateTexture(const ddsktx_texture_info& textureInfo) const
+    Memory::GPUResourceProducer::TexturePtr ResourceLoader::AllocateTexture(const ddsktx_texture_info& textureInfo, uint32_t mostDetailedMip) const
     {
         HAL::FormatVariant format = ToResourceFormat(textureInfo.format);
-        Geometry::Dimensions dimensions(textureInfo.width, textureInfo.height, textureInfo.depth);
+        Geometry::Dimensions dimensions(
+            std::max(textureInfo.width >> mostDetailedMip, 1),
+            std::max(textureInfo.height >> mostDetailedMip, 1),
+            std::max(textureInfo.depth >> mostDetailedMip, 1));
+
         HAL::TextureKind kind = ToKind(textureInfo);
 
-        HAL::TextureProperties properties{ format, kind, dimensions, HAL::ResourceState::AnyShaderAccess, (uint16_t)textureInfo.num_mips };
+        HAL::TextureProperties properties{ format, kind, dimensions, HAL::ResourceState::AnyShaderAccess, uint16_t(textureInfo.num_mips - mostDetailedMip) };
 
         return mResourceProducer->NewTexture(properties);
     }
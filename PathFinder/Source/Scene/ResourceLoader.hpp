@@ -5,6 +5,7 @@
 #include <ThirdParty/dds/dds-ktx.h>
 
 #include <filesystem>
+#include <optional>
 #include <vector>
 
 namespace PathFinder 
@@ -13,15 +14,33 @@ namespace PathFinder
     class ResourceLoader
     {
     public:
+        struct TextureFileInfo
+        {
+            Geometry::Dimensions Dimensions;
+            bool IsBlockCompressed = false;
+            // Sizes of mip data stored in file, most detailed mip first
+            std::vector<uint64_t> MipSizes;
+        };
+
         ResourceLoader(const std::filesystem::path& rootPath, Memory::GPUResourceProducer* resourceProducer);
 
-        Memory::GPUResourceProducer::TexturePtr LoadTexture(const std::string& relativeFilePath) const;
+        // Mips more detailed than the requested one are skipped, the coarsest mip is always loaded
+        Memory::GPUResourceProducer::TexturePtr LoadTexture(const std::string& relativeFilePath, uint32_t mostDetailedMip = 0) const;
+
+        // Most detailed mip of block compressed texture has to consist of whole blocks, so loading starts
+        // at the nearest more detailed mip that does. Returns the mip LoadTexture will actually start at.
+        static uint32_t LoadableMostDetailedMip(const Geometry::Dimensions& dimensions, bool isBlockCompressed, uint32_t mostDetailedMip);
+
+        // Reads texture layout without allocating any GPU memory
+        std::optional<TextureFileInfo> ReadTextureFileInfo(const std::string& relativeFilePath) const;
+
         void StoreResource(const Memory::GPUResource& resource, const std::string& relativeFilePath) const;
 
     private:
+        bool ReadTextureFile(const std::filesystem::path& fullPath, std::vector<uint8_t>& bytes, ddsktx_texture_info& textureInfo) const;
         HAL::TextureKind ToKind(const ddsktx_texture_info& textureInfo) const;
         HAL::FormatVariant ToResourceFormat(const ddsktx_format& parserFormat) const;
-        Memory::GPUResourceProducer::TexturePtr AllocateTexture(const ddsktx_texture_info& textureInfo) const;
+        Memory::GPUResourceProducer::TexturePtr AllocateTexture(const ddsktx_texture_info& textureInfo, uint32_t mostDetailedMip) const;
 
         std::filesystem::path mRootPath;
         Memory::GPUResourceProducer* mResourceProducer;
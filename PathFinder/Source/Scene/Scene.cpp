@@ -9,8 +9,8 @@
 namespace PathFinder 
 {
 
-    Scene::Scene(const std::filesystem::path& executableFolder, const HAL::Device* device, Memory::GPUResourceProducer* resourceProducer)
-        : mResourceLoader{ executableFolder, resourceProducer }, mMeshLoader{ executableFolder }, mLuminanceMeter{ &mCamera }, mGPUStorage{ this, device, resourceProducer }
+    Scene::Scene(const std::filesystem::path& executableFolder, const HAL::Device* device, Memory::GPUResourceProducer* resourceProducer, Foundation::TaskScheduler* taskScheduler)
+        : mResourceLoader{ executableFolder, resourceProducer }, mMeshLoader{ executableFolder }, mLuminanceMeter{ &mCamera }, mGPUStorage{ this, device, resourceProducer, taskScheduler }, mBVH{ this }, mCuller{ this, taskScheduler }, mLODSelector{ this, taskScheduler }
     {
         LoadUtilityResources();
     }
@@ -18,13 +18,40 @@ namespace PathFinder
     Mesh& Scene::AddMesh(Mesh&& mesh)
     {
         mMeshes.emplace_back(std::move(mesh));
+        mMeshes.back().SetID(mNextMeshID++);
         return mMeshes.back();
     }
 
-    MeshInstance& Scene::AddMeshInstance(MeshInstance&& instance)
+    Scene::MeshInstanceHandle Scene::AddMeshInstance(const Mesh* mesh, const Material* material, const Geometry::Transformation& transformation)
     {
-        mMeshInstances.emplace_back(std::move(instance));
-        return mMeshInstances.back();
+        MeshInstanceHandle handle = mMeshInstances.Emplace(mesh);
+        mMeshInstances[handle].SetEntityID(MakeEntityID(EntityType::MeshInstance, handle.SlotIndex));
+        mMeshInstanceColumns.PushBack(material, transformation);
+        return handle;
+    }
+
+    std::vector<Scene::MeshInstanceHandle> Scene::AddModel(MeshLoader::Model&& model, const std::vector<const Material*>& materials)
+    {
+        assert_format(!materials.empty(), "Model requires at least one material");
+
+        std::vector<Mesh*> meshes;
+        meshes.reserve(model.Meshes.size());
+
+        for (Mesh& mesh : model.Meshes)
+        {
+            meshes.push_back(&AddMesh(std::move(mesh)));
+        }
+
+        std::vector<MeshInstanceHandle> instances;
+        instances.reserve(model.References.size());
+
+        for (const MeshLoader::MeshReference& reference : model.References)
+        {
+            const Material* material = materials[std::min<uint64_t>(reference.MaterialIndex, materials.size() - 1)];
+            instances.push_back(AddMeshInstance(meshes[reference.MeshIndex], material, reference.Transformation));
+        }
+
+        return instances;
     }
 
     Material& Scene::AddMaterial(Material&& material)
@@ -33,46 +60,121 @@ namespace PathFinder
         return mMaterials.back();
     }
 
-    Scene::FlatLightIt Scene::EmplaceDiskLight()
+    Scene::FlatLightHandle Scene::EmplaceDiskLight()
+    {
+        FlatLightHandle handle = mDiskLights.Emplace(FlatLight::Type::Disk);
+        mDiskLights[handle].SetEntityID(MakeEntityID(EntityType::DiskLight, handle.SlotIndex));
+        return handle;
+    }
+
+    Scene::FlatLightHandle Scene::EmplaceRectangularLight()
     {
-        mDiskLights.emplace_back(FlatLight::Type::Disk);
-        return std::prev(mDiskLights.end());
+        FlatLightHandle handle = mRectangularLights.Emplace(FlatLight::Type::Rectangle);
+        mRectangularLights[handle].SetEntityID(MakeEntityID(EntityType::RectangularLight, handle.SlotIndex));
+        return handle;
     }
 
-    Scene::FlatLightIt Scene::EmplaceRectangularLight()
+    Scene::SphericalLightHandle Scene::EmplaceSphericalLight()
     {
-        mRectangularLights.emplace_back(FlatLight::Type::Rectangle);
-        return std::prev(mRectangularLights.end());
+        SphericalLightHandle handle = mSphericalLights.Emplace();
+        mSphericalLights[handle].SetEntityID(MakeEntityID(EntityType::SphericalLight, handle.SlotIndex));
+        return handle;
     }
 
-    Scene::SphericalLightIt Scene::EmplaceSphericalLight()
+    void Scene::RemoveMeshInstance(MeshInstanceHandle handle)
     {
-        mSphericalLights.emplace_back();
-        return std::prev(mSphericalLights.end());
+        // Columns fill the hole the same way slot map does, so they stay in dense storage order
+        mMeshInstanceColumns.SwapRemove(mMeshInstances.DenseIndex(handle));
+        mMeshInstances.Remove(handle);
     }
 
-    std::optional<Scene::EntityVariant> Scene::GetEntityByID(const EntityID& id) const
+    void Scene::RemoveDiskLight(FlatLightHandle handle)
     {
-        auto it = mMappedEntities.find(id);
-        return it == mMappedEntities.end() ? std::nullopt : std::optional(it->second);
+        mDiskLights.Remove(handle);
     }
 
-    void Scene::RemapEntityIDs()
+    void Scene::RemoveRectangularLight(FlatLightHandle handle)
     {
-        mMappedEntities.clear();
+        mRectangularLights.Remove(handle);
+    }
+
+    void Scene::RemoveSphericalLight(SphericalLightHandle handle)
+    {
+        mSphericalLights.Remove(handle);
+    }
 
-        auto remap = [this](auto&& entities)
+    Geometry::Transformation Scene::MeshInstanceTransformation(MeshInstanceHandle handle) const
+    {
+        return mMeshInstanceColumns.Transformations.Get(mMeshInstances.DenseIndex(handle));
+    }
+
+    Geometry::Transformation Scene::MeshInstanceTransformation(const MeshInstance& instance) const
+    {
+        return mMeshInstanceColumns.Transformations.Get(mMeshInstances.DenseIndexOf(instance));
+    }
+
+    void Scene::SetMeshInstanceTransformation(MeshInstanceHandle handle, const Geometry::Transformation& transformation)
+    {
+        mMeshInstanceColumns.Transformations.Set(mMeshInstances.DenseIndex(handle), transformation);
+    }
+
+    void Scene::SetMeshInstanceTransformation(const MeshInstance& instance, const Geometry::Transformation& transformation)
+    {
+        mMeshInstanceColumns.Transformations.Set(mMeshInstances.DenseIndexOf(instance), transformation);
+    }
+
+    const Material* Scene::MeshInstanceMaterial(const MeshInstance& instance) const
+    {
+        return mMeshInstanceColumns.Materials[mMeshInstances.DenseIndexOf(instance)];
+    }
+
+    Geometry::AxisAlignedBox3D Scene::MeshInstanceBoundingBox(const MeshInstance& instance) const
+    {
+        return instance.AssociatedMesh()->BoundingBox().TransformedBy(MeshInstanceTransformation(instance));
+    }
+
+    template <class SceneT, class Action>
+    auto Scene::VisitEntityStorage(SceneT& scene, EntityType type, const Action& action)
+    {
+        switch (type)
         {
-            for (auto& entity : entities)
-            {
-                mMappedEntities[entity.ID()] = &entity;
-            }
-        };
+        case EntityType::MeshInstance: return action(scene.mMeshInstances);
+        case EntityType::SphericalLight: return action(scene.mSphericalLights);
+        case EntityType::DiskLight: return action(scene.mDiskLights);
+        case EntityType::RectangularLight: return action(scene.mRectangularLights);
+        default: return decltype(action(scene.mMeshInstances)){};
+        }
+    }
 
-        remap(mMeshInstances);
-        remap(mSphericalLights);
-        remap(mDiskLights);
-        remap(mRectangularLights);
+    std::optional<Scene::EntityVariant> Scene::GetEntityByID(const EntityID& id)
+    {
+        // ID encodes storage and slot of an entity, so no lookup table is necessary
+        return VisitEntityStorage(*this, EntityIDType(id), [slotIndex = EntityIDSlotIndex(id)](auto& storage) -> std::optional<EntityVariant>
+        {
+            auto* entity = storage.GetBySlotIndex(slotIndex);
+            return entity ? std::optional<EntityVariant>{ entity } : std::nullopt;
+        });
+    }
+
+    EntityHandle Scene::GetEntityHandle(const EntityID& id) const
+    {
+        return VisitEntityStorage(*this, EntityIDType(id), [id](auto& storage) -> EntityHandle
+        {
+            auto slotMapHandle = storage.HandleForSlotIndex(EntityIDSlotIndex(id));
+            return slotMapHandle.IsValid() ? EntityHandle{ id, slotMapHandle.Generation } : EntityHandle{};
+        });
+    }
+
+    std::optional<Scene::EntityVariant> Scene::GetEntity(const EntityHandle& handle)
+    {
+        if (!handle.IsValid())
+            return std::nullopt;
+
+        return VisitEntityStorage(*this, EntityIDType(handle.ID), [&handle](auto& storage) -> std::optional<EntityVariant>
+        {
+            auto* entity = storage.Get({ EntityIDSlotIndex(handle.ID), handle.Generation });
+            return entity ? std::optional<EntityVariant>{ entity } : std::nullopt;
+        });
     }
 
     void Scene::Serialize(const std::filesystem::path& destination) const
@@ -111,6 +213,26 @@ namespace PathFinder
 
     }
 
+    void Scene::MeshInstanceColumns::PushBack(const Material* material, const Geometry::Transformation& transformation)
+    {
+        Transformations.PushBack(transformation);
+        PrevTransformations.PushBack(transformation);
+        Materials.push_back(material);
+        Flags.push_back(MeshInstanceFlags::None);
+    }
+
+    void Scene::MeshInstanceColumns::SwapRemove(uint64_t index)
+    {
+        Transformations.SwapRemove(index);
+        PrevTransformations.SwapRemove(index);
+
+        Materials[index] = Materials.back();
+        Materials.pop_back();
+
+        Flags[index] = Flags.back();
+        Flags.pop_back();
+    }
+
     void Scene::LoadUtilityResources()
     {
         mBlueNoiseTexture = mResourceLoader.LoadTexture("/Precompiled/BlueNoise3DIndependent.dds");
@@ -12,9 +12,13 @@
 #include "SphericalLight.hpp"
 #include "LuminanceMeter.hpp"
 #include "SceneGPUStorage.hpp"
+#include "SceneBVH.hpp"
+#include "SceneCuller.hpp"
+#include "SceneLODSelector.hpp"
 
 #include <Memory/GPUResourceProducer.hpp>
-#include <robinhood/robin_hood.h>
+#include <Foundation/TaskScheduler.hpp>
+#include <Foundation/SlotMap.hpp>
 
 #include <functional>
 #include <vector>
@@ -27,38 +31,81 @@ namespace PathFinder
     class Scene 
     {
     public:
-        using FlatLightIt = std::list<FlatLight>::iterator;
-        using SphericalLightIt = std::list<SphericalLight>::iterator;
+        // Entities are stored densely and addressed by handles that stay valid when other entities are added or removed.
+        // References to entities are invalidated by additions and removals, so handles should be held instead.
+        using MeshInstanceHandle = Foundation::SlotMap<MeshInstance>::Handle;
+        using FlatLightHandle = Foundation::SlotMap<FlatLight>::Handle;
+        using SphericalLightHandle = Foundation::SlotMap<SphericalLight>::Handle;
 
         using EntityVariant = std::variant<MeshInstance*, FlatLight*, SphericalLight*>;
 
-        Scene(const std::filesystem::path& executableFolder, const HAL::Device* device, Memory::GPUResourceProducer* resourceProducer);
+        // Per-frame mesh instance state in structure of arrays layout, ordered as dense mesh instance storage,
+        // so that batch processing like matrix computation streams through it without gathering
+        struct MeshInstanceColumns
+        {
+            Geometry::TransformationArrays Transformations;
+            Geometry::TransformationArrays PrevTransformations;
+            std::vector<const Material*> Materials;
+            std::vector<MeshInstanceFlags> Flags;
+
+            void PushBack(const Material* material, const Geometry::Transformation& transformation);
+            void SwapRemove(uint64_t index);
+        };
+
+        Scene(const std::filesystem::path& executableFolder, const HAL::Device* device, Memory::GPUResourceProducer* resourceProducer, Foundation::TaskScheduler* taskScheduler);
 
         Mesh& AddMesh(Mesh&& mesh);
-        MeshInstance& AddMeshInstance(MeshInstance&& instance);
+        MeshInstanceHandle AddMeshInstance(const Mesh* mesh, const Material* material, const Geometry::Transformation& transformation = Geometry::Transformation{});
+
+        // Adds unique meshes of a model and an instance for every reference to them.
+        // Materials are indexed by file material indices, ones past the end of the list use the last material.
+        std::vector<MeshInstanceHandle> AddModel(MeshLoader::Model&& model, const std::vector<const Material*>& materials);
+
         Material& AddMaterial(Material&& material);
-        FlatLightIt EmplaceDiskLight();
-        FlatLightIt EmplaceRectangularLight();
-        SphericalLightIt EmplaceSphericalLight();
+        FlatLightHandle EmplaceDiskLight();
+        FlatLightHandle EmplaceRectangularLight();
+        SphericalLightHandle EmplaceSphericalLight();
 
-        std::optional<EntityVariant> GetEntityByID(const EntityID& id) const;
+        void RemoveMeshInstance(MeshInstanceHandle handle);
+        void RemoveDiskLight(FlatLightHandle handle);
+        void RemoveRectangularLight(FlatLightHandle handle);
+        void RemoveSphericalLight(SphericalLightHandle handle);
 
-        void RemapEntityIDs();
+        Geometry::Transformation MeshInstanceTransformation(MeshInstanceHandle handle) const;
+        Geometry::Transformation MeshInstanceTransformation(const MeshInstance& instance) const;
+        void SetMeshInstanceTransformation(MeshInstanceHandle handle, const Geometry::Transformation& transformation);
+        void SetMeshInstanceTransformation(const MeshInstance& instance, const Geometry::Transformation& transformation);
+        const Material* MeshInstanceMaterial(const MeshInstance& instance) const;
+        Geometry::AxisAlignedBox3D MeshInstanceBoundingBox(const MeshInstance& instance) const;
+
+        std::optional<EntityVariant> GetEntityByID(const EntityID& id);
+
+        // Handle of an entity currently identified by the ID, invalid if there is none
+        EntityHandle GetEntityHandle(const EntityID& id) const;
+
+        // Resolves only the entity the handle was made for, even if its ID was reused since
+        std::optional<EntityVariant> GetEntity(const EntityHandle& handle);
 
         void Serialize(const std::filesystem::path& destination) const;
         void Deserialize(const std::filesystem::path& source);
 
     private:
+        // Invokes action with storage of entities of the given type, unknown types produce default constructed result
+        template <class SceneT, class Action>
+        static auto VisitEntityStorage(SceneT& scene, EntityType type, const Action& action);
+
         void LoadUtilityResources();
 
+        // Meshes and materials are referenced by pointers from instances, so they stay in node based containers
         std::list<Mesh> mMeshes;
-        std::list<MeshInstance> mMeshInstances;
         std::list<Material> mMaterials;
-        std::list<FlatLight> mRectangularLights;
-        std::list<FlatLight> mDiskLights;
-        std::list<SphericalLight> mSphericalLights;
+        uint64_t mNextMeshID = 1;
 
-        robin_hood::unordered_flat_map<EntityID, EntityVariant> mMappedEntities;
+        Foundation::SlotMap<MeshInstance> mMeshInstances;
+        MeshInstanceColumns mMeshInstanceColumns;
+        Foundation::SlotMap<FlatLight> mRectangularLights;
+        Foundation::SlotMap<FlatLight> mDiskLights;
+        Foundation::SlotMap<SphericalLight> mSphericalLights;
 
         Camera mCamera;
         LuminanceMeter mLuminanceMeter;
@@ -74,6 +121,9 @@ namespace PathFinder
         ResourceLoader mResourceLoader;
         MeshLoader mMeshLoader;
         SceneGPUStorage mGPUStorage;
+        SceneBVH mBVH;
+        SceneCuller mCuller;
+        SceneLODSelector mLODSelector;
 
     public:
         inline Camera& MainCamera() { return mCamera; }
@@ -82,6 +132,7 @@ namespace PathFinder
         inline const LuminanceMeter& LumMeter() const { return mLuminanceMeter; }
         inline const auto& Meshes() const { return mMeshes; }
         inline const auto& MeshInstances() const { return mMeshInstances; }
+        inline const auto& MeshInstanceData() const { return mMeshInstanceColumns; }
         inline const auto& Materials() const { return mMaterials; }
         inline const auto& RectangularLights() const { return mRectangularLights; }
         inline const auto& DiskLights() const { return mDiskLights; }
@@ -91,6 +142,7 @@ namespace PathFinder
 
         inline auto& Meshes() { return mMeshes; }
         inline auto& MeshInstances() { return mMeshInstances; }
+        inline auto& MeshInstanceData() { return mMeshInstanceColumns; }
         inline auto& Materials() { return mMaterials; }
         inline auto& RectangularLights() { return mRectangularLights; }
         inline auto& DiskLights() { return mDiskLights; }
@@ -107,6 +159,11 @@ namespace PathFinder
         inline const Mesh& UnitSphere() const { return mUnitSphere; }
 
         inline SceneGPUStorage& GPUStorage() { return mGPUStorage; }
+        inline SceneBVH& BVH() { return mBVH; }
+        inline const SceneBVH& BVH() const { return mBVH; }
+        inline SceneCuller& Culler() { return mCuller; }
+        inline const SceneCuller& Culler() const { return mCuller; }
+        inline SceneLODSelector& LODSelector() { return mLODSelector; }
     };
 
 }
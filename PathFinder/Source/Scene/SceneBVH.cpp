@@ -0,0 +1,211 @@
+#include "SceneBVH.hpp"
+#include "Scene.hpp"
+
+#include <Foundation/Assert.hpp>
+#include <Geometry/Collision.hpp>
+#include <RenderPipeline/DrawablePrimitive.hpp>
+
+namespace PathFinder
+{
+
+    SceneBVH::SceneBVH(const Scene* scene)
+        : mScene{ scene } {}
+
+    void SceneBVH::Update()
+    {
+        if (mUnitSphereBVH.Hierarchy.IsEmpty())
+        {
+            BuildUtilityMeshBVHs();
+        }
+
+        PruneMeshBVHs();
+
+        std::vector<Instance> instances;
+        instances.reserve(mInstances.size());
+        GatherInstances(instances);
+
+        bool isCompositionChanged = instances.size() != mInstances.size() ||
+            !std::equal(instances.begin(), instances.end(), mInstances.begin(), [](const Instance& a, const Instance& b) { return a.MeshID == b.MeshID && a.Mesh == b.Mesh; });
+
+        mInstances = std::move(instances);
+        mInstanceBounds.resize(mInstances.size());
+
+        for (auto i = 0u; i < mInstances.size(); ++i)
+        {
+            mInstanceBounds[i] = mInstances[i].Bounds;
+        }
+
+        // Topology of refitted hierarchy degrades when objects move far,
+        // but that is fine for picking and much cheaper than rebuilding every frame
+        if (isCompositionChanged)
+        {
+            mInstanceHierarchy.Build(mInstanceBounds, 1);
+        }
+        else if (!mInstances.empty())
+        {
+            mInstanceHierarchy.Refit(mInstanceBounds);
+        }
+    }
+
+    std::optional<EntityID> SceneBVH::RayCast(const Geometry::Ray3D& ray) const
+    {
+        float distance = 0.0f;
+        uint32_t instanceIndex = 0;
+
+        auto intersector = [this, &ray](uint32_t index, float& instanceDistance)
+        {
+            return RayMeshInstance(ray, mInstances[index], instanceDistance);
+        };
+
+        if (!mInstanceHierarchy.RayIntersection(ray, intersector, distance, instanceIndex))
+            return std::nullopt;
+
+        return mInstances[instanceIndex].ID;
+    }
+
+    const SceneBVH::MeshBVH& SceneBVH::GetMeshBVH(const Mesh& mesh)
+    {
+        assert_format(mesh.ID() != 0, "Mesh is not part of the scene");
+
+        auto it = mMeshBVHs.find(mesh.ID());
+
+        if (it != mMeshBVHs.end())
+            return it->second;
+
+        MeshBVH& meshBVH = mMeshBVHs[mesh.ID()];
+        BuildMeshBVH(mesh, meshBVH);
+        return meshBVH;
+    }
+
+    void SceneBVH::BuildMeshBVH(const Mesh& mesh, MeshBVH& meshBVH) const
+    {
+        const auto& vertices = mesh.Vertices();
+        const auto& indices = mesh.Indices();
+
+        meshBVH.Triangles.reserve(indices.size() / 3);
+
+        for (auto i = 0u; i + 2 < indices.size(); i += 3)
+        {
+            meshBVH.Triangles.emplace_back(
+                glm::vec3{ vertices[indices[i]].Position },
+                glm::vec3{ vertices[indices[i + 1]].Position },
+                glm::vec3{ vertices[indices[i + 2]].Position });
+        }
+
+        BuildMeshBVH(meshBVH);
+    }
+
+    void SceneBVH::BuildMeshBVH(MeshBVH& meshBVH) const
+    {
+        std::vector<Geometry::AxisAlignedBox3D> triangleBounds;
+        triangleBounds.reserve(meshBVH.Triangles.size());
+
+        for (const Geometry::Triangle3D& triangle : meshBVH.Triangles)
+        {
+            triangleBounds.push_back(triangle.boundingBox());
+        }
+
+        meshBVH.Hierarchy.Build(triangleBounds);
+    }
+
+    void SceneBVH::BuildUtilityMeshBVHs()
+    {
+        BuildMeshBVH(mScene->UnitSphere(), mUnitSphereBVH);
+
+        const auto& quadVertices = DrawablePrimitive::UnitQuadVertices;
+        const auto& quadIndices = DrawablePrimitive::UnitQuadIndices;
+
+        mUnitQuadBVH.Triangles = {
+            { quadVertices[quadIndices[0]], quadVertices[quadIndices[1]], quadVertices[quadIndices[2]] },
+            { quadVertices[quadIndices[3]], quadVertices[quadIndices[4]], quadVertices[quadIndices[5]] }
+        };
+
+        BuildMeshBVH(mUnitQuadBVH);
+    }
+
+    void SceneBVH::GatherInstances(std::vector<Instance>& instances)
+    {
+        auto addInstance = [&instances](EntityID id, uint64_t meshID, const MeshBVH& meshBVH, const glm::mat4& modelMatrix, const Geometry::AxisAlignedBox3D& bounds)
+        {
+            Instance& instance = instances.emplace_back();
+            instance.ID = id;
+            instance.MeshID = meshID;
+            instance.Mesh = &meshBVH;
+            instance.ModelMatrix = modelMatrix;
+            instance.InverseModelMatrix = glm::inverse(modelMatrix);
+            instance.Bounds = bounds;
+        };
+
+        for (const MeshInstance& meshInstance : mScene->MeshInstances())
+        {
+            const MeshBVH& meshBVH = GetMeshBVH(*meshInstance.AssociatedMesh());
+
+            if (meshBVH.Hierarchy.IsEmpty())
+                continue;
+
+            addInstance(meshInstance.ID(), meshInstance.AssociatedMesh()->ID(), meshBVH, mScene->MeshInstanceTransformation(meshInstance).ModelMatrix(), mScene->MeshInstanceBoundingBox(meshInstance));
+        }
+
+        // Lights without power are not added to GPU acceleration structure either
+        auto addLights = [&](auto&& lights, const MeshBVH& meshBVH)
+        {
+            for (const auto& light : lights)
+            {
+                if (light.LuminousPower() <= 0.0) continue;
+
+                addInstance(light.ID(), 0, meshBVH, light.ModelMatrix(), meshBVH.Hierarchy.Nodes().front().Bounds().TransformedBy(light.ModelMatrix()));
+            }
+        };
+
+        addLights(mScene->SphericalLights(), mUnitSphereBVH);
+        addLights(mScene->RectangularLights(), mUnitQuadBVH);
+        addLights(mScene->DiskLights(), mUnitQuadBVH);
+    }
+
+    void SceneBVH::PruneMeshBVHs()
+    {
+        // Mesh IDs are never reused, so stale entries can't be hit, but they hold memory of replaced meshes.
+        // Every cached entry belonged to some scene mesh, so having more entries than meshes means some are gone.
+        if (mMeshBVHs.size() <= mScene->Meshes().size())
+            return;
+
+        robin_hood::unordered_flat_set<uint64_t> aliveMeshIDs;
+        aliveMeshIDs.reserve(mScene->Meshes().size());
+
+        for (const Mesh& mesh : mScene->Meshes())
+        {
+            aliveMeshIDs.insert(mesh.ID());
+        }
+
+        for (auto it = mMeshBVHs.begin(); it != mMeshBVHs.end();)
+        {
+            if (aliveMeshIDs.count(it->first)) ++it;
+            else it = mMeshBVHs.erase(it);
+        }
+    }
+
+    bool SceneBVH::RayMeshInstance(const Geometry::Ray3D& ray, const Instance& instance, float& distance) const
+    {
+        // Object space ray direction is renormalized, so distance is converted back through the hit point
+        Geometry::Ray3D objectSpaceRay = ray.transformedBy(instance.InverseModelMatrix);
+        const auto& triangles = instance.Mesh->Triangles;
+
+        auto intersector = [&objectSpaceRay, &triangles](uint32_t index, float& triangleDistance)
+        {
+            return Geometry::Collision::RayTriangle(objectSpaceRay, triangles[index], triangleDistance);
+        };
+
+        float objectSpaceDistance = 0.0f;
+        uint32_t triangleIndex = 0;
+
+        if (!instance.Mesh->Hierarchy.RayIntersection(objectSpaceRay, intersector, objectSpaceDistance, triangleIndex))
+            return false;
+
+        glm::vec3 objectSpaceHit = objectSpaceRay.origin + objectSpaceRay.direction * objectSpaceDistance;
+        glm::vec3 worldSpaceHit = instance.ModelMatrix * glm::vec4{ objectSpaceHit, 1.0f };
+
+        distance = glm::length(worldSpaceHit - ray.origin);
+        return true;
+    }
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Mesh.hpp"
+#include "EntityID.hpp"
+
+#include <Geometry/BVH.hpp>
+#include <Geometry/Ray3D.hpp>
+#include <Geometry/Triangle3D.hpp>
+#include <robinhood/robin_hood.h>
+
+#include <glm/mat4x4.hpp>
+#include <vector>
+#include <optional>
+
+namespace PathFinder
+{
+
+    class Scene;
+
+    // CPU mirror of scene ray tracing acceleration structures.
+    // Contains same entities as GPU top level structure, so it can
+    // answer picking queries synchronously, without waiting on GPU readback.
+    class SceneBVH
+    {
+    public:
+        SceneBVH(const Scene* scene);
+
+        // Must be called after entity IDs are assigned.
+        // Rebuilds instance hierarchy when scene composition changes, refits it otherwise.
+        void Update();
+
+        // Closest front facing hit, same as in GPU picking
+        std::optional<EntityID> RayCast(const Geometry::Ray3D& ray) const;
+
+    private:
+        struct MeshBVH
+        {
+            std::vector<Geometry::Triangle3D> Triangles;
+            Geometry::BVH Hierarchy;
+        };
+
+        struct Instance
+        {
+            EntityID ID = NoEntityID;
+            uint64_t MeshID = 0;
+            const MeshBVH* Mesh = nullptr;
+            glm::mat4 ModelMatrix;
+            glm::mat4 InverseModelMatrix;
+            Geometry::AxisAlignedBox3D Bounds;
+        };
+
+        const MeshBVH& GetMeshBVH(const Mesh& mesh);
+        void BuildMeshBVH(const Mesh& mesh, MeshBVH& meshBVH) const;
+        void BuildMeshBVH(MeshBVH& meshBVH) const;
+        void BuildUtilityMeshBVHs();
+        void GatherInstances(std::vector<Instance>& instances);
+        void PruneMeshBVHs();
+
+        bool RayMeshInstance(const Geometry::Ray3D& ray, const Instance& instance, float& distance) const;
+
+        const Scene* mScene;
+        robin_hood::unordered_node_map<uint64_t, MeshBVH> mMeshBVHs;
+        MeshBVH mUnitSphereBVH;
+        MeshBVH mUnitQuadBVH;
+        std::vector<Instance> mInstances;
+        std::vector<Geometry::AxisAlignedBox3D> mInstanceBounds;
+        Geometry::BVH mInstanceHierarchy;
+    };
+
+}
@@ -0,0 +1,154 @@
+#include "SceneCuller.hpp"
+#include "Scene.hpp"
+
+#include <Geometry/Collision.hpp>
+
+#include <algorithm>
+
+namespace PathFinder
+{
+
+    SceneCuller::SceneCuller(const Scene* scene, Foundation::TaskScheduler* taskScheduler)
+        : mScene{ scene }, mTaskScheduler{ taskScheduler } {}
+
+    void SceneCuller::Cull(const Camera& camera, bool isOcclusionCullingEnabled)
+    {
+        GatherBounds();
+        FrustumCull(Geometry::Frustum{ camera.ViewProjection() });
+
+        mFrustumCulledCount = mMeshInstances.size() - mFrustumVisibleIndices.size();
+        mOcclusionCulledCount = 0;
+
+        if (isOcclusionCullingEnabled)
+        {
+            OcclusionCull(camera);
+        }
+        else
+        {
+            mVisibleMeshInstances.clear();
+
+            for (uint64_t index : mFrustumVisibleIndices)
+            {
+                mVisibleMeshInstances.push_back(mMeshInstances[index]);
+            }
+        }
+    }
+
+    void SceneCuller::GatherBounds()
+    {
+        mMeshInstances.clear();
+        mBounds.clear();
+
+        for (const MeshInstance& instance : mScene->MeshInstances())
+        {
+            mMeshInstances.push_back(&instance);
+            mBounds.push_back(mScene->MeshInstanceBoundingBox(instance));
+        }
+
+        uint64_t count = mBounds.size();
+
+        for (auto array : { &mMinX, &mMinY, &mMinZ, &mMaxX, &mMaxY, &mMaxZ })
+        {
+            array->resize(count);
+        }
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            mMinX[i] = mBounds[i].Min.x; mMinY[i] = mBounds[i].Min.y; mMinZ[i] = mBounds[i].Min.z;
+            mMaxX[i] = mBounds[i].Max.x; mMaxY[i] = mBounds[i].Max.y; mMaxZ[i] = mBounds[i].Max.z;
+        }
+    }
+
+    void SceneCuller::FrustumCull(const Geometry::Frustum& frustum)
+    {
+        uint64_t count = mBounds.size();
+        uint64_t taskCount = (count + InstancesPerTask - 1) / InstancesPerTask;
+
+        mVisibilityMasks.resize((count + 31) / 32);
+
+        // Task size is a multiple of 32, so tasks never write the same mask word
+        mTaskScheduler->ParallelFor(0, taskCount, 1, [&](uint64_t task)
+        {
+            uint64_t first = task * InstancesPerTask;
+
+            Geometry::AxisAlignedBox3DSoA boxes{
+                mMinX.data() + first, mMinY.data() + first, mMinZ.data() + first,
+                mMaxX.data() + first, mMaxY.data() + first, mMaxZ.data() + first,
+                std::min(InstancesPerTask, count - first)
+            };
+
+            Geometry::Collision::FrustumAABBs(frustum, boxes, mVisibilityMasks.data() + first / 32);
+        });
+
+        mFrustumVisibleIndices.clear();
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            if (mVisibilityMasks[i / 32] & (1u << (i % 32)))
+                mFrustumVisibleIndices.push_back(i);
+        }
+    }
+
+    void SceneCuller::OcclusionCull(const Camera& camera)
+    {
+        glm::mat4 viewProjection = camera.ViewProjection();
+        float tanHalfFOV = std::tan(glm::radians(camera.FOVV()) * 0.5f);
+
+        // Approximate fraction of the screen height covered by the instance
+        auto screenFraction = [&](uint64_t index)
+        {
+            const Geometry::AxisAlignedBox3D& bounds = mBounds[index];
+            float distance = std::max(glm::distance(bounds.Сenter(), camera.Position()), camera.NearClipPlane());
+            return bounds.Diagonal() / (2.0f * distance * tanHalfFOV);
+        };
+
+        std::vector<std::pair<float, uint64_t>> occluderCandidates;
+
+        for (uint64_t index : mFrustumVisibleIndices)
+        {
+            const MeshInstance* instance = mMeshInstances[index];
+
+            if (instance->AssociatedMesh()->Indices().size() / 3 > MaxOccluderTriangleCount)
+                continue;
+
+            float fraction = screenFraction(index);
+
+            if (fraction * fraction >= MinOccluderScreenFraction)
+                occluderCandidates.emplace_back(fraction, index);
+        }
+
+        uint64_t occluderCount = std::min(MaxOccluderCount, occluderCandidates.size());
+
+        std::partial_sort(occluderCandidates.begin(), occluderCandidates.begin() + occluderCount, occluderCandidates.end(),
+            [](auto& a, auto& b) { return a.first > b.first; });
+
+        mOcclusionBuffer.Clear();
+
+        for (auto i = 0u; i < occluderCount; ++i)
+        {
+            const MeshInstance* occluder = mMeshInstances[occluderCandidates[i].second];
+            mOcclusionBuffer.RasterizeMesh(*occluder->AssociatedMesh(), viewProjection * mScene->MeshInstanceTransformation(*occluder).ModelMatrix());
+        }
+
+        std::vector<uint8_t> occluded(mFrustumVisibleIndices.size());
+
+        mTaskScheduler->ParallelFor(0, mFrustumVisibleIndices.size(), OcclusionTestsPerTask, [&](uint64_t i)
+        {
+            occluded[i] = mOcclusionBuffer.IsOccluded(mBounds[mFrustumVisibleIndices[i]], viewProjection);
+        });
+
+        mVisibleMeshInstances.clear();
+
+        for (auto i = 0u; i < mFrustumVisibleIndices.size(); ++i)
+        {
+            if (occluded[i])
+            {
+                ++mOcclusionCulledCount;
+                continue;
+            }
+
+            mVisibleMeshInstances.push_back(mMeshInstances[mFrustumVisibleIndices[i]]);
+        }
+    }
+
+}
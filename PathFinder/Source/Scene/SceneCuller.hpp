@@ -0,0 +1,63 @@
+#pragma once
+
+#include "MeshInstance.hpp"
+#include "Camera.hpp"
+#include "OcclusionBuffer.hpp"
+
+#include <Geometry/Frustum.hpp>
+#include <Foundation/TaskScheduler.hpp>
+
+#include <vector>
+
+namespace PathFinder
+{
+
+    class Scene;
+
+    // Produces list of mesh instances potentially visible from the camera.
+    // Frustum test runs in parallel over SIMD batches of instance bounds,
+    // optional occlusion test uses largest visible instances as occluders.
+    class SceneCuller
+    {
+    public:
+        SceneCuller(const Scene* scene, Foundation::TaskScheduler* taskScheduler);
+
+        void Cull(const Camera& camera, bool isOcclusionCullingEnabled);
+
+    private:
+        void GatherBounds();
+        void FrustumCull(const Geometry::Frustum& frustum);
+        void OcclusionCull(const Camera& camera);
+
+        static const uint64_t InstancesPerTask = 1024;
+        static const uint64_t OcclusionTestsPerTask = 256;
+        static const uint64_t MaxOccluderCount = 16;
+        static const uint64_t MaxOccluderTriangleCount = 20000;
+
+        // Occluder has to cover roughly this fraction of the screen
+        inline static const float MinOccluderScreenFraction = 0.02f;
+
+        const Scene* mScene;
+        Foundation::TaskScheduler* mTaskScheduler;
+        std::vector<const MeshInstance*> mMeshInstances;
+        std::vector<Geometry::AxisAlignedBox3D> mBounds;
+        std::vector<float> mMinX;
+        std::vector<float> mMinY;
+        std::vector<float> mMinZ;
+        std::vector<float> mMaxX;
+        std::vector<float> mMaxY;
+        std::vector<float> mMaxZ;
+        std::vector<uint32_t> mVisibilityMasks;
+        std::vector<uint64_t> mFrustumVisibleIndices;
+        std::vector<const MeshInstance*> mVisibleMeshInstances;
+        OcclusionBuffer mOcclusionBuffer;
+        uint64_t mFrustumCulledCount = 0;
+        uint64_t mOcclusionCulledCount = 0;
+
+    public:
+        inline const auto& VisibleMeshInstances() const { return mVisibleMeshInstances; }
+        inline auto FrustumCulledCount() const { return mFrustumCulledCount; }
+        inline auto OcclusionCulledCount() const { return mOcclusionCulledCount; }
+    };
+
+}
@@ -11,8 +11,8 @@
 namespace PathFinder
 {
 
-    SceneGPUStorage::SceneGPUStorage(Scene* scene, const HAL::Device* device, Memory::GPUResourceProducer* resourceProducer)
-        : mScene{ scene }, mDevice{ device }, mResourceProducer{ resourceProducer }, mTopAccelerationStructure{ device, resourceProducer }
+    SceneGPUStorage::SceneGPUStorage(Scene* scene, const HAL::Device* device, Memory::GPUResourceProducer* resourceProducer, Foundation::TaskScheduler* taskScheduler)
+        : mScene{ scene }, mDevice{ device }, mResourceProducer{ resourceProducer }, mTaskScheduler{ taskScheduler }, mTopAccelerationStructure{ device, resourceProducer }, mLightClusterBuilder{ taskScheduler }
     {
         mTopAccelerationStructure.SetDebugName("All Meshes Top RT AS");
     }        
@@ -31,6 +31,15 @@ namespace PathFinder
                 mesh.Vertices().data(), mesh.Vertices().size(), mesh.Indices().data(), mesh.Indices().size());
 
             mesh.SetVertexStorageLocation(locationInStorage);
+
+            // Coarser levels are only rasterized, ray tracing always uses full detail acceleration structure
+            for (auto lod = 1u; lod < mesh.LODCount(); ++lod)
+            {
+                VertexStorageLocation lodLocationInStorage = WriteIndicesToTemporaryBuffers<Vertex1P1N1UV1T1BT>(
+                    locationInStorage, mesh.Indices(lod).data(), mesh.Indices(lod).size());
+
+                mesh.SetVertexStorageLocation(lodLocationInStorage, lod);
+            }
         }
 
         auto quadVertices = fplus::transform([](const glm::vec3& p) { return Vertex1P1N1UV1T1BT{ glm::vec4{p, 1.0f} }; }, DrawablePrimitive::UnitQuadVertices);
@@ -98,19 +107,17 @@ namespace PathFinder
 
     void SceneGPUStorage::UploadInstances()
     {
-        mUniqueEntityID = 0;
         mTopAccelerationStructure.Clear();
         UploadMeshInstances();
         UploadLights();
+        UploadLightClusters();
+        UploadLightTree();
         mTopAccelerationStructure.Build();
     }
 
     void SceneGPUStorage::UploadMeshInstances()
     {
         auto& meshInstances = mScene->MeshInstances();
-        auto& sphericalLights = mScene->SphericalLights();
-        auto& rectangularLights = mScene->RectangularLights();
-        auto& diskLights = mScene->DiskLights();
 
         auto requiredBufferSize = meshInstances.size() + mScene->TotalLightCount();
 
@@ -126,38 +133,63 @@ namespace PathFinder
 
         mMeshInstanceTable->RequestWrite();
 
-        uint32_t instanceIdx = 0;
+        uint64_t instanceCount = meshInstances.size();
+
+        // Instances are addressed by 32-bit indices on GPU
+        assert_format(instanceCount <= std::numeric_limits<uint32_t>::max(), "Mesh instance count exceeds GPU table index range");
+
+        uint64_t taskCount = (instanceCount + InstancesPerTask - 1) / InstancesPerTask;
 
-        auto uploadInstance = [&](const GPUMeshInstanceTableEntry& gpuInstance, const VertexStorageLocation& vertexLocations, EntityMask mask, auto&& sceneObject)
+        mInstanceWorldMatrices.resize(instanceCount);
+
+        // Scene keeps instance transformations in columns, so matrices are computed without gathering them first
+        Scene::MeshInstanceColumns& columns = mScene->MeshInstanceData();
+        MeshInstance* instances = meshInstances.data();
+        GPUMeshInstanceTableEntry* table = mMeshInstanceTable->WriteOnlyPtr<GPUMeshInstanceTableEntry>();
+        uint64_t tableStride = sizeof(GPUMeshInstanceTableEntry);
+
+        // Matrices are written straight into mapped table. World matrices are also kept on CPU
+        // for ray tracing instances, because reading back from upload memory is slow.
+        mTaskScheduler->ParallelFor(0, taskCount, 1, [&](uint64_t task)
         {
-            EntityID entityId = GetNextEntityID();
+            uint64_t first = task * InstancesPerTask;
+            uint64_t count = std::min(InstancesPerTask, instanceCount - first);
 
-            sceneObject.SetIndexInGPUTable(instanceIdx);
-            sceneObject.SetEntityID(entityId);
+            Geometry::Transformation::ComputeMatrices(
+                columns.Transformations.View(first, count),
+                { reinterpret_cast<uint8_t*>(mInstanceWorldMatrices.data() + first) },
+                { reinterpret_cast<uint8_t*>(&table[first].InstanceNormalMatrix), tableStride });
 
-            BottomRTAS& blas = mBottomAccelerationStructures[vertexLocations.BottomAccelerationStructureIndex];
-            mTopAccelerationStructure.AddInstance(blas, RTASInstanceInfoForEntity(entityId, mask), gpuInstance.InstanceWorldMatrix);
-            mMeshInstanceTable->Write(&gpuInstance, instanceIdx, 1);
+            Geometry::Transformation::ComputeMatrices(
+                columns.PrevTransformations.View(first, count),
+                { reinterpret_cast<uint8_t*>(&table[first].InstancePrevWorldMatrix), tableStride },
+                {});
 
-            ++instanceIdx;
-        };
+            for (uint64_t i = first; i < first + count; ++i)
+            {
+                const Mesh* mesh = instances[i].AssociatedMesh();
+                const VertexStorageLocation& location = mesh->LocationInVertexStorage(instances[i].SelectedLOD());
+                GPUMeshInstanceTableEntry& entry = table[i];
+
+                entry.InstanceWorldMatrix = mInstanceWorldMatrices[i];
+                entry.MaterialIndex = columns.Materials[i]->GPUMaterialTableIndex;
+                entry.UnifiedVertexBufferOffset = location.VertexBufferOffset;
+                entry.UnifiedIndexBufferOffset = location.IndexBufferOffset;
+                entry.IndexCount = location.IndexCount;
+                entry.HasTangentSpace = mesh->HasTangentSpace();
+            }
+        });
 
-        for (MeshInstance& instance : meshInstances)
+        for (uint64_t i = 0; i < instanceCount; ++i)
         {
-            GPUMeshInstanceTableEntry instanceEntry{
-                instance.Transformation().ModelMatrix(),
-                instance.PrevTransformation().ModelMatrix(),
-                instance.Transformation().NormalMatrix(),
-                instance.AssociatedMaterial()->GPUMaterialTableIndex,
-                instance.AssociatedMesh()->LocationInVertexStorage().VertexBufferOffset,
-                instance.AssociatedMesh()->LocationInVertexStorage().IndexBufferOffset,
-                instance.AssociatedMesh()->LocationInVertexStorage().IndexCount,
-                instance.AssociatedMesh()->HasTangentSpace()
-            };
+            MeshInstance& instance = instances[i];
+            instance.SetIndexInGPUTable(static_cast<uint32_t>(i));
 
-            uploadInstance(instanceEntry, instance.AssociatedMesh()->LocationInVertexStorage(), EntityMask::MeshInstance, instance);
-            instance.UpdatePreviousTransform();
+            BottomRTAS& blas = mBottomAccelerationStructures[instance.AssociatedMesh()->LocationInVertexStorage().BottomAccelerationStructureIndex];
+            mTopAccelerationStructure.AddInstance(blas, RTASInstanceInfoForEntity(instance.ID(), EntityMask::MeshInstance), mInstanceWorldMatrices[i]);
         }
+
+        columns.PrevTransformations = columns.Transformations;
     }
 
     void SceneGPUStorage::UploadLights()
@@ -193,14 +225,11 @@ namespace PathFinder
                 GPULightTableEntry lightEntry = CreateLightGPUTableEntry(light);
                 mLightTable->Write(&lightEntry, index, 1);
 
-                EntityID entityId = GetNextEntityID();
-
-                light.SetEntityID(entityId);
                 light.SetIndexInGPUTable(index);
                 light.SetVertexStorageLocation(vertexLocation);
 
                 BottomRTAS& blas = mBottomAccelerationStructures[vertexLocation.BottomAccelerationStructureIndex];
-                mTopAccelerationStructure.AddInstance(blas, RTASInstanceInfoForEntity(entityId, EntityMask::Light), light.ModelMatrix());
+                mTopAccelerationStructure.AddInstance(blas, RTASInstanceInfoForEntity(light.ID(), EntityMask::Light), light.ModelMatrix());
 
                 ++index;
                 ++lightCount;
@@ -213,9 +242,137 @@ namespace PathFinder
         uploadLights(mScene->RectangularLights(), mLightTablePartitionInfo.RectangularLightsOffset, mLightTablePartitionInfo.RectangularLightsCount, mUnitQuadVertexLocation);
     }
 
-    EntityID SceneGPUStorage::GetNextEntityID()
+    void SceneGPUStorage::UploadLightClusters()
     {
-        return ++mUniqueEntityID;
+        std::vector<LightClusterBuilder::LightBounds> lightBounds;
+        lightBounds.reserve(mLightTablePartitionInfo.TotalLightsCount);
+
+        auto addLightBounds = [&lightBounds](auto&& light, float lightExtent)
+        {
+            if (light.LuminousPower() <= 0.0) return;
+
+            float radius = lightExtent + LightClusterBuilder::InfluenceRadius(light.LuminousPower());
+            lightBounds.push_back({ light.Position(), radius, light.IndexInGPUTable() });
+        };
+
+        for (const SphericalLight& light : mScene->SphericalLights())
+        {
+            addLightBounds(light, light.Radius());
+        }
+
+        // Flat lights are bounded by a sphere around their corners
+        for (const FlatLight& light : mScene->DiskLights())
+        {
+            addLightBounds(light, 0.5f * glm::length(glm::vec2{ light.Width(), light.Height() }));
+        }
+
+        for (const FlatLight& light : mScene->RectangularLights())
+        {
+            addLightBounds(light, 0.5f * glm::length(glm::vec2{ light.Width(), light.Height() }));
+        }
+
+        mLightClusterBuilder.Build(mScene->MainCamera(), lightBounds);
+
+        const auto& clusters = mLightClusterBuilder.Clusters();
+        const auto& indices = mLightClusterBuilder.LightIndices();
+
+        // Empty buffers can't be bound, so index list always has at least one element
+        auto requiredIndexListSize = std::max<uint64_t>(indices.size(), 1);
+
+        if (!mLightClusterTable || mLightClusterTable->Capacity<GPULightCluster>() < clusters.size())
+        {
+            auto properties = HAL::BufferProperties::Create<GPULightCluster>(clusters.size());
+            mLightClusterTable = mResourceProducer->NewBuffer(properties, Memory::GPUResource::UploadStrategy::DirectAccess);
+            mLightClusterTable->SetDebugName("Light Cluster Table");
+        }
+
+        if (!mLightClusterIndexList || mLightClusterIndexList->Capacity<uint32_t>() < requiredIndexListSize)
+        {
+            auto properties = HAL::BufferProperties::Create<uint32_t>(requiredIndexListSize);
+            mLightClusterIndexList = mResourceProducer->NewBuffer(properties, Memory::GPUResource::UploadStrategy::DirectAccess);
+            mLightClusterIndexList->SetDebugName("Light Cluster Index List");
+        }
+
+        mLightClusterTable->RequestWrite();
+        mLightClusterTable->Write(clusters.data(), 0, clusters.size());
+
+        mLightClusterIndexList->RequestWrite();
+
+        if (!indices.empty())
+        {
+            mLightClusterIndexList->Write(indices.data(), 0, indices.size());
+        }
+    }
+
+    void SceneGPUStorage::UploadLightTree()
+    {
+        std::vector<LightTree::LightBounds> lightBounds;
+        lightBounds.reserve(mLightTablePartitionInfo.TotalLightsCount);
+
+        for (const SphericalLight& light : mScene->SphericalLights())
+        {
+            if (light.LuminousPower() <= 0.0) continue;
+
+            // Spheres emit in every direction
+            LightTree::LightBounds bounds{};
+            bounds.BoundsMin = light.Position() - glm::vec3{ light.Radius() };
+            bounds.BoundsMax = light.Position() + glm::vec3{ light.Radius() };
+            bounds.Normal = glm::vec3{ 0.0f, 1.0f, 0.0f };
+            bounds.CosThetaO = -1.0f;
+            bounds.CosThetaE = 0.0f;
+            bounds.Flux = light.LuminousPower();
+            bounds.IndexInGPUTable = light.IndexInGPUTable();
+            lightBounds.push_back(bounds);
+        }
+
+        // Flat lights emit into a hemisphere around their normal
+        auto addFlatLightBounds = [&lightBounds](const FlatLight& light)
+        {
+            if (light.LuminousPower() <= 0.0) return;
+
+            float extent = 0.5f * glm::length(glm::vec2{ light.Width(), light.Height() });
+
+            LightTree::LightBounds bounds{};
+            bounds.BoundsMin = light.Position() - glm::vec3{ extent };
+            bounds.BoundsMax = light.Position() + glm::vec3{ extent };
+            bounds.Normal = light.Normal();
+            bounds.CosThetaO = 1.0f;
+            bounds.CosThetaE = 0.0f;
+            bounds.Flux = light.LuminousPower();
+            bounds.IndexInGPUTable = light.IndexInGPUTable();
+            lightBounds.push_back(bounds);
+        };
+
+        for (const FlatLight& light : mScene->DiskLights())
+        {
+            addFlatLightBounds(light);
+        }
+
+        for (const FlatLight& light : mScene->RectangularLights())
+        {
+            addFlatLightBounds(light);
+        }
+
+        mLightTree.Build(lightBounds);
+
+        const auto& nodes = mLightTree.Nodes();
+
+        // Empty buffers can't be bound, so node buffer always has at least one element
+        auto requiredNodeCount = std::max<uint64_t>(nodes.size(), 1);
+
+        if (!mLightTreeNodes || mLightTreeNodes->Capacity<GPULightTreeNode>() < requiredNodeCount)
+        {
+            auto properties = HAL::BufferProperties::Create<GPULightTreeNode>(requiredNodeCount);
+            mLightTreeNodes = mResourceProducer->NewBuffer(properties, Memory::GPUResource::UploadStrategy::DirectAccess);
+            mLightTreeNodes->SetDebugName("Light Tree Nodes");
+        }
+
+        mLightTreeNodes->RequestWrite();
+
+        if (!nodes.empty())
+        {
+            mLightTreeNodes->Write(nodes.data(), 0, nodes.size());
+        }
     }
 
     GPUCamera SceneGPUStorage::CameraGPURepresentation() const
@@ -15,6 +15,8 @@
 #include "FlatLight.hpp"
 #include "SphericalLight.hpp"
 #include "VertexStorageLocation.hpp"
+#include "LightClusterBuilder.hpp"
+#include "LightTree.hpp"
 
 #include <RenderPipeline/BottomRTAS.hpp>
 #include <RenderPipeline/TopRTAS.hpp>
@@ -136,7 +138,7 @@ namespace PathFinder
     class SceneGPUStorage
     {
     public:
-        SceneGPUStorage(Scene* scene, const HAL::Device* device, Memory::GPUResourceProducer* resourceProducer);
+        SceneGPUStorage(Scene* scene, const HAL::Device* device, Memory::GPUResourceProducer* resourceProducer, Foundation::TaskScheduler* taskScheduler);
 
         void UploadMeshes();
         void UploadMaterials();
@@ -145,6 +147,9 @@ namespace PathFinder
         GPUCamera CameraGPURepresentation() const;
 
     private:
+        // Instance matrices are computed in batches of this size in parallel
+        inline static const uint64_t InstancesPerTask = 512;
+
         template <class Vertex>
         struct UploadBufferPackage
         {
@@ -165,8 +170,8 @@ namespace PathFinder
 
         void UploadMeshInstances();
         void UploadLights();
-
-        EntityID GetNextEntityID();
+        void UploadLightClusters();
+        void UploadLightTree();
 
         GPULightTableEntry CreateLightGPUTableEntry(const FlatLight& light) const;
         GPULightTableEntry CreateLightGPUTableEntry(const SphericalLight& light) const;
@@ -174,6 +179,10 @@ namespace PathFinder
         template <class Vertex>
         VertexStorageLocation WriteToTemporaryBuffers(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices = nullptr, uint32_t indexCount = 0);
 
+        // Adds indices referring to vertices of an already written location, without a separate acceleration structure
+        template <class Vertex>
+        VertexStorageLocation WriteIndicesToTemporaryBuffers(const VertexStorageLocation& verticesLocation, const uint32_t* indices, uint32_t indexCount);
+
         std::tuple<UploadBufferPackage<Vertex1P1N1UV1T1BT>, UploadBufferPackage<Vertex1P1N1UV>, UploadBufferPackage<Vertex1P3>> mUploadBuffers;
         std::tuple<FinalBufferPackage<Vertex1P1N1UV1T1BT>, FinalBufferPackage<Vertex1P1N1UV>, FinalBufferPackage<Vertex1P3>> mFinalBuffers;
 
@@ -183,17 +192,22 @@ namespace PathFinder
         Memory::GPUResourceProducer::BufferPtr mMeshInstanceTable;
         Memory::GPUResourceProducer::BufferPtr mLightTable;
         Memory::GPUResourceProducer::BufferPtr mMaterialTable;
+        Memory::GPUResourceProducer::BufferPtr mLightClusterTable;
+        Memory::GPUResourceProducer::BufferPtr mLightClusterIndexList;
+        Memory::GPUResourceProducer::BufferPtr mLightTreeNodes;
 
         VertexStorageLocation mUnitQuadVertexLocation;
         VertexStorageLocation mUnitCubeVertexLocation;
         VertexStorageLocation mUnitSphereVertexLocation;
         GPULightTablePartitionInfo mLightTablePartitionInfo;
+        LightClusterBuilder mLightClusterBuilder;
+        LightTree mLightTree;
+        std::vector<glm::mat4> mInstanceWorldMatrices;
 
         Scene* mScene;
         const HAL::Device* mDevice;
         Memory::GPUResourceProducer* mResourceProducer;
-
-        EntityID mUniqueEntityID = 0;
+        Foundation::TaskScheduler* mTaskScheduler;
 
     public:
         inline const auto UnifiedVertexBuffer() const { return std::get<FinalBufferPackage<Vertex1P1N1UV1T1BT>>(mFinalBuffers).VertexBuffer.get(); }
@@ -201,6 +215,11 @@ namespace PathFinder
         inline const auto MeshInstanceTable() const { return mMeshInstanceTable.get(); }
         inline const auto LightTable() const { return mLightTable.get(); }
         inline const auto MaterialTable() const { return mMaterialTable.get(); }
+        inline const auto LightClusterTable() const { return mLightClusterTable.get(); }
+        inline const auto LightClusterIndexList() const { return mLightClusterIndexList.get(); }
+        inline const auto& LightClusters() const { return mLightClusterBuilder; }
+        inline const auto LightTreeNodes() const { return mLightTreeNodes.get(); }
+        inline auto LightTreeNodeCount() const { return mLightTree.Nodes().size(); }
         inline const auto& LightTablePartitionInfo() const { return mLightTablePartitionInfo; }
         inline const auto& TopAccelerationStructure() const { return mTopAccelerationStructure; }
         inline const auto& BottomAccelerationStructures() const { return mBottomAccelerationStructures; }
@@ -25,6 +25,20 @@ namespace PathFinder
         return location;
     }
 
+    template <class Vertex>
+    VertexStorageLocation SceneGPUStorage::WriteIndicesToTemporaryBuffers(const VertexStorageLocation& verticesLocation, const uint32_t* indices, uint32_t indexCount)
+    {
+        auto& package = std::get<UploadBufferPackage<Vertex>>(mUploadBuffers);
+
+        VertexStorageLocation location = verticesLocation;
+        location.IndexBufferOffset = package.Indices.size();
+        location.IndexCount = indexCount;
+
+        std::copy(indices, indices + indexCount, std::back_inserter(package.Indices));
+
+        return location;
+    }
+
     template <class Vertex>
     void SceneGPUStorage::SubmitTemporaryBuffersToGPU()
     {
@@ -0,0 +1,67 @@
+#include "SceneLODSelector.hpp"
+#include "Scene.hpp"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+
+namespace PathFinder
+{
+
+    SceneLODSelector::SceneLODSelector(Scene* scene, Foundation::TaskScheduler* taskScheduler)
+        : mScene{ scene }, mTaskScheduler{ taskScheduler } {}
+
+    void SceneLODSelector::Select(const Camera& camera, uint64_t viewportHeight)
+    {
+        auto& meshInstances = mScene->MeshInstances();
+        MeshInstance* instances = meshInstances.data();
+
+        // Projection maps view space height at unit distance to [-1, 1] range of NDC
+        float pixelsPerUnit = camera.Projection()[1][1] * viewportHeight * 0.5f;
+        glm::vec3 cameraPosition = camera.Position();
+
+        mTaskScheduler->ParallelFor(0, meshInstances.size(), InstancesPerTask, [&](uint64_t i)
+        {
+            instances[i].SetSelectedLOD(SelectLOD(instances[i], cameraPosition, pixelsPerUnit));
+        });
+    }
+
+    uint32_t SceneLODSelector::SelectLOD(const MeshInstance& instance, const glm::vec3& cameraPosition, float pixelsPerUnit) const
+    {
+        const Mesh& mesh = *instance.AssociatedMesh();
+        uint32_t lodCount = mesh.LODCount();
+
+        if (lodCount == 1)
+            return 0;
+
+        Geometry::AxisAlignedBox3D bounds = mScene->MeshInstanceBoundingBox(instance);
+        glm::vec3 center = (bounds.Min + bounds.Max) * 0.5f;
+        float radius = glm::length(bounds.Max - bounds.Min) * 0.5f;
+        float distance = glm::length(center - cameraPosition);
+        float meshRadius = glm::length(mesh.BoundingBox().Max - mesh.BoundingBox().Min) * 0.5f;
+
+        // Camera is inside of bounding sphere
+        if (distance <= radius || meshRadius <= 0.0f)
+            return 0;
+
+        float projectedRadius = radius * pixelsPerUnit / distance;
+
+        auto pixelError = [&](uint32_t lod)
+        {
+            return mesh.LODError(lod) / meshRadius * projectedRadius;
+        };
+
+        uint32_t lod = std::min(instance.SelectedLOD(), lodCount - 1);
+
+        if (pixelError(lod) > MaxPixelError)
+        {
+            while (lod > 0 && pixelError(lod) > MaxPixelError) --lod;
+            return lod;
+        }
+
+        while (lod + 1 < lodCount && pixelError(lod + 1) <= MaxPixelError * CoarseningThreshold) ++lod;
+
+        return lod;
+    }
+
+}
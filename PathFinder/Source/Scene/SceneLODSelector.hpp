@@ -0,0 +1,40 @@
+#pragma once
+
+#include "MeshInstance.hpp"
+#include "Camera.hpp"
+
+#include <Foundation/TaskScheduler.hpp>
+
+namespace PathFinder
+{
+
+    class Scene;
+
+    // Picks level of detail for every mesh instance from screen size of its bounding sphere.
+    // Simplification error of a level, relative to mesh bounds, is scaled by projected sphere radius
+    // to get error in pixels, and the coarsest level within the threshold is chosen.
+    // Coarser level is only taken when its error is well below the threshold,
+    // so instances hovering around the threshold distance don't flip between levels every frame.
+    class SceneLODSelector
+    {
+    public:
+        SceneLODSelector(Scene* scene, Foundation::TaskScheduler* taskScheduler);
+
+        void Select(const Camera& camera, uint64_t viewportHeight);
+
+    private:
+        uint32_t SelectLOD(const MeshInstance& instance, const glm::vec3& cameraPosition, float pixelsPerUnit) const;
+
+        static const uint64_t InstancesPerTask = 1024;
+
+        // Largest simplification error allowed on screen, in pixels
+        inline static const float MaxPixelError = 1.0f;
+
+        // Fraction of max error a coarser level has to get below to be switched to
+        inline static const float CoarseningThreshold = 0.7f;
+
+        Scene* mScene;
+        Foundation::TaskScheduler* mTaskScheduler;
+    };
+
+}
@@ -0,0 +1,784 @@
+#include "TextureBaker.hpp"
+
+#include <ThirdParty/dds/dds-ktx.h>
+
+#include <glm/vec3.hpp>
+#include <glm/common.hpp>
+#include <glm/exponential.hpp>
+#include <glm/geometric.hpp>
+
+#include <fstream>
+#include <algorithm>
+#include <limits>
+#include <cstring>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define SCENE_TEXTURE_BAKER_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace PathFinder
+{
+
+    namespace
+    {
+
+        // DXGI format codes written into DX10 header of baked files
+        const uint32_t DXGIFormatBC4 = 80;
+        const uint32_t DXGIFormatBC5 = 83;
+        const uint32_t DXGIFormatBC7 = 98;
+
+        // BC7 4-bit index interpolation weights
+        const uint32_t BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        struct DDSPixelFormat
+        {
+            uint32_t Size = sizeof(DDSPixelFormat);
+            uint32_t Flags = 0;
+            uint32_t FourCC = 0;
+            uint32_t RGBBitCount = 0;
+            uint32_t BitMask[4] = {};
+        };
+
+        struct DDSHeader
+        {
+            uint32_t Size = sizeof(DDSHeader);
+            uint32_t Flags = 0;
+            uint32_t Height = 0;
+            uint32_t Width = 0;
+            uint32_t PitchOrLinearSize = 0;
+            uint32_t Depth = 0;
+            uint32_t MipCount = 0;
+            uint32_t Reserved1[11] = {};
+            DDSPixelFormat PixelFormat;
+            uint32_t Caps[4] = {};
+            uint32_t Reserved2 = 0;
+        };
+
+        struct DDSHeaderDX10
+        {
+            uint32_t DXGIFormat = 0;
+            uint32_t ResourceDimension = 0;
+            uint32_t MiscFlag = 0;
+            uint32_t ArraySize = 0;
+            uint32_t MiscFlags2 = 0;
+        };
+
+        constexpr uint32_t FourCC(char a, char b, char c, char d)
+        {
+            return uint32_t(a) | (uint32_t(b) << 8) | (uint32_t(c) << 16) | (uint32_t(d) << 24);
+        }
+
+        // Appends bits to a 128-bit block, least significant bit first
+        class BlockBitWriter
+        {
+        public:
+            BlockBitWriter(uint8_t* block) : mBlock{ block } { std::memset(block, 0, 16); }
+
+            void Write(uint32_t value, uint32_t bitCount)
+            {
+                for (auto bit = 0u; bit < bitCount; ++bit, ++mOffset)
+                {
+                    mBlock[mOffset / 8] |= ((value >> bit) & 1) << (mOffset % 8);
+                }
+            }
+
+        private:
+            uint8_t* mBlock;
+            uint32_t mOffset = 0;
+        };
+
+        // Palette is stored one channel after another so that 4 entries are tested at once.
+        // Entry count must be a multiple of 4.
+        template <uint32_t ChannelCount, uint32_t EntryCount>
+        uint32_t NearestPaletteEntry(const float(&palette)[ChannelCount][EntryCount], const float* texel, float& distance)
+        {
+            static_assert(EntryCount % 4 == 0, "Palette entry count must be a multiple of 4");
+
+#if defined(SCENE_TEXTURE_BAKER_SSE)
+            __m128 bestDistances = _mm_set1_ps(std::numeric_limits<float>::max());
+            __m128 bestIndices = _mm_setzero_ps();
+            __m128 indices = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+            for (auto entry = 0u; entry < EntryCount; entry += 4)
+            {
+                __m128 distances = _mm_setzero_ps();
+
+                for (auto channel = 0u; channel < ChannelCount; ++channel)
+                {
+                    __m128 delta = _mm_sub_ps(_mm_loadu_ps(&palette[channel][entry]), _mm_set1_ps(texel[channel]));
+                    distances = _mm_add_ps(distances, _mm_mul_ps(delta, delta));
+                }
+
+                __m128 closer = _mm_cmplt_ps(distances, bestDistances);
+                bestDistances = _mm_min_ps(distances, bestDistances);
+                bestIndices = _mm_or_ps(_mm_and_ps(closer, indices), _mm_andnot_ps(closer, bestIndices));
+                indices = _mm_add_ps(indices, _mm_set1_ps(4.0f));
+            }
+
+            alignas(16) float laneDistances[4];
+            alignas(16) float laneIndices[4];
+            _mm_store_ps(laneDistances, bestDistances);
+            _mm_store_ps(laneIndices, bestIndices);
+
+            uint32_t bestLane = 0;
+
+            for (auto lane = 1u; lane < 4; ++lane)
+            {
+                if (laneDistances[lane] < laneDistances[bestLane])
+                {
+                    bestLane = lane;
+                }
+            }
+
+            distance = laneDistances[bestLane];
+            return uint32_t(laneIndices[bestLane]);
+#else
+            uint32_t bestIndex = 0;
+            distance = std::numeric_limits<float>::max();
+
+            for (auto entry = 0u; entry < EntryCount; ++entry)
+            {
+                float entryDistance = 0.0f;
+
+                for (auto channel = 0u; channel < ChannelCount; ++channel)
+                {
+                    float delta = palette[channel][entry] - texel[channel];
+                    entryDistance += delta * delta;
+                }
+
+                if (entryDistance < distance)
+                {
+                    distance = entryDistance;
+                    bestIndex = entry;
+                }
+            }
+
+            return bestIndex;
+#endif
+        }
+
+        // Single channel block, values are in [0; 255] range
+        void EncodeBC4Block(const float(&values)[16], uint8_t* block)
+        {
+            float minValue = *std::min_element(std::begin(values), std::end(values));
+            float maxValue = *std::max_element(std::begin(values), std::end(values));
+
+            uint32_t endpoint0 = uint32_t(std::round(maxValue));
+            uint32_t endpoint1 = uint32_t(std::round(minValue));
+
+            std::memset(block, 0, 8);
+            block[0] = endpoint0;
+            block[1] = endpoint1;
+
+            // Constant block, zero indices refer to the first endpoint
+            if (endpoint0 == endpoint1)
+            {
+                return;
+            }
+
+            // First endpoint being greater selects 8 interpolated values mode
+            float palette[1][8];
+            palette[0][0] = float(endpoint0);
+            palette[0][1] = float(endpoint1);
+
+            for (auto i = 1u; i < 7; ++i)
+            {
+                palette[0][i + 1] = float(((7 - i) * endpoint0 + i * endpoint1) / 7);
+            }
+
+            uint64_t indexBits = 0;
+
+            for (auto i = 0u; i < 16; ++i)
+            {
+                float distance = 0.0f;
+                uint64_t index = NearestPaletteEntry(palette, &values[i], distance);
+                indexBits |= index << (i * 3);
+            }
+
+            for (auto i = 0u; i < 6; ++i)
+            {
+                block[2 + i] = uint8_t(indexBits >> (i * 8));
+            }
+        }
+
+        struct BC7Endpoints
+        {
+            glm::uvec4 Colors[2];
+            uint32_t PBits[2];
+        };
+
+        // Quantizes endpoint to 7 bits per channel plus shared p-bit, picking the p-bit with least error
+        void QuantizeBC7Endpoint(const glm::vec4& endpoint, glm::uvec4& color, uint32_t& pBit)
+        {
+            float bestError = std::numeric_limits<float>::max();
+
+            for (auto p = 0u; p < 2; ++p)
+            {
+                glm::vec4 quantized = glm::clamp(glm::round((endpoint - float(p)) * 0.5f), glm::vec4{ 0.0f }, glm::vec4{ 127.0f });
+                glm::vec4 delta = quantized * 2.0f + float(p) - endpoint;
+                float error = glm::dot(delta, delta);
+
+                if (error < bestError)
+                {
+                    bestError = error;
+                    color = glm::uvec4{ quantized };
+                    pBit = p;
+                }
+            }
+        }
+
+        float FindBC7Indices(const glm::vec4(&texels)[16], const BC7Endpoints& endpoints, uint32_t(&indices)[16])
+        {
+            glm::uvec4 endpoint0 = endpoints.Colors[0] * 2u + endpoints.PBits[0];
+            glm::uvec4 endpoint1 = endpoints.Colors[1] * 2u + endpoints.PBits[1];
+
+            float palette[4][16];
+
+            for (auto entry = 0u; entry < 16; ++entry)
+            {
+                for (auto channel = 0u; channel < 4; ++channel)
+                {
+                    uint32_t weight = BC7Weights[entry];
+                    palette[channel][entry] = float(((64 - weight) * endpoint0[channel] + weight * endpoint1[channel] + 32) >> 6);
+                }
+            }
+
+            float totalError = 0.0f;
+
+            for (auto i = 0u; i < 16; ++i)
+            {
+                float distance = 0.0f;
+                indices[i] = NearestPaletteEntry(palette, &texels[i].x, distance);
+                totalError += distance;
+            }
+
+            return totalError;
+        }
+
+        // Encodes block using mode 6: single subset, RGBA 7.7.7.7 endpoints with unique p-bits and 4-bit indices.
+        // Texels are in [0; 255] range.
+        void EncodeBC7Block(const glm::vec4(&texels)[16], uint8_t* block)
+        {
+            glm::vec4 mean{ 0.0f };
+            glm::vec4 minTexel = texels[0];
+            glm::vec4 maxTexel = texels[0];
+
+            for (const glm::vec4& texel : texels)
+            {
+                mean += texel;
+                minTexel = glm::min(minTexel, texel);
+                maxTexel = glm::max(maxTexel, texel);
+            }
+
+            mean /= 16.0f;
+
+            // Principal axis of texel distribution through power iteration on covariance matrix
+            float covariance[4][4] = {};
+
+            for (const glm::vec4& texel : texels)
+            {
+                glm::vec4 delta = texel - mean;
+
+                for (auto r = 0u; r < 4; ++r)
+                {
+                    for (auto c = 0u; c < 4; ++c)
+                    {
+                        covariance[r][c] += delta[r] * delta[c];
+                    }
+                }
+            }
+
+            glm::vec4 axis = maxTexel - minTexel;
+
+            for (auto iteration = 0u; iteration < 8; ++iteration)
+            {
+                glm::vec4 next{ 0.0f };
+
+                for (auto r = 0u; r < 4; ++r)
+                {
+                    for (auto c = 0u; c < 4; ++c)
+                    {
+                        next[r] += covariance[r][c] * axis[c];
+                    }
+                }
+
+                float length = glm::length(next);
+
+                if (length < 1e-6f)
+                {
+                    break;
+                }
+
+                axis = next / length;
+            }
+
+            float axisLengthSq = glm::dot(axis, axis);
+            float minProjection = 0.0f;
+            float maxProjection = 0.0f;
+
+            if (axisLengthSq > 1e-12f)
+            {
+                axis /= std::sqrt(axisLengthSq);
+                minProjection = std::numeric_limits<float>::max();
+                maxProjection = std::numeric_limits<float>::lowest();
+
+                for (const glm::vec4& texel : texels)
+                {
+                    float projection = glm::dot(texel - mean, axis);
+                    minProjection = std::min(minProjection, projection);
+                    maxProjection = std::max(maxProjection, projection);
+                }
+            }
+
+            glm::vec4 lowerBound{ 0.0f };
+            glm::vec4 upperBound{ 255.0f };
+
+            BC7Endpoints endpoints;
+            QuantizeBC7Endpoint(glm::clamp(mean + axis * minProjection, lowerBound, upperBound), endpoints.Colors[0], endpoints.PBits[0]);
+            QuantizeBC7Endpoint(glm::clamp(mean + axis * maxProjection, lowerBound, upperBound), endpoints.Colors[1], endpoints.PBits[1]);
+
+            uint32_t indices[16];
+            float error = FindBC7Indices(texels, endpoints, indices);
+
+            // Least squares refit of endpoints to the chosen indices
+            float alpha2 = 0.0f, beta2 = 0.0f, alphaBeta = 0.0f;
+            glm::vec4 alphaX{ 0.0f }, betaX{ 0.0f };
+
+            for (auto i = 0u; i < 16; ++i)
+            {
+                float beta = BC7Weights[indices[i]] / 64.0f;
+                float alpha = 1.0f - beta;
+                alpha2 += alpha * alpha;
+                beta2 += beta * beta;
+                alphaBeta += alpha * beta;
+                alphaX += texels[i] * alpha;
+                betaX += texels[i] * beta;
+            }
+
+            float determinant = alpha2 * beta2 - alphaBeta * alphaBeta;
+
+            if (std::abs(determinant) > 1e-6f)
+            {
+                BC7Endpoints refitted;
+                glm::vec4 refitted0 = (alphaX * beta2 - betaX * alphaBeta) / determinant;
+                glm::vec4 refitted1 = (betaX * alpha2 - alphaX * alphaBeta) / determinant;
+                QuantizeBC7Endpoint(glm::clamp(refitted0, lowerBound, upperBound), refitted.Colors[0], refitted.PBits[0]);
+                QuantizeBC7Endpoint(glm::clamp(refitted1, lowerBound, upperBound), refitted.Colors[1], refitted.PBits[1]);
+
+                uint32_t refittedIndices[16];
+                float refittedError = FindBC7Indices(texels, refitted, refittedIndices);
+
+                if (refittedError < error)
+                {
+                    endpoints = refitted;
+                    std::copy(std::begin(refittedIndices), std::end(refittedIndices), std::begin(indices));
+                }
+            }
+
+            // Most significant bit of the anchor index is implicit zero, swap endpoints to satisfy that
+            if (indices[0] >= 8)
+            {
+                std::swap(endpoints.Colors[0], endpoints.Colors[1]);
+                std::swap(endpoints.PBits[0], endpoints.PBits[1]);
+
+                for (uint32_t& index : indices)
+                {
+                    index = 15 - index;
+                }
+            }
+
+            BlockBitWriter writer{ block };
+            writer.Write(1 << 6, 7);
+
+            for (auto channel = 0u; channel < 4; ++channel)
+            {
+                writer.Write(endpoints.Colors[0][channel], 7);
+                writer.Write(endpoints.Colors[1][channel], 7);
+            }
+
+            writer.Write(endpoints.PBits[0], 1);
+            writer.Write(endpoints.PBits[1], 1);
+            writer.Write(indices[0], 3);
+
+            for (auto i = 1u; i < 16; ++i)
+            {
+                writer.Write(indices[i], 4);
+            }
+        }
+
+        float SRGBToLinear(float value)
+        {
+            return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        }
+
+        float LinearToSRGB(float value)
+        {
+            return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+        }
+
+    }
+
+    TextureBaker::TextureBaker(const std::filesystem::path& rootPath, Foundation::TaskScheduler* taskScheduler)
+        : mRootPath{ rootPath }, mTaskScheduler{ taskScheduler } {}
+
+    std::string TextureBaker::GetOrBake(const std::string& relativeFilePath, MapSemantic semantic) const
+    {
+        BlockFormat format = ToBlockFormat(semantic);
+        std::string bakedRelativePath = BakedFilePath(relativeFilePath, format);
+
+        std::filesystem::path sourcePath = mRootPath;
+        sourcePath += relativeFilePath;
+
+        std::filesystem::path bakedPath = mRootPath;
+        bakedPath += bakedRelativePath;
+
+        if (IsCacheValid(sourcePath, bakedPath))
+        {
+            return bakedRelativePath;
+        }
+
+        std::ifstream input{ sourcePath.string(), std::ios::binary };
+
+        if (!input.is_open())
+        {
+            return relativeFilePath;
+        }
+
+        std::vector<uint8_t> bytes(std::filesystem::file_size(sourcePath));
+        input.read((char*)bytes.data(), bytes.size());
+        input.close();
+
+        Image image;
+
+        if (!Decode(bytes, image))
+        {
+            return relativeFilePath;
+        }
+
+        uint32_t width = image.Width;
+        uint32_t height = image.Height;
+        uint32_t mipCount = 1;
+
+        for (auto size = std::max(image.Width, image.Height); size > 1; size /= 2)
+        {
+            ++mipCount;
+        }
+
+        std::vector<uint8_t> compressed;
+
+        for (auto mip = 0u; mip < mipCount; ++mip)
+        {
+            if (mip > 0)
+            {
+                image = Downsample(image, semantic);
+            }
+
+            Encode(image, format, compressed);
+        }
+
+        if (!WriteDDS(bakedPath, format, width, height, mipCount, compressed))
+        {
+            return relativeFilePath;
+        }
+
+        return bakedRelativePath;
+    }
+
+    TextureBaker::BlockFormat TextureBaker::ToBlockFormat(MapSemantic semantic) const
+    {
+        switch (semantic)
+        {
+        case MapSemantic::Albedo: return BlockFormat::BC7;
+        case MapSemantic::Normal: return BlockFormat::BC5;
+        default: return BlockFormat::BC4;
+        }
+    }
+
+    uint32_t TextureBaker::BlockSize(BlockFormat format) const
+    {
+        return format == BlockFormat::BC4 ? 8 : 16;
+    }
+
+    std::string TextureBaker::BakedFilePath(const std::string& relativeFilePath, BlockFormat format) const
+    {
+        std::filesystem::path path{ relativeFilePath };
+
+        switch (format)
+        {
+        case BlockFormat::BC4: path.replace_extension(".bc4.dds"); break;
+        case BlockFormat::BC5: path.replace_extension(".bc5.dds"); break;
+        case BlockFormat::BC7: path.replace_extension(".bc7.dds"); break;
+        }
+
+        return path.string();
+    }
+
+    bool TextureBaker::IsCacheValid(const std::filesystem::path& sourcePath, const std::filesystem::path& bakedPath) const
+    {
+        std::error_code error;
+
+        if (!std::filesystem::exists(bakedPath, error))
+        {
+            return false;
+        }
+
+        auto bakedTime = std::filesystem::last_write_time(bakedPath, error);
+        if (error) return false;
+
+        auto sourceTime = std::filesystem::last_write_time(sourcePath, error);
+
+        // Cache is still usable when the source file is not shipped
+        if (error) return true;
+
+        return bakedTime >= sourceTime;
+    }
+
+    bool TextureBaker::Decode(const std::vector<uint8_t>& bytes, Image& image) const
+    {
+        ddsktx_texture_info textureInfo;
+        ddsktx_error error;
+
+        if (!ddsktx_parse(&textureInfo, bytes.data(), (int)bytes.size(), &error))
+        {
+            return false;
+        }
+
+        bool isPlain2DTexture =
+            textureInfo.num_layers == 1 && textureInfo.depth == 1 &&
+            !(textureInfo.flags & DDSKTX_TEXTURE_FLAG_CUBEMAP);
+
+        if (!isPlain2DTexture || ddsktx_format_compressed(textureInfo.format))
+        {
+            return false;
+        }
+
+        uint32_t channelCount = 0;
+        uint32_t channelSize = 1;
+        bool isBGR = false;
+
+        switch (textureInfo.format)
+        {
+        case DDSKTX_FORMAT_R8: channelCount = 1; break;
+        case DDSKTX_FORMAT_RG8: channelCount = 2; break;
+        case DDSKTX_FORMAT_RGBA8: channelCount = 4; break;
+        case DDSKTX_FORMAT_BGRA8: channelCount = 4; isBGR = true; break;
+        case DDSKTX_FORMAT_R16: channelCount = 1; channelSize = 2; break;
+        case DDSKTX_FORMAT_RG16: channelCount = 2; channelSize = 2; break;
+        case DDSKTX_FORMAT_RGBA16: channelCount = 4; channelSize = 2; break;
+        default: return false;
+        }
+
+        auto isPowerOfTwo = [](int size) { return size > 0 && (size & (size - 1)) == 0; };
+
+        // Loader computes block compressed mip sizes from rounded up parent mips,
+        // which only matches the layout we write for power of two textures
+        if (!isPowerOfTwo(textureInfo.width) || !isPowerOfTwo(textureInfo.height))
+        {
+            return false;
+        }
+
+        ddsktx_sub_data subData;
+        ddsktx_get_sub(&textureInfo, &subData, bytes.data(), (int)bytes.size(), 0, 0, 0);
+
+        image.Width = subData.width;
+        image.Height = subData.height;
+        image.Texels.resize(uint64_t(image.Width) * image.Height);
+
+        float maxChannelValue = channelSize == 1 ? 255.0f : 65535.0f;
+
+        for (auto y = 0u; y < image.Height; ++y)
+        {
+            const uint8_t* row = (const uint8_t*)subData.buff + uint64_t(y) * subData.row_pitch_bytes;
+
+            for (auto x = 0u; x < image.Width; ++x)
+            {
+                glm::vec4 texel{ 0.0f, 0.0f, 0.0f, 1.0f };
+
+                for (auto channel = 0u; channel < channelCount; ++channel)
+                {
+                    const uint8_t* channelData = row + (uint64_t(x) * channelCount + channel) * channelSize;
+                    uint32_t value = channelSize == 1 ? *channelData : *(const uint16_t*)channelData;
+                    texel[channel] = value / maxChannelValue;
+                }
+
+                if (isBGR)
+                {
+                    std::swap(texel.r, texel.b);
+                }
+
+                image.Texels[uint64_t(y) * image.Width + x] = texel;
+            }
+        }
+
+        return true;
+    }
+
+    TextureBaker::Image TextureBaker::Downsample(const Image& image, MapSemantic semantic) const
+    {
+        Image mip;
+        mip.Width = std::max(image.Width / 2, 1u);
+        mip.Height = std::max(image.Height / 2, 1u);
+        mip.Texels.resize(uint64_t(mip.Width) * mip.Height);
+
+        mTaskScheduler->ParallelFor(0, mip.Height, BlockRowsPerTask * 4, [&](uint64_t y)
+        {
+            for (auto x = 0u; x < mip.Width; ++x)
+            {
+                glm::vec4 sum{ 0.0f };
+
+                // Box filter, odd and single texel dimensions are clamped to the edge
+                for (auto dy = 0u; dy < 2; ++dy)
+                {
+                    for (auto dx = 0u; dx < 2; ++dx)
+                    {
+                        uint32_t sourceX = std::min(x * 2 + dx, image.Width - 1);
+                        uint32_t sourceY = std::min(uint32_t(y) * 2 + dy, image.Height - 1);
+                        glm::vec4 texel = image.Texels[uint64_t(sourceY) * image.Width + sourceX];
+
+                        switch (semantic)
+                        {
+                        case MapSemantic::Albedo:
+                            // Albedo is stored in sRGB, averaging has to happen in linear space
+                            texel = glm::vec4{ SRGBToLinear(texel.r), SRGBToLinear(texel.g), SRGBToLinear(texel.b), texel.a };
+                            break;
+                        case MapSemantic::Normal:
+                            texel = glm::vec4{ glm::vec3{ texel } * 2.0f - 1.0f, texel.a };
+                            break;
+                        default:
+                            break;
+                        }
+
+                        sum += texel;
+                    }
+                }
+
+                glm::vec4 average = sum * 0.25f;
+
+                switch (semantic)
+                {
+                case MapSemantic::Albedo:
+                    average = glm::vec4{ LinearToSRGB(average.r), LinearToSRGB(average.g), LinearToSRGB(average.b), average.a };
+                    break;
+                case MapSemantic::Normal:
+                {
+                    glm::vec3 normal{ average };
+                    float length = glm::length(normal);
+                    normal = length > 1e-6f ? normal / length : glm::vec3{ 0.0f, 0.0f, 1.0f };
+                    average = glm::vec4{ normal * 0.5f + 0.5f, average.a };
+                    break;
+                }
+                default:
+                    break;
+                }
+
+                mip.Texels[y * mip.Width + x] = average;
+            }
+        });
+
+        return mip;
+    }
+
+    void TextureBaker::Encode(const Image& image, BlockFormat format, std::vector<uint8_t>& output) const
+    {
+        uint64_t blockCountX = (image.Width + 3) / 4;
+        uint64_t blockCountY = (image.Height + 3) / 4;
+        uint64_t blockSize = BlockSize(format);
+        uint64_t mipOffset = output.size();
+
+        output.resize(mipOffset + blockCountX * blockCountY * blockSize);
+
+        mTaskScheduler->ParallelFor(0, blockCountY, BlockRowsPerTask, [&](uint64_t blockY)
+        {
+            for (auto blockX = 0u; blockX < blockCountX; ++blockX)
+            {
+                glm::vec4 texels[16];
+
+                // Blocks overhanging image edges replicate edge texels
+                for (auto i = 0u; i < 16; ++i)
+                {
+                    uint64_t x = std::min<uint64_t>(blockX * 4 + i % 4, image.Width - 1);
+                    uint64_t y = std::min<uint64_t>(blockY * 4 + i / 4, image.Height - 1);
+                    texels[i] = glm::clamp(image.Texels[y * image.Width + x], 0.0f, 1.0f) * 255.0f;
+                }
+
+                uint8_t* block = output.data() + mipOffset + (blockY * blockCountX + blockX) * blockSize;
+
+                switch (format)
+                {
+                case BlockFormat::BC7:
+                {
+                    EncodeBC7Block(texels, block);
+                    break;
+                }
+                case BlockFormat::BC5:
+                case BlockFormat::BC4:
+                {
+                    uint32_t channelCount = format == BlockFormat::BC5 ? 2 : 1;
+
+                    for (auto channel = 0u; channel < channelCount; ++channel)
+                    {
+                        float values[16];
+
+                        for (auto i = 0u; i < 16; ++i)
+                        {
+                            values[i] = texels[i][channel];
+                        }
+
+                        EncodeBC4Block(values, block + channel * 8);
+                    }
+
+                    break;
+                }
+                }
+            }
+        });
+    }
+
+    bool TextureBaker::WriteDDS(const std::filesystem::path& path, BlockFormat format, uint32_t width, uint32_t height, uint32_t mipCount, const std::vector<uint8_t>& data) const
+    {
+        const uint32_t DDSDCaps = 0x1, DDSDHeight = 0x2, DDSDWidth = 0x4, DDSDPixelFormat = 0x1000, DDSDMipCount = 0x20000, DDSDLinearSize = 0x80000;
+        const uint32_t DDPFFourCC = 0x4;
+        const uint32_t DDSCapsComplex = 0x8, DDSCapsTexture = 0x1000, DDSCapsMipMap = 0x400000;
+        const uint32_t ResourceDimensionTexture2D = 3;
+
+        DDSHeader header;
+        header.Flags = DDSDCaps | DDSDHeight | DDSDWidth | DDSDPixelFormat | DDSDMipCount | DDSDLinearSize;
+        header.Width = width;
+        header.Height = height;
+        header.PitchOrLinearSize = ((width + 3) / 4) * ((height + 3) / 4) * BlockSize(format);
+        header.MipCount = mipCount;
+        header.PixelFormat.Flags = DDPFFourCC;
+        header.PixelFormat.FourCC = FourCC('D', 'X', '1', '0');
+        header.Caps[0] = DDSCapsTexture | DDSCapsComplex | DDSCapsMipMap;
+
+        DDSHeaderDX10 headerDX10;
+        headerDX10.ResourceDimension = ResourceDimensionTexture2D;
+        headerDX10.ArraySize = 1;
+
+        switch (format)
+        {
+        case BlockFormat::BC4: headerDX10.DXGIFormat = DXGIFormatBC4; break;
+        case BlockFormat::BC5: headerDX10.DXGIFormat = DXGIFormatBC5; break;
+        case BlockFormat::BC7: headerDX10.DXGIFormat = DXGIFormatBC7; break;
+        }
+
+        std::ofstream output{ path.string(), std::ios::binary | std::ios::trunc };
+
+        if (!output.is_open())
+        {
+            return false;
+        }
+
+        uint32_t magic = FourCC('D', 'D', 'S', ' ');
+
+        output.write((const char*)&magic, sizeof(magic));
+        output.write((const char*)&header, sizeof(header));
+        output.write((const char*)&headerDX10, sizeof(headerDX10));
+        output.write((const char*)data.data(), data.size());
+
+        return output.good();
+    }
+
+}
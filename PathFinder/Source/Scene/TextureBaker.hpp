@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Foundation/TaskScheduler.hpp>
+
+#include <glm/vec4.hpp>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace PathFinder
+{
+
+    // Converts uncompressed material maps into block compressed DDS files with full mip chains.
+    // Baked files are cached next to source files and are rebaked only when a source file changes.
+    class TextureBaker
+    {
+    public:
+        enum class MapSemantic
+        {
+            Albedo, Normal, Roughness, Metalness, AO
+        };
+
+        TextureBaker(const std::filesystem::path& rootPath, Foundation::TaskScheduler* taskScheduler);
+
+        // Returns root-relative path of a baked texture,
+        // or source path when the source is already compressed or cannot be decoded
+        std::string GetOrBake(const std::string& relativeFilePath, MapSemantic semantic) const;
+
+    private:
+        enum class BlockFormat
+        {
+            BC4, BC5, BC7
+        };
+
+        struct Image
+        {
+            uint32_t Width = 0;
+            uint32_t Height = 0;
+            std::vector<glm::vec4> Texels;
+        };
+
+        // Block rows encoded by a single task
+        inline static const uint64_t BlockRowsPerTask = 4;
+
+        BlockFormat ToBlockFormat(MapSemantic semantic) const;
+        uint32_t BlockSize(BlockFormat format) const;
+        std::string BakedFilePath(const std::string& relativeFilePath, BlockFormat format) const;
+        bool IsCacheValid(const std::filesystem::path& sourcePath, const std::filesystem::path& bakedPath) const;
+        bool Decode(const std::vector<uint8_t>& bytes, Image& image) const;
+        Image Downsample(const Image& image, MapSemantic semantic) const;
+        void Encode(const Image& image, BlockFormat format, std::vector<uint8_t>& output) const;
+        bool WriteDDS(const std::filesystem::path& path, BlockFormat format, uint32_t width, uint32_t height, uint32_t mipCount, const std::vector<uint8_t>& data) const;
+
+        std::filesystem::path mRootPath;
+        Foundation::TaskScheduler* mTaskScheduler;
+    };
+
+}
@@ -8,6 +8,14 @@ namespace PathFinder
     void LuminanceMeterViewModel::Import()
     {
         mLuminanceMeter = &Dependencies->ScenePtr->LumMeter();
+
+        std::lock_guard lock{ mHistogramStaging->Mutex };
+
+        if (mHistogramStaging->HasNewData)
+        {
+            mLuminanceMeter->SetHistogramData(mHistogramStaging->Bins.data());
+            mHistogramStaging->HasNewData = false;
+        }
     }
 
     void LuminanceMeterViewModel::Export()
@@ -20,10 +28,26 @@ namespace PathFinder
         {
             const Memory::Buffer* histogram = Dependencies->ResourceStorage->GetPerResourceData(ResourceNames::LuminanceHistogram)->Buffer.get();
 
-            histogram->Read<uint32_t>([this](const uint32_t* data)
+            Memory::ReadbackFuture histogramReadback = histogram->CurrentFrameReadback();
+
+            if (!histogramReadback.IsValid() || !mLuminanceMeter)
+                return;
+
+            // Data of every frame arrives once GPU is done with it, no matter how many frames that takes.
+            // Staged here and handed to the meter on import, since the meter is only touched by the UI thread.
+            std::weak_ptr<HistogramStaging> staging = mHistogramStaging;
+            uint32_t binCount = mLuminanceMeter->HistogramBinCount();
+
+            histogramReadback.OnCompletion<uint32_t>([staging, binCount](const uint32_t* data, const Memory::ReadbackFuture&)
             {
-                if (data && mLuminanceMeter)
-                    mLuminanceMeter->SetHistogramData(data);
+                std::shared_ptr<HistogramStaging> lockedStaging = staging.lock();
+
+                if (!lockedStaging)
+                    return;
+
+                std::lock_guard lock{ lockedStaging->Mutex };
+                lockedStaging->Bins.assign(data, data + binCount);
+                lockedStaging->HasNewData = true;
             });
         }};
     }
@@ -4,6 +4,10 @@
 
 #include <Scene/LuminanceMeter.hpp>
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace PathFinder
 {
    
@@ -15,7 +19,17 @@ namespace PathFinder
         void Export() override;
 
     private:
+        // Readback callbacks run on worker threads and may outlive the view model,
+        // so they only reach histogram data through this shared state
+        struct HistogramStaging
+        {
+            std::mutex Mutex;
+            std::vector<uint32_t> Bins;
+            bool HasNewData = false;
+        };
+
         LuminanceMeter* mLuminanceMeter = nullptr;
+        std::shared_ptr<HistogramStaging> mHistogramStaging = std::make_shared<HistogramStaging>();
 
     public:
         inline const LuminanceMeter* LumMeter() const { return mLuminanceMeter; }
@@ -2,25 +2,15 @@
 
 #include <Foundation/STDHelpers.hpp>
 #include <fplus/fplus.hpp>
-#include <RenderPipeline/RenderPasses/PipelineNames.hpp>
 
 namespace PathFinder
 {
 
-    void PickedEntityViewModel::HandleClick()
+    void PickedEntityViewModel::HandleClick(const glm::vec2& screenUV)
     {
-        mMeshInstance = nullptr;
-        mSphericalLight = nullptr;
-        mFlatLight = nullptr;
-
-        if (auto entity = mScene->GetEntityByID(mHoveredEntityID))
-        {
-            std::visit(Foundation::MakeVisitor(
-                [this](MeshInstance* instance) { mMeshInstance = instance; },
-                [this](SphericalLight* light) { mSphericalLight = light; },
-                [this](FlatLight* light) { mFlatLight = light; }),
-                *entity);
-        }
+        std::optional<EntityID> pickedEntityID = mScene->BVH().RayCast(mScene->MainCamera().WorldRay(screenUV));
+        mPickedEntity = pickedEntityID ? mScene->GetEntityHandle(*pickedEntityID) : EntityHandle{};
+        ResolvePickedEntity();
     }
 
     void PickedEntityViewModel::SetModifiedModelMatrix(const glm::mat4& mat, const glm::mat4& delta)
@@ -32,11 +22,12 @@ namespace PathFinder
     void PickedEntityViewModel::Import()
     {
         mScene = Dependencies->ScenePtr;
+        ResolvePickedEntity();
 
         mShouldDisplay = mMeshInstance != nullptr || mSphericalLight != nullptr || mFlatLight != nullptr;
         mAreRotationsAllowed = mSphericalLight == nullptr;
        
-        if (mMeshInstance) mModelMatrix = mMeshInstance->Transformation().ModelMatrix();
+        if (mMeshInstance) mModelMatrix = mScene->MeshInstanceTransformation(*mMeshInstance).ModelMatrix();
         else if (mSphericalLight) mModelMatrix = mSphericalLight->ModelMatrix();
         else if (mFlatLight) mModelMatrix = mFlatLight->ModelMatrix();
 
@@ -48,7 +39,7 @@ namespace PathFinder
     {
         if (mMeshInstance)
         {
-            mMeshInstance->SetTransformation(Geometry::Transformation{ mModifiedModelMatrix });
+            mScene->SetMeshInstanceTransformation(*mMeshInstance, Geometry::Transformation{ mModifiedModelMatrix });
         }
         else if (mSphericalLight)
         {
@@ -80,17 +71,28 @@ namespace PathFinder
         }
     }
 
-    void PickedEntityViewModel::OnCreated()
+    void PickedEntityViewModel::ResolvePickedEntity()
     {
-        (*Dependencies->PostRenderEvent) += { "PickedEntityViewModel.Post.Render", [this]()
-        {
-            const Memory::Buffer* pickedGeometryInfo = Dependencies->ResourceStorage->GetPerResourceData(PathFinder::ResourceNames::PickedGeometryInfo)->Buffer.get();
+        mMeshInstance = nullptr;
+        mSphericalLight = nullptr;
+        mFlatLight = nullptr;
 
-            pickedGeometryInfo->Read<uint32_t>([this](const uint32_t* info)
-            {
-                if (info) mHoveredEntityID = EntityID{ *info };
-            });
-        }};
+        if (!mPickedEntity.IsValid())
+            return;
+
+        if (auto entity = mScene->GetEntity(mPickedEntity))
+        {
+            std::visit(Foundation::MakeVisitor(
+                [this](MeshInstance* instance) { mMeshInstance = instance; },
+                [this](SphericalLight* light) { mSphericalLight = light; },
+                [this](FlatLight* light) { mFlatLight = light; }),
+                *entity);
+        }
+        else
+        {
+            // Entity was removed from the scene, possibly replaced by another one in the same slot
+            mPickedEntity = {};
+        }
     }
 
 }
@@ -11,14 +11,18 @@ namespace PathFinder
     class PickedEntityViewModel : public ViewModel
     {
     public:
-        void HandleClick();
+        // Picks entity under the cursor synchronously using CPU scene BVH
+        void HandleClick(const glm::vec2& screenUV);
         void SetModifiedModelMatrix(const glm::mat4& mat, const glm::mat4& delta);
 
         void Import() override;
         void Export() override;
-        void OnCreated() override;
 
     private:
+        // Scene storage may move entities around, so only a handle is kept between frames
+        void ResolvePickedEntity();
+
+        EntityHandle mPickedEntity;
         bool mShouldDisplay = false;
         bool mAreRotationsAllowed = true;
         glm::mat4 mModelMatrix;
@@ -28,7 +32,6 @@ namespace PathFinder
         SphericalLight* mSphericalLight = nullptr;
         FlatLight* mFlatLight = nullptr;
         Scene* mScene = nullptr;
-        EntityID mHoveredEntityID = NoEntityID;
 
     public:
         inline const glm::mat4& ModelMatrix() const { return mModelMatrix; }
@@ -1,12 +1,170 @@
 #include "RenderGraphViewController.hpp"
 #include "UIManager.hpp"
 
+#include <implot/implot.h>
+#include <algorithm>
+
 namespace PathFinder
 {
 
+    void RenderGraphViewController::OnCreated()
+    {
+        RenderGraphVM = GetViewModel<RenderGraphViewModel>();
+    }
+
     void RenderGraphViewController::Draw()
     {
-       
+        RenderGraphVM->Import();
+
+        ImGui::SetNextWindowSize({ 900, 700 }, ImGuiCond_Once);
+        ImGui::Begin("Render Graph");
+
+        if (ImGui::Button("Export Chrome Trace"))
+        {
+            RenderGraphVM->RequestChromeTraceExport();
+        }
+
+        const PipelineResourceStorage::TransientMemoryReport& memoryReport = RenderGraphVM->TransientMemoryReport();
+        const float BytesInMB = 1024.0f * 1024.0f;
+
+        ImGui::SameLine();
+        ImGui::Text("Transient Peak %.1f MB (%.1f MB In Depth Order) | Heaps %.1f MB",
+            memoryReport.ExecutionOrderPeak / BytesInMB, memoryReport.DependencyDepthOrderPeak / BytesInMB, memoryReport.HeapsSize / BytesInMB);
+
+        const FrameProfiler::FrameTiming* frame = RenderGraphVM->LatestFrame();
+
+        if (frame)
+        {
+            ImGui::SameLine();
+            ImGui::Text("Frame %llu | CPU %.3f ms (Fence Wait %.3f ms) | GPU %.3f ms | %llu Frames In Flight", 
+                frame->FrameNumber, frame->CPUDurationMS, frame->FenceWaitMS, frame->GPUDurationMS, RenderGraphVM->SimultaneousFramesInFlight());
+
+            ImGui::Text("Barriers %llu (%.0f%% Split, %llu Eliminated)",
+                frame->Barriers.SubmittedBarrierCount, frame->Barriers.SplitRatio() * 100.0f, frame->Barriers.EliminatedBarrierCount);
+
+            ImGui::SameLine();
+            ImGui::Text("| Readbacks %llu (Latency %.1f Avg, %llu Max Frames)",
+                frame->Readbacks.CompletedReadbackCount, frame->Readbacks.AverageFrameLatency(), frame->Readbacks.MaxFrameLatency);
+
+            ImGui::SameLine();
+            ImGui::Text("| Texture Cache %llu Hits, %llu Misses, %llu Cached",
+                RenderGraphVM->TextureCacheHitCount(), RenderGraphVM->TextureCacheMissCount(), RenderGraphVM->CachedTextureCount());
+
+            ImPlot::StyleColorsDark();
+            DrawFrameTimeHistory();
+            DrawTimeline(*frame);
+            DrawPassTable(*frame);
+        }
+
+        ImGui::End();
+
+        RenderGraphVM->Export();
+    }
+
+    void RenderGraphViewController::DrawFrameTimeHistory()
+    {
+        const std::vector<float>& cpuTimes = RenderGraphVM->CPUFrameTimes();
+        const std::vector<float>& gpuTimes = RenderGraphVM->GPUFrameTimes();
+
+        float maxTime = 0.0f;
+
+        for (auto i = 0u; i < cpuTimes.size(); ++i)
+        {
+            maxTime = std::max({ maxTime, cpuTimes[i], gpuTimes[i] });
+        }
+
+        ImPlot::SetNextPlotLimits(0, cpuTimes.size(), 0, maxTime * 1.1, ImGuiCond_Always);
+
+        if (ImPlot::BeginPlot("Frame Times", "Frame", "ms", ImVec2(-1, 200), ImPlotFlags_None, ImPlotAxisFlags_NoTickLabels))
+        {
+            ImPlot::PlotLine("CPU", cpuTimes.data(), cpuTimes.size());
+            ImPlot::PlotLine("GPU", gpuTimes.data(), gpuTimes.size());
+            ImPlot::EndPlot();
+        }
+    }
+
+    void RenderGraphViewController::DrawTimeline(const FrameProfiler::FrameTiming& frame)
+    {
+        // Row 0 is CPU, rows below are GPU queues
+        uint64_t rowCount = 1;
+        double timelineEnd = frame.CPUDurationMS;
+
+        for (const FrameProfiler::PassTiming& pass : frame.Passes)
+        {
+            rowCount = std::max(rowCount, pass.QueueIndex + 2);
+            timelineEnd = std::max(timelineEnd, pass.GPUEndMS);
+        }
+
+        ImPlot::SetNextPlotLimitsY(-0.5, rowCount - 0.5, ImGuiCond_Always);
+        ImPlot::SetNextPlotLimitsX(0.0, timelineEnd, ImGuiCond_Once);
+
+        if (!ImPlot::BeginPlot("Timeline", "ms", nullptr, ImVec2(-1, 80 + rowCount * 40), ImPlotFlags_None, ImPlotAxisFlags_None, ImPlotAxisFlags_NoDecorations | ImPlotAxisFlags_Invert))
+        {
+            return;
+        }
+
+        ImDrawList* drawList = ImPlot::GetPlotDrawList();
+        ImPlotPoint mousePosition = ImPlot::GetPlotMousePos();
+        const char* hoveredName = nullptr;
+        double hoveredDuration = 0.0;
+
+        auto drawBar = [&](const char* name, double row, double start, double end, ImU32 color)
+        {
+            ImVec2 min = ImPlot::PlotToPixels(start, row - 0.4);
+            ImVec2 max = ImPlot::PlotToPixels(end, row + 0.4);
+            drawList->AddRectFilled(min, max, color);
+            drawList->AddRect(min, max, IM_COL32(0, 0, 0, 255));
+
+            if (ImPlot::IsPlotHovered() && 
+                mousePosition.x >= start && mousePosition.x <= end &&
+                mousePosition.y >= row - 0.4 && mousePosition.y <= row + 0.4)
+            {
+                hoveredName = name;
+                hoveredDuration = end - start;
+            }
+        };
+
+        ImPlot::PushPlotClipRect();
+
+        for (const FrameProfiler::CPUScopeTiming& scope : frame.CPUScopes)
+        {
+            // Offset nested scopes slightly to keep them distinguishable
+            drawBar(scope.Name.c_str(), scope.Depth * 0.1, scope.StartMS, scope.EndMS, IM_COL32(70, 130, 180, 255));
+        }
+
+        for (const FrameProfiler::PassTiming& pass : frame.Passes)
+        {
+            ImU32 color = pass.QueueIndex == 0 ? IM_COL32(200, 80, 60, 255) : IM_COL32(90, 170, 90, 255);
+            drawBar(pass.PassName.ToString().c_str(), pass.QueueIndex + 1, pass.GPUStartMS, pass.GPUEndMS, color);
+        }
+
+        ImPlot::PopPlotClipRect();
+        ImPlot::EndPlot();
+
+        if (hoveredName)
+        {
+            ImGui::SetTooltip("%s: %.3f ms", hoveredName, hoveredDuration);
+        }
+    }
+
+    void RenderGraphViewController::DrawPassTable(const FrameProfiler::FrameTiming& frame)
+    {
+        ImGui::Columns(4, "Passes");
+        ImGui::Text("Pass"); ImGui::NextColumn();
+        ImGui::Text("Queue"); ImGui::NextColumn();
+        ImGui::Text("GPU, ms"); ImGui::NextColumn();
+        ImGui::Text("CPU Recording, ms"); ImGui::NextColumn();
+        ImGui::Separator();
+
+        for (const FrameProfiler::PassTiming& pass : frame.Passes)
+        {
+            ImGui::Text("%s", pass.PassName.ToString().c_str()); ImGui::NextColumn();
+            ImGui::Text("%llu", pass.QueueIndex); ImGui::NextColumn();
+            ImGui::Text("%.3f", pass.GPUEndMS - pass.GPUStartMS); ImGui::NextColumn();
+            ImGui::Text("%.3f", pass.CPURecordingMS); ImGui::NextColumn();
+        }
+
+        ImGui::Columns(1);
     }
 
 }
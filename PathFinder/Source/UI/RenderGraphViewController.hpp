@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ViewController.hpp"
+#include "RenderGraphViewModel.hpp"
 
 namespace PathFinder
 {
@@ -8,7 +9,15 @@ namespace PathFinder
     class RenderGraphViewController : public ViewController
     {
     public:
+        void OnCreated() override;
         void Draw() override;
+
+        RenderGraphViewModel* RenderGraphVM;
+
+    private:
+        void DrawFrameTimeHistory();
+        void DrawTimeline(const FrameProfiler::FrameTiming& frame);
+        void DrawPassTable(const FrameProfiler::FrameTiming& frame);
     };
 
 }
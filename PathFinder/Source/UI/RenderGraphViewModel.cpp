@@ -5,12 +5,37 @@ namespace PathFinder
 
     void RenderGraphViewModel::Import()
     {
+        const FrameProfiler* profiler = Dependencies->Profiler;
 
+        mLatestFrame = profiler->MostRecentFrame();
+        mTransientMemoryReport = Dependencies->ResourceStorage->GetTransientMemoryReport();
+        mSimultaneousFramesInFlight = profiler->SimultaneousFramesInFlight();
+        mTextureCacheHitCount = Dependencies->ResourceAllocator->TextureCacheHitCount();
+        mTextureCacheMissCount = Dependencies->ResourceAllocator->TextureCacheMissCount();
+        mCachedTextureCount = Dependencies->ResourceAllocator->CachedTextureCount();
+        mCPUFrameTimes.clear();
+        mGPUFrameTimes.clear();
+
+        for (const FrameProfiler::FrameTiming& frame : profiler->History())
+        {
+            mCPUFrameTimes.push_back(frame.CPUDurationMS);
+            mGPUFrameTimes.push_back(frame.GPUDurationMS);
+        }
     }
 
     void RenderGraphViewModel::Export()
     {
+        if (mIsChromeTraceExportRequested)
+        {
+            // Working directory depends on how the app was launched, executable folder does not
+            Dependencies->Profiler->ExportChromeTrace(Dependencies->CmdLineParser->ExecutableFolderPath() / "FrameTrace.json");
+            mIsChromeTraceExportRequested = false;
+        }
+    }
 
+    void RenderGraphViewModel::RequestChromeTraceExport()
+    {
+        mIsChromeTraceExportRequested = true;
     }
 
 }
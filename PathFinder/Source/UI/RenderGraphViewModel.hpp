@@ -2,6 +2,11 @@
 
 #include "ViewModel.hpp"
 
+#include <RenderPipeline/FrameProfiler.hpp>
+#include <RenderPipeline/PipelineResourceStorage.hpp>
+
+#include <vector>
+
 namespace PathFinder
 {
    
@@ -11,7 +16,28 @@ namespace PathFinder
         void Import() override;
         void Export() override;
 
+        void RequestChromeTraceExport();
+
     private:
+        const FrameProfiler::FrameTiming* mLatestFrame = nullptr;
+        std::vector<float> mCPUFrameTimes;
+        std::vector<float> mGPUFrameTimes;
+        PipelineResourceStorage::TransientMemoryReport mTransientMemoryReport;
+        uint64_t mSimultaneousFramesInFlight = 0;
+        uint64_t mTextureCacheHitCount = 0;
+        uint64_t mTextureCacheMissCount = 0;
+        uint64_t mCachedTextureCount = 0;
+        bool mIsChromeTraceExportRequested = false;
+
+    public:
+        inline const FrameProfiler::FrameTiming* LatestFrame() const { return mLatestFrame; }
+        inline const std::vector<float>& CPUFrameTimes() const { return mCPUFrameTimes; }
+        inline const std::vector<float>& GPUFrameTimes() const { return mGPUFrameTimes; }
+        inline const auto& TransientMemoryReport() const { return mTransientMemoryReport; }
+        inline uint64_t SimultaneousFramesInFlight() const { return mSimultaneousFramesInFlight; }
+        inline uint64_t TextureCacheHitCount() const { return mTextureCacheHitCount; }
+        inline uint64_t TextureCacheMissCount() const { return mTextureCacheMissCount; }
+        inline uint64_t CachedTextureCount() const { return mCachedTextureCount; }
     };
 
 }
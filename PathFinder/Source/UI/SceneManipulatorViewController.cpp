@@ -151,7 +151,8 @@ namespace PathFinder
     {
         if (GetInput()->CurrentClickCount() == 1 && !GetUIManager()->IsInteracting() && !GetUIManager()->IsMouseOverUI())
         {
-            EntityVM->HandleClick();
+            ImGuiIO& io = ImGui::GetIO();
+            EntityVM->HandleClick(GetInput()->MousePosition() / glm::vec2{ io.DisplaySize.x, io.DisplaySize.y });
         }
 
         if (GetInput()->WasKeyboardKeyUnpressed(KeyboardKey::T))
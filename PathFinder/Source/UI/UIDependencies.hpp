@@ -2,8 +2,10 @@
 
 #include <RenderPipeline/PipelineResourceStorage.hpp>
 #include <RenderPipeline/RenderEngine.hpp>
+#include <RenderPipeline/FrameProfiler.hpp>
 #include <RenderPipeline/RenderPassContentMediator.hpp>
 #include <Scene/Scene.hpp>
+#include <IO/CommandLineParser.hpp>
 
 namespace PathFinder
 {
@@ -15,16 +17,25 @@ namespace PathFinder
             const PipelineResourceStorage* resourceStorage, 
             RenderEngine<RenderPassContentMediator>::Event* preRenderEvent,
             RenderEngine<RenderPassContentMediator>::Event* postRenderEvent,
+            const FrameProfiler* profiler,
+            const Memory::SegregatedPoolsResourceAllocator* resourceAllocator,
+            const CommandLineParser* commandLineParser,
             Scene* scene)
             :
             ResourceStorage{ resourceStorage },
             PreRenderEvent{ preRenderEvent },
             PostRenderEvent{ postRenderEvent },
+            Profiler{ profiler },
+            ResourceAllocator{ resourceAllocator },
+            CmdLineParser{ commandLineParser },
             ScenePtr{ scene } {}
 
         const PipelineResourceStorage* const ResourceStorage;
         RenderEngine<RenderPassContentMediator>::Event* const PreRenderEvent;
         RenderEngine<RenderPassContentMediator>::Event* const PostRenderEvent;
+        const FrameProfiler* const Profiler;
+        const Memory::SegregatedPoolsResourceAllocator* const ResourceAllocator;
+        const CommandLineParser* const CmdLineParser;
         Scene* const ScenePtr;
     };
 
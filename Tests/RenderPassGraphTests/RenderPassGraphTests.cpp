@@ -0,0 +1,269 @@
+#include <RenderPipeline/RenderPassGraph.hpp>
+
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+
+namespace
+{
+
+    using PathFinder::RenderPassGraph;
+    using PathFinder::RenderPassMetadata;
+    using PathFinder::RenderPassPurpose;
+    using PathFinder::RenderPassExecutionQueue;
+
+    uint32_t FailureCount = 0;
+
+    void Expect(bool condition, const char* description, int line)
+    {
+        if (!condition)
+        {
+            std::printf("FAILED (line %d): %s\n", line, description);
+            ++FailureCount;
+        }
+    }
+
+#define EXPECT(CONDITION) Expect((CONDITION), #CONDITION, __LINE__)
+
+    const uint64_t GraphicsQueue = std::underlying_type_t<RenderPassExecutionQueue>(RenderPassExecutionQueue::Graphics);
+    const uint64_t AsyncComputeQueue = std::underlying_type_t<RenderPassExecutionQueue>(RenderPassExecutionQueue::AsyncCompute);
+
+    bool NearlyEqual(float a, float b)
+    {
+        return std::abs(a - b) < 1e-5f;
+    }
+
+    // Pass indices in the order they are added by DeclarePasses
+    enum Pass : uint64_t
+    {
+        GBuffer = 0, Lighting, AO, SSR, FixedQueue, Raster, Composition, Unused, PassCount
+    };
+
+    // GBuffer (cost 2) feeds every other pass and Composition (cost 3) reads all their outputs,
+    // so each path through the graph costs 5 plus cost of the pass in between.
+    // Critical path goes through Lighting (cost 4), slack of other passes is 4 minus their own cost.
+    void DeclarePasses(RenderPassGraph& graph, bool addPasses)
+    {
+        const char* names[] = { "GBuffer", "Lighting", "AO", "SSR", "FixedQueue", "Raster", "Composition", "Unused" };
+
+        if (addPasses)
+        {
+            for (const char* name : names)
+            {
+                graph.AddPass(RenderPassMetadata{ name, RenderPassPurpose::Default });
+            }
+        }
+
+        auto& nodes = graph.Nodes();
+
+        nodes[GBuffer].AddWriteDependency("GBufferTexture", std::nullopt, 1);
+        nodes[GBuffer].UsesRasterization = true;
+        nodes[GBuffer].EstimatedCost = 2.0f;
+
+        auto declareConsumer = [&](Pass pass, const char* output, float cost)
+        {
+            nodes[pass].AddReadDependency("GBufferTexture", 1);
+            nodes[pass].AddWriteDependency(output, std::nullopt, 1);
+            nodes[pass].EstimatedCost = cost;
+            nodes[Composition].AddReadDependency(output, 1);
+        };
+
+        declareConsumer(Lighting, "LightingTexture", 4.0f);
+        declareConsumer(AO, "AOTexture", 1.0f);
+        declareConsumer(SSR, "SSRTexture", 3.0f);
+        declareConsumer(FixedQueue, "FixedQueueTexture", 1.0f);
+        declareConsumer(Raster, "RasterTexture", 1.0f);
+
+        nodes[Lighting].UsesRasterization = true;
+        nodes[Raster].UsesRasterization = true;
+        nodes[FixedQueue].IsExecutionQueueFixed = true;
+
+        nodes[Composition].AddWriteDependency(RenderPassGraph::Node::BackBufferName, std::nullopt, 1);
+        nodes[Composition].UsesRasterization = true;
+        nodes[Composition].EstimatedCost = 3.0f;
+
+        // Output nobody reads, so pass is culled and must not affect critical path
+        nodes[Unused].AddReadDependency("GBufferTexture", 1);
+        nodes[Unused].AddWriteDependency("UnusedTexture", std::nullopt, 1);
+        nodes[Unused].EstimatedCost = 100.0f;
+    }
+
+    void TestSlackAndCriticalPath()
+    {
+        RenderPassGraph graph;
+        DeclarePasses(graph, true);
+        graph.Build(RenderPassGraph::OrderingPolicy::DependencyDepth, RenderPassGraph::QueueAssignmentPolicy::CriticalPath);
+
+        const auto& nodes = graph.Nodes();
+
+        EXPECT(nodes[Unused].IsCulled());
+        EXPECT(NearlyEqual(graph.CriticalPathCost(), 9.0f));
+
+        // Zero slack marks critical path
+        EXPECT(NearlyEqual(nodes[GBuffer].CriticalPathSlack(), 0.0f));
+        EXPECT(NearlyEqual(nodes[Lighting].CriticalPathSlack(), 0.0f));
+        EXPECT(NearlyEqual(nodes[Composition].CriticalPathSlack(), 0.0f));
+
+        EXPECT(NearlyEqual(nodes[AO].CriticalPathSlack(), 3.0f));
+        EXPECT(NearlyEqual(nodes[SSR].CriticalPathSlack(), 1.0f));
+        EXPECT(NearlyEqual(nodes[FixedQueue].CriticalPathSlack(), 3.0f));
+        EXPECT(NearlyEqual(nodes[Raster].CriticalPathSlack(), 3.0f));
+    }
+
+    void TestCriticalPathQueueAssignment()
+    {
+        RenderPassGraph graph;
+        DeclarePasses(graph, true);
+        graph.Build(RenderPassGraph::OrderingPolicy::DependencyDepth, RenderPassGraph::QueueAssignmentPolicy::CriticalPath);
+
+        const auto& nodes = graph.Nodes();
+
+        // Only compute pass that fits entirely into its slack moves
+        EXPECT(nodes[AO].ExecutionQueueIndex == AsyncComputeQueue);
+
+        // Slack shorter than pass itself
+        EXPECT(nodes[SSR].ExecutionQueueIndex == GraphicsQueue);
+        // Explicitly requested queue and rasterization keep passes on graphics queue
+        EXPECT(nodes[FixedQueue].ExecutionQueueIndex == GraphicsQueue);
+        EXPECT(nodes[Raster].ExecutionQueueIndex == GraphicsQueue);
+
+        for (Pass pass : { GBuffer, Lighting, Composition })
+        {
+            EXPECT(nodes[pass].ExecutionQueueIndex == GraphicsQueue);
+        }
+
+        EXPECT(graph.DetectedQueueCount() == 2);
+
+        // Moved pass synchronizes with graphics queue on both ends
+        EXPECT(nodes[GBuffer].IsSyncSignalRequired());
+        EXPECT(nodes[AO].IsSyncSignalRequired());
+
+        const auto& compositionSyncs = nodes[Composition].NodesToSyncWith();
+        EXPECT(std::find(compositionSyncs.begin(), compositionSyncs.end(), &nodes[AO]) != compositionSyncs.end());
+    }
+
+    void TestManualQueueAssignment()
+    {
+        RenderPassGraph graph;
+        DeclarePasses(graph, true);
+        graph.Build(RenderPassGraph::OrderingPolicy::DependencyDepth, RenderPassGraph::QueueAssignmentPolicy::Manual);
+
+        const auto& nodes = graph.Nodes();
+
+        // Slack is still reported, but queues are left as requested
+        EXPECT(NearlyEqual(graph.CriticalPathCost(), 9.0f));
+        EXPECT(NearlyEqual(nodes[AO].CriticalPathSlack(), 3.0f));
+        EXPECT(graph.DetectedQueueCount() == 1);
+
+        for (auto pass = 0u; pass < PassCount; ++pass)
+        {
+            EXPECT(nodes[pass].ExecutionQueueIndex == GraphicsQueue);
+        }
+    }
+
+    void TestRebuildWithUpdatedCosts()
+    {
+        RenderPassGraph graph;
+        DeclarePasses(graph, true);
+        graph.Build(RenderPassGraph::OrderingPolicy::DependencyDepth, RenderPassGraph::QueueAssignmentPolicy::CriticalPath);
+
+        // Next frame AO takes over critical path from lighting
+        graph.Clear();
+        DeclarePasses(graph, false);
+
+        auto& nodes = graph.Nodes();
+        nodes[AO].EstimatedCost = 4.0f;
+        nodes[Lighting].EstimatedCost = 1.0f;
+
+        graph.Build(RenderPassGraph::OrderingPolicy::DependencyDepth, RenderPassGraph::QueueAssignmentPolicy::CriticalPath);
+
+        EXPECT(NearlyEqual(graph.CriticalPathCost(), 9.0f));
+        EXPECT(NearlyEqual(nodes[AO].CriticalPathSlack(), 0.0f));
+        EXPECT(NearlyEqual(nodes[SSR].CriticalPathSlack(), 1.0f));
+        EXPECT(nodes[AO].ExecutionQueueIndex == GraphicsQueue);
+        EXPECT(nodes[SSR].ExecutionQueueIndex == GraphicsQueue);
+
+        // Cheaper SSR fits now
+        graph.Clear();
+        DeclarePasses(graph, false);
+
+        nodes[AO].EstimatedCost = 4.0f;
+        nodes[SSR].EstimatedCost = 2.0f;
+
+        graph.Build(RenderPassGraph::OrderingPolicy::DependencyDepth, RenderPassGraph::QueueAssignmentPolicy::CriticalPath);
+
+        EXPECT(NearlyEqual(nodes[SSR].CriticalPathSlack(), 2.0f));
+        EXPECT(nodes[SSR].ExecutionQueueIndex == AsyncComputeQueue);
+        EXPECT(nodes[AO].ExecutionQueueIndex == GraphicsQueue);
+    }
+
+    void TestDisabledChainCulling()
+    {
+        enum ChainPass : uint64_t { Shading, PreBlur, Denoiser, PostBlur };
+
+        RenderPassGraph graph;
+
+        for (const char* name : { "Shading", "PreBlur", "Denoiser", "PostBlur" })
+        {
+            graph.AddPass(RenderPassMetadata{ name, RenderPassPurpose::Default });
+        }
+
+        auto& nodes = graph.Nodes();
+
+        nodes[Shading].AddWriteDependency("NoisyShading", std::nullopt, 1);
+
+        // Enabled, but its only consumer is disabled
+        nodes[PreBlur].AddReadDependency("NoisyShading", 1);
+        nodes[PreBlur].AddWriteDependency("PreBlurredShading", std::nullopt, 1);
+
+        // Produces history for next frame, which would otherwise make it a sink
+        nodes[Denoiser].AddReadDependency("PreBlurredShading", 1);
+        nodes[Denoiser].AddWriteDependency("DenoisedShading", std::nullopt, 1);
+        nodes[Denoiser].WritesCrossFrameReadResources = true;
+        nodes[Denoiser].IsDisabled = true;
+
+        // Still declares denoised input, same as a consumer that didn't adapt to the disabled producer
+        nodes[PostBlur].AddReadDependency("NoisyShading", 1);
+        nodes[PostBlur].AddReadDependency("DenoisedShading", 1);
+        nodes[PostBlur].AddWriteDependency(RenderPassGraph::Node::BackBufferName, std::nullopt, 1);
+
+        graph.Build();
+
+        EXPECT(nodes[Denoiser].IsCulled());
+        EXPECT(nodes[PreBlur].IsCulled());
+        EXPECT(!nodes[Shading].IsCulled());
+        EXPECT(!nodes[PostBlur].IsCulled());
+        EXPECT(graph.CulledNodeCount() == 2);
+        EXPECT(graph.GetNode("Denoiser").IsDisabled);
+
+        // Flag is reset with the rest of per-frame node state, so re-enabled chain comes back
+        graph.Clear();
+
+        nodes[Shading].AddWriteDependency("NoisyShading", std::nullopt, 1);
+        nodes[PreBlur].AddReadDependency("NoisyShading", 1);
+        nodes[PreBlur].AddWriteDependency("PreBlurredShading", std::nullopt, 1);
+        nodes[Denoiser].AddReadDependency("PreBlurredShading", 1);
+        nodes[Denoiser].AddWriteDependency("DenoisedShading", std::nullopt, 1);
+        nodes[PostBlur].AddReadDependency("DenoisedShading", 1);
+        nodes[PostBlur].AddWriteDependency(RenderPassGraph::Node::BackBufferName, std::nullopt, 1);
+
+        graph.Build();
+
+        EXPECT(graph.CulledNodeCount() == 0);
+    }
+
+}
+
+int main()
+{
+    TestSlackAndCriticalPath();
+    TestCriticalPathQueueAssignment();
+    TestManualQueueAssignment();
+    TestRebuildWithUpdatedCosts();
+    TestDisabledChainCulling();
+
+    std::printf(FailureCount ? "%u checks failed\n" : "All checks passed\n", FailureCount);
+
+    return FailureCount ? 1 : 0;
+}
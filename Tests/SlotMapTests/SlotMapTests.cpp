@@ -0,0 +1,153 @@
+#include <Foundation/SlotMap.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+
+    using Map = Foundation::SlotMap<std::string>;
+
+    uint32_t FailureCount = 0;
+
+    void Expect(bool condition, const char* description, int line)
+    {
+        if (!condition)
+        {
+            std::printf("FAILED (line %d): %s\n", line, description);
+            ++FailureCount;
+        }
+    }
+
+#define EXPECT(CONDITION) Expect((CONDITION), #CONDITION, __LINE__)
+
+    // Every stored object is reachable through the handle reported for its dense position
+    void ExpectConsistentDenseStorage(const Map& map, int line)
+    {
+        for (auto denseIndex = 0u; denseIndex < map.size(); ++denseIndex)
+        {
+            Map::Handle handle = map.HandleAt(denseIndex);
+            const std::string* object = map.Get(handle);
+            Expect(object == map.data() + denseIndex, "Dense index maps back to its own object", line);
+            Expect(map.DenseIndex(handle) == denseIndex && map.DenseIndexOf(*object) == denseIndex, "Handle and object map to their dense index", line);
+        }
+    }
+
+    void TestInsertAndErase()
+    {
+        Map map;
+
+        Map::Handle a = map.Emplace("A");
+        Map::Handle b = map.Emplace("B");
+        Map::Handle c = map.Emplace("C");
+
+        EXPECT(map.size() == 3);
+        EXPECT(map[a] == "A" && map[b] == "B" && map[c] == "C");
+        EXPECT(!Map::Handle{}.IsValid());
+        EXPECT(!map.Contains(Map::Handle{}));
+
+        map.Remove(a);
+
+        // Last object fills the hole and other handles stay valid
+        EXPECT(map.size() == 2);
+        EXPECT(!map.Contains(a));
+        EXPECT(map.Get(a) == nullptr);
+        EXPECT(map[b] == "B" && map[c] == "C");
+        EXPECT(map.data()[0] == "C");
+        EXPECT(map.DenseIndex(c) == 0);
+        ExpectConsistentDenseStorage(map, __LINE__);
+
+        map.Clear();
+
+        EXPECT(map.empty());
+        EXPECT(!map.Contains(b));
+        EXPECT(!map.Contains(c));
+    }
+
+    void TestSlotReuseInvalidatesStaleHandles()
+    {
+        Map map;
+
+        Map::Handle first = map.Emplace("First");
+        map.Remove(first);
+
+        Map::Handle second = map.Emplace("Second");
+
+        // Slot is reused, but generation tells the handles apart
+        EXPECT(second.SlotIndex == first.SlotIndex);
+        EXPECT(second.Generation != first.Generation);
+        EXPECT(second != first);
+        EXPECT(!map.Contains(first));
+        EXPECT(map.Get(first) == nullptr);
+        EXPECT(map[second] == "Second");
+
+        // Slot index lookups ignore generation by design and see the new occupant
+        EXPECT(map.GetBySlotIndex(first.SlotIndex) == map.Get(second));
+        EXPECT(map.HandleForSlotIndex(first.SlotIndex) == second);
+
+        map.Remove(second);
+
+        EXPECT(map.GetBySlotIndex(first.SlotIndex) == nullptr);
+        EXPECT(!map.HandleForSlotIndex(first.SlotIndex).IsValid());
+
+        // Clear also retires outstanding handles
+        Map::Handle third = map.Emplace("Third");
+        map.Clear();
+        Map::Handle fourth = map.Emplace("Fourth");
+
+        EXPECT(!map.Contains(third));
+        EXPECT(map.Contains(fourth));
+    }
+
+    void TestDenseIterationAfterErase()
+    {
+        Map map;
+        std::vector<Map::Handle> handles;
+
+        for (auto i = 0; i < 8; ++i)
+        {
+            handles.push_back(map.Emplace(std::to_string(i)));
+        }
+
+        // Remove from the front, middle and back
+        for (auto i : { 0, 3, 7 })
+        {
+            map.Remove(handles[i]);
+        }
+
+        std::vector<std::string> iterated{ map.begin(), map.end() };
+        std::sort(iterated.begin(), iterated.end());
+
+        EXPECT(map.size() == 5);
+        EXPECT((iterated == std::vector<std::string>{ "1", "2", "4", "5", "6" }));
+        ExpectConsistentDenseStorage(map, __LINE__);
+
+        for (auto i : { 1, 2, 4, 5, 6 })
+        {
+            EXPECT(map[handles[i]] == std::to_string(i));
+        }
+
+        // Removing everything through the dense array leaves no holes behind
+        while (!map.empty())
+        {
+            map.Remove(map.HandleAt(0));
+            ExpectConsistentDenseStorage(map, __LINE__);
+        }
+
+        EXPECT(map.begin() == map.end());
+    }
+
+}
+
+int main()
+{
+    TestInsertAndErase();
+    TestSlotReuseInvalidatesStaleHandles();
+    TestDenseIterationAfterErase();
+
+    std::printf(FailureCount ? "%u checks failed\n" : "All checks passed\n", FailureCount);
+
+    return FailureCount ? 1 : 0;
+}
@@ -0,0 +1,221 @@
+#include <Memory/TextureResidency.hpp>
+
+#include <cstdio>
+#include <vector>
+#include <numeric>
+
+namespace
+{
+
+    uint32_t FailureCount = 0;
+
+    void Expect(bool condition, const char* description, int line)
+    {
+        if (!condition)
+        {
+            std::printf("FAILED (line %d): %s\n", line, description);
+            ++FailureCount;
+        }
+    }
+
+#define EXPECT(CONDITION) Expect((CONDITION), #CONDITION, __LINE__)
+
+    // 4 mips, the coarsest one is pinned
+    const std::vector<uint64_t> MipSizes = { 64, 16, 4, 1 };
+    const uint32_t PinnedMipCount = 1;
+    const uint64_t FullChainSize = 85;
+
+    uint64_t ChainTailSize(uint32_t mostDetailedMip)
+    {
+        return std::accumulate(MipSizes.begin() + mostDetailedMip, MipSizes.end(), uint64_t(0));
+    }
+
+    // Resident bytes only add up if every texture holds exactly a contiguous tail of its chain
+    void ExpectContiguousTails(const Memory::TextureResidency& residency, const std::vector<Memory::TextureResidency::TextureID>& textures, int line)
+    {
+        uint64_t expectedBytes = 0;
+
+        for (Memory::TextureResidency::TextureID texture : textures)
+        {
+            expectedBytes += ChainTailSize(residency.MostDetailedResidentMip(texture));
+        }
+
+        Expect(expectedBytes == residency.ResidentBytes(), "Resident mips form contiguous chain tails", line);
+    }
+
+    void TestRegistration()
+    {
+        Memory::TextureResidency residency{ 1000 };
+
+        auto full = residency.Register(MipSizes, PinnedMipCount);
+        auto partial = residency.Register(MipSizes, PinnedMipCount, 2);
+        // Requested mip coarser than pinned tail still keeps pinned mips resident
+        auto overPinned = residency.Register(MipSizes, 2, 3);
+
+        EXPECT(residency.MostDetailedResidentMip(full) == 0);
+        EXPECT(residency.MostDetailedResidentMip(partial) == 2);
+        EXPECT(residency.MostDetailedResidentMip(overPinned) == 2);
+        EXPECT(residency.MipCount(full) == 4);
+        ExpectContiguousTails(residency, { full, partial, overPinned }, __LINE__);
+
+        // Registration does not produce changes, caller knows the initial state
+        EXPECT(residency.Update().empty());
+    }
+
+    void TestStreamingIn()
+    {
+        Memory::TextureResidency residency{ 1000 };
+        auto texture = residency.Register(MipSizes, PinnedMipCount, 3);
+
+        // One mip per frame until desired one is reached
+        for (uint32_t expectedMip : { 2u, 1u, 0u })
+        {
+            residency.ReportUsage(texture, 0);
+            auto changes = residency.Update();
+
+            EXPECT(changes.size() == 1);
+            EXPECT(!changes.empty() && changes[0].Texture == texture && changes[0].MostDetailedResidentMip == expectedMip);
+            ExpectContiguousTails(residency, { texture }, __LINE__);
+        }
+
+        residency.ReportUsage(texture, 0);
+        EXPECT(residency.Update().empty());
+        EXPECT(residency.ResidentBytes() == FullChainSize);
+    }
+
+    void TestBudgetEvictionOrder()
+    {
+        Memory::TextureResidency residency{ 1000 };
+        auto a = residency.Register(MipSizes, PinnedMipCount);
+        auto b = residency.Register(MipSizes, PinnedMipCount);
+
+        // a becomes least recently used
+        residency.ReportUsage(a, 0);
+        residency.ReportUsage(b, 0);
+        residency.Update();
+        residency.ReportUsage(b, 0);
+        residency.Update();
+
+        // Room for b's full chain and a's two coarsest mips
+        residency.SetMemoryBudget(FullChainSize + ChainTailSize(2));
+        residency.ReportUsage(b, 0);
+        auto changes = residency.Update();
+
+        EXPECT(residency.MostDetailedResidentMip(a) == 2);
+        EXPECT(residency.MostDetailedResidentMip(b) == 0);
+        EXPECT(changes.size() == 1 && changes[0].Texture == a && changes[0].MostDetailedResidentMip == 2);
+        EXPECT(residency.ResidentBytes() <= residency.MemoryBudget());
+        ExpectContiguousTails(residency, { a, b }, __LINE__);
+    }
+
+    void TestCurrentFrameUsageEvictedLast()
+    {
+        Memory::TextureResidency residency{ 1000 };
+        auto a = residency.Register(MipSizes, PinnedMipCount);
+        auto b = residency.Register(MipSizes, PinnedMipCount);
+
+        // Both are used, but budget can't hold both, so eviction has to touch current frame pages
+        residency.SetMemoryBudget(FullChainSize);
+        residency.ReportUsage(a, 0);
+        residency.ReportUsage(b, 0);
+        residency.Update();
+
+        EXPECT(residency.ResidentBytes() <= residency.MemoryBudget());
+        ExpectContiguousTails(residency, { a, b }, __LINE__);
+    }
+
+    void TestPinnedTail()
+    {
+        Memory::TextureResidency residency{ 1000 };
+        auto a = residency.Register(MipSizes, 2);
+        auto b = residency.Register(MipSizes, PinnedMipCount);
+
+        residency.SetMemoryBudget(0);
+        residency.ReportUsage(a, 0);
+        residency.ReportUsage(b, 0);
+        residency.Update();
+
+        // Pinned mips stay over budget
+        EXPECT(residency.MostDetailedResidentMip(a) == 2);
+        EXPECT(residency.MostDetailedResidentMip(b) == 3);
+        EXPECT(residency.ResidentBytes() == ChainTailSize(2) + ChainTailSize(3));
+        ExpectContiguousTails(residency, { a, b }, __LINE__);
+
+        // Nothing streams in while there is no room
+        residency.ReportUsage(b, 0);
+        EXPECT(residency.Update().empty());
+    }
+
+    void TestUnregisterAndIDReuse()
+    {
+        Memory::TextureResidency residency{ 1000 };
+        auto a = residency.Register(MipSizes, PinnedMipCount);
+        auto b = residency.Register(MipSizes, PinnedMipCount);
+
+        residency.Unregister(a);
+        EXPECT(residency.ResidentBytes() == FullChainSize);
+
+        auto c = residency.Register(MipSizes, PinnedMipCount, 3);
+        EXPECT(c == a);
+        EXPECT(residency.MostDetailedResidentMip(c) == 3);
+        ExpectContiguousTails(residency, { b, c }, __LINE__);
+
+        // Pages of unregistered texture must not linger in eviction order
+        residency.SetMemoryBudget(ChainTailSize(3) * 2);
+        residency.Update();
+
+        EXPECT(residency.MostDetailedResidentMip(b) == 3);
+        EXPECT(residency.MostDetailedResidentMip(c) == 3);
+        ExpectContiguousTails(residency, { b, c }, __LINE__);
+    }
+
+    void TestLoweringAndRaisingBudget()
+    {
+        Memory::TextureResidency residency{ 1000 };
+        std::vector<Memory::TextureResidency::TextureID> textures;
+
+        for (auto i = 0; i < 4; ++i)
+        {
+            textures.push_back(residency.Register(MipSizes, PinnedMipCount));
+        }
+
+        for (uint64_t budget : { 300ull, 200ull, 50ull, 4ull })
+        {
+            residency.SetMemoryBudget(budget);
+
+            for (auto texture : textures) residency.ReportUsage(texture, 0);
+            residency.Update();
+
+            EXPECT(residency.ResidentBytes() <= std::max<uint64_t>(budget, textures.size() * ChainTailSize(3)));
+            ExpectContiguousTails(residency, textures, __LINE__);
+        }
+
+        // Raising budget back streams everything in again, one mip per frame
+        residency.SetMemoryBudget(1000);
+
+        for (auto frame = 0; frame < 3; ++frame)
+        {
+            for (auto texture : textures) residency.ReportUsage(texture, 0);
+            residency.Update();
+            ExpectContiguousTails(residency, textures, __LINE__);
+        }
+
+        EXPECT(residency.ResidentBytes() == textures.size() * FullChainSize);
+    }
+
+}
+
+int main()
+{
+    TestRegistration();
+    TestStreamingIn();
+    TestBudgetEvictionOrder();
+    TestCurrentFrameUsageEvictedLast();
+    TestPinnedTail();
+    TestUnregisterAndIDReuse();
+    TestLoweringAndRaisingBudget();
+
+    std::printf(FailureCount ? "%u checks failed\n" : "All checks passed\n", FailureCount);
+
+    return FailureCount ? 1 : 0;
+}
@@ -0,0 +1,174 @@
+#include <Geometry/Transformation.hpp>
+
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+
+    using Geometry::Transformation;
+    using Geometry::TransformationArrays;
+
+    uint32_t FailureCount = 0;
+
+    void Expect(bool condition, const char* description, int line)
+    {
+        if (!condition)
+        {
+            std::printf("FAILED (line %d): %s\n", line, description);
+            ++FailureCount;
+        }
+    }
+
+#define EXPECT(CONDITION) Expect((CONDITION), #CONDITION, __LINE__)
+
+    // Tolerance is relative, because normal matrices of small scales have large elements
+    bool NearlyEqual(const glm::mat4& a, const glm::mat4& b)
+    {
+        for (auto column = 0; column < 4; ++column)
+        {
+            for (auto row = 0; row < 4; ++row)
+            {
+                float tolerance = 1e-4f * std::max(1.0f, std::abs(b[column][row]));
+
+                if (std::abs(a[column][row] - b[column][row]) > tolerance)
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool NearlyEqual(const Transformation& a, const Transformation& b)
+    {
+        return NearlyEqual(a.ModelMatrix(), b.ModelMatrix());
+    }
+
+    // Non-uniform scales, arbitrary rotations and translations, deterministic across runs
+    Transformation MakeTransformation(uint32_t index)
+    {
+        float f = float(index);
+
+        glm::vec3 scale{ 0.5f + 0.25f * (index % 5), 2.0f - 0.3f * (index % 4), 0.75f + 0.5f * (index % 3) };
+        glm::vec3 translation{ f * 1.5f - 7.0f, 3.0f - f * 0.5f, f * 0.25f };
+        glm::vec3 axis = glm::normalize(glm::vec3{ 1.0f + f, 2.0f - f * 0.3f, 0.5f + f * 0.7f });
+        glm::quat rotation = glm::angleAxis(0.37f * f - 1.0f, axis);
+
+        return Transformation{ scale, translation, rotation };
+    }
+
+    TransformationArrays MakeArrays(uint32_t count)
+    {
+        TransformationArrays arrays;
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            arrays.PushBack(MakeTransformation(i));
+        }
+
+        return arrays;
+    }
+
+    void TestArraysStorage()
+    {
+        TransformationArrays arrays = MakeArrays(5);
+
+        EXPECT(arrays.Count() == 5);
+
+        for (auto i = 0u; i < 5; ++i)
+        {
+            EXPECT(NearlyEqual(arrays.Get(i), MakeTransformation(i)));
+        }
+
+        // Last transformation fills the hole
+        arrays.SwapRemove(1);
+
+        EXPECT(arrays.Count() == 4);
+        EXPECT(NearlyEqual(arrays.Get(1), MakeTransformation(4)));
+        EXPECT(NearlyEqual(arrays.Get(3), MakeTransformation(3)));
+
+        arrays.Set(0, MakeTransformation(7));
+        EXPECT(NearlyEqual(arrays.Get(0), MakeTransformation(7)));
+
+        Geometry::TransformationSoA view = arrays.View(2, 2);
+        EXPECT(view.Count == 2);
+        EXPECT(view.ScaleX == arrays.ScaleX.data() + 2);
+        EXPECT(view.RotationW == arrays.RotationW.data() + 2);
+    }
+
+    // Counts that are not multiples of vector width exercise remainder handling
+    void TestBatchMatricesMatchScalar()
+    {
+        for (uint32_t count : { 1u, 3u, 4u, 8u, 13u, 35u })
+        {
+            TransformationArrays arrays = MakeArrays(count);
+            std::vector<glm::mat4> modelMatrices(count);
+            std::vector<glm::mat4> normalMatrices(count);
+
+            Transformation::ComputeMatrices(
+                arrays.View(0, count),
+                { reinterpret_cast<uint8_t*>(modelMatrices.data()) },
+                { reinterpret_cast<uint8_t*>(normalMatrices.data()) });
+
+            for (auto i = 0u; i < count; ++i)
+            {
+                Transformation transformation = MakeTransformation(i);
+
+                EXPECT(NearlyEqual(modelMatrices[i], transformation.ModelMatrix()));
+                EXPECT(NearlyEqual(normalMatrices[i], transformation.NormalMatrix()));
+            }
+        }
+    }
+
+    void TestBatchMatricesStreams()
+    {
+        // Interleaved destination, similar to GPU instance table entries
+        struct Entry
+        {
+            glm::mat4 Model;
+            uint32_t Padding[3];
+            glm::mat4 Normal;
+        };
+
+        const uint32_t count = 11;
+        const uint32_t first = 2;
+        const uint32_t viewCount = count - first;
+
+        TransformationArrays arrays = MakeArrays(count);
+        std::vector<Entry> entries(viewCount);
+        std::vector<glm::mat4> modelOnly(viewCount, glm::mat4{ 0.0f });
+
+        Transformation::ComputeMatrices(
+            arrays.View(first, viewCount),
+            { reinterpret_cast<uint8_t*>(&entries[0].Model), sizeof(Entry) },
+            { reinterpret_cast<uint8_t*>(&entries[0].Normal), sizeof(Entry) });
+
+        // Stream with null data is skipped
+        Transformation::ComputeMatrices(arrays.View(first, viewCount), { reinterpret_cast<uint8_t*>(modelOnly.data()) }, {});
+
+        for (auto i = 0u; i < viewCount; ++i)
+        {
+            Transformation transformation = MakeTransformation(first + i);
+
+            EXPECT(NearlyEqual(entries[i].Model, transformation.ModelMatrix()));
+            EXPECT(NearlyEqual(entries[i].Normal, transformation.NormalMatrix()));
+            EXPECT(NearlyEqual(modelOnly[i], transformation.ModelMatrix()));
+        }
+    }
+
+}
+
+int main()
+{
+    TestArraysStorage();
+    TestBatchMatricesMatchScalar();
+    TestBatchMatricesStreams();
+
+    std::printf(FailureCount ? "%u checks failed\n" : "All checks passed\n", FailureCount);
+
+    return FailureCount ? 1 : 0;
+}